@@ -0,0 +1,749 @@
+/*
+    Hash - blake2_many.c
+
+    History:
+
+    v. 1.0.0 (10/18/2026) - Initial version
+    v. 1.0.1 (10/18/2026) - process BLAKE2bp / BLAKE2sp leaves in the
+                            lanes or on threads
+
+    Copyright (c) 2026 Sriranga R. Veeraraghavan <ranga@calalum.org>
+
+    Permission is hereby granted, free of charge, to any person obtaining
+    a copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+    OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <string.h>
+
+#include "blake2.h"
+#include "blake2_many.h"
+#include "blake2_simd.h"
+
+#if !defined(_WIN32) && !defined(BLAKE2_NO_PTHREADS)
+#define BLAKE2_MANY_THREADS 1
+#include "hash_threads.h"
+#endif
+
+/*
+    Each SIMD lane holds the chaining value of a different message.  All
+    of the lanes compress their next block together until one of them
+    reaches the last block of its message, which is then finished with
+    the reference code (the last block needs the finalization flag, and
+    may be partial), and the lane is refilled with the next message.
+    Messages that fit in a single block never use a lane.
+
+    The lanes are written with the GCC / clang vector extensions, and
+    AVX2 is enabled for this file with a target pragma, so the rest of
+    the build doesn't need to be compiled for AVX2.
+ */
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+
+#define BLAKE2_MANY_SIMD 1
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("avx2"))), apply_to = function)
+#else
+#pragma GCC push_options
+#pragma GCC target("avx2")
+#endif
+
+enum {
+    BLAKE2B_LANES = 4,
+    BLAKE2S_LANES = 8,
+};
+
+typedef uint64_t blake2bLanes __attribute__((vector_size(32)));
+typedef uint32_t blake2sLanes __attribute__((vector_size(32)));
+
+static const uint64_t blake2b_many_IV[8] = {
+    0x6a09e667f3bcc908ULL, 0xbb67ae8584caa73bULL,
+    0x3c6ef372fe94f82bULL, 0xa54ff53a5f1d36f1ULL,
+    0x510e527fade682d1ULL, 0x9b05688c2b3e6c1fULL,
+    0x1f83d9abfb41bd6bULL, 0x5be0cd19137e2179ULL,
+};
+
+static const uint32_t blake2s_many_IV[8] = {
+    0x6A09E667UL, 0xBB67AE85UL, 0x3C6EF372UL, 0xA54FF53AUL,
+    0x510E527FUL, 0x9B05688CUL, 0x1F83D9ABUL, 0x5BE0CD19UL,
+};
+
+static const uint8_t blake2_many_sigma[12][16] = {
+    {  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15 },
+    { 14, 10,  4,  8,  9, 15, 13,  6,  1, 12,  0,  2, 11,  7,  5,  3 },
+    { 11,  8, 12,  0,  5,  2, 15, 13, 10, 14,  3,  6,  7,  1,  9,  4 },
+    {  7,  9,  3,  1, 13, 12, 11, 14,  2,  6,  5, 10,  4,  0, 15,  8 },
+    {  9,  0,  5,  7,  2,  4, 10, 15, 14,  1, 11, 12,  6,  8,  3, 13 },
+    {  2, 12,  6, 10,  0, 11,  8,  3,  4, 13,  7,  5, 15, 14,  1,  9 },
+    { 12,  5,  1, 15, 14, 13,  4, 10,  0,  7,  6,  3,  9,  2,  8, 11 },
+    { 13, 11,  7, 14, 12,  1,  3,  9,  5,  0, 15,  4,  8,  6,  2, 10 },
+    {  6, 15, 14,  9, 11,  3,  0,  8, 12,  2, 13,  7,  1,  4, 10,  5 },
+    { 10,  2,  8,  4,  7,  6,  1,  5, 15, 11,  9, 14,  3, 12, 13,  0 },
+    {  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15 },
+    { 14, 10,  4,  8,  9, 15, 13,  6,  1, 12,  0,  2, 11,  7,  5,  3 },
+};
+
+// an all zero block for the lanes that have no message
+
+static const uint8_t blake2_many_zero[BLAKE2B_BLOCKBYTES];
+
+#define ROTR_LANES(x, n, bits) (((x) >> (n)) | ((x) << ((bits) - (n))))
+
+#define G_LANES(r, i, a, b, c, d, r1, r2, r3, r4, bits) \
+    do { \
+        a = a + b + m[blake2_many_sigma[r][2*i+0]]; \
+        d = ROTR_LANES(d ^ a, r1, bits); \
+        c = c + d; \
+        b = ROTR_LANES(b ^ c, r2, bits); \
+        a = a + b + m[blake2_many_sigma[r][2*i+1]]; \
+        d = ROTR_LANES(d ^ a, r3, bits); \
+        c = c + d; \
+        b = ROTR_LANES(b ^ c, r4, bits); \
+    } while (0)
+
+#define ROUND_LANES(r, r1, r2, r3, r4, bits) \
+    do { \
+        G_LANES(r, 0, v[ 0], v[ 4], v[ 8], v[12], r1, r2, r3, r4, bits); \
+        G_LANES(r, 1, v[ 1], v[ 5], v[ 9], v[13], r1, r2, r3, r4, bits); \
+        G_LANES(r, 2, v[ 2], v[ 6], v[10], v[14], r1, r2, r3, r4, bits); \
+        G_LANES(r, 3, v[ 3], v[ 7], v[11], v[15], r1, r2, r3, r4, bits); \
+        G_LANES(r, 4, v[ 0], v[ 5], v[10], v[15], r1, r2, r3, r4, bits); \
+        G_LANES(r, 5, v[ 1], v[ 6], v[11], v[12], r1, r2, r3, r4, bits); \
+        G_LANES(r, 6, v[ 2], v[ 7], v[ 8], v[13], r1, r2, r3, r4, bits); \
+        G_LANES(r, 7, v[ 3], v[ 4], v[ 9], v[14], r1, r2, r3, r4, bits); \
+    } while (0)
+
+/* blake2b_compress_lanes - compress one (non-final) block per lane */
+
+static void blake2b_compress_lanes(blake2bLanes h[8],
+                                   blake2bLanes t,
+                                   const uint8_t *const blocks[BLAKE2B_LANES])
+{
+    blake2bLanes m[16];
+    blake2bLanes v[16];
+    uint64_t w[BLAKE2B_LANES];
+    int i = 0, j = 0, r = 0;
+
+    for (i = 0; i < 16; i++) {
+        for (j = 0; j < BLAKE2B_LANES; j++) {
+            memcpy(&w[j], blocks[j] + 8*i, sizeof(uint64_t));
+        }
+        m[i] = (blake2bLanes){ w[0], w[1], w[2], w[3] };
+    }
+
+    for (i = 0; i < 8; i++) {
+        v[i] = h[i];
+        v[i + 8] = (blake2bLanes){ 0 } + blake2b_many_IV[i];
+    }
+    v[12] ^= t;
+
+    for (r = 0; r < 12; r++) {
+        ROUND_LANES(r, 32, 24, 16, 63, 64);
+    }
+
+    for (i = 0; i < 8; i++) {
+        h[i] ^= v[i] ^ v[i + 8];
+    }
+}
+
+/* blake2s_compress_lanes - compress one (non-final) block per lane */
+
+static void blake2s_compress_lanes(blake2sLanes h[8],
+                                   blake2sLanes t,
+                                   const uint8_t *const blocks[BLAKE2S_LANES])
+{
+    blake2sLanes m[16];
+    blake2sLanes v[16];
+    uint32_t w[BLAKE2S_LANES];
+    int i = 0, j = 0, r = 0;
+
+    for (i = 0; i < 16; i++) {
+        for (j = 0; j < BLAKE2S_LANES; j++) {
+            memcpy(&w[j], blocks[j] + 4*i, sizeof(uint32_t));
+        }
+        m[i] = (blake2sLanes){ w[0], w[1], w[2], w[3],
+                               w[4], w[5], w[6], w[7] };
+    }
+
+    for (i = 0; i < 8; i++) {
+        v[i] = h[i];
+        v[i + 8] = (blake2sLanes){ 0 } + blake2s_many_IV[i];
+    }
+    v[12] ^= t;
+
+    for (r = 0; r < 10; r++) {
+        ROUND_LANES(r, 16, 12, 8, 7, 32);
+    }
+
+    for (i = 0; i < 8; i++) {
+        h[i] ^= v[i] ^ v[i + 8];
+    }
+}
+
+/* a message that is being hashed in a lane */
+
+typedef struct blake2ManyLane {
+    size_t index;           /* message number */
+    const uint8_t *next;    /* next block */
+    size_t blocks;          /* blocks left before the last block */
+    size_t length;          /* bytes left, including the last block */
+    int active;
+} blake2ManyLane;
+
+/*
+    Prefix of a message that can be compressed in a lane, every block but
+    the last (which may also be a full block)
+ */
+
+#define BLAKE2_LANE_BLOCKS(length, blockBytes) \
+    ((length) == 0 ? 0 : ((length) - 1) / (blockBytes))
+
+static void blake2b_many_avx2(const uint8_t *const *inputs,
+                              const size_t *lengths,
+                              size_t count,
+                              uint8_t *out,
+                              uint8_t outlen)
+{
+    blake2ManyLane lanes[BLAKE2B_LANES];
+    const uint8_t *blocks[BLAKE2B_LANES];
+    blake2bLanes h[8];
+    blake2bLanes t = { 0 };
+    blake2b_state init, S;
+    size_t next = 0, steps = 0, s = 0;
+    int i = 0, j = 0, active = 0;
+
+    blake2b_init(&init, outlen);
+    memset(lanes, 0, sizeof(lanes));
+    memset(h, 0, sizeof(h));
+
+    for (;;) {
+
+        // refill the empty lanes, messages of one block are hashed now
+
+        active = 0;
+        for (j = 0; j < BLAKE2B_LANES; j++) {
+            while (!lanes[j].active && next < count) {
+                if (BLAKE2_LANE_BLOCKS(lengths[next],
+                                       BLAKE2B_BLOCKBYTES) == 0) {
+                    blake2b(out + next*outlen, inputs[next], NULL,
+                            outlen, lengths[next], 0);
+                    next++;
+                    continue;
+                }
+                lanes[j].index = next;
+                lanes[j].next = inputs[next];
+                lanes[j].length = lengths[next];
+                lanes[j].blocks = BLAKE2_LANE_BLOCKS(lengths[next],
+                                                     BLAKE2B_BLOCKBYTES);
+                lanes[j].active = 1;
+                for (i = 0; i < 8; i++) {
+                    h[i][j] = init.h[i];
+                }
+                t[j] = 0;
+                next++;
+            }
+            if (lanes[j].active) {
+                if (active == 0 || lanes[j].blocks < steps) {
+                    steps = lanes[j].blocks;
+                }
+                active++;
+            }
+        }
+
+        if (active == 0) {
+            break;
+        }
+
+        // compress until a lane reaches its last block
+
+        for (s = 0; s < steps; s++) {
+            for (j = 0; j < BLAKE2B_LANES; j++) {
+                if (lanes[j].active) {
+                    blocks[j] = lanes[j].next;
+                    lanes[j].next += BLAKE2B_BLOCKBYTES;
+                } else {
+                    blocks[j] = blake2_many_zero;
+                }
+            }
+            t += BLAKE2B_BLOCKBYTES;
+            blake2b_compress_lanes(h, t, blocks);
+        }
+
+        // finish the messages that are down to their last block
+
+        for (j = 0; j < BLAKE2B_LANES; j++) {
+            if (!lanes[j].active) {
+                continue;
+            }
+            lanes[j].blocks -= steps;
+            lanes[j].length -= steps * BLAKE2B_BLOCKBYTES;
+            if (lanes[j].blocks > 0) {
+                continue;
+            }
+            S = init;
+            for (i = 0; i < 8; i++) {
+                S.h[i] = h[i][j];
+            }
+            S.t[0] = t[j];
+            blake2b_update(&S, lanes[j].next, lanes[j].length);
+            blake2b_final(&S, out + lanes[j].index*outlen, outlen);
+            lanes[j].active = 0;
+        }
+    }
+}
+
+static void blake2s_many_avx2(const uint8_t *const *inputs,
+                              const size_t *lengths,
+                              size_t count,
+                              uint8_t *out,
+                              uint8_t outlen)
+{
+    blake2ManyLane lanes[BLAKE2S_LANES];
+    const uint8_t *blocks[BLAKE2S_LANES];
+    blake2sLanes h[8];
+    blake2sLanes t = { 0 };
+    blake2s_state init, S;
+    size_t next = 0, steps = 0, s = 0;
+    int i = 0, j = 0, active = 0;
+
+    blake2s_init(&init, outlen);
+    memset(lanes, 0, sizeof(lanes));
+    memset(h, 0, sizeof(h));
+
+    for (;;) {
+
+        // refill the empty lanes, messages of one block are hashed now,
+        // as are messages of 4GB or more (the lanes only hold the low
+        // word of the counter)
+
+        active = 0;
+        for (j = 0; j < BLAKE2S_LANES; j++) {
+            while (!lanes[j].active && next < count) {
+                if (BLAKE2_LANE_BLOCKS(lengths[next],
+                                       BLAKE2S_BLOCKBYTES) == 0 ||
+                    (uint64_t)lengths[next] > UINT32_MAX) {
+                    blake2s(out + next*outlen, inputs[next], NULL,
+                            outlen, lengths[next], 0);
+                    next++;
+                    continue;
+                }
+                lanes[j].index = next;
+                lanes[j].next = inputs[next];
+                lanes[j].length = lengths[next];
+                lanes[j].blocks = BLAKE2_LANE_BLOCKS(lengths[next],
+                                                     BLAKE2S_BLOCKBYTES);
+                lanes[j].active = 1;
+                for (i = 0; i < 8; i++) {
+                    h[i][j] = init.h[i];
+                }
+                t[j] = 0;
+                next++;
+            }
+            if (lanes[j].active) {
+                if (active == 0 || lanes[j].blocks < steps) {
+                    steps = lanes[j].blocks;
+                }
+                active++;
+            }
+        }
+
+        if (active == 0) {
+            break;
+        }
+
+        // compress until a lane reaches its last block
+
+        for (s = 0; s < steps; s++) {
+            for (j = 0; j < BLAKE2S_LANES; j++) {
+                if (lanes[j].active) {
+                    blocks[j] = lanes[j].next;
+                    lanes[j].next += BLAKE2S_BLOCKBYTES;
+                } else {
+                    blocks[j] = blake2_many_zero;
+                }
+            }
+            t += BLAKE2S_BLOCKBYTES;
+            blake2s_compress_lanes(h, t, blocks);
+        }
+
+        // finish the messages that are down to their last block
+
+        for (j = 0; j < BLAKE2S_LANES; j++) {
+            if (!lanes[j].active) {
+                continue;
+            }
+            lanes[j].blocks -= steps;
+            lanes[j].length -= steps * BLAKE2S_BLOCKBYTES;
+            if (lanes[j].blocks > 0) {
+                continue;
+            }
+            S = init;
+            for (i = 0; i < 8; i++) {
+                S.h[i] = h[i][j];
+            }
+            S.t[0] = t[j];
+            blake2s_update(&S, lanes[j].next, lanes[j].length);
+            blake2s_final(&S, out + lanes[j].index*outlen, outlen);
+            lanes[j].active = 0;
+        }
+    }
+}
+
+/*
+    Leaves of a BLAKE2bp / BLAKE2sp tree.  There is one leaf per lane,
+    and leaf j gets blocks j, j + lanes, j + 2*lanes, ... of the input.
+    A leaf may have one full block left in its buffer by the previous
+    update, and its last block is always left in the buffer, since it
+    could be the final one.  The lanes only carry the low word of the
+    counter and no finalization flags, so leaves that don't fit that are
+    left to the reference code (the functions return 0).
+ */
+
+static int blake2b_leaves_avx2(blake2b_state leaves[BLAKE2B_LANES][1],
+                               const uint8_t *in,
+                               size_t blocks)
+{
+    const uint8_t *ptrs[BLAKE2B_LANES];
+    blake2bLanes h[8];
+    blake2bLanes t = { 0 };
+    size_t buflen = leaves[0]->buflen;
+    size_t s = 0;
+    int i = 0, j = 0;
+
+    for (j = 0; j < BLAKE2B_LANES; j++) {
+        if (leaves[j]->buflen != buflen ||
+            leaves[j]->f[0] != 0 || leaves[j]->f[1] != 0 ||
+            leaves[j]->t[1] != 0 ||
+            leaves[j]->t[0] > UINT64_MAX - (blocks + 1)*BLAKE2B_BLOCKBYTES) {
+            return 0;
+        }
+    }
+    if ((buflen != 0 && buflen != BLAKE2B_BLOCKBYTES) || blocks == 0) {
+        return 0;
+    }
+
+    for (j = 0; j < BLAKE2B_LANES; j++) {
+        for (i = 0; i < 8; i++) {
+            h[i][j] = leaves[j]->h[i];
+        }
+        t[j] = leaves[j]->t[0];
+    }
+
+    if (buflen != 0) {
+        for (j = 0; j < BLAKE2B_LANES; j++) {
+            ptrs[j] = leaves[j]->buf;
+        }
+        t += BLAKE2B_BLOCKBYTES;
+        blake2b_compress_lanes(h, t, ptrs);
+    }
+
+    for (s = 0; s + 1 < blocks; s++) {
+        for (j = 0; j < BLAKE2B_LANES; j++) {
+            ptrs[j] = in + (s*BLAKE2B_LANES + j)*BLAKE2B_BLOCKBYTES;
+        }
+        t += BLAKE2B_BLOCKBYTES;
+        blake2b_compress_lanes(h, t, ptrs);
+    }
+
+    for (j = 0; j < BLAKE2B_LANES; j++) {
+        for (i = 0; i < 8; i++) {
+            leaves[j]->h[i] = h[i][j];
+        }
+        leaves[j]->t[0] = t[j];
+        memcpy(leaves[j]->buf,
+               in + (s*BLAKE2B_LANES + j)*BLAKE2B_BLOCKBYTES,
+               BLAKE2B_BLOCKBYTES);
+        leaves[j]->buflen = BLAKE2B_BLOCKBYTES;
+    }
+
+    return 1;
+}
+
+static int blake2s_leaves_avx2(blake2s_state leaves[BLAKE2S_LANES][1],
+                               const uint8_t *in,
+                               size_t blocks)
+{
+    const uint8_t *ptrs[BLAKE2S_LANES];
+    blake2sLanes h[8];
+    blake2sLanes t = { 0 };
+    size_t buflen = leaves[0]->buflen;
+    size_t s = 0;
+    int i = 0, j = 0;
+
+    // the low word of the counter must not wrap
+
+    if (blocks >= UINT32_MAX / BLAKE2S_BLOCKBYTES) {
+        return 0;
+    }
+    for (j = 0; j < BLAKE2S_LANES; j++) {
+        if (leaves[j]->buflen != buflen ||
+            leaves[j]->f[0] != 0 || leaves[j]->f[1] != 0 ||
+            leaves[j]->t[1] != 0 ||
+            leaves[j]->t[0] > UINT32_MAX - (blocks + 1)*BLAKE2S_BLOCKBYTES) {
+            return 0;
+        }
+    }
+    if ((buflen != 0 && buflen != BLAKE2S_BLOCKBYTES) || blocks == 0) {
+        return 0;
+    }
+
+    for (j = 0; j < BLAKE2S_LANES; j++) {
+        for (i = 0; i < 8; i++) {
+            h[i][j] = leaves[j]->h[i];
+        }
+        t[j] = leaves[j]->t[0];
+    }
+
+    if (buflen != 0) {
+        for (j = 0; j < BLAKE2S_LANES; j++) {
+            ptrs[j] = leaves[j]->buf;
+        }
+        t += BLAKE2S_BLOCKBYTES;
+        blake2s_compress_lanes(h, t, ptrs);
+    }
+
+    for (s = 0; s + 1 < blocks; s++) {
+        for (j = 0; j < BLAKE2S_LANES; j++) {
+            ptrs[j] = in + (s*BLAKE2S_LANES + j)*BLAKE2S_BLOCKBYTES;
+        }
+        t += BLAKE2S_BLOCKBYTES;
+        blake2s_compress_lanes(h, t, ptrs);
+    }
+
+    for (j = 0; j < BLAKE2S_LANES; j++) {
+        for (i = 0; i < 8; i++) {
+            leaves[j]->h[i] = h[i][j];
+        }
+        leaves[j]->t[0] = t[j];
+        memcpy(leaves[j]->buf,
+               in + (s*BLAKE2S_LANES + j)*BLAKE2S_BLOCKBYTES,
+               BLAKE2S_BLOCKBYTES);
+        leaves[j]->buflen = BLAKE2S_BLOCKBYTES;
+    }
+
+    return 1;
+}
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#else
+#pragma GCC pop_options
+#endif
+
+#endif /* __x86_64__ && (__GNUC__ || __clang__) */
+
+void blake2b_many(const uint8_t *const *inputs,
+                  const size_t *lengths,
+                  size_t count,
+                  uint8_t *out,
+                  uint8_t outlen,
+                  int useSimd)
+{
+    size_t i = 0;
+
+#if defined(BLAKE2_MANY_SIMD)
+    if (useSimd && __builtin_cpu_supports("avx2")) {
+        blake2b_many_avx2(inputs, lengths, count, out, outlen);
+        return;
+    }
+#else
+    (void)useSimd;
+#endif
+
+    for (i = 0; i < count; i++) {
+        blake2b(out + i*outlen, inputs[i], NULL, outlen, lengths[i], 0);
+    }
+}
+
+void blake2s_many(const uint8_t *const *inputs,
+                  const size_t *lengths,
+                  size_t count,
+                  uint8_t *out,
+                  uint8_t outlen,
+                  int useSimd)
+{
+    size_t i = 0;
+
+#if defined(BLAKE2_MANY_SIMD)
+    if (useSimd && __builtin_cpu_supports("avx2")) {
+        blake2s_many_avx2(inputs, lengths, count, out, outlen);
+        return;
+    }
+#else
+    (void)useSimd;
+#endif
+
+    for (i = 0; i < count; i++) {
+        blake2s(out + i*outlen, inputs[i], NULL, outlen, lengths[i], 0);
+    }
+}
+
+/*
+    Leaves on threads.  Each thread takes a contiguous range of leaves
+    and feeds them their blocks one at a time, so every leaf still sees
+    its blocks in order.  Inputs smaller than BLAKE2_LEAF_THREAD_MIN per
+    thread aren't worth starting threads for.
+ */
+
+#if defined(BLAKE2_MANY_THREADS)
+
+enum {
+    BLAKE2_LEAF_THREAD_MIN = 524288,
+};
+
+typedef struct blake2LeafJob {
+    void *leaves;           /* the first leaf of the range */
+    size_t first;           /* index of the first leaf */
+    size_t count;           /* number of leaves */
+    size_t fanout;          /* total number of leaves */
+    const uint8_t *in;
+    uint64_t inlen;
+    int isBlake2b;
+} blake2LeafJob;
+
+static void blake2_leaf_job(void *arg, size_t index)
+{
+    blake2LeafJob *job = (blake2LeafJob *)arg + index;
+    size_t blockBytes = (job->isBlake2b ?
+                         BLAKE2B_BLOCKBYTES : BLAKE2S_BLOCKBYTES);
+    size_t stride = blockBytes * job->fanout;
+    const uint8_t *in = NULL;
+    uint64_t off = 0;
+    size_t j = 0;
+
+    for (j = 0; j < job->count; j++) {
+        in = job->in + (job->first + j) * blockBytes;
+        for (off = 0; off < job->inlen; off += stride) {
+            if (job->isBlake2b) {
+                blake2b_update((blake2b_state *)job->leaves + j,
+                               in + off, blockBytes);
+            } else {
+                blake2s_update((blake2s_state *)job->leaves + j,
+                               in + off, blockBytes);
+            }
+        }
+    }
+}
+
+/*
+    blake2_leaves_threaded - returns 1 if the leaves were updated on
+                             threads, 0 if the input is too small or there
+                             is only one cpu
+ */
+
+static int blake2_leaves_threaded(void *leaves,
+                                  size_t leafSize,
+                                  size_t fanout,
+                                  const uint8_t *in,
+                                  uint64_t inlen,
+                                  int isBlake2b)
+{
+    blake2LeafJob jobs[BLAKE2S_PARALLELISM];
+    size_t threadCount = hash_threads_count(inlen,
+                                            BLAKE2_LEAF_THREAD_MIN,
+                                            fanout);
+    size_t i = 0, leaf = 0;
+
+    if (threadCount < 2) {
+        return 0;
+    }
+
+    for (i = 0; i < threadCount; i++) {
+        jobs[i].count = fanout / threadCount +
+                        (i < fanout % threadCount ? 1 : 0);
+        jobs[i].first = leaf;
+        jobs[i].leaves = (uint8_t *)leaves + leaf * leafSize;
+        jobs[i].fanout = fanout;
+        jobs[i].in = in;
+        jobs[i].inlen = inlen;
+        jobs[i].isBlake2b = isBlake2b;
+        leaf += jobs[i].count;
+    }
+
+    hash_threads_run(threadCount, blake2_leaf_job, jobs);
+
+    return 1;
+}
+
+#endif /* BLAKE2_MANY_THREADS */
+
+void blake2bp_update_leaves(blake2b_state leaves[BLAKE2B_PARALLELISM][1],
+                            const uint8_t *in,
+                            uint64_t inlen)
+{
+    const size_t stride = BLAKE2B_PARALLELISM * BLAKE2B_BLOCKBYTES;
+    uint64_t off = 0;
+    size_t j = 0;
+
+    if (inlen == 0) {
+        return;
+    }
+
+#if defined(BLAKE2_MANY_THREADS)
+    if (blake2_leaves_threaded(leaves, sizeof(leaves[0]),
+                               BLAKE2B_PARALLELISM, in, inlen, 1)) {
+        return;
+    }
+#endif
+
+#if defined(BLAKE2_MANY_SIMD)
+    if (blake2_lanes_enabled() &&
+        blake2b_leaves_avx2(leaves, in, (size_t)(inlen / stride))) {
+        return;
+    }
+#endif
+
+    for (j = 0; j < BLAKE2B_PARALLELISM; j++) {
+        for (off = j * BLAKE2B_BLOCKBYTES; off < inlen; off += stride) {
+            blake2b_update(leaves[j], in + off, BLAKE2B_BLOCKBYTES);
+        }
+    }
+}
+
+void blake2sp_update_leaves(blake2s_state leaves[BLAKE2S_PARALLELISM][1],
+                            const uint8_t *in,
+                            uint64_t inlen)
+{
+    const size_t stride = BLAKE2S_PARALLELISM * BLAKE2S_BLOCKBYTES;
+    uint64_t off = 0;
+    size_t j = 0;
+
+    if (inlen == 0) {
+        return;
+    }
+
+#if defined(BLAKE2_MANY_THREADS)
+    if (blake2_leaves_threaded(leaves, sizeof(leaves[0]),
+                               BLAKE2S_PARALLELISM, in, inlen, 0)) {
+        return;
+    }
+#endif
+
+#if defined(BLAKE2_MANY_SIMD)
+    if (blake2_lanes_enabled() &&
+        blake2s_leaves_avx2(leaves, in, (size_t)(inlen / stride))) {
+        return;
+    }
+#endif
+
+    for (j = 0; j < BLAKE2S_PARALLELISM; j++) {
+        for (off = j * BLAKE2S_BLOCKBYTES; off < inlen; off += stride) {
+            blake2s_update(leaves[j], in + off, BLAKE2S_BLOCKBYTES);
+        }
+    }
+}
@@ -0,0 +1,101 @@
+/*
+    Hash - blake2_many.h
+
+    Batch hashing of many independent messages with BLAKE2b and
+    BLAKE2s.  On x86_64 cpus with AVX2, the messages are hashed four
+    (BLAKE2b) or eight (BLAKE2s) at a time, one message per SIMD lane.
+    The same lanes process the leaves of BLAKE2bp and BLAKE2sp trees.
+
+    History:
+
+    v. 1.0.0 (10/18/2026) - Initial version
+    v. 1.0.1 (10/18/2026) - add blake2bp_update_leaves and
+                            blake2sp_update_leaves
+
+    Copyright (c) 2026 Sriranga R. Veeraraghavan <ranga@calalum.org>
+
+    Permission is hereby granted, free of charge, to any person obtaining
+    a copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+    OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef blake2_many_h
+#define blake2_many_h
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "blake2.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+    blake2b_many, blake2s_many - hash count messages (inputs[i], which is
+                                 lengths[i] bytes long), writing outlen
+                                 bytes of digest for each message to
+                                 out + i*outlen.  If useSimd is 0, or the
+                                 cpu doesn't support AVX2, the messages
+                                 are hashed one at a time.
+ */
+
+void blake2b_many(const uint8_t *const *inputs,
+                  const size_t *lengths,
+                  size_t count,
+                  uint8_t *out,
+                  uint8_t outlen,
+                  int useSimd);
+
+void blake2s_many(const uint8_t *const *inputs,
+                  const size_t *lengths,
+                  size_t count,
+                  uint8_t *out,
+                  uint8_t outlen,
+                  int useSimd);
+
+/* number of leaves in a BLAKE2bp and a BLAKE2sp tree */
+
+enum {
+    BLAKE2B_PARALLELISM = 4,
+    BLAKE2S_PARALLELISM = 8,
+};
+
+/*
+    blake2bp_update_leaves, blake2sp_update_leaves -
+        give each leaf of a BLAKE2bp (4 leaves) or BLAKE2sp (8 leaves)
+        tree its share of inlen bytes of input, which must be a multiple
+        of one block per leaf.  Leaf j gets blocks j, j + leaves,
+        j + 2*leaves, ...  Large inputs are split across threads, one or
+        more leaves per thread; otherwise, when the AVX2 compression is
+        enabled (see blake2_use_avx2), all of the leaves are compressed
+        together, one per SIMD lane.
+ */
+
+void blake2bp_update_leaves(blake2b_state leaves[BLAKE2B_PARALLELISM][1],
+                            const uint8_t *in,
+                            uint64_t inlen);
+
+void blake2sp_update_leaves(blake2s_state leaves[BLAKE2S_PARALLELISM][1],
+                            const uint8_t *in,
+                            uint64_t inlen);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* blake2_many_h */
@@ -0,0 +1,516 @@
+/*
+    Hash - blake2_simd.c
+
+    History:
+
+    v. 1.0.0 (10/18/2026) - Initial version
+
+    Copyright (c) 2026 Sriranga R. Veeraraghavan <ranga@calalum.org>
+
+    Permission is hereby granted, free of charge, to any person obtaining
+    a copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+    OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <string.h>
+
+#include "blake2_simd.h"
+
+/*
+    The state is kept as four rows of the 4x4 matrix of BLAKE2, and
+    each round runs the column step on whole rows, rotates rows b, c
+    and d so that the diagonals line up as columns, runs the diagonal
+    step, and rotates the rows back.  The message words for each step
+    are gathered according to the round's permutation (sigma), which
+    is a constant once the rounds are unrolled.
+
+    For BLAKE2b a row is four 64-bit words, one AVX2 register or two
+    SSE registers.  For BLAKE2s a row is four 32-bit words, one SSE
+    register.  The instruction sets are enabled for just these
+    functions with target pragmas.
+ */
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+
+#define BLAKE2_SIMD_X86 1
+
+#include <immintrin.h>
+
+static const uint64_t blake2b_simd_IV[8] = {
+    0x6a09e667f3bcc908ULL, 0xbb67ae8584caa73bULL,
+    0x3c6ef372fe94f82bULL, 0xa54ff53a5f1d36f1ULL,
+    0x510e527fade682d1ULL, 0x9b05688c2b3e6c1fULL,
+    0x1f83d9abfb41bd6bULL, 0x5be0cd19137e2179ULL,
+};
+
+static const uint32_t blake2s_simd_IV[8] = {
+    0x6A09E667UL, 0xBB67AE85UL, 0x3C6EF372UL, 0xA54FF53AUL,
+    0x510E527FUL, 0x9B05688CUL, 0x1F83D9ABUL, 0x5BE0CD19UL,
+};
+
+static const uint8_t blake2_simd_sigma[12][16] = {
+    {  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15 },
+    { 14, 10,  4,  8,  9, 15, 13,  6,  1, 12,  0,  2, 11,  7,  5,  3 },
+    { 11,  8, 12,  0,  5,  2, 15, 13, 10, 14,  3,  6,  7,  1,  9,  4 },
+    {  7,  9,  3,  1, 13, 12, 11, 14,  2,  6,  5, 10,  4,  0, 15,  8 },
+    {  9,  0,  5,  7,  2,  4, 10, 15, 14,  1, 11, 12,  6,  8,  3, 13 },
+    {  2, 12,  6, 10,  0, 11,  8,  3,  4, 13,  7,  5, 15, 14,  1,  9 },
+    { 12,  5,  1, 15, 14, 13,  4, 10,  0,  7,  6,  3,  9,  2,  8, 11 },
+    { 13, 11,  7, 14, 12,  1,  3,  9,  5,  0, 15,  4,  8,  6,  2, 10 },
+    {  6, 15, 14,  9, 11,  3,  0,  8, 12,  2, 13,  7,  1,  4, 10,  5 },
+    { 10,  2,  8,  4,  7,  6,  1,  5, 15, 11,  9, 14,  3, 12, 13,  0 },
+    {  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15 },
+    { 14, 10,  4,  8,  9, 15, 13,  6,  1, 12,  0,  2, 11,  7,  5,  3 },
+};
+
+#define SIGMA(r, i) blake2_simd_sigma[(r)][(i)]
+
+/* ---- BLAKE2b, AVX2 ---- */
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("avx2"))), apply_to = function)
+#else
+#pragma GCC push_options
+#pragma GCC target("avx2")
+#endif
+
+#define B2B_AVX2_MSG(m, r, i0, i1, i2, i3) \
+    _mm256_setr_epi64x((long long)m[SIGMA(r, i0)], \
+                       (long long)m[SIGMA(r, i1)], \
+                       (long long)m[SIGMA(r, i2)], \
+                       (long long)m[SIGMA(r, i3)])
+
+#define B2B_AVX2_G(a, b, c, d, mx, my) \
+    do { \
+        a = _mm256_add_epi64(_mm256_add_epi64(a, b), mx); \
+        d = _mm256_shuffle_epi32(_mm256_xor_si256(d, a), \
+                                 _MM_SHUFFLE(2, 3, 0, 1)); \
+        c = _mm256_add_epi64(c, d); \
+        b = _mm256_shuffle_epi8(_mm256_xor_si256(b, c), r24); \
+        a = _mm256_add_epi64(_mm256_add_epi64(a, b), my); \
+        d = _mm256_shuffle_epi8(_mm256_xor_si256(d, a), r16); \
+        c = _mm256_add_epi64(c, d); \
+        b = _mm256_xor_si256(b, c); \
+        b = _mm256_xor_si256(_mm256_srli_epi64(b, 63), \
+                             _mm256_add_epi64(b, b)); \
+    } while (0)
+
+#define B2B_AVX2_ROUND(r) \
+    do { \
+        B2B_AVX2_G(a, b, c, d, \
+                   B2B_AVX2_MSG(m, r, 0, 2, 4, 6), \
+                   B2B_AVX2_MSG(m, r, 1, 3, 5, 7)); \
+        b = _mm256_permute4x64_epi64(b, _MM_SHUFFLE(0, 3, 2, 1)); \
+        c = _mm256_permute4x64_epi64(c, _MM_SHUFFLE(1, 0, 3, 2)); \
+        d = _mm256_permute4x64_epi64(d, _MM_SHUFFLE(2, 1, 0, 3)); \
+        B2B_AVX2_G(a, b, c, d, \
+                   B2B_AVX2_MSG(m, r, 8, 10, 12, 14), \
+                   B2B_AVX2_MSG(m, r, 9, 11, 13, 15)); \
+        b = _mm256_permute4x64_epi64(b, _MM_SHUFFLE(2, 1, 0, 3)); \
+        c = _mm256_permute4x64_epi64(c, _MM_SHUFFLE(1, 0, 3, 2)); \
+        d = _mm256_permute4x64_epi64(d, _MM_SHUFFLE(0, 3, 2, 1)); \
+    } while (0)
+
+static void blake2b_compress_avx2(uint64_t h[8],
+                                  const uint64_t t[2],
+                                  const uint64_t f[2],
+                                  const uint8_t *block)
+{
+    const __m256i r16 = _mm256_setr_epi8(2, 3, 4, 5, 6, 7, 0, 1,
+                                         10, 11, 12, 13, 14, 15, 8, 9,
+                                         2, 3, 4, 5, 6, 7, 0, 1,
+                                         10, 11, 12, 13, 14, 15, 8, 9);
+    const __m256i r24 = _mm256_setr_epi8(3, 4, 5, 6, 7, 0, 1, 2,
+                                         11, 12, 13, 14, 15, 8, 9, 10,
+                                         3, 4, 5, 6, 7, 0, 1, 2,
+                                         11, 12, 13, 14, 15, 8, 9, 10);
+    uint64_t m[16];
+    __m256i a, b, c, d, a0, b0;
+
+    // x86 is little endian, so the block is the message words
+
+    memcpy(m, block, sizeof(m));
+
+    a = a0 = _mm256_loadu_si256((const __m256i *)&h[0]);
+    b = b0 = _mm256_loadu_si256((const __m256i *)&h[4]);
+    c = _mm256_loadu_si256((const __m256i *)&blake2b_simd_IV[0]);
+    d = _mm256_xor_si256(
+            _mm256_loadu_si256((const __m256i *)&blake2b_simd_IV[4]),
+            _mm256_setr_epi64x((long long)t[0], (long long)t[1],
+                               (long long)f[0], (long long)f[1]));
+
+    B2B_AVX2_ROUND(0);
+    B2B_AVX2_ROUND(1);
+    B2B_AVX2_ROUND(2);
+    B2B_AVX2_ROUND(3);
+    B2B_AVX2_ROUND(4);
+    B2B_AVX2_ROUND(5);
+    B2B_AVX2_ROUND(6);
+    B2B_AVX2_ROUND(7);
+    B2B_AVX2_ROUND(8);
+    B2B_AVX2_ROUND(9);
+    B2B_AVX2_ROUND(10);
+    B2B_AVX2_ROUND(11);
+
+    _mm256_storeu_si256((__m256i *)&h[0],
+                        _mm256_xor_si256(a0, _mm256_xor_si256(a, c)));
+    _mm256_storeu_si256((__m256i *)&h[4],
+                        _mm256_xor_si256(b0, _mm256_xor_si256(b, d)));
+}
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#else
+#pragma GCC pop_options
+#endif
+
+/* ---- BLAKE2b and BLAKE2s, SSE4.1 ---- */
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("sse4.1"))), apply_to = function)
+#else
+#pragma GCC push_options
+#pragma GCC target("sse4.1")
+#endif
+
+// each BLAKE2b row is split into a low (words 0, 1) and high (words 2, 3)
+// register
+
+#define B2B_SSE_MSG(m, r, i0, i1) \
+    _mm_set_epi64x((long long)m[SIGMA(r, i1)], (long long)m[SIGMA(r, i0)])
+
+#define B2B_SSE_G(al, ah, bl, bh, cl, ch, dl, dh, mxl, mxh, myl, myh) \
+    do { \
+        al = _mm_add_epi64(_mm_add_epi64(al, bl), mxl); \
+        ah = _mm_add_epi64(_mm_add_epi64(ah, bh), mxh); \
+        dl = _mm_shuffle_epi32(_mm_xor_si128(dl, al), \
+                               _MM_SHUFFLE(2, 3, 0, 1)); \
+        dh = _mm_shuffle_epi32(_mm_xor_si128(dh, ah), \
+                               _MM_SHUFFLE(2, 3, 0, 1)); \
+        cl = _mm_add_epi64(cl, dl); \
+        ch = _mm_add_epi64(ch, dh); \
+        bl = _mm_shuffle_epi8(_mm_xor_si128(bl, cl), r24); \
+        bh = _mm_shuffle_epi8(_mm_xor_si128(bh, ch), r24); \
+        al = _mm_add_epi64(_mm_add_epi64(al, bl), myl); \
+        ah = _mm_add_epi64(_mm_add_epi64(ah, bh), myh); \
+        dl = _mm_shuffle_epi8(_mm_xor_si128(dl, al), r16); \
+        dh = _mm_shuffle_epi8(_mm_xor_si128(dh, ah), r16); \
+        cl = _mm_add_epi64(cl, dl); \
+        ch = _mm_add_epi64(ch, dh); \
+        bl = _mm_xor_si128(bl, cl); \
+        bh = _mm_xor_si128(bh, ch); \
+        bl = _mm_xor_si128(_mm_srli_epi64(bl, 63), _mm_add_epi64(bl, bl)); \
+        bh = _mm_xor_si128(_mm_srli_epi64(bh, 63), _mm_add_epi64(bh, bh)); \
+    } while (0)
+
+// rotate row b left by one word, swap the halves of row c, and rotate
+// row d right by one word (and back)
+
+#define B2B_SSE_DIAGONALIZE() \
+    do { \
+        t0 = _mm_alignr_epi8(bh, bl, 8); \
+        t1 = _mm_alignr_epi8(bl, bh, 8); \
+        bl = t0; \
+        bh = t1; \
+        t0 = cl; \
+        cl = ch; \
+        ch = t0; \
+        t0 = _mm_alignr_epi8(dh, dl, 8); \
+        t1 = _mm_alignr_epi8(dl, dh, 8); \
+        dl = t1; \
+        dh = t0; \
+    } while (0)
+
+#define B2B_SSE_UNDIAGONALIZE() \
+    do { \
+        t0 = _mm_alignr_epi8(bl, bh, 8); \
+        t1 = _mm_alignr_epi8(bh, bl, 8); \
+        bl = t0; \
+        bh = t1; \
+        t0 = cl; \
+        cl = ch; \
+        ch = t0; \
+        t0 = _mm_alignr_epi8(dl, dh, 8); \
+        t1 = _mm_alignr_epi8(dh, dl, 8); \
+        dl = t1; \
+        dh = t0; \
+    } while (0)
+
+#define B2B_SSE_ROUND(r) \
+    do { \
+        B2B_SSE_G(al, ah, bl, bh, cl, ch, dl, dh, \
+                  B2B_SSE_MSG(m, r, 0, 2), B2B_SSE_MSG(m, r, 4, 6), \
+                  B2B_SSE_MSG(m, r, 1, 3), B2B_SSE_MSG(m, r, 5, 7)); \
+        B2B_SSE_DIAGONALIZE(); \
+        B2B_SSE_G(al, ah, bl, bh, cl, ch, dl, dh, \
+                  B2B_SSE_MSG(m, r, 8, 10), B2B_SSE_MSG(m, r, 12, 14), \
+                  B2B_SSE_MSG(m, r, 9, 11), B2B_SSE_MSG(m, r, 13, 15)); \
+        B2B_SSE_UNDIAGONALIZE(); \
+    } while (0)
+
+static void blake2b_compress_sse41(uint64_t h[8],
+                                   const uint64_t t[2],
+                                   const uint64_t f[2],
+                                   const uint8_t *block)
+{
+    const __m128i r16 = _mm_setr_epi8(2, 3, 4, 5, 6, 7, 0, 1,
+                                      10, 11, 12, 13, 14, 15, 8, 9);
+    const __m128i r24 = _mm_setr_epi8(3, 4, 5, 6, 7, 0, 1, 2,
+                                      11, 12, 13, 14, 15, 8, 9, 10);
+    uint64_t m[16];
+    __m128i al, ah, bl, bh, cl, ch, dl, dh, t0, t1;
+
+    memcpy(m, block, sizeof(m));
+
+    al = _mm_loadu_si128((const __m128i *)&h[0]);
+    ah = _mm_loadu_si128((const __m128i *)&h[2]);
+    bl = _mm_loadu_si128((const __m128i *)&h[4]);
+    bh = _mm_loadu_si128((const __m128i *)&h[6]);
+    cl = _mm_loadu_si128((const __m128i *)&blake2b_simd_IV[0]);
+    ch = _mm_loadu_si128((const __m128i *)&blake2b_simd_IV[2]);
+    dl = _mm_xor_si128(_mm_loadu_si128((const __m128i *)&blake2b_simd_IV[4]),
+                       _mm_loadu_si128((const __m128i *)&t[0]));
+    dh = _mm_xor_si128(_mm_loadu_si128((const __m128i *)&blake2b_simd_IV[6]),
+                       _mm_loadu_si128((const __m128i *)&f[0]));
+
+    B2B_SSE_ROUND(0);
+    B2B_SSE_ROUND(1);
+    B2B_SSE_ROUND(2);
+    B2B_SSE_ROUND(3);
+    B2B_SSE_ROUND(4);
+    B2B_SSE_ROUND(5);
+    B2B_SSE_ROUND(6);
+    B2B_SSE_ROUND(7);
+    B2B_SSE_ROUND(8);
+    B2B_SSE_ROUND(9);
+    B2B_SSE_ROUND(10);
+    B2B_SSE_ROUND(11);
+
+    _mm_storeu_si128((__m128i *)&h[0],
+        _mm_xor_si128(_mm_loadu_si128((const __m128i *)&h[0]),
+                      _mm_xor_si128(al, cl)));
+    _mm_storeu_si128((__m128i *)&h[2],
+        _mm_xor_si128(_mm_loadu_si128((const __m128i *)&h[2]),
+                      _mm_xor_si128(ah, ch)));
+    _mm_storeu_si128((__m128i *)&h[4],
+        _mm_xor_si128(_mm_loadu_si128((const __m128i *)&h[4]),
+                      _mm_xor_si128(bl, dl)));
+    _mm_storeu_si128((__m128i *)&h[6],
+        _mm_xor_si128(_mm_loadu_si128((const __m128i *)&h[6]),
+                      _mm_xor_si128(bh, dh)));
+}
+
+#define B2S_SSE_MSG(m, r, i0, i1, i2, i3) \
+    _mm_setr_epi32((int)m[SIGMA(r, i0)], (int)m[SIGMA(r, i1)], \
+                   (int)m[SIGMA(r, i2)], (int)m[SIGMA(r, i3)])
+
+#define B2S_SSE_ROTR(x, n) \
+    _mm_or_si128(_mm_srli_epi32(x, n), _mm_slli_epi32(x, 32 - (n)))
+
+#define B2S_SSE_G(a, b, c, d, mx, my) \
+    do { \
+        a = _mm_add_epi32(_mm_add_epi32(a, b), mx); \
+        d = _mm_shuffle_epi8(_mm_xor_si128(d, a), r16); \
+        c = _mm_add_epi32(c, d); \
+        b = B2S_SSE_ROTR(_mm_xor_si128(b, c), 12); \
+        a = _mm_add_epi32(_mm_add_epi32(a, b), my); \
+        d = _mm_shuffle_epi8(_mm_xor_si128(d, a), r8); \
+        c = _mm_add_epi32(c, d); \
+        b = B2S_SSE_ROTR(_mm_xor_si128(b, c), 7); \
+    } while (0)
+
+#define B2S_SSE_ROUND(r) \
+    do { \
+        B2S_SSE_G(a, b, c, d, \
+                  B2S_SSE_MSG(m, r, 0, 2, 4, 6), \
+                  B2S_SSE_MSG(m, r, 1, 3, 5, 7)); \
+        b = _mm_shuffle_epi32(b, _MM_SHUFFLE(0, 3, 2, 1)); \
+        c = _mm_shuffle_epi32(c, _MM_SHUFFLE(1, 0, 3, 2)); \
+        d = _mm_shuffle_epi32(d, _MM_SHUFFLE(2, 1, 0, 3)); \
+        B2S_SSE_G(a, b, c, d, \
+                  B2S_SSE_MSG(m, r, 8, 10, 12, 14), \
+                  B2S_SSE_MSG(m, r, 9, 11, 13, 15)); \
+        b = _mm_shuffle_epi32(b, _MM_SHUFFLE(2, 1, 0, 3)); \
+        c = _mm_shuffle_epi32(c, _MM_SHUFFLE(1, 0, 3, 2)); \
+        d = _mm_shuffle_epi32(d, _MM_SHUFFLE(0, 3, 2, 1)); \
+    } while (0)
+
+static void blake2s_compress_sse41(uint32_t h[8],
+                                   const uint32_t t[2],
+                                   const uint32_t f[2],
+                                   const uint8_t *block)
+{
+    const __m128i r8 = _mm_setr_epi8(1, 2, 3, 0, 5, 6, 7, 4,
+                                     9, 10, 11, 8, 13, 14, 15, 12);
+    const __m128i r16 = _mm_setr_epi8(2, 3, 0, 1, 6, 7, 4, 5,
+                                      10, 11, 8, 9, 14, 15, 12, 13);
+    uint32_t m[16];
+    __m128i a, b, c, d, a0, b0;
+
+    memcpy(m, block, sizeof(m));
+
+    a = a0 = _mm_loadu_si128((const __m128i *)&h[0]);
+    b = b0 = _mm_loadu_si128((const __m128i *)&h[4]);
+    c = _mm_loadu_si128((const __m128i *)&blake2s_simd_IV[0]);
+    d = _mm_xor_si128(_mm_loadu_si128((const __m128i *)&blake2s_simd_IV[4]),
+                      _mm_setr_epi32((int)t[0], (int)t[1],
+                                     (int)f[0], (int)f[1]));
+
+    B2S_SSE_ROUND(0);
+    B2S_SSE_ROUND(1);
+    B2S_SSE_ROUND(2);
+    B2S_SSE_ROUND(3);
+    B2S_SSE_ROUND(4);
+    B2S_SSE_ROUND(5);
+    B2S_SSE_ROUND(6);
+    B2S_SSE_ROUND(7);
+    B2S_SSE_ROUND(8);
+    B2S_SSE_ROUND(9);
+
+    _mm_storeu_si128((__m128i *)&h[0],
+                     _mm_xor_si128(a0, _mm_xor_si128(a, c)));
+    _mm_storeu_si128((__m128i *)&h[4],
+                     _mm_xor_si128(b0, _mm_xor_si128(b, d)));
+}
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#else
+#pragma GCC pop_options
+#endif
+
+#endif /* __x86_64__ && (__GNUC__ || __clang__) */
+
+/* dispatch */
+
+typedef void (*blake2bCompressFn)(uint64_t h[8],
+                                  const uint64_t t[2],
+                                  const uint64_t f[2],
+                                  const uint8_t *block);
+typedef void (*blake2sCompressFn)(uint32_t h[8],
+                                  const uint32_t t[2],
+                                  const uint32_t f[2],
+                                  const uint8_t *block);
+
+static int gAllowSse41 = 1;
+static int gAllowAvx2 = 1;
+static int gSelected = 0;
+static blake2bCompressFn gBlake2bCompress = NULL;
+static blake2sCompressFn gBlake2sCompress = NULL;
+static const char *gBlake2bImplementation = "portable";
+static const char *gBlake2sImplementation = "portable";
+
+/*
+    blake2_select - pick the compression functions, NULL means the
+                    reference code (racing threads pick the same ones)
+ */
+
+static void blake2_select(void)
+{
+    gBlake2bCompress = NULL;
+    gBlake2sCompress = NULL;
+    gBlake2bImplementation = "portable";
+    gBlake2sImplementation = "portable";
+
+#if defined(BLAKE2_SIMD_X86)
+    if (gAllowSse41 && __builtin_cpu_supports("sse4.1")) {
+        gBlake2bCompress = blake2b_compress_sse41;
+        gBlake2sCompress = blake2s_compress_sse41;
+        gBlake2bImplementation = "sse4.1";
+        gBlake2sImplementation = "sse4.1";
+    }
+    if (gAllowAvx2 && __builtin_cpu_supports("avx2")) {
+        gBlake2bCompress = blake2b_compress_avx2;
+        gBlake2bImplementation = "avx2";
+    }
+#endif
+
+    gSelected = 1;
+}
+
+int blake2b_compress_simd(uint64_t h[8],
+                          const uint64_t t[2],
+                          const uint64_t f[2],
+                          const uint8_t *block)
+{
+    blake2bCompressFn fn = NULL;
+
+    if (!gSelected) {
+        blake2_select();
+    }
+    fn = gBlake2bCompress;
+    if (fn == NULL) {
+        return 0;
+    }
+    fn(h, t, f, block);
+    return 1;
+}
+
+int blake2s_compress_simd(uint32_t h[8],
+                          const uint32_t t[2],
+                          const uint32_t f[2],
+                          const uint8_t *block)
+{
+    blake2sCompressFn fn = NULL;
+
+    if (!gSelected) {
+        blake2_select();
+    }
+    fn = gBlake2sCompress;
+    if (fn == NULL) {
+        return 0;
+    }
+    fn(h, t, f, block);
+    return 1;
+}
+
+void blake2_use_sse41(int enable)
+{
+    gAllowSse41 = (enable != 0);
+    blake2_select();
+}
+
+void blake2_use_avx2(int enable)
+{
+    gAllowAvx2 = (enable != 0);
+    blake2_select();
+}
+
+int blake2_lanes_enabled(void)
+{
+#if defined(BLAKE2_SIMD_X86)
+    return (gAllowAvx2 && __builtin_cpu_supports("avx2"));
+#else
+    return 0;
+#endif
+}
+
+const char *blake2b_implementation(void)
+{
+    if (!gSelected) {
+        blake2_select();
+    }
+    return gBlake2bImplementation;
+}
+
+const char *blake2s_implementation(void)
+{
+    if (!gSelected) {
+        blake2_select();
+    }
+    return gBlake2sImplementation;
+}
@@ -0,0 +1,96 @@
+/*
+    Hash - blake2_simd.h
+
+    SSE4.1 and AVX2 compression functions for BLAKE2b and BLAKE2s, which
+    the reference code (blake2b-ref.c, blake2s-ref.c) uses when the cpu
+    supports them.
+
+    History:
+
+    v. 1.0.0 (10/18/2026) - Initial version
+
+    Copyright (c) 2026 Sriranga R. Veeraraghavan <ranga@calalum.org>
+
+    Permission is hereby granted, free of charge, to any person obtaining
+    a copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+    OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef blake2_simd_h
+#define blake2_simd_h
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+    blake2b_compress_simd, blake2s_compress_simd - compress one block into
+                                                   h, with the counter t
+                                                   and finalization flags
+                                                   f.  Return 1 if the
+                                                   block was compressed,
+                                                   or 0 if no SIMD
+                                                   implementation is
+                                                   enabled, in which case
+                                                   the caller uses the
+                                                   reference code.
+ */
+
+int blake2b_compress_simd(uint64_t h[8],
+                          const uint64_t t[2],
+                          const uint64_t f[2],
+                          const uint8_t *block);
+
+int blake2s_compress_simd(uint32_t h[8],
+                          const uint32_t t[2],
+                          const uint32_t f[2],
+                          const uint8_t *block);
+
+/*
+    blake2_use_sse41, blake2_use_avx2 - allow (1, the default) or
+                                        disallow (0) the SSE4.1 and AVX2
+                                        implementations, for benchmarking
+                                        and testing.  BLAKE2s has no AVX2
+                                        compression function, each row
+                                        of its state fits in one SSE
+                                        register.
+ */
+
+void blake2_use_sse41(int enable);
+void blake2_use_avx2(int enable);
+
+/*
+    blake2_lanes_enabled - return 1 if the AVX2 lanes (see blake2_many.h)
+                           may be used
+ */
+
+int blake2_lanes_enabled(void);
+
+/* blake2b_implementation, blake2s_implementation - name of the
+   implementation in use */
+
+const char *blake2b_implementation(void);
+const char *blake2s_implementation(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* blake2_simd_h */
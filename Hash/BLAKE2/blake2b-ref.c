@@ -19,6 +19,7 @@
 
 #include "blake2.h"
 #include "blake2-impl.h"
+#include "blake2_simd.h"
 
 static const uint64_t blake2b_IV[8] =
 {
@@ -235,6 +236,10 @@ static int blake2b_compress( blake2b_state *S, const uint8_t block[BLAKE2B_BLOCK
   uint64_t v[16];
   int i;
 
+  /* srv 2026-10-18 - use the SSE4.1 / AVX2 compression function if
+     the cpu has one (see blake2_simd.c) */
+  if( blake2b_compress_simd( S->h, S->t, S->f, block ) ) return 0;
+
   for( i = 0; i < 16; ++i )
     m[i] = load64( block + i * sizeof( m[i] ) );
 
@@ -293,33 +298,50 @@ static int blake2b_compress( blake2b_state *S, const uint8_t block[BLAKE2B_BLOCK
 }
 
 /* inlen now in bytes */
+/* srv 2026-10-18 - compress whole blocks straight from the input instead
+   of copying each one through the two block buffer, keeping only the
+   last block (which may turn out to be the final one) buffered.  States
+   saved by the lazy version can hold up to two blocks, so whatever is
+   buffered is completed and compressed first. */
 int blake2b_update( blake2b_state *S, const uint8_t *in, uint64_t inlen )
 {
-  while( inlen > 0 )
+  if( inlen == 0 ) return 0;
+
+  if( S->buflen > 0 )
   {
     size_t left = S->buflen;
-    size_t fill = 2 * BLAKE2B_BLOCKBYTES - left;
+    size_t fill = ( left > BLAKE2B_BLOCKBYTES ? 2 * BLAKE2B_BLOCKBYTES : BLAKE2B_BLOCKBYTES ) - left;
 
-    if( inlen > fill )
+    if( inlen <= fill )
     {
-      memcpy( S->buf + left, in, fill ); /* Fill buffer */
-      S->buflen += fill;
-      blake2b_increment_counter( S, BLAKE2B_BLOCKBYTES );
-      blake2b_compress( S, S->buf ); /* Compress */
-      memcpy( S->buf, S->buf + BLAKE2B_BLOCKBYTES, BLAKE2B_BLOCKBYTES ); /* Shift buffer left */
-      S->buflen -= BLAKE2B_BLOCKBYTES;
-      in += fill;
-      inlen -= fill;
+      memcpy( S->buf + left, in, ( size_t )inlen );
+      S->buflen += ( size_t )inlen; /* Be lazy, do not compress */
+      return 0;
     }
-    else /* inlen <= fill */
+
+    memcpy( S->buf + left, in, fill ); /* Fill buffer */
+    in += fill;
+    inlen -= fill;
+
+    for( size_t off = 0; off < left + fill; off += BLAKE2B_BLOCKBYTES )
     {
-      memcpy( S->buf + left, in, inlen );
-      S->buflen += inlen; /* Be lazy, do not compress */
-      in += inlen;
-      inlen -= inlen;
+      blake2b_increment_counter( S, BLAKE2B_BLOCKBYTES );
+      blake2b_compress( S, S->buf + off ); /* Compress */
     }
+
+    S->buflen = 0;
+  }
+
+  while( inlen > BLAKE2B_BLOCKBYTES )
+  {
+    blake2b_increment_counter( S, BLAKE2B_BLOCKBYTES );
+    blake2b_compress( S, in );
+    in += BLAKE2B_BLOCKBYTES;
+    inlen -= BLAKE2B_BLOCKBYTES;
   }
 
+  memcpy( S->buf, in, ( size_t )inlen );
+  S->buflen = ( size_t )inlen;
   return 0;
 }
 
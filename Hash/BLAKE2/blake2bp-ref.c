@@ -24,6 +24,7 @@
 
 #include "blake2.h"
 #include "blake2-impl.h"
+#include "blake2_many.h"
 
 #define PARALLELISM_DEGREE 4
 
@@ -120,35 +121,16 @@ int blake2bp_update( blake2bp_state *S, const uint8_t *in, uint64_t inlen )
   {
     memcpy( S->buf + left, in, fill );
 
-    for( size_t i = 0; i < PARALLELISM_DEGREE; ++i )
-      blake2b_update( S->S[i], S->buf + i * BLAKE2B_BLOCKBYTES, BLAKE2B_BLOCKBYTES );
+    blake2bp_update_leaves( S->S, S->buf, sizeof( S->buf ) );
 
     in += fill;
     inlen -= fill;
     left = 0;
   }
 
-#if defined(_OPENMP)
-  #pragma omp parallel shared(S), num_threads(PARALLELISM_DEGREE)
-#else
-
-  for( size_t id__ = 0; id__ < PARALLELISM_DEGREE; ++id__ )
-#endif
-  {
-#if defined(_OPENMP)
-    size_t      id__ = omp_get_thread_num();
-#endif
-    uint64_t inlen__ = inlen;
-    const uint8_t *in__ = ( const uint8_t * )in;
-    in__ += id__ * BLAKE2B_BLOCKBYTES;
-
-    while( inlen__ >= PARALLELISM_DEGREE * BLAKE2B_BLOCKBYTES )
-    {
-      blake2b_update( S->S[id__], in__, BLAKE2B_BLOCKBYTES );
-      in__ += PARALLELISM_DEGREE * BLAKE2B_BLOCKBYTES;
-      inlen__ -= PARALLELISM_DEGREE * BLAKE2B_BLOCKBYTES;
-    }
-  }
+  /* srv 2026-10-18 - process the leaves in SIMD lanes or on threads
+     (see blake2_many.c) */
+  blake2bp_update_leaves( S->S, in, inlen - inlen % ( PARALLELISM_DEGREE * BLAKE2B_BLOCKBYTES ) );
 
   in += inlen - inlen % ( PARALLELISM_DEGREE * BLAKE2B_BLOCKBYTES );
   inlen %= PARALLELISM_DEGREE * BLAKE2B_BLOCKBYTES;
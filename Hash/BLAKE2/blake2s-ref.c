@@ -19,6 +19,7 @@
 
 #include "blake2.h"
 #include "blake2-impl.h"
+#include "blake2_simd.h"
 
 static const uint32_t blake2s_IV[8] =
 {
@@ -227,6 +228,10 @@ static int blake2s_compress( blake2s_state *S, const uint8_t block[BLAKE2S_BLOCK
   uint32_t m[16];
   uint32_t v[16];
 
+  /* srv 2026-10-18 - use the SSE4.1 compression function if the cpu
+     has one (see blake2_simd.c) */
+  if( blake2s_compress_simd( S->h, S->t, S->f, block ) ) return 0;
+
   for( size_t i = 0; i < 16; ++i )
     m[i] = load32( block + i * sizeof( m[i] ) );
 
@@ -283,33 +288,47 @@ static int blake2s_compress( blake2s_state *S, const uint8_t block[BLAKE2S_BLOCK
 }
 
 
+/* srv 2026-10-18 - compress whole blocks straight from the input, as in
+   blake2b_update */
 int blake2s_update( blake2s_state *S, const uint8_t *in, uint64_t inlen )
 {
-  while( inlen > 0 )
+  if( inlen == 0 ) return 0;
+
+  if( S->buflen > 0 )
   {
     size_t left = S->buflen;
-    size_t fill = 2 * BLAKE2S_BLOCKBYTES - left;
+    size_t fill = ( left > BLAKE2S_BLOCKBYTES ? 2 * BLAKE2S_BLOCKBYTES : BLAKE2S_BLOCKBYTES ) - left;
 
-    if( inlen > fill )
+    if( inlen <= fill )
     {
-      memcpy( S->buf + left, in, fill ); /* Fill buffer */
-      S->buflen += fill;
-      blake2s_increment_counter( S, BLAKE2S_BLOCKBYTES );
-      blake2s_compress( S, S->buf ); /* Compress */
-      memcpy( S->buf, S->buf + BLAKE2S_BLOCKBYTES, BLAKE2S_BLOCKBYTES ); /* Shift buffer left */
-      S->buflen -= BLAKE2S_BLOCKBYTES;
-      in += fill;
-      inlen -= fill;
+      memcpy( S->buf + left, in, ( size_t )inlen );
+      S->buflen += ( size_t )inlen; /* Be lazy, do not compress */
+      return 0;
     }
-    else /* inlen <= fill */
+
+    memcpy( S->buf + left, in, fill ); /* Fill buffer */
+    in += fill;
+    inlen -= fill;
+
+    for( size_t off = 0; off < left + fill; off += BLAKE2S_BLOCKBYTES )
     {
-      memcpy( S->buf + left, in, inlen );
-      S->buflen += inlen; /* Be lazy, do not compress */
-      in += inlen;
-      inlen -= inlen;
+      blake2s_increment_counter( S, BLAKE2S_BLOCKBYTES );
+      blake2s_compress( S, S->buf + off ); /* Compress */
     }
+
+    S->buflen = 0;
+  }
+
+  while( inlen > BLAKE2S_BLOCKBYTES )
+  {
+    blake2s_increment_counter( S, BLAKE2S_BLOCKBYTES );
+    blake2s_compress( S, in );
+    in += BLAKE2S_BLOCKBYTES;
+    inlen -= BLAKE2S_BLOCKBYTES;
   }
 
+  memcpy( S->buf, in, ( size_t )inlen );
+  S->buflen = ( size_t )inlen;
   return 0;
 }
 
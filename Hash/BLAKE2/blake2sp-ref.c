@@ -23,6 +23,7 @@
 
 #include "blake2.h"
 #include "blake2-impl.h"
+#include "blake2_many.h"
 
 #define PARALLELISM_DEGREE 8
 
@@ -117,35 +118,16 @@ int blake2sp_update( blake2sp_state *S, const uint8_t *in, uint64_t inlen )
   {
     memcpy( S->buf + left, in, fill );
 
-    for( size_t i = 0; i < PARALLELISM_DEGREE; ++i )
-      blake2s_update( S->S[i], S->buf + i * BLAKE2S_BLOCKBYTES, BLAKE2S_BLOCKBYTES );
+    blake2sp_update_leaves( S->S, S->buf, sizeof( S->buf ) );
 
     in += fill;
     inlen -= fill;
     left = 0;
   }
 
-#if defined(_OPENMP)
-  #pragma omp parallel shared(S), num_threads(PARALLELISM_DEGREE)
-#else
-
-  for( size_t id__ = 0; id__ < PARALLELISM_DEGREE; ++id__ )
-#endif
-  {
-#if defined(_OPENMP)
-    size_t      id__ = omp_get_thread_num();
-#endif
-    uint64_t inlen__ = inlen;
-    const uint8_t *in__ = ( const uint8_t * )in;
-    in__ += id__ * BLAKE2S_BLOCKBYTES;
-
-    while( inlen__ >= PARALLELISM_DEGREE * BLAKE2S_BLOCKBYTES )
-    {
-      blake2s_update( S->S[id__], in__, BLAKE2S_BLOCKBYTES );
-      in__ += PARALLELISM_DEGREE * BLAKE2S_BLOCKBYTES;
-      inlen__ -= PARALLELISM_DEGREE * BLAKE2S_BLOCKBYTES;
-    }
-  }
+  /* srv 2026-10-18 - process the leaves in SIMD lanes or on threads
+     (see blake2_many.c) */
+  blake2sp_update_leaves( S->S, in, inlen - inlen % ( PARALLELISM_DEGREE * BLAKE2S_BLOCKBYTES ) );
 
   in += inlen - inlen % ( PARALLELISM_DEGREE * BLAKE2S_BLOCKBYTES );
   inlen %= PARALLELISM_DEGREE * BLAKE2S_BLOCKBYTES;
@@ -86,8 +86,26 @@ INLINE void output_chaining_value(const output_t *self, uint8_t cv[32]) {
   store_cv_words(cv, cv_words);
 }
 
+// srv 2026-10-18 - with use_threads, long runs of output blocks are split
+// across the thread pool (see blake3_pthreads.c)
+INLINE void output_root_blocks(const output_t *self, uint64_t counter,
+                               uint8_t *out, size_t outblocks,
+                               bool use_threads) {
+#if defined(BLAKE3_USE_PTHREADS)
+  if (use_threads) {
+    blake3_xof_many_pthreads(self->input_cv, self->block, self->block_len,
+                             counter, self->flags | ROOT, out, outblocks);
+    return;
+  }
+#else
+  (void)use_threads;
+#endif
+  blake3_xof_many(self->input_cv, self->block, self->block_len, counter,
+                  self->flags | ROOT, out, outblocks);
+}
+
 INLINE void output_root_bytes(const output_t *self, uint64_t seek, uint8_t *out,
-                              size_t out_len) {
+                              size_t out_len, bool use_threads) {
   if (out_len == 0) {
       return;
   }
@@ -104,7 +122,7 @@ INLINE void output_root_bytes(const output_t *self, uint64_t seek, uint8_t *out,
     output_block_counter += 1;
   }
   if(out_len / 64) {
-    blake3_xof_many(self->input_cv, self->block, self->block_len, output_block_counter, self->flags | ROOT, out, out_len / 64);
+    output_root_blocks(self, output_block_counter, out, out_len / 64, use_threads);
   }
   output_block_counter += out_len / 64;
   out += out_len & -64;
@@ -313,13 +331,20 @@ size_t blake3_compress_subtree_wide(const uint8_t *input, size_t input_len,
       input, left_input_len, chunk_counter, cv_array, &left_n,
       // right-hand side
       right_input, right_input_len, right_chunk_counter, right_cvs, &right_n);
+#elif defined(BLAKE3_USE_PTHREADS)
+  blake3_compress_subtree_wide_join_pthreads(
+      key, flags, use_tbb,
+      // left-hand side
+      input, left_input_len, chunk_counter, cv_array, &left_n,
+      // right-hand side
+      right_input, right_input_len, right_chunk_counter, right_cvs, &right_n);
 #else
   left_n = blake3_compress_subtree_wide(
       input, left_input_len, key, chunk_counter, flags, cv_array, use_tbb);
   right_n = blake3_compress_subtree_wide(right_input, right_input_len, key,
                                          right_chunk_counter, flags, right_cvs,
                                          use_tbb);
-#endif // BLAKE3_USE_TBB
+#endif // BLAKE3_USE_TBB / BLAKE3_USE_PTHREADS
 
   // The special case again. If simd_degree=1, then we'll have left_n=1 and
   // right_n=1. Rather than compressing them into a single output, return
@@ -595,13 +620,23 @@ void blake3_hasher_update_tbb(blake3_hasher *self, const void *input,
 }
 #endif // BLAKE3_USE_TBB
 
+#if defined(BLAKE3_USE_PTHREADS)
+void blake3_hasher_update_pthreads(blake3_hasher *self, const void *input,
+                                   size_t input_len) {
+  bool use_threads = true;
+  blake3_hasher_update_base(self, input, input_len, use_threads);
+}
+#endif // BLAKE3_USE_PTHREADS
+
 void blake3_hasher_finalize(const blake3_hasher *self, uint8_t *out,
                             size_t out_len) {
   blake3_hasher_finalize_seek(self, 0, out, out_len);
 }
 
-void blake3_hasher_finalize_seek(const blake3_hasher *self, uint64_t seek,
-                                 uint8_t *out, size_t out_len) {
+static void blake3_hasher_finalize_seek_base(const blake3_hasher *self,
+                                             uint64_t seek, uint8_t *out,
+                                             size_t out_len,
+                                             bool use_threads) {
   // Explicitly checking for zero avoids causing UB by passing a null pointer
   // to memcpy. This comes up in practice with things like:
   //   std::vector<uint8_t> v;
@@ -613,7 +648,7 @@ void blake3_hasher_finalize_seek(const blake3_hasher *self, uint64_t seek,
   // If the subtree stack is empty, then the current chunk is the root.
   if (self->cv_stack_len == 0) {
     output_t output = chunk_state_output(&self->chunk);
-    output_root_bytes(&output, seek, out, out_len);
+    output_root_bytes(&output, seek, out, out_len, use_threads);
     return;
   }
   // If there are any bytes in the chunk state, finalize that chunk and do a
@@ -641,8 +676,23 @@ void blake3_hasher_finalize_seek(const blake3_hasher *self, uint64_t seek,
     output_chaining_value(&output, &parent_block[32]);
     output = parent_output(parent_block, self->key, self->chunk.flags);
   }
-  output_root_bytes(&output, seek, out, out_len);
+  output_root_bytes(&output, seek, out, out_len, use_threads);
+}
+
+void blake3_hasher_finalize_seek(const blake3_hasher *self, uint64_t seek,
+                                 uint8_t *out, size_t out_len) {
+  bool use_threads = false;
+  blake3_hasher_finalize_seek_base(self, seek, out, out_len, use_threads);
+}
+
+#if defined(BLAKE3_USE_PTHREADS)
+void blake3_hasher_finalize_seek_pthreads(const blake3_hasher *self,
+                                          uint64_t seek, uint8_t *out,
+                                          size_t out_len) {
+  bool use_threads = true;
+  blake3_hasher_finalize_seek_base(self, seek, out, out_len, use_threads);
 }
+#endif // BLAKE3_USE_PTHREADS
 
 void blake3_hasher_reset(blake3_hasher *self) {
   chunk_state_reset(&self->chunk, self->key, 0);
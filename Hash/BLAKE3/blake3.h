@@ -4,6 +4,10 @@
 #include <stddef.h>
 #include <stdint.h>
 
+/* srv 2026-10-18 - needed for BLAKE3_USE_PTHREADS */
+
+#include "blake3_config.h"
+
 #if !defined(BLAKE3_API)
 # if defined(_WIN32) || defined(__CYGWIN__)
 #   if defined(BLAKE3_DLL)
@@ -73,12 +77,61 @@ BLAKE3_API void blake3_hasher_update(blake3_hasher *self, const void *input,
 BLAKE3_API void blake3_hasher_update_tbb(blake3_hasher *self, const void *input,
                                          size_t input_len);
 #endif // BLAKE3_USE_TBB
+#if defined(BLAKE3_USE_PTHREADS)
+BLAKE3_API void blake3_hasher_update_pthreads(blake3_hasher *self,
+                                              const void *input,
+                                              size_t input_len);
+/* srv 2026-10-18 - as blake3_hasher_finalize_seek, but large outputs are
+   computed on the thread pool */
+BLAKE3_API void blake3_hasher_finalize_seek_pthreads(const blake3_hasher *self,
+                                                     uint64_t seek,
+                                                     uint8_t *out,
+                                                     size_t out_len);
+#endif // BLAKE3_USE_PTHREADS
+/* srv 2026-10-18 - hash count messages, writing BLAKE3_OUT_LEN bytes of
+   digest for message i to out + i*BLAKE3_OUT_LEN, see blake3_batch.c */
+BLAKE3_API void blake3_hash_batch(const uint8_t *const *inputs,
+                                  const size_t *lengths, size_t count,
+                                  uint8_t *out);
 BLAKE3_API void blake3_hasher_finalize(const blake3_hasher *self, uint8_t *out,
                                        size_t out_len);
 BLAKE3_API void blake3_hasher_finalize_seek(const blake3_hasher *self, uint64_t seek,
                                             uint8_t *out, size_t out_len);
 BLAKE3_API void blake3_hasher_reset(blake3_hasher *self);
 
+/* srv 2026-10-18 - Bao outboard trees, see blake3_bao.c.
+   blake3_bao_encode_outboard writes blake3_bao_outboard_size(input_len)
+   bytes of tree to outboard, and the BLAKE3 hash of the input to hash.
+   blake3_bao_verify checks bytes [start, start + len) of input (which
+   must be input_len bytes long, only the chunks covering the range are
+   read) against the trusted hash.  It returns 0 if they match, or -1
+   and the range of content that failed to verify. */
+BLAKE3_API size_t blake3_bao_outboard_size(uint64_t content_len);
+BLAKE3_API void blake3_bao_encode_outboard(const uint8_t *input,
+                                           size_t input_len,
+                                           uint8_t *outboard,
+                                           uint8_t hash[BLAKE3_OUT_LEN]);
+BLAKE3_API int blake3_bao_verify(const uint8_t hash[BLAKE3_OUT_LEN],
+                                 const uint8_t *outboard,
+                                 size_t outboard_len, const uint8_t *input,
+                                 uint64_t input_len, uint64_t start,
+                                 uint64_t len, uint64_t *bad_start,
+                                 uint64_t *bad_len);
+
+/* srv 2026-10-18 - limit the instruction sets used by the dispatcher,
+   call before hashing (the default is BLAKE3_SIMD_ALL) */
+
+typedef enum {
+  BLAKE3_SIMD_PORTABLE = 0,
+  BLAKE3_SIMD_SSE2,
+  BLAKE3_SIMD_SSE41,
+  BLAKE3_SIMD_AVX2,
+  BLAKE3_SIMD_AVX512,
+  BLAKE3_SIMD_ALL,
+} blake3_simd_limit;
+
+BLAKE3_API void blake3_set_simd_limit(blake3_simd_limit limit);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,267 @@
+/*
+    blake3_bao.c - Bao outboard trees
+
+    srv 2026-10-18 - a Bao outboard encoding keeps the BLAKE3 Merkle tree
+    of a file next to the file: an 8 byte little endian content length,
+    followed by every parent node (the chaining values of its left and
+    right children, 64 bytes) in pre-order.  The chunk (1KB) leaves are
+    not stored, they are recomputed from the content.  With the tree and
+    the root hash, any byte range can be verified by reading only the
+    chunks that cover it and the O(log n) parent nodes above them, and a
+    corrupted range can be narrowed down to the chunks that don't match.
+    The format is that of "bao encode --outboard".
+ */
+
+#include <string.h>
+
+#include "blake3_impl.h"
+
+// Size of a parent node, and of the length header
+
+#define BAO_NODE_LEN (2 * BLAKE3_OUT_LEN)
+#define BAO_HEADER_LEN 8
+
+// Subtrees of up to this many chunks have all of their chunks hashed
+// with a single blake3_hash_many() call
+
+#define BAO_LEAF_CHUNKS 64
+
+typedef struct {
+  const uint8_t *input;
+  uint64_t start;
+  uint64_t end;
+  uint64_t bad_start;
+  uint64_t bad_end;
+  bool bad;
+} bao_verifier;
+
+static uint64_t chunk_count(uint64_t len) {
+  return (len + BLAKE3_CHUNK_LEN - 1) / BLAKE3_CHUNK_LEN;
+}
+
+// The number of chunks in the left subtree of a subtree of chunks (> 1)
+// chunks: the largest power of 2 that leaves at least one for the right
+
+static uint64_t left_chunks(uint64_t chunks) {
+  return round_down_to_power_of_2(chunks - 1);
+}
+
+// The chaining value of a chunk (which may be partial, or empty for
+// empty content), flags (ROOT) only apply to its last block
+
+static void chunk_cv(const uint8_t *input, size_t len, uint64_t counter,
+                     uint8_t flags, uint8_t out[BLAKE3_OUT_LEN]) {
+  uint8_t block[BLAKE3_BLOCK_LEN];
+  uint8_t start = CHUNK_START;
+  uint32_t cv[8];
+
+  memcpy(cv, IV, sizeof(cv));
+  while (len > BLAKE3_BLOCK_LEN) {
+    blake3_compress_in_place(cv, input, BLAKE3_BLOCK_LEN, counter, start);
+    input += BLAKE3_BLOCK_LEN;
+    len -= BLAKE3_BLOCK_LEN;
+    start = 0;
+  }
+
+  memset(block, 0, sizeof(block));
+  memcpy(block, input, len);
+  blake3_compress_in_place(cv, block, (uint8_t)len, counter,
+                           flags | start | CHUNK_END);
+  store_cv_words(out, cv);
+}
+
+static void parent_cv(const uint8_t node[BAO_NODE_LEN], uint8_t flags,
+                      uint8_t out[BLAKE3_OUT_LEN]) {
+  uint32_t cv[8];
+
+  memcpy(cv, IV, sizeof(cv));
+  blake3_compress_in_place(cv, node, BAO_NODE_LEN, 0, flags | PARENT);
+  store_cv_words(out, cv);
+}
+
+// Write the parent nodes over count chunk chaining values to out, and
+// the subtree's chaining value to cv
+
+static void encode_cvs(const uint8_t *cvs, uint64_t count, bool is_root,
+                       uint8_t *out, uint8_t cv[BLAKE3_OUT_LEN]) {
+  uint64_t left = 0;
+
+  if (count == 1) {
+    memcpy(cv, cvs, BLAKE3_OUT_LEN);
+    return;
+  }
+
+  left = left_chunks(count);
+  encode_cvs(cvs, left, false, out + BAO_NODE_LEN, out);
+  encode_cvs(cvs + left * BLAKE3_OUT_LEN, count - left, false,
+             out + BAO_NODE_LEN * left, out + BLAKE3_OUT_LEN);
+  parent_cv(out, is_root ? ROOT : 0, cv);
+}
+
+// Write the parent nodes of the subtree over input (len > 0 bytes,
+// starting at chunk counter) to out, and its chaining value to cv
+
+static void encode_subtree(const uint8_t *input, uint64_t len,
+                           uint64_t counter, bool is_root, uint8_t *out,
+                           uint8_t cv[BLAKE3_OUT_LEN]) {
+  const uint8_t *chunks[BAO_LEAF_CHUNKS];
+  uint8_t cvs[BAO_LEAF_CHUNKS * BLAKE3_OUT_LEN];
+  uint64_t count = chunk_count(len);
+  uint64_t full = len / BLAKE3_CHUNK_LEN;
+  uint64_t left = 0;
+  uint64_t i = 0;
+
+  if (count == 1) {
+    chunk_cv(input, (size_t)len, counter, is_root ? ROOT : 0, cv);
+    return;
+  }
+
+  if (count > BAO_LEAF_CHUNKS) {
+    left = left_chunks(count);
+    encode_subtree(input, left * BLAKE3_CHUNK_LEN, counter, false,
+                   out + BAO_NODE_LEN, out);
+    encode_subtree(input + left * BLAKE3_CHUNK_LEN,
+                   len - left * BLAKE3_CHUNK_LEN, counter + left, false,
+                   out + BAO_NODE_LEN * left, out + BLAKE3_OUT_LEN);
+    parent_cv(out, is_root ? ROOT : 0, cv);
+    return;
+  }
+
+  // the full chunks go through the SIMD lanes, a partial last chunk is
+  // hashed on its own
+
+  for (i = 0; i < full; i++) {
+    chunks[i] = input + i * BLAKE3_CHUNK_LEN;
+  }
+  blake3_hash_many(chunks, (size_t)full, BLAKE3_CHUNK_LEN / BLAKE3_BLOCK_LEN,
+                   IV, counter, true, 0, CHUNK_START, CHUNK_END, cvs);
+  if (full < count) {
+    chunk_cv(input + full * BLAKE3_CHUNK_LEN,
+             (size_t)(len - full * BLAKE3_CHUNK_LEN), counter + full, 0,
+             cvs + full * BLAKE3_OUT_LEN);
+  }
+
+  encode_cvs(cvs, count, is_root, out, cv);
+}
+
+size_t blake3_bao_outboard_size(uint64_t content_len) {
+  uint64_t chunks = chunk_count(content_len);
+
+  return BAO_HEADER_LEN +
+         (size_t)(chunks > 1 ? (chunks - 1) * BAO_NODE_LEN : 0);
+}
+
+void blake3_bao_encode_outboard(const uint8_t *input, size_t input_len,
+                                uint8_t *outboard,
+                                uint8_t hash[BLAKE3_OUT_LEN]) {
+  uint64_t len = (uint64_t)input_len;
+  size_t i = 0;
+
+  for (i = 0; i < BAO_HEADER_LEN; i++) {
+    outboard[i] = (uint8_t)(len >> (8 * i));
+  }
+
+  if (input_len == 0) {
+    chunk_cv(input, 0, 0, ROOT, hash);
+    return;
+  }
+
+  encode_subtree(input, len, 0, true, outboard + BAO_HEADER_LEN, hash);
+}
+
+static void mark_bad(bao_verifier *v, uint64_t start, uint64_t len) {
+  if (!v->bad || start < v->bad_start) {
+    v->bad_start = start;
+  }
+  if (!v->bad || start + len > v->bad_end) {
+    v->bad_end = start + len;
+  }
+  v->bad = true;
+}
+
+// Check the subtree of content bytes [start, start + len) whose nodes
+// are at node, against its expected chaining value, only descending
+// into the children that overlap the range being verified
+
+static void verify_subtree(bao_verifier *v, const uint8_t *node,
+                           uint64_t start, uint64_t len, bool is_root,
+                           const uint8_t expected[BLAKE3_OUT_LEN]) {
+  uint8_t cv[BLAKE3_OUT_LEN];
+  uint64_t left = 0;
+  uint64_t left_len = 0;
+
+  if (len <= BLAKE3_CHUNK_LEN) {
+    chunk_cv(v->input + start, (size_t)len, start / BLAKE3_CHUNK_LEN,
+             is_root ? ROOT : 0, cv);
+    if (memcmp(cv, expected, BLAKE3_OUT_LEN) != 0) {
+      mark_bad(v, start, len);
+    }
+    return;
+  }
+
+  // a node that doesn't match was damaged in the outboard, nothing
+  // below it can be trusted
+
+  parent_cv(node, is_root ? ROOT : 0, cv);
+  if (memcmp(cv, expected, BLAKE3_OUT_LEN) != 0) {
+    mark_bad(v, start, len);
+    return;
+  }
+
+  left = left_chunks(chunk_count(len));
+  left_len = left * BLAKE3_CHUNK_LEN;
+
+  if (v->start < start + left_len) {
+    verify_subtree(v, node + BAO_NODE_LEN, start, left_len, false, node);
+  }
+  if (v->end > start + left_len) {
+    verify_subtree(v, node + BAO_NODE_LEN * left, start + left_len,
+                   len - left_len, false, node + BLAKE3_OUT_LEN);
+  }
+}
+
+int blake3_bao_verify(const uint8_t hash[BLAKE3_OUT_LEN],
+                      const uint8_t *outboard, size_t outboard_len,
+                      const uint8_t *input, uint64_t input_len,
+                      uint64_t start, uint64_t len, uint64_t *bad_start,
+                      uint64_t *bad_len) {
+  bao_verifier v;
+  uint64_t header = 0;
+  size_t i = 0;
+
+  memset(&v, 0, sizeof(v));
+  v.input = input;
+
+  for (i = 0; i < BAO_HEADER_LEN && i < outboard_len; i++) {
+    header |= (uint64_t)outboard[i] << (8 * i);
+  }
+
+  // the range is clamped to the content, an empty range still checks
+  // the chunk it falls in (which, at the end, proves the length)
+
+  v.start = (start < input_len ? start : input_len);
+  v.end = (len < input_len - v.start ? v.start + len : input_len);
+  if (v.end == v.start) {
+    v.start = (v.start > 0 && v.start == input_len ? v.start - 1 : v.start);
+    v.end = v.start + 1;
+  }
+
+  if (outboard_len < BAO_HEADER_LEN || header != input_len ||
+      outboard_len != blake3_bao_outboard_size(input_len)) {
+    mark_bad(&v, 0, input_len);
+  } else {
+    verify_subtree(&v, outboard + BAO_HEADER_LEN, 0, input_len, true, hash);
+  }
+
+  if (v.bad) {
+    if (bad_start != NULL) {
+      *bad_start = v.bad_start;
+    }
+    if (bad_len != NULL) {
+      *bad_len = v.bad_end - v.bad_start;
+    }
+    return -1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,129 @@
+/*
+    blake3_batch.c - hash many independent messages
+
+    srv 2026-10-18 - blake3_hasher_update() can only use the SIMD lanes
+    for the chunks of a single message, so a message of a few chunks
+    leaves most of the lanes (up to 16 with AVX-512) idle.  For runs of
+    messages of the same length (a multiple of the block size, up to
+    BLAKE3_BATCH_MAX_CHUNKS chunks), blake3_hash_batch() instead hashes
+    chunk i of every message in the run with one blake3_hash_many()
+    call, and then the parent nodes of every message, level by level.
+    Other messages are hashed with a hasher.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "blake3_impl.h"
+
+// Longest message (64KB) that is hashed across the lanes
+
+#define BLAKE3_BATCH_MAX_CHUNKS 64
+
+// Messages hashed together
+
+#define BLAKE3_BATCH_GROUP MAX_SIMD_DEGREE
+
+static void hash_one(const uint8_t *input, size_t input_len, uint8_t *out) {
+  blake3_hasher hasher;
+
+  blake3_hasher_init(&hasher);
+  blake3_hasher_update(&hasher, input, input_len);
+  blake3_hasher_finalize(&hasher, out, BLAKE3_OUT_LEN);
+}
+
+// Hash n (>= 2) messages of input_len bytes, cvs and tmp each hold
+// BLAKE3_BATCH_GROUP * BLAKE3_BATCH_MAX_CHUNKS chaining values
+
+static void hash_group(const uint8_t *const *inputs, size_t n,
+                       size_t input_len, uint8_t *out, uint8_t *cvs,
+                       uint8_t *tmp) {
+  const uint8_t *ptrs[BLAKE3_BATCH_GROUP * BLAKE3_BATCH_MAX_CHUNKS / 2];
+  size_t chunks = (input_len + BLAKE3_CHUNK_LEN - 1) / BLAKE3_CHUNK_LEN;
+  size_t stride = chunks * BLAKE3_OUT_LEN;
+  size_t chunk_len = 0;
+  size_t count = chunks;
+  size_t pairs = 0;
+  size_t c = 0, m = 0, p = 0;
+
+  // a single chunk is also the root
+
+  if (chunks == 1) {
+    blake3_hash_many(inputs, n, input_len / BLAKE3_BLOCK_LEN, IV, 0, false,
+                     0, CHUNK_START, CHUNK_END | ROOT, out);
+    return;
+  }
+
+  for (c = 0; c < chunks; c++) {
+    chunk_len = (c + 1 < chunks ? BLAKE3_CHUNK_LEN
+                                : input_len - c * BLAKE3_CHUNK_LEN);
+    for (m = 0; m < n; m++) {
+      ptrs[m] = inputs[m] + c * BLAKE3_CHUNK_LEN;
+    }
+    blake3_hash_many(ptrs, n, chunk_len / BLAKE3_BLOCK_LEN, IV, c, false, 0,
+                     CHUNK_START, CHUNK_END, tmp);
+    for (m = 0; m < n; m++) {
+      memcpy(cvs + m * stride + c * BLAKE3_OUT_LEN,
+             tmp + m * BLAKE3_OUT_LEN, BLAKE3_OUT_LEN);
+    }
+  }
+
+  // merge adjacent pairs, an odd node at the end moves up a level as is
+
+  while (count > 1) {
+    pairs = count / 2;
+    for (m = 0; m < n; m++) {
+      for (p = 0; p < pairs; p++) {
+        ptrs[m * pairs + p] = cvs + m * stride + p * 2 * BLAKE3_OUT_LEN;
+      }
+    }
+    blake3_hash_many(ptrs, n * pairs, 1, IV, 0, false,
+                     PARENT | (count == 2 ? ROOT : 0), 0, 0, tmp);
+    for (m = 0; m < n; m++) {
+      if (count % 2 != 0) {
+        memcpy(cvs + m * stride + pairs * BLAKE3_OUT_LEN,
+               cvs + m * stride + (count - 1) * BLAKE3_OUT_LEN,
+               BLAKE3_OUT_LEN);
+      }
+      memcpy(cvs + m * stride, tmp + m * pairs * BLAKE3_OUT_LEN,
+             pairs * BLAKE3_OUT_LEN);
+    }
+    count = pairs + count % 2;
+  }
+
+  for (m = 0; m < n; m++) {
+    memcpy(out + m * BLAKE3_OUT_LEN, cvs + m * stride, BLAKE3_OUT_LEN);
+  }
+}
+
+void blake3_hash_batch(const uint8_t *const *inputs, const size_t *lengths,
+                       size_t count, uint8_t *out) {
+  uint8_t *cvs = NULL;
+  size_t len = 0;
+  size_t i = 0, n = 0;
+
+  cvs = malloc(2 * BLAKE3_BATCH_GROUP * BLAKE3_BATCH_MAX_CHUNKS *
+               BLAKE3_OUT_LEN);
+
+  while (i < count) {
+    len = lengths[i];
+    n = 1;
+    if (cvs != NULL && len > 0 && len % BLAKE3_BLOCK_LEN == 0 &&
+        len <= BLAKE3_BATCH_MAX_CHUNKS * BLAKE3_CHUNK_LEN) {
+      while (i + n < count && n < BLAKE3_BATCH_GROUP && lengths[i + n] == len) {
+        n++;
+      }
+    }
+
+    if (n > 1) {
+      hash_group(&inputs[i], n, len, out + i * BLAKE3_OUT_LEN, cvs,
+                 cvs + BLAKE3_BATCH_GROUP * BLAKE3_BATCH_MAX_CHUNKS *
+                           BLAKE3_OUT_LEN);
+    } else {
+      hash_one(inputs[i], len, out + i * BLAKE3_OUT_LEN);
+    }
+    i += n;
+  }
+
+  free(cvs);
+}
@@ -1,11 +1,28 @@
 #ifndef BLAKE3_CONFIG_H
 #define BLAKE3_CONFIG_H
 
-/* disable x86 SMID code for now */
+/*
+    srv 2026-10-18 - enable the x86 SIMD code on x86_64 (other than
+    Windows), using the upstream unix assembly implementations
+    (blake3_*_x86-64_unix.S).  blake3_dispatch.c picks the best one at
+    runtime using cpuid / xgetbv.  Everywhere else, disable it.
+ */
 
+#if !defined(__x86_64__) || defined(_WIN32)
 #define BLAKE3_NO_SSE2
 #define BLAKE3_NO_SSE41
 #define BLAKE3_NO_AVX2
 #define BLAKE3_NO_AVX512
+#endif
+
+/*
+    srv 2026-10-18 - hash large updates in parallel on a pool of
+    pthreads (see blake3_pthreads.c), unless TBB is being used
+ */
+
+#if !defined(_WIN32) && !defined(BLAKE3_USE_TBB) && \
+    !defined(BLAKE3_NO_PTHREADS)
+#define BLAKE3_USE_PTHREADS
+#endif
 
 #endif /* BLAKE3_CONFIG_H */
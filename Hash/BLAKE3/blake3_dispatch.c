@@ -109,6 +109,36 @@ static /* Allow the variable to be controlled manually for testing */
 #endif
     ATOMIC_INT g_cpu_features = UNDEFINED;
 
+/* srv 2026-10-18 - the features that may be used, so that the portable
+   and older SIMD implementations can be selected (see
+   blake3_set_simd_limit) */
+
+static ATOMIC_INT g_cpu_features_allowed = ~UNDEFINED;
+
+void blake3_set_simd_limit(blake3_simd_limit limit) {
+  int allowed = 0;
+
+  switch (limit) {
+  case BLAKE3_SIMD_PORTABLE:
+    allowed = NONE;
+    break;
+  case BLAKE3_SIMD_SSE2:
+    allowed = SSE2;
+    break;
+  case BLAKE3_SIMD_SSE41:
+    allowed = SSE2 | SSSE3 | SSE41;
+    break;
+  case BLAKE3_SIMD_AVX2:
+    allowed = SSE2 | SSSE3 | SSE41 | AVX | AVX2;
+    break;
+  default:
+    allowed = ~UNDEFINED;
+    break;
+  }
+
+  ATOMIC_STORE(g_cpu_features_allowed, allowed);
+}
+
 #if !defined(BLAKE3_TESTING)
 static
 #endif
@@ -118,7 +148,7 @@ static
   /* If TSAN detects a data race here, try compiling with -DBLAKE3_ATOMICS=1 */
   enum cpu_feature features = ATOMIC_LOAD(g_cpu_features);
   if (features != UNDEFINED) {
-    return features;
+    return (enum cpu_feature)(features & ATOMIC_LOAD(g_cpu_features_allowed));
   } else {
 #if defined(IS_X86)
     uint32_t regs[4] = {0};
@@ -158,7 +188,7 @@ static
       }
     }
     ATOMIC_STORE(g_cpu_features, features);
-    return features;
+    return (enum cpu_feature)(features & ATOMIC_LOAD(g_cpu_features_allowed));
 #else
     /* How to detect NEON? */
     return 0;
@@ -238,6 +238,24 @@ BLAKE3_PRIVATE void blake3_compress_subtree_wide_join_tbb(
     uint8_t *r_cvs, size_t *r_n) NOEXCEPT;
 #endif
 
+#if defined(BLAKE3_USE_PTHREADS)
+BLAKE3_PRIVATE void blake3_compress_subtree_wide_join_pthreads(
+    // shared params
+    const uint32_t key[8], uint8_t flags, bool use_threads,
+    // left-hand side params
+    const uint8_t *l_input, size_t l_input_len, uint64_t l_chunk_counter,
+    uint8_t *l_cvs, size_t *l_n,
+    // right-hand side params
+    const uint8_t *r_input, size_t r_input_len, uint64_t r_chunk_counter,
+    uint8_t *r_cvs, size_t *r_n);
+
+BLAKE3_PRIVATE void blake3_xof_many_pthreads(const uint32_t cv[8],
+                                             const uint8_t block[BLAKE3_BLOCK_LEN],
+                                             uint8_t block_len, uint64_t counter,
+                                             uint8_t flags, uint8_t *out,
+                                             size_t outblocks);
+#endif
+
 // Declarations for implementation-specific functions.
 void blake3_compress_in_place_portable(uint32_t cv[8],
                                        const uint8_t block[BLAKE3_BLOCK_LEN],
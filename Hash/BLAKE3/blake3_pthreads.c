@@ -0,0 +1,145 @@
+/*
+    blake3_pthreads.c - a pthreads based replacement for blake3_tbb.cpp
+
+    srv 2026-10-18 - Hash can't depend on TBB (or C++), so subtrees are
+    hashed in parallel on the engine's pool of worker threads instead
+    (see hash_threads.h).
+
+    blake3_compress_subtree_wide_join_pthreads() runs the left-hand and
+    right-hand subtrees as a pair of jobs on the pool.  The calling
+    thread runs any job that no worker has picked up, so a join only
+    ever waits on a thread that is actively working on its subtree and
+    nested joins cannot deadlock.
+
+    blake3_xof_many_pthreads() splits long runs of output blocks (each
+    block is an independent compression of the root node with its own
+    counter) the same way.
+ */
+
+#include "blake3_impl.h"
+
+#if defined(BLAKE3_USE_PTHREADS)
+
+#include "hash_threads.h"
+
+// Subtrees smaller than this aren't worth handing to another thread
+
+#define BLAKE3_PTHREADS_MIN_SPLIT (128 * BLAKE3_CHUNK_LEN)
+
+// Runs of output blocks shorter than this (64KB) aren't split
+
+#define BLAKE3_PTHREADS_MIN_XOF_BLOCKS 1024
+
+typedef enum {
+  BLAKE3_TASK_SUBTREE = 0,
+  BLAKE3_TASK_XOF,
+} blake3_task_kind;
+
+// For BLAKE3_TASK_XOF, key is the root's input cv, input and input_len
+// are its block and block length, chunk_counter is the first output
+// block's counter and n is the number of output blocks
+
+typedef struct blake3_task {
+  blake3_task_kind kind;
+  const uint8_t *input;
+  size_t input_len;
+  const uint32_t *key;
+  uint64_t chunk_counter;
+  uint8_t flags;
+  uint8_t *out;
+  size_t n;
+} blake3_task;
+
+static void run_task(void *arg, size_t index) {
+  blake3_task *task = (blake3_task *)arg + index;
+
+  if (task->kind == BLAKE3_TASK_XOF) {
+    blake3_xof_many_pthreads(task->key, task->input,
+                             (uint8_t)task->input_len, task->chunk_counter,
+                             task->flags, task->out, task->n);
+    return;
+  }
+  task->n = blake3_compress_subtree_wide(task->input, task->input_len,
+                                         task->key, task->chunk_counter,
+                                         task->flags, task->out, true);
+}
+
+void blake3_compress_subtree_wide_join_pthreads(
+    // shared params
+    const uint32_t key[8], uint8_t flags, bool use_threads,
+    // left-hand side params
+    const uint8_t *l_input, size_t l_input_len, uint64_t l_chunk_counter,
+    uint8_t *l_cvs, size_t *l_n,
+    // right-hand side params
+    const uint8_t *r_input, size_t r_input_len, uint64_t r_chunk_counter,
+    uint8_t *r_cvs, size_t *r_n) {
+  blake3_task tasks[2];
+
+  if (!use_threads || r_input_len < BLAKE3_PTHREADS_MIN_SPLIT) {
+    *l_n = blake3_compress_subtree_wide(l_input, l_input_len, key,
+                                        l_chunk_counter, flags, l_cvs,
+                                        use_threads);
+    *r_n = blake3_compress_subtree_wide(r_input, r_input_len, key,
+                                        r_chunk_counter, flags, r_cvs,
+                                        use_threads);
+    return;
+  }
+
+  tasks[0].kind = BLAKE3_TASK_SUBTREE;
+  tasks[0].input = l_input;
+  tasks[0].input_len = l_input_len;
+  tasks[0].key = key;
+  tasks[0].chunk_counter = l_chunk_counter;
+  tasks[0].flags = flags;
+  tasks[0].out = l_cvs;
+  tasks[0].n = 0;
+
+  tasks[1] = tasks[0];
+  tasks[1].input = r_input;
+  tasks[1].input_len = r_input_len;
+  tasks[1].chunk_counter = r_chunk_counter;
+  tasks[1].out = r_cvs;
+
+  hash_threads_run(2, run_task, tasks);
+
+  *l_n = tasks[0].n;
+  *r_n = tasks[1].n;
+}
+
+void blake3_xof_many_pthreads(const uint32_t cv[8],
+                              const uint8_t block[BLAKE3_BLOCK_LEN],
+                              uint8_t block_len, uint64_t counter,
+                              uint8_t flags, uint8_t *out, size_t outblocks) {
+  blake3_task tasks[2];
+  size_t left_blocks = 0;
+
+  // with a single cpu there's nothing to split the run across
+
+  if (outblocks < 2 * BLAKE3_PTHREADS_MIN_XOF_BLOCKS ||
+      hash_threads_count(2, 1, 2) < 2) {
+    blake3_xof_many(cv, block, block_len, counter, flags, out, outblocks);
+    return;
+  }
+
+  // keep the left-hand run a multiple of the widest SIMD degree
+
+  left_blocks = (outblocks / 2) & ~(size_t)15;
+
+  tasks[0].kind = BLAKE3_TASK_XOF;
+  tasks[0].input = block;
+  tasks[0].input_len = block_len;
+  tasks[0].key = cv;
+  tasks[0].chunk_counter = counter;
+  tasks[0].flags = flags;
+  tasks[0].out = out;
+  tasks[0].n = left_blocks;
+
+  tasks[1] = tasks[0];
+  tasks[1].chunk_counter = counter + left_blocks;
+  tasks[1].out = out + left_blocks * BLAKE3_BLOCK_LEN;
+  tasks[1].n = outblocks - left_blocks;
+
+  hash_threads_run(2, run_task, tasks);
+}
+
+#endif // BLAKE3_USE_PTHREADS
@@ -36,7 +36,10 @@ static char sccsid[] = "@(#)crc.c	8.1 (Berkeley) 6/17/93";
 #endif
 #endif /* not lint */
 #include <sys/cdefs.h>
+/* __FBSDID is only available on the BSDs (including MacOSX) */
+#ifdef __FBSDID
 __FBSDID("$FreeBSD$");
+#endif
 
 #include <sys/types.h>
 
@@ -171,8 +174,6 @@ void cksum_init(crcContext *ctx)
 
 void cksum_update(crcContext *ctx, unsigned char *buf, uint32_t len)
 {
-    u_char *p = NULL;
-    
     if (ctx == NULL) {
         return;
     }
@@ -181,9 +182,9 @@ void cksum_update(crcContext *ctx, unsigned char *buf, uint32_t len)
         return;
     }
     
-    for (p = buf; len--; ++p) {
-        ctx->crc = ctx->crc << 8 ^ crctab[ctx->crc >> 24 ^ *p];
-    }
+    /* 2026-10-18 srv - use the slicing-by-16 / PCLMUL code in crc_fast.c */
+
+    ctx->crc = cksum_update_raw(ctx->crc, buf, len);
 }
 
 /*
@@ -7,6 +7,8 @@
     v. 1.0.0 (08/13/2015) - Initial version
     v. 1.0.1 (08/17/2015) - Added crc_init, crc32_update, and crcContext
     v. 1.0.2 (07/06/2016) - Added cksum_init, crc32_finalize
+    v. 1.0.3 (10/18/2026) - Added hash_crc32_combine, hash_cksum_combine
+                            and the raw (slicing-by-16 / PCLMUL) updates
  
     Copyright (c) 2015-2016 Sriranga R. Veeraraghavan <ranga@calalum.org>
  
@@ -32,6 +34,9 @@
 #ifndef Hash_crc_h
 #define Hash_crc_h
 
+#include <stddef.h>
+#include <stdint.h>
+
 typedef struct crcContext {
     uint32_t crc;
 } crcContext;
@@ -44,4 +49,39 @@ void cksum_init(crcContext *ctx);
 void cksum_update(crcContext *ctx, unsigned char *buf, uint32_t len);
 void cksum_finalize(crcContext *ctx, unsigned long long len);
 
+/*
+    hash_crc32_combine - return the CRC32 of A followed by B, given the
+                         CRC32 of A (crc1), the CRC32 of B (crc2) and
+                         B's length
+    hash_cksum_combine - the same for the cksum CRC, crc1 and crc2 are
+                         the values of crcContext.crc after cksum_update
+                         (the length is only added by cksum_finalize)
+
+    These allow segments of a file to be checksummed independently
+    (e.g. on separate threads) and merged.  They are prefixed with
+    hash_ so they don't clash with zlib's crc32_combine when both are
+    linked into the same program.
+ */
+
+uint32_t hash_crc32_combine(uint32_t crc1, uint32_t crc2,
+                            unsigned long long len2);
+uint32_t hash_cksum_combine(uint32_t crc1, uint32_t crc2,
+                            unsigned long long len2);
+
+/*
+    crc32_update_raw, cksum_update_raw - update a CRC register (for
+                                         CRC32, without the inversions
+                                         done by crc32_update) with len
+                                         bytes, see crc_fast.c
+    crc_use_pclmul                     - allow (1, the default) or
+                                         disallow (0) the PCLMULQDQ
+                                         implementation
+    crc_implementation                 - the implementation in use
+ */
+
+uint32_t crc32_update_raw(uint32_t crc, const void *buf, size_t len);
+uint32_t cksum_update_raw(uint32_t crc, const void *buf, size_t len);
+void crc_use_pclmul(int enable);
+const char *crc_implementation(void);
+
 #endif
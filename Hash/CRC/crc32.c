@@ -132,8 +132,6 @@ void crc32_init(crcContext *ctx)
 
 void crc32_update(crcContext *ctx, const void *buf, size_t size)
 {
-    const uint8_t *p = NULL;
-
     if (ctx == NULL) {
         return;
     }
@@ -142,14 +140,9 @@ void crc32_update(crcContext *ctx, const void *buf, size_t size)
         return;
     }
     
-    p = buf;
-    ctx->crc = ctx->crc ^ ~0U;
-    
-    while (size--) {
-        ctx->crc = crc32_tab[(ctx->crc ^ *p++) & 0xFF] ^ (ctx->crc >> 8);
-    }
-    
-    ctx->crc = ctx->crc ^ ~0U;
+    /* 2026-10-18 srv - use the slicing-by-16 / PCLMUL code in crc_fast.c */
+
+    ctx->crc = crc32_update_raw(ctx->crc ^ ~0U, buf, size) ^ ~0U;
 }
 
 /*
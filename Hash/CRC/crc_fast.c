@@ -0,0 +1,513 @@
+/*
+    Hash - crc_fast.c
+
+    Fast CRC32 (gzip / zlib) and POSIX cksum CRCs.  Both are the same
+    kind of CRC, with the polynomial 0x04C11DB7, but CRC32 processes
+    the bits of each byte least significant first (so its register is
+    bit reflected), and cksum most significant first.
+
+    On x86_64 cpus with PCLMULQDQ, the data is folded 64 bytes at a
+    time with carry-less multiplies (see "Fast CRC Computation for
+    Generic Polynomials Using PCLMULQDQ Instruction", Intel, 2009),
+    elsewhere 16 bytes at a time with slicing-by-16 tables.  Buffers
+    of several megabytes are split into segments that are checksummed
+    on separate threads, and the segments' CRCs are combined.
+
+    History:
+
+    v. 1.0.0 (10/18/2026) - Initial version
+
+    Copyright (c) 2026 Sriranga R. Veeraraghavan <ranga@calalum.org>
+
+    Permission is hereby granted, free of charge, to any person obtaining
+    a copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+    OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <pthread.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "crc.h"
+#include "hash_threads.h"
+
+// Polynomials, bit reflected for CRC32
+
+#define CRC32_POLY 0xEDB88320U
+#define CKSUM_POLY 0x04C11DB7U
+
+enum {
+
+    /* buffers shorter than this are slow to fold */
+
+    CrcFoldMin = 256,
+
+    /* segments checksummed on other threads are at least 4MB, and at
+       most CrcMaxThreads are used */
+
+    CrcThreadMinSegment = 4194304,
+    CrcMaxThreads = 8,
+};
+
+/*
+    tables - T[k][b] is the CRC register after byte b followed by k
+             zero bytes, T[0] is the usual byte at a time table.
+             x2n[k] is x^(2^k) modulo the polynomial, for combining.
+ */
+
+static uint32_t gCrc32Table[16][256];
+static uint32_t gCksumTable[16][256];
+static uint32_t gCrc32X2n[64];
+static uint32_t gCksumX2n[64];
+static pthread_once_t gTablesOnce = PTHREAD_ONCE_INIT;
+
+/* crc32_multmodp - a * b modulo the polynomial, bit reflected */
+
+static uint32_t crc32_multmodp(uint32_t a, uint32_t b)
+{
+    uint32_t m = 1U << 31;
+    uint32_t p = 0;
+
+    for (;;) {
+        if (a & m) {
+            p ^= b;
+            if ((a & (m - 1)) == 0) {
+                break;
+            }
+        }
+        m >>= 1;
+        b = (b & 1 ? (b >> 1) ^ CRC32_POLY : b >> 1);
+    }
+
+    return p;
+}
+
+/* cksum_multmodp - a * b modulo the polynomial */
+
+static uint32_t cksum_multmodp(uint32_t a, uint32_t b)
+{
+    uint32_t p = 0;
+    int i = 0;
+
+    for (i = 31; i >= 0; i--) {
+        p = (p & 0x80000000U ? (p << 1) ^ CKSUM_POLY : p << 1);
+        if ((a >> i) & 1) {
+            p ^= b;
+        }
+    }
+
+    return p;
+}
+
+static void crc_tables_init(void)
+{
+    uint32_t c = 0;
+    int b = 0, k = 0;
+
+    for (b = 0; b < 256; b++) {
+        c = (uint32_t)b;
+        for (k = 0; k < 8; k++) {
+            c = (c & 1 ? (c >> 1) ^ CRC32_POLY : c >> 1);
+        }
+        gCrc32Table[0][b] = c;
+
+        c = (uint32_t)b << 24;
+        for (k = 0; k < 8; k++) {
+            c = (c & 0x80000000U ? (c << 1) ^ CKSUM_POLY : c << 1);
+        }
+        gCksumTable[0][b] = c;
+    }
+
+    for (k = 1; k < 16; k++) {
+        for (b = 0; b < 256; b++) {
+            c = gCrc32Table[k - 1][b];
+            gCrc32Table[k][b] = (c >> 8) ^ gCrc32Table[0][c & 0xff];
+            c = gCksumTable[k - 1][b];
+            gCksumTable[k][b] = (c << 8) ^ gCksumTable[0][c >> 24];
+        }
+    }
+
+    // x^1, then repeated squaring
+
+    gCrc32X2n[0] = 1U << 30;
+    gCksumX2n[0] = 2;
+    for (k = 1; k < 64; k++) {
+        gCrc32X2n[k] = crc32_multmodp(gCrc32X2n[k - 1], gCrc32X2n[k - 1]);
+        gCksumX2n[k] = cksum_multmodp(gCksumX2n[k - 1], gCksumX2n[k - 1]);
+    }
+}
+
+/* slicing-by-16 */
+
+static uint32_t crc32_slice16(uint32_t crc, const uint8_t *p, size_t len)
+{
+    const uint32_t (*t)[256] = gCrc32Table;
+    uint32_t a = 0;
+
+    while (len >= 16) {
+        a = crc ^ ((uint32_t)p[0] | (uint32_t)p[1] << 8 |
+                   (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24);
+        crc = t[15][a & 0xff] ^ t[14][(a >> 8) & 0xff] ^
+              t[13][(a >> 16) & 0xff] ^ t[12][a >> 24] ^
+              t[11][p[4]] ^ t[10][p[5]] ^ t[9][p[6]] ^ t[8][p[7]] ^
+              t[7][p[8]] ^ t[6][p[9]] ^ t[5][p[10]] ^ t[4][p[11]] ^
+              t[3][p[12]] ^ t[2][p[13]] ^ t[1][p[14]] ^ t[0][p[15]];
+        p += 16;
+        len -= 16;
+    }
+
+    while (len-- > 0) {
+        crc = (crc >> 8) ^ t[0][(crc ^ *p++) & 0xff];
+    }
+
+    return crc;
+}
+
+static uint32_t cksum_slice16(uint32_t crc, const uint8_t *p, size_t len)
+{
+    const uint32_t (*t)[256] = gCksumTable;
+    uint32_t a = 0;
+
+    while (len >= 16) {
+        a = crc ^ ((uint32_t)p[0] << 24 | (uint32_t)p[1] << 16 |
+                   (uint32_t)p[2] << 8 | (uint32_t)p[3]);
+        crc = t[15][a >> 24] ^ t[14][(a >> 16) & 0xff] ^
+              t[13][(a >> 8) & 0xff] ^ t[12][a & 0xff] ^
+              t[11][p[4]] ^ t[10][p[5]] ^ t[9][p[6]] ^ t[8][p[7]] ^
+              t[7][p[8]] ^ t[6][p[9]] ^ t[5][p[10]] ^ t[4][p[11]] ^
+              t[3][p[12]] ^ t[2][p[13]] ^ t[1][p[14]] ^ t[0][p[15]];
+        p += 16;
+        len -= 16;
+    }
+
+    while (len-- > 0) {
+        crc = (crc << 8) ^ t[0][(crc >> 24) ^ *p++];
+    }
+
+    return crc;
+}
+
+/*
+    crc32_fold, cksum_fold - fold the whole 16 byte blocks of p into
+                             128 bits with carry-less multiplies, then
+                             finish with the tables (the CRC of the
+                             folded value is the CRC of the blocks).
+                             Folding a block forward by n bits
+                             multiplies its two halves by x^(n+64) and
+                             x^n modulo the polynomial; for CRC32 the
+                             constants are bit reflected, which shifts
+                             them by 32 bits and one more bit.  PCLMUL
+                             and SSSE3 (for cksum's byte swaps) are
+                             enabled for just these functions.
+ */
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+
+#define CRC_FOLD_X86 1
+
+#include <immintrin.h>
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("pclmul,ssse3"))), apply_to = function)
+#else
+#pragma GCC push_options
+#pragma GCC target("pclmul,ssse3")
+#endif
+
+#define CRC_FOLD(x, k) \
+    _mm_xor_si128(_mm_clmulepi64_si128((x), (k), 0x00), \
+                  _mm_clmulepi64_si128((x), (k), 0x11))
+
+static uint32_t crc32_fold(uint32_t crc, const uint8_t *p, size_t len)
+{
+    const __m128i k512 = _mm_set_epi64x(0x1c6e41596LL, 0x154442bd4LL);
+    const __m128i k128 = _mm_set_epi64x(0x0ccaa009eLL, 0x1751997d0LL);
+    __m128i x0, x1, x2, x3;
+    uint8_t folded[16];
+
+    x0 = _mm_loadu_si128((const __m128i *)(p + 0));
+    x1 = _mm_loadu_si128((const __m128i *)(p + 16));
+    x2 = _mm_loadu_si128((const __m128i *)(p + 32));
+    x3 = _mm_loadu_si128((const __m128i *)(p + 48));
+    x0 = _mm_xor_si128(x0, _mm_cvtsi32_si128((int)crc));
+    p += 64;
+    len -= 64;
+
+    while (len >= 64) {
+        x0 = _mm_xor_si128(CRC_FOLD(x0, k512),
+                           _mm_loadu_si128((const __m128i *)(p + 0)));
+        x1 = _mm_xor_si128(CRC_FOLD(x1, k512),
+                           _mm_loadu_si128((const __m128i *)(p + 16)));
+        x2 = _mm_xor_si128(CRC_FOLD(x2, k512),
+                           _mm_loadu_si128((const __m128i *)(p + 32)));
+        x3 = _mm_xor_si128(CRC_FOLD(x3, k512),
+                           _mm_loadu_si128((const __m128i *)(p + 48)));
+        p += 64;
+        len -= 64;
+    }
+
+    x0 = _mm_xor_si128(CRC_FOLD(x0, k128), x1);
+    x0 = _mm_xor_si128(CRC_FOLD(x0, k128), x2);
+    x0 = _mm_xor_si128(CRC_FOLD(x0, k128), x3);
+
+    while (len >= 16) {
+        x0 = _mm_xor_si128(CRC_FOLD(x0, k128),
+                           _mm_loadu_si128((const __m128i *)p));
+        p += 16;
+        len -= 16;
+    }
+
+    _mm_storeu_si128((__m128i *)folded, x0);
+    return crc32_slice16(0, folded, sizeof(folded));
+}
+
+static uint32_t cksum_fold(uint32_t crc, const uint8_t *p, size_t len)
+{
+    const __m128i swap = _mm_set_epi64x(0x0001020304050607LL,
+                                        0x08090a0b0c0d0e0fLL);
+    const __m128i k512 = _mm_set_epi64x(0x8833794cLL, 0xe6228b11LL);
+    const __m128i k128 = _mm_set_epi64x(0xc5b9cd4cLL, 0xe8a45605LL);
+    __m128i x0, x1, x2, x3;
+    uint8_t folded[16];
+
+#define CKSUM_LOAD(q) \
+    _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(q)), swap)
+
+    x0 = CKSUM_LOAD(p + 0);
+    x1 = CKSUM_LOAD(p + 16);
+    x2 = CKSUM_LOAD(p + 32);
+    x3 = CKSUM_LOAD(p + 48);
+    x0 = _mm_xor_si128(x0, _mm_set_epi32((int)crc, 0, 0, 0));
+    p += 64;
+    len -= 64;
+
+    while (len >= 64) {
+        x0 = _mm_xor_si128(CRC_FOLD(x0, k512), CKSUM_LOAD(p + 0));
+        x1 = _mm_xor_si128(CRC_FOLD(x1, k512), CKSUM_LOAD(p + 16));
+        x2 = _mm_xor_si128(CRC_FOLD(x2, k512), CKSUM_LOAD(p + 32));
+        x3 = _mm_xor_si128(CRC_FOLD(x3, k512), CKSUM_LOAD(p + 48));
+        p += 64;
+        len -= 64;
+    }
+
+    x0 = _mm_xor_si128(CRC_FOLD(x0, k128), x1);
+    x0 = _mm_xor_si128(CRC_FOLD(x0, k128), x2);
+    x0 = _mm_xor_si128(CRC_FOLD(x0, k128), x3);
+
+    while (len >= 16) {
+        x0 = _mm_xor_si128(CRC_FOLD(x0, k128), CKSUM_LOAD(p));
+        p += 16;
+        len -= 16;
+    }
+
+#undef CKSUM_LOAD
+
+    _mm_storeu_si128((__m128i *)folded, _mm_shuffle_epi8(x0, swap));
+    return cksum_slice16(0, folded, sizeof(folded));
+}
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#else
+#pragma GCC pop_options
+#endif
+
+#endif /* __x86_64__ */
+
+/* dispatch */
+
+typedef uint32_t (*crcUpdateFn)(uint32_t crc, const uint8_t *p, size_t len);
+
+static int gAllowPclmul = 1;
+static int gUsePclmul = -1;
+
+static int crc_fold_available(void)
+{
+    int use = gUsePclmul;
+
+    if (use < 0) {
+        use = 0;
+#if defined(CRC_FOLD_X86)
+        __builtin_cpu_init();
+        use = (gAllowPclmul &&
+               __builtin_cpu_supports("pclmul") &&
+               __builtin_cpu_supports("ssse3"));
+#endif
+        gUsePclmul = use;
+    }
+
+    return use;
+}
+
+void crc_use_pclmul(int enable)
+{
+    gAllowPclmul = (enable != 0);
+    gUsePclmul = -1;
+}
+
+const char *crc_implementation(void)
+{
+    return (crc_fold_available() ? "pclmul" : "slice-by-16");
+}
+
+/* update the register with one segment, on the calling thread */
+
+static uint32_t crc32_segment(uint32_t crc, const uint8_t *p, size_t len)
+{
+    size_t whole = 0;
+
+#if defined(CRC_FOLD_X86)
+    if (len >= CrcFoldMin && crc_fold_available()) {
+        whole = len & ~(size_t)15;
+        crc = crc32_fold(crc, p, whole);
+    }
+#endif
+
+    return crc32_slice16(crc, p + whole, len - whole);
+}
+
+static uint32_t cksum_segment(uint32_t crc, const uint8_t *p, size_t len)
+{
+    size_t whole = 0;
+
+#if defined(CRC_FOLD_X86)
+    if (len >= CrcFoldMin && crc_fold_available()) {
+        whole = len & ~(size_t)15;
+        crc = cksum_fold(crc, p, whole);
+    }
+#endif
+
+    return cksum_slice16(crc, p + whole, len - whole);
+}
+
+/*
+    combining - the register after A followed by B is the register
+                after A multiplied by x^(8 * len(B)), plus the register
+                after B starting from 0
+ */
+
+static uint32_t crc32_shift(uint32_t crc, unsigned long long len)
+{
+    uint32_t p = 1U << 31;
+    int k = 3;
+
+    for (; len != 0; len >>= 1, k++) {
+        if (len & 1) {
+            p = crc32_multmodp(gCrc32X2n[k & 63], p);
+        }
+    }
+
+    return crc32_multmodp(p, crc);
+}
+
+static uint32_t cksum_shift(uint32_t crc, unsigned long long len)
+{
+    uint32_t p = 1;
+    int k = 3;
+
+    for (; len != 0; len >>= 1, k++) {
+        if (len & 1) {
+            p = cksum_multmodp(gCksumX2n[k & 63], p);
+        }
+    }
+
+    return cksum_multmodp(p, crc);
+}
+
+uint32_t hash_crc32_combine(uint32_t crc1, uint32_t crc2,
+                            unsigned long long len2)
+{
+    pthread_once(&gTablesOnce, crc_tables_init);
+    return crc32_shift(crc1, len2) ^ crc2;
+}
+
+uint32_t hash_cksum_combine(uint32_t crc1, uint32_t crc2,
+                            unsigned long long len2)
+{
+    pthread_once(&gTablesOnce, crc_tables_init);
+    return cksum_shift(crc1, len2) ^ crc2;
+}
+
+/*
+    crc_update_split - checksum large buffers in segments on several
+                       threads, and combine the segments' registers
+ */
+
+typedef struct crcSegment {
+    crcUpdateFn        fn;
+    const uint8_t     *p;
+    size_t             len;
+    uint32_t           crc;
+} crcSegment;
+
+static void crc_segment_job(void *arg, size_t index)
+{
+    crcSegment *segment = (crcSegment *)arg + index;
+
+    segment->crc = segment->fn(segment->crc, segment->p, segment->len);
+}
+
+static uint32_t crc_update_split(crcUpdateFn fn,
+                                 uint32_t (*shift)(uint32_t,
+                                                   unsigned long long),
+                                 uint32_t crc,
+                                 const uint8_t *p,
+                                 size_t len)
+{
+    crcSegment segments[CrcMaxThreads];
+    size_t count = hash_threads_count(len, CrcThreadMinSegment, CrcMaxThreads);
+    size_t segmentLength = 0;
+    size_t i = 0;
+
+    if (count < 2) {
+        return fn(crc, p, len);
+    }
+
+    // the first segment continues from crc, the others start from 0
+
+    segmentLength = (len / count) & ~(size_t)63;
+
+    for (i = 0; i < count; i++) {
+        segments[i].fn = fn;
+        segments[i].p = p + i * segmentLength;
+        segments[i].len = (i == count - 1 ?
+                           len - i * segmentLength : segmentLength);
+        segments[i].crc = (i == 0 ? crc : 0);
+    }
+
+    hash_threads_run(count, crc_segment_job, segments);
+
+    crc = segments[0].crc;
+    for (i = 1; i < count; i++) {
+        crc = shift(crc, segments[i].len) ^ segments[i].crc;
+    }
+
+    return crc;
+}
+
+uint32_t crc32_update_raw(uint32_t crc, const void *buf, size_t len)
+{
+    pthread_once(&gTablesOnce, crc_tables_init);
+    return crc_update_split(crc32_segment, crc32_shift, crc, buf, len);
+}
+
+uint32_t cksum_update_raw(uint32_t crc, const void *buf, size_t len)
+{
+    pthread_once(&gTablesOnce, crc_tables_init);
+    return crc_update_split(cksum_segment, cksum_shift, crc, buf, len);
+}
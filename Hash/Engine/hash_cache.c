@@ -0,0 +1,566 @@
+/*
+    Hash - hash_cache.c
+
+    Persistent digest cache
+
+    History:
+
+    v. 1.0.0 (10/18/2026) - Initial version
+
+    Copyright (c) 2026 Sriranga R. Veeraraghavan <ranga@calalum.org>
+
+    Permission is hereby granted, free of charge, to any person obtaining
+    a copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+    OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "hash_cache.h"
+
+/*
+    The cache file is a header followed by a table of capacity records
+    (a power of 2), addressed by a hash of (device, inode, type) with
+    linear probing.  Removed records are left as tombstones until the
+    table is rebuilt.  The header's dirty flag is set, and written out,
+    before the table is first modified, and is only cleared once the
+    table has been written back, so a cache that a crash left half
+    written is emptied rather than trusted.
+ */
+
+#define HASH_CACHE_MAGIC "HASHCACH"
+
+enum {
+    HashCacheVersion         = 1,
+    HashCacheByteOrder       = 0x01020304,
+    HashCacheInitialCapacity = 4096,
+};
+
+typedef enum {
+    HashCacheSlotEmpty = 0,
+    HashCacheSlotUsed,
+    HashCacheSlotDeleted,
+} hashCacheSlotState;
+
+typedef struct hashCacheHeader {
+    char     magic[8];
+    uint32_t version;
+    uint32_t recordSize;
+    uint64_t capacity;
+    uint64_t count;
+    uint64_t deleted;
+    uint32_t dirty;
+    uint32_t byteOrder;
+    uint32_t reserved[4];
+} hashCacheHeader;
+
+typedef struct hashCacheRecord {
+    uint64_t device;
+    uint64_t inode;
+    uint64_t size;
+    int64_t  mtime;
+    int64_t  ctime;
+    uint32_t type;
+    uint16_t digestLength;
+    uint16_t state;
+    uint8_t  digest[HASH_CACHE_MAX_DIGEST_LENGTH];
+} hashCacheRecord;
+
+struct hashCache {
+    int fd;
+    pthread_mutex_t lock;
+    unsigned char *map;
+    size_t mapLength;
+    hashCacheHeader *header;
+    hashCacheRecord *records;
+    int dirty;
+};
+
+// the file times, in nanoseconds
+
+#if defined(__APPLE__)
+#define HASH_CACHE_TIME_NS(ts) \
+    ((int64_t)(ts).tv_sec*1000000000LL + (int64_t)(ts).tv_nsec)
+#define HASH_CACHE_MTIME(sb) HASH_CACHE_TIME_NS((sb)->st_mtimespec)
+#define HASH_CACHE_CTIME(sb) HASH_CACHE_TIME_NS((sb)->st_ctimespec)
+#else
+#define HASH_CACHE_TIME_NS(ts) \
+    ((int64_t)(ts).tv_sec*1000000000LL + (int64_t)(ts).tv_nsec)
+#define HASH_CACHE_MTIME(sb) HASH_CACHE_TIME_NS((sb)->st_mtim)
+#define HASH_CACHE_CTIME(sb) HASH_CACHE_TIME_NS((sb)->st_ctim)
+#endif
+
+void hash_cache_key(const struct stat *sb, hashCacheKey *key)
+{
+    if (sb == NULL || key == NULL) {
+        return;
+    }
+
+    key->device = (uint64_t)sb->st_dev;
+    key->inode = (uint64_t)sb->st_ino;
+    key->size = (uint64_t)sb->st_size;
+    key->mtime = HASH_CACHE_MTIME(sb);
+    key->ctime = HASH_CACHE_CTIME(sb);
+}
+
+/* slotFor - the first slot to probe for a file and hash type */
+
+static uint64_t slotFor(const hashCache *cache,
+                        const hashCacheKey *key,
+                        HashType type)
+{
+    uint64_t h = key->inode;
+
+    // splitmix64 finalizer over the inode, device and type
+
+    h ^= key->device * 0x9E3779B97F4A7C15ULL;
+    h ^= (uint64_t)type * 0xC2B2AE3D27D4EB4FULL;
+    h ^= h >> 30;
+    h *= 0xBF58476D1CE4E5B9ULL;
+    h ^= h >> 27;
+    h *= 0x94D049BB133111EBULL;
+    h ^= h >> 31;
+
+    return h & (cache->header->capacity - 1);
+}
+
+/*
+    findRecord - return the record for a file and hash type, or NULL.  If
+                 slotFree is not NULL, it is set to the slot a new
+                 record should go in.
+ */
+
+static hashCacheRecord *findRecord(hashCache *cache,
+                                   const hashCacheKey *key,
+                                   HashType type,
+                                   hashCacheRecord **slotFree)
+{
+    hashCacheRecord *record = NULL;
+    uint64_t mask = cache->header->capacity - 1;
+    uint64_t slot = slotFor(cache, key, type);
+    uint64_t i = 0;
+
+    if (slotFree != NULL) {
+        *slotFree = NULL;
+    }
+
+    for (i = 0; i < cache->header->capacity; i++) {
+        record = &cache->records[(slot + i) & mask];
+
+        if (record->state == HashCacheSlotEmpty) {
+            if (slotFree != NULL && *slotFree == NULL) {
+                *slotFree = record;
+            }
+            return NULL;
+        }
+
+        if (record->state == HashCacheSlotDeleted) {
+            if (slotFree != NULL && *slotFree == NULL) {
+                *slotFree = record;
+            }
+            continue;
+        }
+
+        if (record->device == key->device &&
+            record->inode == key->inode &&
+            record->type == (uint32_t)type) {
+            return record;
+        }
+    }
+
+    return NULL;
+}
+
+static void unmapCache(hashCache *cache)
+{
+    if (cache->map != NULL) {
+        (void)munmap(cache->map, cache->mapLength);
+    }
+    cache->map = NULL;
+    cache->mapLength = 0;
+    cache->header = NULL;
+    cache->records = NULL;
+}
+
+static int mapCache(hashCache *cache, size_t length)
+{
+    void *map = NULL;
+
+    map = mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_SHARED,
+               cache->fd, 0);
+    if (map == MAP_FAILED) {
+        return -1;
+    }
+
+    cache->map = map;
+    cache->mapLength = length;
+    cache->header = (hashCacheHeader *)cache->map;
+    cache->records = (hashCacheRecord *)(cache->map + sizeof(hashCacheHeader));
+
+    return 0;
+}
+
+/*
+    markDirty - set the dirty flag, and make sure it is on disk, before
+                the table is modified
+ */
+
+static int markDirty(hashCache *cache)
+{
+    if (cache->dirty) {
+        return 0;
+    }
+
+    cache->header->dirty = 1;
+    if (msync(cache->map, sizeof(hashCacheHeader), MS_SYNC) != 0) {
+        return -1;
+    }
+
+    cache->dirty = 1;
+    return 0;
+}
+
+/* resetCache - replace the file's contents with an empty table */
+
+static int resetCache(hashCache *cache, uint64_t capacity)
+{
+    size_t length = sizeof(hashCacheHeader) +
+                    (size_t)capacity * sizeof(hashCacheRecord);
+
+    unmapCache(cache);
+    cache->dirty = 0;
+
+    if (ftruncate(cache->fd, 0) != 0 ||
+        ftruncate(cache->fd, (off_t)length) != 0 ||
+        mapCache(cache, length) != 0) {
+        return -1;
+    }
+
+    memcpy(cache->header->magic, HASH_CACHE_MAGIC, 8);
+    cache->header->version = HashCacheVersion;
+    cache->header->recordSize = sizeof(hashCacheRecord);
+    cache->header->byteOrder = HashCacheByteOrder;
+    cache->header->capacity = capacity;
+
+    return markDirty(cache);
+}
+
+/*
+    growCache - rebuild the table, doubling it if it is more than half
+                full, which also drops the tombstones
+ */
+
+static int growCache(hashCache *cache)
+{
+    hashCacheRecord *saved = NULL;
+    hashCacheRecord *slot = NULL;
+    uint64_t capacity = cache->header->capacity;
+    uint64_t count = 0;
+    uint64_t i = 0;
+    hashCacheKey key;
+
+    saved = malloc((size_t)cache->header->count * sizeof(hashCacheRecord));
+    if (saved == NULL && cache->header->count > 0) {
+        return -1;
+    }
+
+    for (i = 0; i < capacity; i++) {
+        if (cache->records[i].state == HashCacheSlotUsed) {
+            saved[count++] = cache->records[i];
+        }
+    }
+
+    if (count*2 >= capacity) {
+        capacity *= 2;
+    }
+
+    if (resetCache(cache, capacity) != 0) {
+        free(saved);
+        return -1;
+    }
+
+    for (i = 0; i < count; i++) {
+        key.device = saved[i].device;
+        key.inode = saved[i].inode;
+        (void)findRecord(cache, &key, (HashType)saved[i].type, &slot);
+        *slot = saved[i];
+        cache->header->count++;
+    }
+
+    free(saved);
+    return 0;
+}
+
+/* validHeader - whether the mapped file holds a usable table */
+
+static int validHeader(const hashCache *cache, size_t length)
+{
+    const hashCacheHeader *header = cache->header;
+
+    if (memcmp(header->magic, HASH_CACHE_MAGIC, 8) != 0 ||
+        header->version != HashCacheVersion ||
+        header->recordSize != sizeof(hashCacheRecord) ||
+        header->byteOrder != HashCacheByteOrder ||
+        header->dirty != 0 ||
+        header->capacity == 0 ||
+        (header->capacity & (header->capacity - 1)) != 0 ||
+        header->capacity > (SIZE_MAX - sizeof(hashCacheHeader)) /
+                           sizeof(hashCacheRecord) ||
+        header->count + header->deleted > header->capacity) {
+        return 0;
+    }
+
+    return (length == sizeof(hashCacheHeader) +
+                      (size_t)header->capacity * sizeof(hashCacheRecord));
+}
+
+hashCache *hash_cache_open(const char *path)
+{
+    hashCache *cache = NULL;
+    struct stat sb;
+    int err = 0;
+
+    if (path == NULL) {
+        errno = EINVAL;
+        return NULL;
+    }
+
+    cache = calloc(1, sizeof(hashCache));
+    if (cache == NULL) {
+        return NULL;
+    }
+
+    pthread_mutex_init(&cache->lock, NULL);
+
+    cache->fd = open(path, O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+    if (cache->fd < 0) {
+        err = errno;
+        pthread_mutex_destroy(&cache->lock);
+        free(cache);
+        errno = err;
+        return NULL;
+    }
+
+    while (flock(cache->fd, LOCK_EX) != 0) {
+        if (errno != EINTR) {
+            err = errno;
+            break;
+        }
+    }
+
+    if (err == 0 && fstat(cache->fd, &sb) != 0) {
+        err = errno;
+    }
+
+    // anything that isn't a cleanly closed table of the current
+    // format is thrown away
+
+    if (err == 0) {
+        if (sb.st_size < (off_t)sizeof(hashCacheHeader) ||
+            (unsigned long long)sb.st_size > (unsigned long long)SIZE_MAX ||
+            mapCache(cache, (size_t)sb.st_size) != 0 ||
+            !validHeader(cache, (size_t)sb.st_size)) {
+            if (resetCache(cache, HashCacheInitialCapacity) != 0) {
+                err = errno;
+            }
+        }
+    }
+
+    if (err != 0) {
+        unmapCache(cache);
+        close(cache->fd);
+        pthread_mutex_destroy(&cache->lock);
+        free(cache);
+        errno = err;
+        return NULL;
+    }
+
+    return cache;
+}
+
+int hash_cache_close(hashCache *cache)
+{
+    int rc = 0;
+
+    if (cache == NULL) {
+        return -1;
+    }
+
+    // write the table back before clearing the dirty flag
+
+    if (cache->header == NULL) {
+        rc = -1;
+    } else if (cache->dirty) {
+        if (msync(cache->map, cache->mapLength, MS_SYNC) != 0) {
+            rc = -1;
+        } else {
+            cache->header->dirty = 0;
+            if (msync(cache->map, sizeof(hashCacheHeader), MS_SYNC) != 0) {
+                rc = -1;
+            }
+        }
+    }
+
+    unmapCache(cache);
+    close(cache->fd);
+    pthread_mutex_destroy(&cache->lock);
+    free(cache);
+
+    return rc;
+}
+
+int hash_cache_lookup(hashCache *cache,
+                      const hashCacheKey *key,
+                      HashType type,
+                      unsigned char *digest,
+                      size_t digestLength)
+{
+    hashCacheRecord *record = NULL;
+    int rc = -1;
+
+    if (cache == NULL || key == NULL || digest == NULL) {
+        return -1;
+    }
+
+    pthread_mutex_lock(&cache->lock);
+
+    record = (cache->header != NULL ?
+              findRecord(cache, key, type, NULL) : NULL);
+    if (record != NULL &&
+        record->size == key->size &&
+        record->mtime == key->mtime &&
+        record->ctime == key->ctime &&
+        record->digestLength == digestLength) {
+        memcpy(digest, record->digest, digestLength);
+        rc = 0;
+    }
+
+    pthread_mutex_unlock(&cache->lock);
+
+    return rc;
+}
+
+int hash_cache_store(hashCache *cache,
+                     const hashCacheKey *key,
+                     HashType type,
+                     const unsigned char *digest,
+                     size_t digestLength)
+{
+    hashCacheRecord *record = NULL;
+    hashCacheRecord *slot = NULL;
+    struct timespec now;
+
+    if (cache == NULL || key == NULL || digest == NULL ||
+        digestLength == 0 || digestLength > HASH_CACHE_MAX_DIGEST_LENGTH) {
+        return -1;
+    }
+
+    // a file that was changed very recently could be changed again
+    // without its times changing
+
+    if (clock_gettime(CLOCK_REALTIME, &now) != 0 ||
+        HASH_CACHE_TIME_NS(now) - key->ctime <
+            (int64_t)HASH_CACHE_RACY_SECONDS*1000000000LL) {
+        return -1;
+    }
+
+    pthread_mutex_lock(&cache->lock);
+
+    // keep the table at most 3/4 full (counting tombstones)
+
+    if (cache->header == NULL ||
+        markDirty(cache) != 0 ||
+        ((cache->header->count + cache->header->deleted + 1)*4 >
+         cache->header->capacity*3 && growCache(cache) != 0)) {
+        pthread_mutex_unlock(&cache->lock);
+        return -1;
+    }
+
+    record = findRecord(cache, key, type, &slot);
+    if (record == NULL) {
+        record = slot;
+        if (record->state == HashCacheSlotDeleted) {
+            cache->header->deleted--;
+        }
+        cache->header->count++;
+    }
+
+    record->device = key->device;
+    record->inode = key->inode;
+    record->size = key->size;
+    record->mtime = key->mtime;
+    record->ctime = key->ctime;
+    record->type = (uint32_t)type;
+    record->digestLength = (uint16_t)digestLength;
+    record->state = HashCacheSlotUsed;
+    memcpy(record->digest, digest, digestLength);
+
+    pthread_mutex_unlock(&cache->lock);
+
+    return 0;
+}
+
+void hash_cache_invalidate(hashCache *cache, const hashCacheKey *key)
+{
+    hashCacheRecord *record = NULL;
+    int type = 0;
+
+    if (cache == NULL || key == NULL) {
+        return;
+    }
+
+    pthread_mutex_lock(&cache->lock);
+
+    for (type = HASH_NONE + 1;
+         cache->header != NULL && type < HASH_TYPE_COUNT;
+         type++) {
+        record = findRecord(cache, key, (HashType)type, NULL);
+        if (record == NULL || markDirty(cache) != 0) {
+            continue;
+        }
+        record->state = HashCacheSlotDeleted;
+        cache->header->count--;
+        cache->header->deleted++;
+    }
+
+    pthread_mutex_unlock(&cache->lock);
+}
+
+int hash_cache_clear(hashCache *cache)
+{
+    int rc = 0;
+
+    if (cache == NULL) {
+        return -1;
+    }
+
+    pthread_mutex_lock(&cache->lock);
+    rc = resetCache(cache, HashCacheInitialCapacity);
+    pthread_mutex_unlock(&cache->lock);
+
+    return rc;
+}
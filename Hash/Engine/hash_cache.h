@@ -0,0 +1,127 @@
+/*
+    Hash - hash_cache.h
+
+    Persistent digest cache: digests of regular files are stored in a
+    memory mapped, open addressed table on disk, keyed by the file's
+    device, inode and hash type, and validated by its size and its
+    modification and status change times (in nanoseconds), so that an
+    unchanged file can be skipped instead of being read again.
+
+    History:
+
+    v. 1.0.0 (10/18/2026) - Initial version
+
+    Copyright (c) 2026 Sriranga R. Veeraraghavan <ranga@calalum.org>
+
+    Permission is hereby granted, free of charge, to any person obtaining
+    a copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+    OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef hash_cache_h
+#define hash_cache_h
+
+#include <sys/stat.h>
+#include <stdint.h>
+
+#include "hash_engine.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Longest digest that can be cached, files whose status changed less
+// than HASH_CACHE_RACY_SECONDS ago are not cached, because a change
+// within the file system's timestamp granularity could go unnoticed
+
+enum {
+    HASH_CACHE_MAX_DIGEST_LENGTH = 128,
+    HASH_CACHE_RACY_SECONDS      = 2,
+};
+
+typedef struct hashCache hashCache;
+
+/* the identity and version of a file, see hash_cache_key */
+
+typedef struct hashCacheKey {
+    uint64_t device;
+    uint64_t inode;
+    uint64_t size;
+    int64_t  mtime;
+    int64_t  ctime;
+} hashCacheKey;
+
+/* hash_cache_key - fill in key from the results of stat */
+
+void hash_cache_key(const struct stat *sb, hashCacheKey *key);
+
+/*
+    hash_cache_open - open (or create) the cache at path.  The cache is
+                      locked for the lifetime of the handle, so other
+                      processes opening it wait.  A cache that was not
+                      closed cleanly, or has an unknown format, is
+                      emptied.  returns NULL on failure, with errno set.
+ */
+
+hashCache *hash_cache_open(const char *path);
+
+/*
+    hash_cache_close - write the cache back and release it.  returns 0
+                       on success, or -1 if it could not be written.
+ */
+
+int hash_cache_close(hashCache *cache);
+
+/*
+    hash_cache_lookup - copy the cached digest for the file and hash type
+                        to digest.  returns 0 on a hit, or -1 if there is
+                        no digest for this version of the file.
+ */
+
+int hash_cache_lookup(hashCache *cache,
+                      const hashCacheKey *key,
+                      HashType type,
+                      unsigned char *digest,
+                      size_t digestLength);
+
+/*
+    hash_cache_store - record the digest for the file and hash type,
+                       replacing any digest for an older version of the
+                       file.  Files changed in the last
+                       HASH_CACHE_RACY_SECONDS are skipped.  returns 0 if
+                       the digest was stored.
+ */
+
+int hash_cache_store(hashCache *cache,
+                     const hashCacheKey *key,
+                     HashType type,
+                     const unsigned char *digest,
+                     size_t digestLength);
+
+/* hash_cache_invalidate - forget every digest for the file */
+
+void hash_cache_invalidate(hashCache *cache, const hashCacheKey *key);
+
+/* hash_cache_clear - forget every digest. returns 0 on success. */
+
+int hash_cache_clear(hashCache *cache);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* hash_cache_h */
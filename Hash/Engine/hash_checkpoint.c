@@ -0,0 +1,528 @@
+/*
+    Hash - hash_checkpoint.c
+
+    Checkpoint files for resuming the hashing of large files
+
+    History:
+
+    v. 1.0.0 (10/18/2026) - Initial version
+    v. 1.0.1 (10/18/2026) - add append checkpoints, which are trusted
+                            for a longer file if samples of the
+                            hashed prefix still match
+
+    Copyright (c) 2026 Sriranga R. Veeraraghavan <ranga@calalum.org>
+
+    Permission is hereby granted, free of charge, to any person obtaining
+    a copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+    OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sys/stat.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "crc.h"
+#include "hash_checkpoint.h"
+
+/*
+    A checkpoint file is a header, followed by each context (its
+    serialized length, then the serialized context), followed by the
+    CRC32 of everything before it.  It is written to a temporary file
+    that is renamed over the old checkpoint, so a crash while saving
+    leaves the previous checkpoint in place.
+
+    Append checkpoints are flagged as such, and carry a SHA256 digest
+    of samples of the prefix that was hashed.  Appending to a file
+    changes its size and times, so only the device and inode have to
+    match, the samples catch a file that was rewritten or replaced in
+    place.
+ */
+
+#define HASH_CHECKPOINT_MAGIC "HASHCKPT"
+
+// checkpoints larger than this (16MB) are not read
+
+enum {
+    HashCheckpointMaxSize = 16777216,
+};
+
+enum {
+    HashCheckpointFlagAppend = 0x1,
+    HashCheckpointSampleLength = 32,
+};
+
+typedef struct hashCheckpointHeader {
+    char          magic[8];
+    uint32_t      version;
+    uint32_t      count;
+    uint64_t      offset;
+    hashCacheKey  file;
+    uint32_t      flags;
+    uint32_t      reserved;
+    unsigned char sample[HashCheckpointSampleLength];
+} hashCheckpointHeader;
+
+static uint32_t checksum(const unsigned char *data, size_t length)
+{
+    crcContext crc;
+
+    crc32_init(&crc);
+    crc32_update(&crc, data, length);
+    (void)crc32_finalize(&crc);
+
+    return crc.crc;
+}
+
+/* writeAll - write length bytes to fd, returns 0 on success */
+
+static int writeAll(int fd, const unsigned char *data, size_t length)
+{
+    ssize_t written = 0;
+
+    while (length > 0) {
+        written = write(fd, data, length);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return -1;
+        }
+        data += written;
+        length -= (size_t)written;
+    }
+
+    return 0;
+}
+
+/* readAt - read length bytes at offset, returns 0 on success */
+
+static int readAt(int fd,
+                  unsigned char *data,
+                  size_t length,
+                  unsigned long long offset)
+{
+    ssize_t bytesRead = 0;
+
+    while (length > 0) {
+        bytesRead = pread(fd, data, length, (off_t)offset);
+        if (bytesRead < 0 && errno == EINTR) {
+            continue;
+        }
+        if (bytesRead <= 0) {
+            return -1;
+        }
+        data += bytesRead;
+        length -= (size_t)bytesRead;
+        offset += (unsigned long long)bytesRead;
+    }
+
+    return 0;
+}
+
+/*
+    prefixSample - digest the samples of the first length bytes of the
+                   file open on fd (see HASH_CHECKPOINT_TAIL_SAMPLE),
+                   returns 0 on success
+ */
+
+static int prefixSample(int fd,
+                        unsigned long long length,
+                        unsigned char *sample)
+{
+    unsigned char block[HASH_CHECKPOINT_SAMPLE_SIZE];
+    hashEngineContext *ctx = NULL;
+    unsigned long long tail = 0;
+    unsigned long long at = 0;
+    unsigned long long chunk = 0;
+    unsigned int i = 0;
+    int rc = 0;
+
+    ctx = hash_engine_new(HASH_SHA256);
+    if (ctx == NULL) {
+        return -1;
+    }
+
+    hash_engine_update(ctx, &length, sizeof(length));
+
+    tail = (length > HASH_CHECKPOINT_TAIL_SAMPLE ?
+            length - HASH_CHECKPOINT_TAIL_SAMPLE : 0);
+
+    // blocks spread over the part before the tail, the first one at
+    // the start of the file
+
+    for (i = 0; i < HASH_CHECKPOINT_SAMPLE_COUNT && rc == 0; i++) {
+        at = (tail / HASH_CHECKPOINT_SAMPLE_COUNT) * i;
+        if (at + HASH_CHECKPOINT_SAMPLE_SIZE > tail) {
+            break;
+        }
+        rc = readAt(fd, block, HASH_CHECKPOINT_SAMPLE_SIZE, at);
+        if (rc == 0) {
+            hash_engine_update(ctx, block, HASH_CHECKPOINT_SAMPLE_SIZE);
+        }
+    }
+
+    for (at = tail; at < length && rc == 0; at += chunk) {
+        chunk = length - at;
+        if (chunk > sizeof(block)) {
+            chunk = sizeof(block);
+        }
+        rc = readAt(fd, block, (size_t)chunk, at);
+        if (rc == 0) {
+            hash_engine_update(ctx, block, (size_t)chunk);
+        }
+    }
+
+    if (rc == 0 && hash_engine_final(ctx, sample) < 0) {
+        rc = -1;
+    }
+
+    hash_engine_free(ctx);
+    return rc;
+}
+
+/* saveCheckpoint - write a checkpoint with the given header */
+
+static int saveCheckpoint(const char *path,
+                          const hashCheckpointHeader *header,
+                          hashEngineContext *const *ctxs,
+                          size_t count)
+{
+    unsigned char *data = NULL;
+    unsigned char *p = NULL;
+    char *tmpPath = NULL;
+    size_t length = sizeof(*header) + sizeof(uint32_t);
+    uint64_t stateLength = 0;
+    uint32_t crc = 0;
+    size_t i = 0;
+    int fd = -1;
+    int rc = -1;
+
+    for (i = 0; i < count; i++) {
+        length += sizeof(uint64_t) + hash_engine_serialized_size(ctxs[i]);
+    }
+
+    data = malloc(length);
+    tmpPath = malloc(strlen(path) + sizeof(".tmp"));
+    if (data == NULL || tmpPath == NULL) {
+        free(data);
+        free(tmpPath);
+        return -1;
+    }
+
+    memcpy(data, header, sizeof(*header));
+    p = data + sizeof(*header);
+
+    for (i = 0; i < count; i++) {
+        stateLength = hash_engine_serialized_size(ctxs[i]);
+        memcpy(p, &stateLength, sizeof(stateLength));
+        p += sizeof(stateLength);
+        p += hash_engine_serialize(ctxs[i], p, (size_t)stateLength);
+    }
+
+    crc = checksum(data, (size_t)(p - data));
+    memcpy(p, &crc, sizeof(crc));
+
+    // write a new file and rename it over the old one, only once it is
+    // safely on disk
+
+    sprintf(tmpPath, "%s.tmp", path);
+
+    fd = open(tmpPath, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+    if (fd >= 0) {
+        if (writeAll(fd, data, length) == 0 && fsync(fd) == 0) {
+            rc = 0;
+        }
+        if (close(fd) != 0) {
+            rc = -1;
+        }
+        if (rc == 0 && rename(tmpPath, path) != 0) {
+            rc = -1;
+        }
+        if (rc != 0) {
+            (void)unlink(tmpPath);
+        }
+    }
+
+    free(data);
+    free(tmpPath);
+
+    return rc;
+}
+
+/* newHeader - start a header for a checkpoint */
+
+static void newHeader(hashCheckpointHeader *header,
+                      const hashCacheKey *file,
+                      unsigned long long offset,
+                      size_t count)
+{
+    memset(header, 0, sizeof(*header));
+    memcpy(header->magic, HASH_CHECKPOINT_MAGIC, 8);
+    header->version = HASH_CHECKPOINT_VERSION;
+    header->count = (uint32_t)count;
+    header->offset = offset;
+    header->file = *file;
+}
+
+int hash_checkpoint_save(const char *path,
+                         const hashCacheKey *file,
+                         unsigned long long offset,
+                         hashEngineContext *const *ctxs,
+                         size_t count)
+{
+    hashCheckpointHeader header;
+
+    if (path == NULL || file == NULL || ctxs == NULL || count == 0) {
+        return -1;
+    }
+
+    newHeader(&header, file, offset, count);
+    return saveCheckpoint(path, &header, ctxs, count);
+}
+
+int hash_checkpoint_save_append(const char *path,
+                                int fd,
+                                const hashCacheKey *file,
+                                unsigned long long offset,
+                                hashEngineContext *const *ctxs,
+                                size_t count)
+{
+    hashCheckpointHeader header;
+
+    if (path == NULL || file == NULL || ctxs == NULL || count == 0) {
+        return -1;
+    }
+
+    newHeader(&header, file, offset, count);
+    header.flags = HashCheckpointFlagAppend;
+    if (prefixSample(fd, offset, header.sample) != 0) {
+        return -1;
+    }
+
+    return saveCheckpoint(path, &header, ctxs, count);
+}
+
+/* readCheckpoint - read and check the checkpoint, returns its contents */
+
+static unsigned char *readCheckpoint(const char *path, size_t *length)
+{
+    unsigned char *data = NULL;
+    struct stat sb;
+    ssize_t bytesRead = 0;
+    size_t total = 0;
+    uint32_t crc = 0;
+    int fd = -1;
+
+    fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return NULL;
+    }
+
+    if (fstat(fd, &sb) != 0 || !S_ISREG(sb.st_mode) ||
+        sb.st_size < (off_t)(sizeof(hashCheckpointHeader) + sizeof(crc)) ||
+        sb.st_size > HashCheckpointMaxSize) {
+        close(fd);
+        return NULL;
+    }
+
+    data = malloc((size_t)sb.st_size);
+    while (data != NULL && total < (size_t)sb.st_size) {
+        bytesRead = read(fd, data + total, (size_t)sb.st_size - total);
+        if (bytesRead < 0 && errno == EINTR) {
+            continue;
+        }
+        if (bytesRead <= 0) {
+            break;
+        }
+        total += (size_t)bytesRead;
+    }
+
+    close(fd);
+
+    if (data == NULL || total != (size_t)sb.st_size) {
+        free(data);
+        return NULL;
+    }
+
+    memcpy(&crc, data + total - sizeof(crc), sizeof(crc));
+    if (crc != checksum(data, total - sizeof(crc))) {
+        free(data);
+        return NULL;
+    }
+
+    *length = total - sizeof(crc);
+    return data;
+}
+
+/*
+    restoreCheckpoint - restore the contexts from a checkpoint that is
+                        read from path, if accept (fd, file) agrees
+                        that it is for this file
+ */
+
+typedef int (*hashCheckpointAccept)(const hashCheckpointHeader *header,
+                                    int fd,
+                                    const hashCacheKey *file);
+
+static int restoreCheckpoint(const char *path,
+                             hashCheckpointAccept accept,
+                             int fd,
+                             const hashCacheKey *file,
+                             hashEngineContext *const *ctxs,
+                             size_t count,
+                             unsigned long long *offset)
+{
+    hashCheckpointHeader header;
+    unsigned char *data = NULL;
+    const unsigned char *p = NULL;
+    size_t length = 0;
+    size_t left = 0;
+    uint64_t stateLength = 0;
+    size_t i = 0;
+    int rc = 0;
+
+    if (path == NULL || file == NULL || ctxs == NULL || count == 0 ||
+        offset == NULL) {
+        return -1;
+    }
+
+    data = readCheckpoint(path, &length);
+    if (data == NULL) {
+        return -1;
+    }
+
+    memcpy(&header, data, sizeof(header));
+    if (memcmp(header.magic, HASH_CHECKPOINT_MAGIC, 8) != 0 ||
+        header.version != HASH_CHECKPOINT_VERSION ||
+        header.count != count ||
+        header.offset > file->size ||
+        !accept(&header, fd, file)) {
+        free(data);
+        return -1;
+    }
+
+    p = data + sizeof(header);
+    left = length - sizeof(header);
+
+    for (i = 0; i < count && rc == 0; i++) {
+        if (left < sizeof(stateLength)) {
+            rc = -1;
+            break;
+        }
+        memcpy(&stateLength, p, sizeof(stateLength));
+        p += sizeof(stateLength);
+        left -= sizeof(stateLength);
+
+        if (stateLength > left ||
+            hash_engine_deserialize(ctxs[i], p, (size_t)stateLength) != 0) {
+            rc = -1;
+            break;
+        }
+        p += stateLength;
+        left -= (size_t)stateLength;
+    }
+
+    free(data);
+
+    // don't leave the contexts half restored
+
+    if (rc != 0) {
+        for (i = 0; i < count; i++) {
+            hash_engine_reset(ctxs[i]);
+        }
+        return -1;
+    }
+
+    *offset = header.offset;
+    return 0;
+}
+
+/* acceptSame - the file hasn't changed at all since the checkpoint */
+
+static int acceptSame(const hashCheckpointHeader *header,
+                      int fd,
+                      const hashCacheKey *file)
+{
+    (void)fd;
+
+    return ((header->flags & HashCheckpointFlagAppend) == 0 &&
+            memcmp(&header->file, file, sizeof(hashCacheKey)) == 0);
+}
+
+/*
+    acceptAppended - the file is the same one, and its prefix matches
+                     the samples taken when the checkpoint was saved
+ */
+
+static int acceptAppended(const hashCheckpointHeader *header,
+                          int fd,
+                          const hashCacheKey *file)
+{
+    unsigned char sample[HashCheckpointSampleLength];
+
+    if ((header->flags & HashCheckpointFlagAppend) == 0 ||
+        header->file.device != file->device ||
+        header->file.inode != file->inode) {
+        return 0;
+    }
+
+    return (prefixSample(fd, header->offset, sample) == 0 &&
+            memcmp(sample, header->sample, sizeof(sample)) == 0);
+}
+
+int hash_checkpoint_load(const char *path,
+                         const hashCacheKey *file,
+                         hashEngineContext *const *ctxs,
+                         size_t count,
+                         unsigned long long *offset)
+{
+    return restoreCheckpoint(path,
+                             acceptSame,
+                             -1,
+                             file,
+                             ctxs,
+                             count,
+                             offset);
+}
+
+int hash_checkpoint_load_append(const char *path,
+                                int fd,
+                                const hashCacheKey *file,
+                                hashEngineContext *const *ctxs,
+                                size_t count,
+                                unsigned long long *offset)
+{
+    return restoreCheckpoint(path,
+                             acceptAppended,
+                             fd,
+                             file,
+                             ctxs,
+                             count,
+                             offset);
+}
+
+void hash_checkpoint_remove(const char *path)
+{
+    if (path != NULL) {
+        (void)unlink(path);
+    }
+}
@@ -0,0 +1,137 @@
+/*
+    Hash - hash_checkpoint.h
+
+    Checkpoint files: the serialized contexts for a file that is being
+    hashed, along with how much of it has been hashed, so that hashing a
+    very large file can resume where it left off after it is cancelled
+    or the process dies.
+
+    History:
+
+    v. 1.0.0 (10/18/2026) - Initial version
+    v. 1.0.1 (10/18/2026) - add append checkpoints for files that only
+                            grow, such as logs
+
+    Copyright (c) 2026 Sriranga R. Veeraraghavan <ranga@calalum.org>
+
+    Permission is hereby granted, free of charge, to any person obtaining
+    a copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+    OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef hash_checkpoint_h
+#define hash_checkpoint_h
+
+#include "hash_cache.h"
+#include "hash_engine.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Version of the checkpoint file format
+
+enum {
+    HASH_CHECKPOINT_VERSION = 2,
+};
+
+/*
+    An append checkpoint also records a digest of samples of the hashed
+    prefix: its last HASH_CHECKPOINT_TAIL_SAMPLE bytes, and
+    HASH_CHECKPOINT_SAMPLE_COUNT blocks of HASH_CHECKPOINT_SAMPLE_SIZE
+    bytes spread evenly over the rest of it.
+ */
+
+enum {
+    HASH_CHECKPOINT_TAIL_SAMPLE  = 65536,
+    HASH_CHECKPOINT_SAMPLE_SIZE  = 4096,
+    HASH_CHECKPOINT_SAMPLE_COUNT = 16,
+};
+
+/*
+    hash_checkpoint_save - atomically replace the checkpoint at path with
+                           the state of count contexts, which have
+                           hashed the first offset bytes of the file
+                           identified by file.  returns 0 on success.
+ */
+
+int hash_checkpoint_save(const char *path,
+                         const hashCacheKey *file,
+                         unsigned long long offset,
+                         hashEngineContext *const *ctxs,
+                         size_t count);
+
+/*
+    hash_checkpoint_load - if the checkpoint at path is for the file
+                           identified by file (which must not have
+                           changed since), and for the same hashes as
+                           ctxs, restore the contexts and set offset to
+                           the number of bytes to skip.  The contexts
+                           must be freshly created or reset.  returns 0
+                           on success, or -1 if there is no usable
+                           checkpoint (the contexts are then reset).
+ */
+
+int hash_checkpoint_load(const char *path,
+                         const hashCacheKey *file,
+                         hashEngineContext *const *ctxs,
+                         size_t count,
+                         unsigned long long *offset);
+
+/*
+    hash_checkpoint_save_append - like hash_checkpoint_save, for a file
+                                  that is only ever appended to.  fd
+                                  must be open on the file, it is used
+                                  to sample the hashed prefix.
+ */
+
+int hash_checkpoint_save_append(const char *path,
+                                int fd,
+                                const hashCacheKey *file,
+                                unsigned long long offset,
+                                hashEngineContext *const *ctxs,
+                                size_t count);
+
+/*
+    hash_checkpoint_load_append - restore an append checkpoint for the
+                                  file open on fd (identified by file)
+                                  if it is the same file (device and
+                                  inode), it is at least as long as the
+                                  hashed prefix, and the prefix still
+                                  matches its samples.  The contexts
+                                  then only need the bytes from offset
+                                  on.  returns 0 on success, or -1 if
+                                  the file has to be hashed from the
+                                  start (the contexts are then reset).
+ */
+
+int hash_checkpoint_load_append(const char *path,
+                                int fd,
+                                const hashCacheKey *file,
+                                hashEngineContext *const *ctxs,
+                                size_t count,
+                                unsigned long long *offset);
+
+/* hash_checkpoint_remove - delete the checkpoint once it is finished */
+
+void hash_checkpoint_remove(const char *path);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* hash_checkpoint_h */
@@ -0,0 +1,1881 @@
+/*
+    Hash - hash_engine.c
+
+    History:
+
+    v. 1.0.0 (10/18/2026) - Initial version, extracted from HashOperation
+    v. 1.0.1 (10/18/2026) - use the BLAKE3 thread pool for large updates
+    v. 1.0.2 (10/18/2026) - add SIMD level selection for BLAKE3 and K12
+    v. 1.0.3 (10/18/2026) - add hash_engine_hash_many
+    v. 1.0.4 (10/18/2026) - use the in-tree MD5, SHA1 and SHA2 instead
+                            of CommonCrypto, so they are available on
+                            all platforms
+    v. 1.0.5 (10/18/2026) - add hash_engine_update_many, MD5, SHA1 and
+                            SHA256 use the multi-buffer lanes (hash_mb)
+    v. 1.0.6 (10/18/2026) - add context serialization, with custom
+                            serializers for Groestl and SHA1DC
+    v. 1.0.7 (10/18/2026) - add hash_engine_squeeze to stream output
+                            from SHAKE, BLAKE3 and K12
+    v. 1.0.8 (10/18/2026) - CRC32 and cksum have PCLMUL implementations
+    v. 1.0.9 (10/18/2026) - SHA3 and SHAKE use K12's runtime dispatched
+                            Keccak-p[1600] permutations
+    v. 1.0.10 (10/18/2026) - add BLAKE2bp and BLAKE2sp, BLAKE2 has SSE4.1
+                             and AVX2 compression functions
+    v. 1.0.11 (10/18/2026) - add Skein tree hashing, with the leaves
+                             hashed on threads and in SIMD lanes
+    v. 1.0.12 (10/18/2026) - MD6 has AVX2 and AVX-512 compression loops,
+                             and compresses whole subtrees on threads
+    v. 1.0.13 (10/18/2026) - Groestl uses AES-NI, and VAES for the long
+                             variants
+
+    Copyright (c) 2015-2026 Sriranga R. Veeraraghavan <ranga@calalum.org>
+
+    Permission is hereby granted, free of charge, to any person obtaining
+    a copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+    OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+
+#include "hash_engine.h"
+#include "hash_mb.h"
+#include "crc.h"
+#include "md5.h"
+#include "sha1.h"
+#include "sha256.h"
+#include "sha512.h"
+#include "md6.h"
+#include "md6_simd.h"
+#include "rmd160.h"
+#include "rmd320.h"
+#include "Whirlpool.h"
+#include "keccak-tiny.h"
+#include "sha3_many.h"
+#include "blake2.h"
+#include "blake2_many.h"
+#include "blake2_simd.h"
+#include "blake3.h"
+#include "skein.h"
+#include "skein_tree.h"
+#include "jh.h"
+#include "tiger.h"
+#include "has160.h"
+#include "blake.h"
+#include "Groestl-opt.h"
+#include "Groestl-aesni.h"
+#include "sha1dc.h"
+#include "snefru.h"
+#include "lsh.h"
+#include "KangarooTwelve.h"
+
+/*
+    Several of the cores take 32-bit lengths or lengths in bits (which
+    overflow for large buffers), so updates are passed to them in chunks
+    of at most 256MB.
+ */
+
+#define HASH_ENGINE_MAX_CHUNK ((size_t)1 << 28)
+
+#define FOR_EACH_CHUNK(data, length, chunk) \
+    for (size_t chunk = ((length) > HASH_ENGINE_MAX_CHUNK ? \
+                         HASH_ENGINE_MAX_CHUNK : (length)); \
+         (length) > 0; \
+         (data) += chunk, (length) -= chunk, \
+         chunk = ((length) > HASH_ENGINE_MAX_CHUNK ? \
+                  HASH_ENGINE_MAX_CHUNK : (length)))
+
+/* store a 32-bit checksum as a big endian digest */
+
+static void store32_be(unsigned char *digest, uint32_t value)
+{
+    digest[0] = (unsigned char)(value >> 24);
+    digest[1] = (unsigned char)(value >> 16);
+    digest[2] = (unsigned char)(value >> 8);
+    digest[3] = (unsigned char)(value);
+}
+
+/* CRC32 */
+
+static void crc32_engine_init(void *ctx, size_t digestLength)
+{
+    (void)digestLength;
+    crc32_init((crcContext *)ctx);
+}
+
+static void crc32_engine_update(void *ctx,
+                                const unsigned char *data,
+                                size_t length)
+{
+    crc32_update((crcContext *)ctx, data, length);
+}
+
+static int crc32_engine_final(void *ctx,
+                              unsigned char *digest,
+                              size_t digestLength)
+{
+    (void)digestLength;
+    if (crc32_finalize((crcContext *)ctx) != 0) {
+        return -1;
+    }
+    store32_be(digest, ((crcContext *)ctx)->crc);
+    return 0;
+}
+
+/* POSIX cksum - the file length is included in the checksum */
+
+typedef struct cksumEngineContext {
+    crcContext crc;
+    unsigned long long length;
+} cksumEngineContext;
+
+static void cksum_engine_init(void *ctx, size_t digestLength)
+{
+    cksumEngineContext *c = ctx;
+    (void)digestLength;
+    cksum_init(&c->crc);
+    c->length = 0;
+}
+
+static void cksum_engine_update(void *ctx,
+                                const unsigned char *data,
+                                size_t length)
+{
+    cksumEngineContext *c = ctx;
+    c->length += length;
+    FOR_EACH_CHUNK(data, length, chunk) {
+        cksum_update(&c->crc, (unsigned char *)data, (uint32_t)chunk);
+    }
+}
+
+static int cksum_engine_final(void *ctx,
+                              unsigned char *digest,
+                              size_t digestLength)
+{
+    cksumEngineContext *c = ctx;
+    (void)digestLength;
+    cksum_finalize(&c->crc, c->length);
+    store32_be(digest, c->crc.crc);
+    return 0;
+}
+
+/*
+    MD5, SHA1, SHA2 - the SHA224 and SHA384 contexts are SHA256 and
+    SHA512 contexts with a different initial state
+ */
+
+#define SHA_ENGINE(name, ctxType, prefix) \
+static void name##_engine_init(void *ctx, size_t digestLength) \
+{ \
+    (void)digestLength; \
+    name##_init((ctxType *)ctx); \
+} \
+static void name##_engine_update(void *ctx, \
+                                 const unsigned char *data, \
+                                 size_t length) \
+{ \
+    prefix##_update((ctxType *)ctx, data, length); \
+} \
+static int name##_engine_final(void *ctx, \
+                               unsigned char *digest, \
+                               size_t digestLength) \
+{ \
+    (void)digestLength; \
+    prefix##_final((ctxType *)ctx, digest); \
+    return 0; \
+}
+
+SHA_ENGINE(md5, md5_ctx, md5)
+SHA_ENGINE(sha1, sha1_ctx, sha1)
+SHA_ENGINE(sha224, sha256_ctx, sha256)
+SHA_ENGINE(sha256, sha256_ctx, sha256)
+SHA_ENGINE(sha384, sha512_ctx, sha512)
+SHA_ENGINE(sha512, sha512_ctx, sha512)
+
+/*
+    MD5, SHA1, SHA224 and SHA256 can update several contexts at once in
+    the multi-buffer lanes, batches of messages are hashed the same way,
+    a lane's worth of contexts at a time
+ */
+
+#define MB_ENGINE(name, ctxType, prefix) \
+static void name##_engine_update_many(void *const *ctxs, \
+                                      const unsigned char *const *data, \
+                                      const size_t *lengths, \
+                                      size_t count) \
+{ \
+    hash_mb_##prefix##_update((ctxType *const *)ctxs, \
+                              data, \
+                              lengths, \
+                              count); \
+} \
+static void name##_engine_many(const unsigned char *const *inputs, \
+                               const size_t *lengths, \
+                               size_t count, \
+                               unsigned char *digests, \
+                               size_t digestLength) \
+{ \
+    ctxType ctxs[HASH_MB_MAX_LANES]; \
+    ctxType *ctxp[HASH_MB_MAX_LANES]; \
+    size_t n = 0; \
+    size_t i = 0; \
+    for (; count > 0; \
+         inputs += n, lengths += n, count -= n, \
+         digests += n*digestLength) { \
+        n = (count < HASH_MB_MAX_LANES ? count : HASH_MB_MAX_LANES); \
+        for (i = 0; i < n; i++) { \
+            name##_init(&ctxs[i]); \
+            ctxp[i] = &ctxs[i]; \
+        } \
+        hash_mb_##prefix##_update(ctxp, inputs, lengths, n); \
+        for (i = 0; i < n; i++) { \
+            prefix##_final(&ctxs[i], digests + i*digestLength); \
+        } \
+    } \
+}
+
+MB_ENGINE(md5, md5_ctx, md5)
+MB_ENGINE(sha1, sha1_ctx, sha1)
+MB_ENGINE(sha224, sha256_ctx, sha256)
+MB_ENGINE(sha256, sha256_ctx, sha256)
+
+/* SHA1 with collision detection */
+
+static void sha1dc_engine_init(void *ctx, size_t digestLength)
+{
+    (void)digestLength;
+    SHA1DCInit((SHA1_CTX *)ctx);
+}
+
+static void sha1dc_engine_update(void *ctx,
+                                 const unsigned char *data,
+                                 size_t length)
+{
+    SHA1DCUpdate((SHA1_CTX *)ctx, (const char *)data, length);
+}
+
+static int sha1dc_engine_final(void *ctx,
+                               unsigned char *digest,
+                               size_t digestLength)
+{
+    (void)digestLength;
+    return (SHA1DCFinal(digest, (SHA1_CTX *)ctx) != 0 ? 1 : 0);
+}
+
+/* the collision callback is a function pointer, it is never saved */
+
+static size_t sha1dc_engine_serialize(const void *ctx, unsigned char *state)
+{
+    if (state != NULL) {
+        memcpy(state, ctx, sizeof(SHA1_CTX));
+        memset(state + offsetof(SHA1_CTX, callback),
+               0,
+               sizeof(collision_block_callback));
+    }
+    return sizeof(SHA1_CTX);
+}
+
+static int sha1dc_engine_deserialize(void *ctx,
+                                     const unsigned char *state,
+                                     size_t length)
+{
+    collision_block_callback callback = ((SHA1_CTX *)ctx)->callback;
+
+    if (length != sizeof(SHA1_CTX)) {
+        return -1;
+    }
+    memcpy(ctx, state, sizeof(SHA1_CTX));
+    ((SHA1_CTX *)ctx)->callback = callback;
+    return 0;
+}
+
+/* MD6 - the reference implementation takes lengths in bits */
+
+static void md6_engine_init(void *ctx, size_t digestLength)
+{
+    md6_init((md6_state *)ctx, (int)(digestLength*8));
+}
+
+static void md6_engine_update(void *ctx,
+                              const unsigned char *data,
+                              size_t length)
+{
+    FOR_EACH_CHUNK(data, length, chunk) {
+        md6_update((md6_state *)ctx,
+                   (unsigned char *)data,
+                   (uint64_t)chunk*8);
+    }
+}
+
+static int md6_engine_final(void *ctx,
+                            unsigned char *digest,
+                            size_t digestLength)
+{
+    (void)digestLength;
+    return (md6_final((md6_state *)ctx, digest) == 0 ? 0 : -1);
+}
+
+/* SHA3 */
+
+static void sha3_engine_init(void *ctx, size_t digestLength)
+{
+    keccak_cleanse((keccak_state *)ctx);
+    keccak_digest_init((keccak_state *)ctx, digestLength*8);
+}
+
+static void sha3_engine_update(void *ctx,
+                               const unsigned char *data,
+                               size_t length)
+{
+    keccak_digest_update((keccak_state *)ctx, data, length);
+}
+
+static int sha3_engine_final(void *ctx,
+                             unsigned char *digest,
+                             size_t digestLength)
+{
+    keccak_finalize((keccak_state *)ctx);
+    return (keccak_squeeze((keccak_state *)ctx,
+                           digest,
+                           digestLength) == 0 ? 0 : -1);
+}
+
+static void sha3_engine_many(const unsigned char *const *inputs,
+                             const size_t *lengths,
+                             size_t count,
+                             unsigned char *digests,
+                             size_t digestLength)
+{
+    (void)sha3_many(inputs, lengths, count, digests, digestLength*8,
+                    hash_engine_simd_level() >= HASH_ENGINE_SIMD_AVX2);
+}
+
+/* SHAKE */
+
+static void shake128_engine_init(void *ctx, size_t digestLength)
+{
+    (void)digestLength;
+    keccak_cleanse((keccak_state *)ctx);
+    keccak_xof_init((keccak_state *)ctx, 128);
+}
+
+static void shake256_engine_init(void *ctx, size_t digestLength)
+{
+    (void)digestLength;
+    keccak_cleanse((keccak_state *)ctx);
+    keccak_xof_init((keccak_state *)ctx, 256);
+}
+
+static void shake_engine_update(void *ctx,
+                                const unsigned char *data,
+                                size_t length)
+{
+    keccak_xof_absorb((keccak_state *)ctx, data, length);
+}
+
+static int shake_engine_final(void *ctx,
+                              unsigned char *digest,
+                              size_t digestLength)
+{
+    return (keccak_xof_squeeze((keccak_state *)ctx,
+                               digest,
+                               digestLength) == 0 ? 0 : -1);
+}
+
+/* the sponge keeps its own position, keccak_squeeze writes whole
+   blocks straight to out */
+
+static int shake_engine_squeeze(void *ctx,
+                                unsigned long long offset,
+                                unsigned char *out,
+                                size_t length)
+{
+    (void)offset;
+    return (keccak_xof_squeeze((keccak_state *)ctx,
+                               out,
+                               length) == 0 ? 0 : -1);
+}
+
+/* RIPEMD-160 */
+
+static void rmd160_engine_init(void *ctx, size_t digestLength)
+{
+    (void)digestLength;
+    RMD160Init((RMD160_CTX *)ctx);
+}
+
+static void rmd160_engine_update(void *ctx,
+                                 const unsigned char *data,
+                                 size_t length)
+{
+    FOR_EACH_CHUNK(data, length, chunk) {
+        RMD160Update((RMD160_CTX *)ctx, data, (uint32_t)chunk);
+    }
+}
+
+static int rmd160_engine_final(void *ctx,
+                               unsigned char *digest,
+                               size_t digestLength)
+{
+    (void)digestLength;
+    RMD160Final(digest, (RMD160_CTX *)ctx);
+    return 0;
+}
+
+/* RIPEMD-320 */
+
+static void rmd320_engine_init(void *ctx, size_t digestLength)
+{
+    (void)digestLength;
+    rmd320_init((rmd320_ctx *)ctx);
+}
+
+static void rmd320_engine_update(void *ctx,
+                                 const unsigned char *data,
+                                 size_t length)
+{
+    rmd320_hash((rmd320_ctx *)ctx, data, length);
+}
+
+static int rmd320_engine_final(void *ctx,
+                               unsigned char *digest,
+                               size_t digestLength)
+{
+    (void)digestLength;
+    rmd320_done((rmd320_ctx *)ctx, digest);
+    return 0;
+}
+
+/* Whirlpool - the NESSIE api takes lengths in bits */
+
+static void wpool_engine_init(void *ctx, size_t digestLength)
+{
+    (void)digestLength;
+    NESSIEinit((struct NESSIEstruct *)ctx);
+}
+
+static void wpool_engine_update(void *ctx,
+                                const unsigned char *data,
+                                size_t length)
+{
+    FOR_EACH_CHUNK(data, length, chunk) {
+        NESSIEadd(data,
+                  (unsigned long)chunk*8,
+                  (struct NESSIEstruct *)ctx);
+    }
+}
+
+static int wpool_engine_final(void *ctx,
+                              unsigned char *digest,
+                              size_t digestLength)
+{
+    (void)digestLength;
+    NESSIEfinalize((struct NESSIEstruct *)ctx, digest);
+    return 0;
+}
+
+/* BLAKE2B, BLAKE2S */
+
+static void blake2b_engine_init(void *ctx, size_t digestLength)
+{
+    blake2b_init((blake2b_state *)ctx, (uint8_t)digestLength);
+}
+
+static void blake2b_engine_update(void *ctx,
+                                  const unsigned char *data,
+                                  size_t length)
+{
+    blake2b_update((blake2b_state *)ctx, data, (uint64_t)length);
+}
+
+static int blake2b_engine_final(void *ctx,
+                                unsigned char *digest,
+                                size_t digestLength)
+{
+    return (blake2b_final((blake2b_state *)ctx,
+                          digest,
+                          (uint8_t)digestLength) == 0 ? 0 : -1);
+}
+
+static void blake2s_engine_init(void *ctx, size_t digestLength)
+{
+    blake2s_init((blake2s_state *)ctx, (uint8_t)digestLength);
+}
+
+static void blake2s_engine_update(void *ctx,
+                                  const unsigned char *data,
+                                  size_t length)
+{
+    blake2s_update((blake2s_state *)ctx, data, (uint64_t)length);
+}
+
+static int blake2s_engine_final(void *ctx,
+                                unsigned char *digest,
+                                size_t digestLength)
+{
+    return (blake2s_final((blake2s_state *)ctx,
+                          digest,
+                          (uint8_t)digestLength) == 0 ? 0 : -1);
+}
+
+static void blake2b_engine_many(const unsigned char *const *inputs,
+                                const size_t *lengths,
+                                size_t count,
+                                unsigned char *digests,
+                                size_t digestLength)
+{
+    blake2b_many(inputs, lengths, count, digests, (uint8_t)digestLength,
+                 hash_engine_simd_level() >= HASH_ENGINE_SIMD_AVX2);
+}
+
+static void blake2s_engine_many(const unsigned char *const *inputs,
+                                const size_t *lengths,
+                                size_t count,
+                                unsigned char *digests,
+                                size_t digestLength)
+{
+    blake2s_many(inputs, lengths, count, digests, (uint8_t)digestLength,
+                 hash_engine_simd_level() >= HASH_ENGINE_SIMD_AVX2);
+}
+
+/* BLAKE2BP, BLAKE2SP */
+
+static void blake2bp_engine_init(void *ctx, size_t digestLength)
+{
+    blake2bp_init((blake2bp_state *)ctx, (uint8_t)digestLength);
+}
+
+static void blake2bp_engine_update(void *ctx,
+                                   const unsigned char *data,
+                                   size_t length)
+{
+    blake2bp_update((blake2bp_state *)ctx, data, (uint64_t)length);
+}
+
+static int blake2bp_engine_final(void *ctx,
+                                 unsigned char *digest,
+                                 size_t digestLength)
+{
+    return (blake2bp_final((blake2bp_state *)ctx,
+                           digest,
+                           (uint8_t)digestLength) == 0 ? 0 : -1);
+}
+
+static void blake2sp_engine_init(void *ctx, size_t digestLength)
+{
+    blake2sp_init((blake2sp_state *)ctx, (uint8_t)digestLength);
+}
+
+static void blake2sp_engine_update(void *ctx,
+                                   const unsigned char *data,
+                                   size_t length)
+{
+    blake2sp_update((blake2sp_state *)ctx, data, (uint64_t)length);
+}
+
+static int blake2sp_engine_final(void *ctx,
+                                 unsigned char *digest,
+                                 size_t digestLength)
+{
+    return (blake2sp_final((blake2sp_state *)ctx,
+                           digest,
+                           (uint8_t)digestLength) == 0 ? 0 : -1);
+}
+
+/* BLAKE3 */
+
+static void blake3_engine_init(void *ctx, size_t digestLength)
+{
+    (void)digestLength;
+    blake3_hasher_init((blake3_hasher *)ctx);
+}
+
+static void blake3_engine_update(void *ctx,
+                                 const unsigned char *data,
+                                 size_t length)
+{
+    // large updates are split across the BLAKE3 thread pool
+
+#if defined(BLAKE3_USE_PTHREADS)
+    blake3_hasher_update_pthreads((blake3_hasher *)ctx, data, length);
+#else
+    blake3_hasher_update((blake3_hasher *)ctx, data, length);
+#endif
+}
+
+static int blake3_engine_final(void *ctx,
+                               unsigned char *digest,
+                               size_t digestLength)
+{
+    blake3_hasher_finalize((blake3_hasher *)ctx, digest, digestLength);
+    return 0;
+}
+
+/* the hasher isn't changed by finalizing, so the output is produced
+   by seeking to offset, and large outputs use the thread pool */
+
+static int blake3_engine_squeeze(void *ctx,
+                                 unsigned long long offset,
+                                 unsigned char *out,
+                                 size_t length)
+{
+#if defined(BLAKE3_USE_PTHREADS)
+    blake3_hasher_finalize_seek_pthreads((const blake3_hasher *)ctx,
+                                         offset,
+                                         out,
+                                         length);
+#else
+    blake3_hasher_finalize_seek((const blake3_hasher *)ctx,
+                                offset,
+                                out,
+                                length);
+#endif
+    return 0;
+}
+
+/* the BLAKE3 dispatcher applies the SIMD level itself */
+
+static void blake3_engine_many(const unsigned char *const *inputs,
+                               const size_t *lengths,
+                               size_t count,
+                               unsigned char *digests,
+                               size_t digestLength)
+{
+    (void)digestLength;
+    blake3_hash_batch(inputs, lengths, count, digests);
+}
+
+/* Skein - the state size is fixed by the context type, the output
+   size is set by the digest length */
+
+#define SKEIN_ENGINE(name, ctxType, prefix) \
+static void name##_engine_init(void *ctx, size_t digestLength) \
+{ \
+    prefix##_Init((ctxType *)ctx, digestLength*8); \
+} \
+static void name##_engine_update(void *ctx, \
+                                 const unsigned char *data, \
+                                 size_t length) \
+{ \
+    prefix##_Update((ctxType *)ctx, data, length); \
+} \
+static int name##_engine_final(void *ctx, \
+                               unsigned char *digest, \
+                               size_t digestLength) \
+{ \
+    (void)digestLength; \
+    return (prefix##_Final((ctxType *)ctx, digest) == SKEIN_SUCCESS ? \
+            0 : -1); \
+}
+
+SKEIN_ENGINE(skein256, Skein_256_Ctxt_t, Skein_256)
+SKEIN_ENGINE(skein512, Skein_512_Ctxt_t, Skein_512)
+SKEIN_ENGINE(skein1024, Skein1024_Ctxt_t, Skein1024)
+
+/* Skein tree hashing, with 64KB leaves for every state size */
+
+static void skein_tree_engine_start(void *ctx,
+                                    size_t stateBits,
+                                    size_t digestLength)
+{
+    unsigned int leafLevel = 0;
+
+    while (((size_t)(stateBits / 8) << (leafLevel + 1)) <=
+           SKEIN_TREE_DEFAULT_LEAF_BYTES) {
+        leafLevel++;
+    }
+    skein_tree_init((skein_tree_state *)ctx,
+                    stateBits,
+                    digestLength*8,
+                    leafLevel,
+                    SKEIN_TREE_DEFAULT_FANOUT,
+                    SKEIN_TREE_DEFAULT_MAX_LEVEL);
+}
+
+static void skein256tree_engine_init(void *ctx, size_t digestLength)
+{
+    skein_tree_engine_start(ctx, 256, digestLength);
+}
+
+static void skein512tree_engine_init(void *ctx, size_t digestLength)
+{
+    skein_tree_engine_start(ctx, 512, digestLength);
+}
+
+static void skein1024tree_engine_init(void *ctx, size_t digestLength)
+{
+    skein_tree_engine_start(ctx, 1024, digestLength);
+}
+
+static void skeintree_engine_update(void *ctx,
+                                    const unsigned char *data,
+                                    size_t length)
+{
+    skein_tree_update((skein_tree_state *)ctx, data, length);
+}
+
+static int skeintree_engine_final(void *ctx,
+                                  unsigned char *digest,
+                                  size_t digestLength)
+{
+    (void)digestLength;
+    return (skein_tree_final((skein_tree_state *)ctx, digest) ==
+            SKEIN_SUCCESS ? 0 : -1);
+}
+
+/* JH - lengths are in bits */
+
+static void jh_engine_init(void *ctx, size_t digestLength)
+{
+    JH_Init((JH_HashState *)ctx, (int)(digestLength*8));
+}
+
+static void jh_engine_update(void *ctx,
+                             const unsigned char *data,
+                             size_t length)
+{
+    FOR_EACH_CHUNK(data, length, chunk) {
+        JH_Update((JH_HashState *)ctx,
+                  (const JH_BitSequence *)data,
+                  (JH_DataLength)chunk*8);
+    }
+}
+
+static int jh_engine_final(void *ctx,
+                           unsigned char *digest,
+                           size_t digestLength)
+{
+    (void)digestLength;
+    return (JH_Final((JH_HashState *)ctx,
+                     (JH_BitSequence *)digest) == JH_SUCCESS ? 0 : -1);
+}
+
+/* Tiger, Tiger2 */
+
+static void tiger_engine_init(void *ctx, size_t digestLength)
+{
+    (void)digestLength;
+    rhash_tiger_init((tiger_ctx *)ctx);
+}
+
+static void tiger2_engine_init(void *ctx, size_t digestLength)
+{
+    (void)digestLength;
+    rhash_tiger2_init((tiger_ctx *)ctx);
+}
+
+static void tiger_engine_update(void *ctx,
+                                const unsigned char *data,
+                                size_t length)
+{
+    rhash_tiger_update((tiger_ctx *)ctx, data, length);
+}
+
+static int tiger_engine_final(void *ctx,
+                              unsigned char *digest,
+                              size_t digestLength)
+{
+    (void)digestLength;
+    rhash_tiger_final((tiger_ctx *)ctx, digest);
+    return 0;
+}
+
+/* HAS-160 */
+
+static void has160_engine_init(void *ctx, size_t digestLength)
+{
+    (void)digestLength;
+    rhash_has160_init((has160_ctx *)ctx);
+}
+
+static void has160_engine_update(void *ctx,
+                                 const unsigned char *data,
+                                 size_t length)
+{
+    rhash_has160_update((has160_ctx *)ctx, data, length);
+}
+
+static int has160_engine_final(void *ctx,
+                               unsigned char *digest,
+                               size_t digestLength)
+{
+    (void)digestLength;
+    rhash_has160_final((has160_ctx *)ctx, digest);
+    return 0;
+}
+
+/* BLAKE (SHA3 finalist) */
+
+#define BLAKE_ENGINE(bits) \
+static void blake##bits##_engine_init(void *ctx, size_t digestLength) \
+{ \
+    (void)digestLength; \
+    blake##bits##_init((state##bits *)ctx); \
+} \
+static void blake##bits##_engine_update(void *ctx, \
+                                        const unsigned char *data, \
+                                        size_t length) \
+{ \
+    blake##bits##_update((state##bits *)ctx, data, (uint64_t)length); \
+} \
+static int blake##bits##_engine_final(void *ctx, \
+                                      unsigned char *digest, \
+                                      size_t digestLength) \
+{ \
+    (void)digestLength; \
+    blake##bits##_final((state##bits *)ctx, digest); \
+    return 0; \
+}
+
+BLAKE_ENGINE(224)
+BLAKE_ENGINE(256)
+BLAKE_ENGINE(384)
+BLAKE_ENGINE(512)
+
+/* Groestl - lengths are in bits */
+
+static void groestl_engine_init(void *ctx, size_t digestLength)
+{
+    groestl_Init((groestl_HashState *)ctx, (int)(digestLength*8));
+}
+
+static void groestl_engine_update(void *ctx,
+                                  const unsigned char *data,
+                                  size_t length)
+{
+    FOR_EACH_CHUNK(data, length, chunk) {
+        groestl_Update((groestl_HashState *)ctx,
+                       (const groestl_BitSequence *)data,
+                       (groestl_DataLength)chunk*8);
+    }
+}
+
+static int groestl_engine_final(void *ctx,
+                                unsigned char *digest,
+                                size_t digestLength)
+{
+    (void)digestLength;
+    return (groestl_Final((groestl_HashState *)ctx,
+                          (groestl_BitSequence *)digest) ==
+            groestl_SUCCESS ? 0 : -1);
+}
+
+/*
+    the chaining value and the buffer are allocated by groestl_Init (both
+    are size bytes long), so they are serialized after the context, with
+    the pointers cleared
+ */
+
+static size_t groestl_engine_serialize(const void *ctx, unsigned char *state)
+{
+    const groestl_HashState *hs = ctx;
+    groestl_HashState copy;
+    size_t size = (size_t)hs->size;
+
+    if (state != NULL) {
+        copy = *hs;
+        copy.chaining = NULL;
+        copy.buffer = NULL;
+        memcpy(state, &copy, sizeof(copy));
+        memcpy(state + sizeof(copy), hs->chaining, size);
+        memcpy(state + sizeof(copy) + size, hs->buffer, size);
+    }
+
+    return sizeof(groestl_HashState) + 2*size;
+}
+
+static int groestl_engine_deserialize(void *ctx,
+                                      const unsigned char *state,
+                                      size_t length)
+{
+    groestl_HashState *hs = ctx;
+    groestl_HashState copy;
+    size_t size = (size_t)hs->size;
+
+    if (length != sizeof(copy) + 2*size) {
+        return -1;
+    }
+
+    memcpy(&copy, state, sizeof(copy));
+    if (copy.size != hs->size || copy.hashbitlen != hs->hashbitlen ||
+        copy.buf_ptr < 0 || (size_t)copy.buf_ptr > size) {
+        return -1;
+    }
+
+    copy.chaining = hs->chaining;
+    copy.buffer = hs->buffer;
+    *hs = copy;
+    memcpy(hs->chaining, state + sizeof(copy), size);
+    memcpy(hs->buffer, state + sizeof(copy) + size, size);
+
+    return 0;
+}
+
+/* Snefru */
+
+static void snefru128_engine_init(void *ctx, size_t digestLength)
+{
+    (void)digestLength;
+    rhash_snefru128_init((snefru_ctx *)ctx);
+}
+
+static void snefru256_engine_init(void *ctx, size_t digestLength)
+{
+    (void)digestLength;
+    rhash_snefru256_init((snefru_ctx *)ctx);
+}
+
+static void snefru_engine_update(void *ctx,
+                                 const unsigned char *data,
+                                 size_t length)
+{
+    rhash_snefru_update((snefru_ctx *)ctx, data, length);
+}
+
+static int snefru_engine_final(void *ctx,
+                               unsigned char *digest,
+                               size_t digestLength)
+{
+    (void)digestLength;
+    rhash_snefru_final((snefru_ctx *)ctx, digest);
+    return 0;
+}
+
+/* LSH - lengths are in bits */
+
+static void lsh_engine_init(void *ctx, size_t digestLength)
+{
+    lsh_type type;
+
+    switch (digestLength) {
+        case 28:
+            type = LSH_TYPE_224;
+            break;
+        case 32:
+            type = LSH_TYPE_256;
+            break;
+        case 48:
+            type = LSH_TYPE_384;
+            break;
+        default:
+            type = LSH_TYPE_512;
+            break;
+    }
+
+    lsh_init((union LSH_Context *)ctx, type);
+}
+
+static void lsh_engine_update(void *ctx,
+                              const unsigned char *data,
+                              size_t length)
+{
+    FOR_EACH_CHUNK(data, length, chunk) {
+        lsh_update((union LSH_Context *)ctx,
+                   (const lsh_u8 *)data,
+                   chunk*8);
+    }
+}
+
+static int lsh_engine_final(void *ctx,
+                            unsigned char *digest,
+                            size_t digestLength)
+{
+    (void)digestLength;
+    return (lsh_final((union LSH_Context *)ctx, digest) == LSH_SUCCESS ?
+            0 : -1);
+}
+
+/* KangarooTwelve */
+
+static void k12_engine_init(void *ctx, size_t digestLength)
+{
+    (void)digestLength;
+    KangarooTwelve_Initialize((KangarooTwelve_Instance *)ctx, 0);
+}
+
+static void k12_engine_update(void *ctx,
+                              const unsigned char *data,
+                              size_t length)
+{
+    KangarooTwelve_Update((KangarooTwelve_Instance *)ctx, data, length);
+}
+
+static int k12_engine_final(void *ctx,
+                            unsigned char *digest,
+                            size_t digestLength)
+{
+    if (KangarooTwelve_Final((KangarooTwelve_Instance *)ctx,
+                             0,
+                             (const unsigned char *)"",
+                             0) != 0) {
+        return -1;
+    }
+    return (KangarooTwelve_Squeeze((KangarooTwelve_Instance *)ctx,
+                                   digest,
+                                   digestLength) == 0 ? 0 : -1);
+}
+
+static int k12_engine_squeeze(void *ctx,
+                              unsigned long long offset,
+                              unsigned char *out,
+                              size_t length)
+{
+    if (offset == 0 &&
+        KangarooTwelve_Final((KangarooTwelve_Instance *)ctx,
+                             0,
+                             (const unsigned char *)"",
+                             0) != 0) {
+        return -1;
+    }
+    return (KangarooTwelve_Squeeze((KangarooTwelve_Instance *)ctx,
+                                   out,
+                                   length) == 0 ? 0 : -1);
+}
+
+/* descriptor table, indexed by HashType */
+
+#define DESC(hashType, hashName, ctxType, length, flags, prefix, initFn) \
+    [hashType] = { hashType, hashName, sizeof(ctxType), length, flags, \
+                   initFn, prefix##_engine_update, prefix##_engine_final }
+
+#define DESC_SIMPLE(hashType, hashName, ctxType, length, flags, prefix) \
+    DESC(hashType, hashName, ctxType, length, flags, prefix, \
+         prefix##_engine_init)
+
+#define DESC_MANY(hashType, hashName, ctxType, length, flags, prefix) \
+    [hashType] = { hashType, hashName, sizeof(ctxType), length, flags, \
+                   prefix##_engine_init, prefix##_engine_update, \
+                   prefix##_engine_final, prefix##_engine_many }
+
+#define DESC_MB(hashType, hashName, ctxType, length, flags, prefix) \
+    [hashType] = { hashType, hashName, sizeof(ctxType), length, flags, \
+                   prefix##_engine_init, prefix##_engine_update, \
+                   prefix##_engine_final, prefix##_engine_many, \
+                   prefix##_engine_update_many }
+
+#define DESC_SERIAL(hashType, hashName, ctxType, length, flags, prefix) \
+    [hashType] = { hashType, hashName, sizeof(ctxType), length, flags, \
+                   prefix##_engine_init, prefix##_engine_update, \
+                   prefix##_engine_final, NULL, NULL, \
+                   prefix##_engine_serialize, prefix##_engine_deserialize }
+
+#define DESC_XOF(hashType, hashName, ctxType, length, flags, prefix, \
+                 initFn, manyFn) \
+    [hashType] = { hashType, hashName, sizeof(ctxType), length, flags, \
+                   initFn, prefix##_engine_update, prefix##_engine_final, \
+                   manyFn, NULL, NULL, NULL, prefix##_engine_squeeze }
+
+static const hashEngineDescriptor gDescriptors[HASH_TYPE_COUNT] = {
+    DESC_SIMPLE(HASH_CRC32, "crc32", crcContext, 4,
+                HASH_ENGINE_FLAG_CHECKSUM | HASH_ENGINE_FLAG_SIMD, crc32),
+    DESC_SIMPLE(HASH_CKSUM, "cksum", cksumEngineContext, 4,
+                HASH_ENGINE_FLAG_CHECKSUM | HASH_ENGINE_FLAG_SIMD, cksum),
+    DESC_MB(HASH_MD5, "md5", md5_ctx, 16, HASH_ENGINE_FLAG_SIMD, md5),
+    DESC_MB(HASH_SHA1, "sha1", sha1_ctx, 20, HASH_ENGINE_FLAG_SIMD, sha1),
+    DESC_MB(HASH_SHA224, "sha224", sha256_ctx, 28,
+            HASH_ENGINE_FLAG_SIMD, sha224),
+    DESC_MB(HASH_SHA256, "sha256", sha256_ctx, 32,
+            HASH_ENGINE_FLAG_SIMD, sha256),
+    DESC_SIMPLE(HASH_SHA384, "sha384", sha512_ctx, 48,
+                HASH_ENGINE_FLAG_SIMD, sha384),
+    DESC_SIMPLE(HASH_SHA512, "sha512", sha512_ctx, 64,
+                HASH_ENGINE_FLAG_SIMD, sha512),
+    DESC_SERIAL(HASH_SHA1DC, "sha1dc", SHA1_CTX, 20,
+                HASH_ENGINE_FLAG_COLLISION, sha1dc),
+    DESC_SIMPLE(HASH_MD6_256, "md6-256", md6_state, 32,
+                HASH_ENGINE_FLAG_SIMD, md6),
+    DESC_SIMPLE(HASH_MD6_512, "md6-512", md6_state, 64,
+                HASH_ENGINE_FLAG_SIMD, md6),
+    DESC_MANY(HASH_SHA3_224, "sha3-224", keccak_state, 28,
+              HASH_ENGINE_FLAG_SIMD, sha3),
+    DESC_MANY(HASH_SHA3_256, "sha3-256", keccak_state, 32,
+              HASH_ENGINE_FLAG_SIMD, sha3),
+    DESC_MANY(HASH_SHA3_384, "sha3-384", keccak_state, 48,
+              HASH_ENGINE_FLAG_SIMD, sha3),
+    DESC_MANY(HASH_SHA3_512, "sha3-512", keccak_state, 64,
+              HASH_ENGINE_FLAG_SIMD, sha3),
+    DESC_XOF(HASH_SHAKE128, "shake128", keccak_state, 32,
+             HASH_ENGINE_FLAG_XOF | HASH_ENGINE_FLAG_SIMD, shake,
+             shake128_engine_init, NULL),
+    DESC_XOF(HASH_SHAKE256, "shake256", keccak_state, 64,
+             HASH_ENGINE_FLAG_XOF | HASH_ENGINE_FLAG_SIMD, shake,
+             shake256_engine_init, NULL),
+    DESC_SIMPLE(HASH_RMD160, "rmd160", RMD160_CTX, 20, 0, rmd160),
+    DESC_SIMPLE(HASH_RMD320, "rmd320", rmd320_ctx, 40, 0, rmd320),
+    DESC_SIMPLE(HASH_WPOOL, "whirlpool", struct NESSIEstruct, 64, 0, wpool),
+    DESC_MANY(HASH_BLAKE2B_256, "blake2b-256", blake2b_state, 32,
+              HASH_ENGINE_FLAG_SIMD, blake2b),
+    DESC_MANY(HASH_BLAKE2B_512, "blake2b-512", blake2b_state, 64,
+              HASH_ENGINE_FLAG_SIMD, blake2b),
+    DESC_MANY(HASH_BLAKE2S_256, "blake2s-256", blake2s_state, 32,
+              HASH_ENGINE_FLAG_SIMD, blake2s),
+    DESC_SIMPLE(HASH_BLAKE2SP_256, "blake2sp-256", blake2sp_state, 32,
+                HASH_ENGINE_FLAG_SIMD, blake2sp),
+    DESC_SIMPLE(HASH_BLAKE2BP_256, "blake2bp-256", blake2bp_state, 32,
+                HASH_ENGINE_FLAG_SIMD, blake2bp),
+    DESC_SIMPLE(HASH_BLAKE2BP_512, "blake2bp-512", blake2bp_state, 64,
+                HASH_ENGINE_FLAG_SIMD, blake2bp),
+    DESC_XOF(HASH_BLAKE3, "blake3", blake3_hasher, 32,
+             HASH_ENGINE_FLAG_XOF | HASH_ENGINE_FLAG_SIMD, blake3,
+             blake3_engine_init, blake3_engine_many),
+    DESC_SIMPLE(HASH_SKEIN_256, "skein-256", Skein_256_Ctxt_t, 32, 0,
+                skein256),
+    DESC_SIMPLE(HASH_SKEIN_512_256, "skein-512-256", Skein_512_Ctxt_t, 32, 0,
+                skein512),
+    DESC_SIMPLE(HASH_SKEIN_512, "skein-512", Skein_512_Ctxt_t, 64, 0,
+                skein512),
+    DESC_SIMPLE(HASH_SKEIN_1024_256, "skein-1024-256", Skein1024_Ctxt_t, 32, 0,
+                skein1024),
+    DESC_SIMPLE(HASH_SKEIN_1024_512, "skein-1024-512", Skein1024_Ctxt_t, 64, 0,
+                skein1024),
+    DESC_SIMPLE(HASH_SKEIN_1024, "skein-1024", Skein1024_Ctxt_t, 128, 0,
+                skein1024),
+    DESC_SIMPLE(HASH_JH_224, "jh-224", JH_HashState, 28, 0, jh),
+    DESC_SIMPLE(HASH_JH_256, "jh-256", JH_HashState, 32, 0, jh),
+    DESC_SIMPLE(HASH_JH_384, "jh-384", JH_HashState, 48, 0, jh),
+    DESC_SIMPLE(HASH_JH_512, "jh-512", JH_HashState, 64, 0, jh),
+    DESC_SIMPLE(HASH_TIGER, "tiger", tiger_ctx, tiger_hash_length, 0, tiger),
+    DESC(HASH_TIGER2, "tiger2", tiger_ctx, tiger_hash_length, 0, tiger,
+         tiger2_engine_init),
+    DESC_SIMPLE(HASH_HAS160, "has160", has160_ctx, has160_hash_size, 0,
+                has160),
+    DESC_SIMPLE(HASH_BLAKE224, "blake-224", state224, 28, 0, blake224),
+    DESC_SIMPLE(HASH_BLAKE256, "blake-256", state256, 32, 0, blake256),
+    DESC_SIMPLE(HASH_BLAKE384, "blake-384", state384, 48, 0, blake384),
+    DESC_SIMPLE(HASH_BLAKE512, "blake-512", state512, 64, 0, blake512),
+    DESC_SERIAL(HASH_GROESTL224, "groestl-224", groestl_HashState, 28,
+                HASH_ENGINE_FLAG_SIMD,
+                groestl),
+    DESC_SERIAL(HASH_GROESTL256, "groestl-256", groestl_HashState, 32,
+                HASH_ENGINE_FLAG_SIMD,
+                groestl),
+    DESC_SERIAL(HASH_GROESTL384, "groestl-384", groestl_HashState, 48,
+                HASH_ENGINE_FLAG_SIMD,
+                groestl),
+    DESC_SERIAL(HASH_GROESTL512, "groestl-512", groestl_HashState, 64,
+                HASH_ENGINE_FLAG_SIMD,
+                groestl),
+    DESC(HASH_SNEFRU128, "snefru-128", snefru_ctx, snefru128_hash_length, 0,
+         snefru, snefru128_engine_init),
+    DESC(HASH_SNEFRU256, "snefru-256", snefru_ctx, snefru256_hash_length, 0,
+         snefru, snefru256_engine_init),
+    DESC_SIMPLE(HASH_LSH224, "lsh-224", union LSH_Context, 28, 0, lsh),
+    DESC_SIMPLE(HASH_LSH256, "lsh-256", union LSH_Context, 32, 0, lsh),
+    DESC_SIMPLE(HASH_LSH384, "lsh-384", union LSH_Context, 48, 0, lsh),
+    DESC_SIMPLE(HASH_LSH512, "lsh-512", union LSH_Context, 64, 0, lsh),
+    DESC_XOF(HASH_K12_256, "k12-256", KangarooTwelve_Instance, 32,
+             HASH_ENGINE_FLAG_XOF | HASH_ENGINE_FLAG_SIMD, k12,
+             k12_engine_init, NULL),
+    DESC_XOF(HASH_K12_384, "k12-384", KangarooTwelve_Instance, 48,
+             HASH_ENGINE_FLAG_XOF | HASH_ENGINE_FLAG_SIMD, k12,
+             k12_engine_init, NULL),
+    DESC_XOF(HASH_K12_512, "k12-512", KangarooTwelve_Instance, 64,
+             HASH_ENGINE_FLAG_XOF | HASH_ENGINE_FLAG_SIMD, k12,
+             k12_engine_init, NULL),
+    DESC(HASH_SKEIN_256_TREE, "skein-256-tree", skein_tree_state, 32,
+         HASH_ENGINE_FLAG_SIMD, skeintree, skein256tree_engine_init),
+    DESC(HASH_SKEIN_512_TREE, "skein-512-tree", skein_tree_state, 64,
+         HASH_ENGINE_FLAG_SIMD, skeintree, skein512tree_engine_init),
+    DESC(HASH_SKEIN_1024_TREE, "skein-1024-tree", skein_tree_state, 128,
+         HASH_ENGINE_FLAG_SIMD, skeintree, skein1024tree_engine_init),
+};
+
+/*
+    hash_engine_descriptor - return the descriptor for the specified hash
+                             type, or NULL if it is not supported
+ */
+
+const hashEngineDescriptor *hash_engine_descriptor(HashType type)
+{
+    if (type <= HASH_NONE || type >= HASH_TYPE_COUNT) {
+        return NULL;
+    }
+
+    if (gDescriptors[type].init == NULL) {
+        return NULL;
+    }
+
+    return &gDescriptors[type];
+}
+
+/*
+    hash_engine_descriptor_by_name - return the descriptor whose name
+                                     matches (ignoring case), or NULL
+ */
+
+const hashEngineDescriptor *hash_engine_descriptor_by_name(const char *name)
+{
+    size_t i = 0;
+    const hashEngineDescriptor *desc = NULL;
+
+    if (name == NULL) {
+        return NULL;
+    }
+
+    while ((desc = hash_engine_descriptor_at(i++)) != NULL) {
+        if (strcasecmp(desc->name, name) == 0) {
+            return desc;
+        }
+    }
+
+    return NULL;
+}
+
+/*
+    hash_engine_descriptor_at - return the n-th supported descriptor
+ */
+
+const hashEngineDescriptor *hash_engine_descriptor_at(size_t n)
+{
+    int type = 0;
+
+    for (type = HASH_NONE + 1; type < HASH_TYPE_COUNT; type++) {
+        if (gDescriptors[type].init == NULL) {
+            continue;
+        }
+        if (n == 0) {
+            return &gDescriptors[type];
+        }
+        n--;
+    }
+
+    return NULL;
+}
+
+/*
+    hash_engine_alloc_state - allocate aligned, zeroed storage for a
+                              descriptor's context
+ */
+
+void *hash_engine_alloc_state(const hashEngineDescriptor *desc)
+{
+    void *state = NULL;
+
+    if (desc == NULL) {
+        return NULL;
+    }
+
+    if (posix_memalign(&state,
+                       HASH_ENGINE_CONTEXT_ALIGNMENT,
+                       desc->contextSize) != 0) {
+        return NULL;
+    }
+
+    memset(state, 0, desc->contextSize);
+    return state;
+}
+
+void hash_engine_free_state(void *state)
+{
+    free(state);
+}
+
+/*
+    hash_engine_new - allocate and initialize a context for a hash type
+ */
+
+hashEngineContext *hash_engine_new(HashType type)
+{
+    const hashEngineDescriptor *desc = NULL;
+    hashEngineContext *ctx = NULL;
+
+    desc = hash_engine_descriptor(type);
+    if (desc == NULL) {
+        return NULL;
+    }
+
+    ctx = calloc(1, sizeof(hashEngineContext));
+    if (ctx == NULL) {
+        return NULL;
+    }
+
+    ctx->desc = desc;
+    ctx->state = hash_engine_alloc_state(desc);
+    if (ctx->state == NULL) {
+        free(ctx);
+        return NULL;
+    }
+
+    hash_engine_reset(ctx);
+    return ctx;
+}
+
+/*
+    hash_engine_reset - reinitialize a context so that it can be reused
+ */
+
+void hash_engine_reset(hashEngineContext *ctx)
+{
+    if (ctx == NULL) {
+        return;
+    }
+
+    ctx->length = 0;
+    ctx->squeezed = 0;
+    ctx->squeezing = 0;
+    ctx->desc->init(ctx->state, ctx->desc->digestLength);
+}
+
+void hash_engine_update(hashEngineContext *ctx,
+                        const void *data,
+                        size_t length)
+{
+    if (ctx == NULL || data == NULL || length == 0 || ctx->squeezing) {
+        return;
+    }
+
+    ctx->length += length;
+    ctx->desc->update(ctx->state, data, length);
+}
+
+/*
+    hash_engine_final - write the digest (digestLength bytes) for the
+                        context
+ */
+
+int hash_engine_final(hashEngineContext *ctx, unsigned char *digest)
+{
+    if (ctx == NULL || digest == NULL || ctx->squeezing) {
+        return -1;
+    }
+
+    return ctx->desc->final(ctx->state, digest, ctx->desc->digestLength);
+}
+
+/*
+    hash_engine_squeeze - write the next length bytes of an XOF's output
+ */
+
+int hash_engine_squeeze(hashEngineContext *ctx,
+                        unsigned char *out,
+                        size_t length)
+{
+    if (ctx == NULL || ctx->desc->squeeze == NULL ||
+        (out == NULL && length > 0)) {
+        return -1;
+    }
+
+    if (length == 0) {
+        return 0;
+    }
+
+    if (ctx->desc->squeeze(ctx->state, ctx->squeezed, out, length) != 0) {
+        return -1;
+    }
+
+    ctx->squeezing = 1;
+    ctx->squeezed += length;
+    return 0;
+}
+
+void hash_engine_free(hashEngineContext *ctx)
+{
+    if (ctx == NULL) {
+        return;
+    }
+
+    hash_engine_free_state(ctx->state);
+    free(ctx);
+}
+
+/*
+    Serialized contexts - a header followed by the context's state.  The
+    checksum is the CRC32 of the header (with the checksum set to 0) and
+    the state.  abi identifies the pointer size and byte order, since the
+    state is the context's in-memory layout.
+ */
+
+typedef struct hashEngineSerialHeader {
+    char     magic[4];
+    uint32_t version;
+    uint32_t type;
+    uint32_t abi;
+    uint64_t contextSize;
+    uint64_t length;
+    uint64_t stateLength;
+    uint32_t checksum;
+    uint32_t reserved;
+} hashEngineSerialHeader;
+
+static uint32_t serialAbi(void)
+{
+    const uint16_t order = 0x0102;
+
+    return (uint32_t)sizeof(void *) |
+           ((uint32_t)*(const unsigned char *)&order << 8);
+}
+
+static uint32_t serialChecksum(const hashEngineSerialHeader *header,
+                               const unsigned char *state)
+{
+    hashEngineSerialHeader copy = *header;
+    crcContext crc;
+
+    copy.checksum = 0;
+    crc32_init(&crc);
+    crc32_update(&crc, &copy, sizeof(copy));
+    crc32_update(&crc, state, (size_t)header->stateLength);
+    (void)crc32_finalize(&crc);
+
+    return crc.crc;
+}
+
+static size_t stateLength(const hashEngineContext *ctx)
+{
+    if (ctx->desc->serialize != NULL) {
+        return ctx->desc->serialize(ctx->state, NULL);
+    }
+    return ctx->desc->contextSize;
+}
+
+size_t hash_engine_serialized_size(const hashEngineContext *ctx)
+{
+    if (ctx == NULL) {
+        return 0;
+    }
+
+    return sizeof(hashEngineSerialHeader) + stateLength(ctx);
+}
+
+size_t hash_engine_serialize(const hashEngineContext *ctx,
+                             unsigned char *buffer,
+                             size_t size)
+{
+    hashEngineSerialHeader header;
+    unsigned char *state = NULL;
+
+    if (ctx == NULL || buffer == NULL || ctx->squeezing ||
+        size < hash_engine_serialized_size(ctx)) {
+        return 0;
+    }
+
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, "HCTX", 4);
+    header.version = HASH_ENGINE_SERIAL_VERSION;
+    header.type = (uint32_t)ctx->desc->type;
+    header.abi = serialAbi();
+    header.contextSize = ctx->desc->contextSize;
+    header.length = ctx->length;
+    header.stateLength = stateLength(ctx);
+
+    state = buffer + sizeof(header);
+    if (ctx->desc->serialize != NULL) {
+        (void)ctx->desc->serialize(ctx->state, state);
+    } else {
+        memcpy(state, ctx->state, ctx->desc->contextSize);
+    }
+
+    header.checksum = serialChecksum(&header, state);
+    memcpy(buffer, &header, sizeof(header));
+
+    return sizeof(header) + (size_t)header.stateLength;
+}
+
+int hash_engine_deserialize(hashEngineContext *ctx,
+                            const unsigned char *buffer,
+                            size_t size)
+{
+    hashEngineSerialHeader header;
+    const unsigned char *state = NULL;
+
+    if (ctx == NULL || buffer == NULL || size < sizeof(header)) {
+        return -1;
+    }
+
+    memcpy(&header, buffer, sizeof(header));
+    state = buffer + sizeof(header);
+
+    if (memcmp(header.magic, "HCTX", 4) != 0 ||
+        header.version != HASH_ENGINE_SERIAL_VERSION ||
+        header.type != (uint32_t)ctx->desc->type ||
+        header.abi != serialAbi() ||
+        header.contextSize != ctx->desc->contextSize ||
+        header.stateLength > size - sizeof(header) ||
+        header.checksum != serialChecksum(&header, state)) {
+        return -1;
+    }
+
+    if (ctx->desc->deserialize != NULL) {
+        if (ctx->desc->deserialize(ctx->state,
+                                   state,
+                                   (size_t)header.stateLength) != 0) {
+            return -1;
+        }
+    } else {
+        if (header.stateLength != ctx->desc->contextSize) {
+            return -1;
+        }
+        memcpy(ctx->state, state, ctx->desc->contextSize);
+    }
+
+    ctx->length = header.length;
+    return 0;
+}
+
+/* SIMD levels */
+
+static const char *gSimdNames[HASH_ENGINE_SIMD_LEVEL_COUNT] = {
+    [HASH_ENGINE_SIMD_PORTABLE] = "portable",
+    [HASH_ENGINE_SIMD_SSE2]     = "sse2",
+    [HASH_ENGINE_SIMD_SSSE3]    = "ssse3",
+    [HASH_ENGINE_SIMD_SSE41]    = "sse4.1",
+    [HASH_ENGINE_SIMD_AVX2]     = "avx2",
+    [HASH_ENGINE_SIMD_AVX512]   = "avx512",
+};
+
+/* the level in use, HASH_ENGINE_SIMD_LEVEL_COUNT until one is set */
+
+static hashEngineSimdLevel gSimdLevel = HASH_ENGINE_SIMD_LEVEL_COUNT;
+
+/*
+    hash_engine_simd_detected - return the highest SIMD level that this
+                                cpu (and OS) supports
+ */
+
+hashEngineSimdLevel hash_engine_simd_detected(void)
+{
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("avx512f") &&
+        __builtin_cpu_supports("avx512vl")) {
+        return HASH_ENGINE_SIMD_AVX512;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return HASH_ENGINE_SIMD_AVX2;
+    }
+    if (__builtin_cpu_supports("sse4.1")) {
+        return HASH_ENGINE_SIMD_SSE41;
+    }
+    if (__builtin_cpu_supports("ssse3")) {
+        return HASH_ENGINE_SIMD_SSSE3;
+    }
+    return HASH_ENGINE_SIMD_SSE2;
+#else
+    return HASH_ENGINE_SIMD_PORTABLE;
+#endif
+}
+
+hashEngineSimdLevel hash_engine_simd_level(void)
+{
+    if (gSimdLevel == HASH_ENGINE_SIMD_LEVEL_COUNT) {
+        return hash_engine_simd_detected();
+    }
+    return gSimdLevel;
+}
+
+/*
+    hash_engine_set_simd_level - limit the SIMD implementations used by
+                                 BLAKE2, BLAKE3, CRC32, cksum, Groestl,
+                                 K12, MD6, SHA1, SHA2, SHA3, SHAKE and
+                                 Skein
+ */
+
+hashEngineSimdLevel hash_engine_set_simd_level(hashEngineSimdLevel level)
+{
+    hashEngineSimdLevel detected = hash_engine_simd_detected();
+    blake3_simd_limit blake3Limit = BLAKE3_SIMD_ALL;
+
+    if (level > detected) {
+        level = detected;
+    }
+
+    // BLAKE3 has no SSSE3 implementation
+
+    switch (level) {
+        case HASH_ENGINE_SIMD_PORTABLE:
+            blake3Limit = BLAKE3_SIMD_PORTABLE;
+            break;
+        case HASH_ENGINE_SIMD_SSE2:
+        case HASH_ENGINE_SIMD_SSSE3:
+            blake3Limit = BLAKE3_SIMD_SSE2;
+            break;
+        case HASH_ENGINE_SIMD_SSE41:
+            blake3Limit = BLAKE3_SIMD_SSE41;
+            break;
+        case HASH_ENGINE_SIMD_AVX2:
+            blake3Limit = BLAKE3_SIMD_AVX2;
+            break;
+        default:
+            blake3Limit = BLAKE3_SIMD_ALL;
+            break;
+    }
+    blake3_set_simd_limit(blake3Limit);
+
+    // K12's parallel implementations need at least SSSE3.  The single
+    // Keccak-p[1600] permutation, which SHA3 and SHAKE share with K12,
+    // uses AVX-512, or BMI1/BMI2 from the AVX2 level on
+
+#if defined(KeccakP1600_enable_simd_options)
+    KangarooTwelve_EnableAllCpuFeatures();
+    if (level < HASH_ENGINE_SIMD_AVX512) {
+        KangarooTwelve_DisableAVX512();
+    }
+    if (level < HASH_ENGINE_SIMD_AVX2) {
+        KangarooTwelve_DisableAVX2();
+    }
+    if (level < HASH_ENGINE_SIMD_SSSE3) {
+        KangarooTwelve_DisableSSSE3();
+    }
+#endif
+
+    // PCLMULQDQ folding uses SSSE3 to byte swap cksum's blocks
+
+    crc_use_pclmul(level >= HASH_ENGINE_SIMD_SSSE3);
+
+    // SHA-NI needs SSE4.1 to shuffle the state, the SHA512 message
+    // schedule is done with AVX2
+
+    sha1_use_shani(level >= HASH_ENGINE_SIMD_SSE41);
+    sha256_use_shani(level >= HASH_ENGINE_SIMD_SSE41);
+    sha512_use_avx2(level >= HASH_ENGINE_SIMD_AVX2);
+    hash_mb_set_simd_level(level);
+
+    // BLAKE2s only has an SSE4.1 compression function, the BLAKE2bp and
+    // BLAKE2sp leaves are compressed together with AVX2
+
+    blake2_use_sse41(level >= HASH_ENGINE_SIMD_SSE41);
+    blake2_use_avx2(level >= HASH_ENGINE_SIMD_AVX2);
+
+    // Skein trees hash their leaves in AVX2 or AVX-512 lanes
+
+    Skein_Use_AVX2(level >= HASH_ENGINE_SIMD_AVX2);
+    Skein_Use_AVX512(level >= HASH_ENGINE_SIMD_AVX512);
+
+    // MD6 runs the 16 steps of each round of its compression loop in
+    // parallel
+
+    md6_use_avx2(level >= HASH_ENGINE_SIMD_AVX2);
+    md6_use_avx512(level >= HASH_ENGINE_SIMD_AVX512);
+
+    // Groestl's rounds use AES-NI, with SSSE3 for ShiftBytes.  From the
+    // AVX2 level on, Groestl-384/512 run P and Q together with VAES
+
+    groestl_use_aesni(level >= HASH_ENGINE_SIMD_SSSE3);
+    groestl_use_vaes(level >= HASH_ENGINE_SIMD_AVX2);
+
+    gSimdLevel = level;
+    return level;
+}
+
+const char *hash_engine_simd_name(hashEngineSimdLevel level)
+{
+    if (level < HASH_ENGINE_SIMD_PORTABLE ||
+        level >= HASH_ENGINE_SIMD_LEVEL_COUNT) {
+        return NULL;
+    }
+    return gSimdNames[level];
+}
+
+int hash_engine_simd_by_name(const char *name)
+{
+    int level = 0;
+
+    if (name == NULL) {
+        return -1;
+    }
+
+    for (level = 0; level < HASH_ENGINE_SIMD_LEVEL_COUNT; level++) {
+        if (strcasecmp(gSimdNames[level], name) == 0) {
+            return level;
+        }
+    }
+
+    return -1;
+}
+
+/*
+    hash_engine_hash_many - hash a batch of independent messages
+ */
+
+int hash_engine_hash_many(HashType type,
+                          const unsigned char *const *inputs,
+                          const size_t *lengths,
+                          size_t count,
+                          unsigned char *digests)
+{
+    const hashEngineDescriptor *desc = NULL;
+    void *state = NULL;
+    size_t i = 0;
+    int rc = 0;
+    int err = 0;
+
+    desc = hash_engine_descriptor(type);
+    if (desc == NULL) {
+        return -1;
+    }
+
+    if (count == 0) {
+        return 0;
+    }
+
+    if (inputs == NULL || lengths == NULL || digests == NULL) {
+        return -1;
+    }
+
+    if (desc->many != NULL) {
+        desc->many(inputs, lengths, count, digests, desc->digestLength);
+        return 0;
+    }
+
+    // no batch implementation, avoid allocating a context per message
+
+    state = hash_engine_alloc_state(desc);
+    if (state == NULL) {
+        return -1;
+    }
+
+    for (i = 0; i < count; i++) {
+        desc->init(state, desc->digestLength);
+        if (lengths[i] > 0) {
+            desc->update(state, inputs[i], lengths[i]);
+        }
+        err = desc->final(state, digests + i*desc->digestLength,
+                          desc->digestLength);
+        if (err < 0) {
+            rc = -1;
+        } else if (err > 0 && rc == 0) {
+            rc = 1;
+        }
+    }
+
+    hash_engine_free_state(state);
+    return rc;
+}
+
+/*
+    hash_engine_update_many - update several contexts of the same type
+ */
+
+int hash_engine_update_many(hashEngineContext *const *ctxs,
+                            const unsigned char *const *data,
+                            const size_t *lengths,
+                            size_t count)
+{
+    void *states[HASH_MB_MAX_LANES*4];
+    const hashEngineDescriptor *desc = NULL;
+    size_t n = 0;
+    size_t i = 0;
+
+    if (count == 0) {
+        return 0;
+    }
+
+    if (ctxs == NULL || data == NULL || lengths == NULL || ctxs[0] == NULL) {
+        return -1;
+    }
+
+    desc = ctxs[0]->desc;
+    for (i = 0; i < count; i++) {
+        if (ctxs[i] == NULL || ctxs[i]->desc != desc) {
+            return -1;
+        }
+    }
+
+    for (i = 0; i < count; i++) {
+        ctxs[i]->length += lengths[i];
+    }
+
+    if (desc->updateMany == NULL || count == 1) {
+        for (i = 0; i < count; i++) {
+            if (lengths[i] > 0) {
+                desc->update(ctxs[i]->state, data[i], lengths[i]);
+            }
+        }
+        return 0;
+    }
+
+    for (; count > 0; ctxs += n, data += n, lengths += n, count -= n) {
+        n = (count < HASH_MB_MAX_LANES*4 ? count : HASH_MB_MAX_LANES*4);
+        for (i = 0; i < n; i++) {
+            states[i] = ctxs[i]->state;
+        }
+        desc->updateMany(states, data, lengths, n);
+    }
+
+    return 0;
+}
+
+size_t hash_engine_lanes(HashType type)
+{
+    const hashEngineDescriptor *desc = hash_engine_descriptor(type);
+
+    if (desc == NULL || desc->updateMany == NULL) {
+        return 1;
+    }
+    return hash_mb_lanes(type);
+}
+
+/*
+    hash_engine_string_length - length of the printable form of a digest,
+                                not including the terminating NUL
+ */
+
+size_t hash_engine_string_length(const hashEngineDescriptor *desc)
+{
+    if (desc == NULL) {
+        return 0;
+    }
+
+    /* a 32-bit checksum is at most 10 decimal digits */
+
+    if (desc->flags & HASH_ENGINE_FLAG_CHECKSUM) {
+        return 10;
+    }
+
+    return 2*desc->digestLength;
+}
+
+/*
+    hash_engine_digest_to_string - write the printable form of a digest,
+                                   returns the length of the string
+ */
+
+size_t hash_engine_digest_to_string(const hashEngineDescriptor *desc,
+                                    const unsigned char *digest,
+                                    int lowercase,
+                                    char *str)
+{
+    static const char upperHex[] = "0123456789ABCDEF";
+    static const char lowerHex[] = "0123456789abcdef";
+    const char *hex = (lowercase ? lowerHex : upperHex);
+    uint32_t checksum = 0;
+    size_t i = 0;
+
+    if (desc == NULL || digest == NULL || str == NULL) {
+        return 0;
+    }
+
+    if (desc->flags & HASH_ENGINE_FLAG_CHECKSUM) {
+        checksum = ((uint32_t)digest[0] << 24) |
+                   ((uint32_t)digest[1] << 16) |
+                   ((uint32_t)digest[2] << 8) |
+                   (uint32_t)digest[3];
+        return (size_t)snprintf(str, 11, "%u", checksum);
+    }
+
+    for (i = 0; i < desc->digestLength; i++) {
+        str[2*i] = hex[digest[i] >> 4];
+        str[2*i + 1] = hex[digest[i] & 0x0F];
+    }
+    str[2*desc->digestLength] = '\0';
+
+    return 2*desc->digestLength;
+}
@@ -0,0 +1,384 @@
+/*
+    Hash - hash_engine.h
+
+    Portable (non-Cocoa) hashing engine.  Each supported HashType is
+    described by a hashEngineDescriptor that provides the size of its
+    context and its init, update and final functions, so that the same
+    code can be used by HashOperation and by headless tools.
+
+    History:
+
+    v. 1.0.0 (10/18/2026) - Initial version, extracted from HashOperation
+    v. 1.0.1 (10/18/2026) - add SIMD levels, so that the portable and SIMD
+                            implementations can be compared
+    v. 1.0.2 (10/18/2026) - add hash_engine_hash_many for batches of
+                            small messages
+    v. 1.0.3 (10/18/2026) - add hash_engine_update_many to interleave
+                            several MD5 / SHA1 / SHA256 streams
+    v. 1.0.4 (10/18/2026) - add hash_engine_serialize and
+                            hash_engine_deserialize to checkpoint and
+                            resume contexts
+    v. 1.0.5 (10/18/2026) - add hash_engine_squeeze to stream any amount
+                            of output from the XOFs
+
+    Copyright (c) 2015-2026 Sriranga R. Veeraraghavan <ranga@calalum.org>
+
+    Permission is hereby granted, free of charge, to any person obtaining
+    a copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+    OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef hash_engine_h
+#define hash_engine_h
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Supported Hash Types
+
+typedef enum {
+    HASH_NONE           =  0,
+    HASH_MD5            =  1,
+    HASH_SHA1           =  2,
+    HASH_SHA256         =  3,
+    HASH_RMD160         =  4,
+    HASH_SHA512         =  5,
+    HASH_WPOOL          =  6,
+    HASH_SHA3_256       =  7,
+    HASH_SHA3_512       =  8,
+    HASH_CRC32          =  9,
+    HASH_CKSUM          = 10,
+    HASH_RMD320         = 11,
+    HASH_BLAKE2B_256    = 12,
+    HASH_BLAKE2B_512    = 13,
+    HASH_SKEIN_256      = 14,
+    HASH_SKEIN_512      = 15,
+    HASH_SKEIN_1024     = 16,
+    HASH_SKEIN_512_256  = 17,
+    HASH_SKEIN_1024_256 = 18,
+    HASH_SKEIN_1024_512 = 19,
+    HASH_BLAKE2S_256    = 20,
+    HASH_BLAKE2S_512    = 21,
+    HASH_BLAKE2SP_256   = 22,
+    HASH_BLAKE2SP_512   = 23,
+    HASH_BLAKE2BP_256   = 24,
+    HASH_BLAKE2BP_512   = 25,
+    HASH_SHA224         = 26,
+    HASH_SHA384         = 27,
+    HASH_SHA3_224       = 28,
+    HASH_SHA3_384       = 29,
+    HASH_MD6_256        = 30,
+    HASH_MD6_512        = 31,
+    HASH_JH_224         = 32,
+    HASH_JH_256         = 33,
+    HASH_JH_384         = 34,
+    HASH_JH_512         = 35,
+    HASH_TIGER          = 36,
+    HASH_TIGER2         = 37,
+    HASH_HAS160         = 38,
+    HASH_BLAKE224       = 39,
+    HASH_BLAKE256       = 40,
+    HASH_BLAKE384       = 41,
+    HASH_BLAKE512       = 42,
+    HASH_GROESTL224     = 43,
+    HASH_GROESTL256     = 44,
+    HASH_GROESTL384     = 45,
+    HASH_GROESTL512     = 46,
+    HASH_SHA1DC         = 47,
+    HASH_SNEFRU128      = 48,
+    HASH_SNEFRU256      = 49,
+    HASH_SHAKE128       = 50,
+    HASH_SHAKE256       = 51,
+    HASH_BLAKE3         = 52,
+    HASH_LSH224         = 53,
+    HASH_LSH256         = 54,
+    HASH_LSH384         = 55,
+    HASH_LSH512         = 56,
+    HASH_K12_256        = 57,
+    HASH_K12_384        = 58,
+    HASH_K12_512        = 59,
+    HASH_SKEIN_256_TREE = 60,
+    HASH_SKEIN_512_TREE = 61,
+    HASH_SKEIN_1024_TREE = 62,
+    HASH_TYPE_COUNT
+} HashType;
+
+// Descriptor flags
+
+enum {
+
+    /* the digest is a 32-bit checksum (stored big endian) that is
+       displayed as an unsigned decimal number */
+
+    HASH_ENGINE_FLAG_CHECKSUM  = 1 << 0,
+
+    /* final() returns 1 if a collision attack was detected */
+
+    HASH_ENGINE_FLAG_COLLISION = 1 << 1,
+
+    /* the algorithm is an extendable output function */
+
+    HASH_ENGINE_FLAG_XOF       = 1 << 2,
+
+    /* SIMD implementations are selected at run time, see
+       hash_engine_set_simd_level */
+
+    HASH_ENGINE_FLAG_SIMD      = 1 << 3,
+};
+
+// SIMD levels, each level includes the ones before it
+
+typedef enum {
+    HASH_ENGINE_SIMD_PORTABLE = 0,
+    HASH_ENGINE_SIMD_SSE2,
+    HASH_ENGINE_SIMD_SSSE3,
+    HASH_ENGINE_SIMD_SSE41,
+    HASH_ENGINE_SIMD_AVX2,
+    HASH_ENGINE_SIMD_AVX512,
+    HASH_ENGINE_SIMD_LEVEL_COUNT
+} hashEngineSimdLevel;
+
+// Alignment required for hash contexts (BLAKE3, K12)
+
+enum {
+    HASH_ENGINE_CONTEXT_ALIGNMENT = 64,
+};
+
+// Version of the serialized context format
+
+enum {
+    HASH_ENGINE_SERIAL_VERSION = 1,
+};
+
+/*
+    hashEngineDescriptor - describes how to compute a HashType:
+
+        contextSize  - bytes of (suitably aligned) storage needed for the
+                       context passed to init, update and final
+        digestLength - length of the digest written by final
+        init         - initialize the context
+        update       - add length bytes of data to the context, any length
+                       (including lengths larger than 4GB) is supported
+        final        - write the digest, returns -1 on failure, 1 if a
+                       collision was detected and 0 otherwise
+        many         - optional, hash count messages at once (filling
+                       the SIMD lanes across messages), writing
+                       digestLength bytes per message to digests
+        updateMany   - optional, update count contexts at once, with
+                       data[i] (lengths[i] bytes) going to ctxs[i]
+        serialize    - optional, for contexts that contain pointers:
+                       write the context's state to state (if it is not
+                       NULL) and return its length.  Other contexts are
+                       serialized as a copy of contextSize bytes.
+        deserialize  - optional, restore a state written by serialize
+                       into an initialized context, returns 0 on success
+        squeeze      - optional, for XOFs: write the length bytes of
+                       output that start offset bytes into the output
+                       stream, offset is the total length of the
+                       previous calls.  returns 0 on success.
+ */
+
+typedef struct hashEngineDescriptor {
+    HashType     type;
+    const char  *name;
+    size_t       contextSize;
+    size_t       digestLength;
+    unsigned int flags;
+    void (*init)(void *ctx, size_t digestLength);
+    void (*update)(void *ctx, const unsigned char *data, size_t length);
+    int  (*final)(void *ctx, unsigned char *digest, size_t digestLength);
+    void (*many)(const unsigned char *const *inputs,
+                 const size_t *lengths,
+                 size_t count,
+                 unsigned char *digests,
+                 size_t digestLength);
+    void (*updateMany)(void *const *ctxs,
+                       const unsigned char *const *data,
+                       const size_t *lengths,
+                       size_t count);
+    size_t (*serialize)(const void *ctx, unsigned char *state);
+    int    (*deserialize)(void *ctx,
+                          const unsigned char *state,
+                          size_t length);
+    int    (*squeeze)(void *ctx,
+                      unsigned long long offset,
+                      unsigned char *out,
+                      size_t length);
+} hashEngineDescriptor;
+
+/*
+    hashEngineContext - a heap allocated, aligned context for a descriptor
+ */
+
+typedef struct hashEngineContext {
+    const hashEngineDescriptor *desc;
+    unsigned long long length;
+    void *state;
+    unsigned long long squeezed;
+    int squeezing;
+} hashEngineContext;
+
+/* descriptor lookup, returns NULL if the type is unknown or unsupported
+   on this platform */
+
+const hashEngineDescriptor *hash_engine_descriptor(HashType type);
+const hashEngineDescriptor *hash_engine_descriptor_by_name(const char *name);
+
+/* return the n-th supported descriptor (in HashType order), or NULL */
+
+const hashEngineDescriptor *hash_engine_descriptor_at(size_t n);
+
+/* context management */
+
+hashEngineContext *hash_engine_new(HashType type);
+void hash_engine_reset(hashEngineContext *ctx);
+void hash_engine_update(hashEngineContext *ctx,
+                        const void *data,
+                        size_t length);
+int  hash_engine_final(hashEngineContext *ctx, unsigned char *digest);
+void hash_engine_free(hashEngineContext *ctx);
+
+/*
+    hash_engine_squeeze - for the hashes flagged HASH_ENGINE_FLAG_XOF,
+                          write the next length bytes of output to out,
+                          so that any amount of output can be streamed
+                          through a buffer of any size.  The first call
+                          finalizes the context, after which it can only
+                          be squeezed further or reset (update is
+                          ignored, and final and serialize fail).  The
+                          first digestLength bytes are the digest that
+                          final would have written.  BLAKE3 splits large
+                          requests across its thread pool.  returns -1
+                          if the hash isn't an XOF, 0 otherwise.
+ */
+
+int  hash_engine_squeeze(hashEngineContext *ctx,
+                         unsigned char *out,
+                         size_t length);
+
+/*
+    hash_engine_hash_many - compute the digests of count independent
+                            messages (inputs[i] is lengths[i] bytes long),
+                            the digest of message i is written to
+                            digests + i*digestLength.  BLAKE2, BLAKE3
+                            and SHA3 hash several messages at once in the
+                            SIMD lanes, other hashes reuse one context.
+                            returns -1 on failure, 1 if a collision was
+                            detected in any message and 0 otherwise.
+ */
+
+int hash_engine_hash_many(HashType type,
+                          const unsigned char *const *inputs,
+                          const size_t *lengths,
+                          size_t count,
+                          unsigned char *digests);
+
+/*
+    hash_engine_update_many - add data[i] (lengths[i] bytes) to ctxs[i]
+                              for count contexts of the same type, e.g.
+                              the next blocks of several files.  MD5,
+                              SHA1 and SHA256 hash hash_engine_lanes of
+                              the contexts at once, one per SIMD lane,
+                              other hashes update them one at a time.
+                              returns -1 if the contexts are of
+                              different types, 0 otherwise.
+    hash_engine_lanes       - the number of contexts that
+                              hash_engine_update_many hashes at once for
+                              type (1 if there is no advantage to
+                              updating several contexts together)
+ */
+
+int hash_engine_update_many(hashEngineContext *const *ctxs,
+                            const unsigned char *const *data,
+                            const size_t *lengths,
+                            size_t count);
+size_t hash_engine_lanes(HashType type);
+
+/*
+    hash_engine_serialized_size - the number of bytes needed to serialize
+                                  ctx
+    hash_engine_serialize       - write ctx (the data hashed so far) to
+                                  buffer, returns the number of bytes
+                                  written, or 0 if buffer is too small
+    hash_engine_deserialize     - restore a serialized context into ctx,
+                                  which must be of the same type and
+                                  freshly created or reset.  returns 0 on
+                                  success, or -1 if the data is corrupt,
+                                  of another type, or was written by an
+                                  incompatible build (the state is the
+                                  in-memory layout of the context, so it
+                                  can only be restored on the same cpu
+                                  architecture and version of the engine)
+
+    NOTE: serialized contexts are checksummed against corruption, but
+          are not authenticated, so they should only be read from
+          trusted locations.
+ */
+
+size_t hash_engine_serialized_size(const hashEngineContext *ctx);
+size_t hash_engine_serialize(const hashEngineContext *ctx,
+                             unsigned char *buffer,
+                             size_t size);
+int hash_engine_deserialize(hashEngineContext *ctx,
+                            const unsigned char *buffer,
+                            size_t size);
+
+/* aligned allocation of raw context storage, free with hash_engine_free_state */
+
+void *hash_engine_alloc_state(const hashEngineDescriptor *desc);
+void hash_engine_free_state(void *state);
+
+/*
+    SIMD level selection:
+
+        hash_engine_simd_detected  - the highest level supported by the cpu
+        hash_engine_simd_level     - the level currently in use (by default,
+                                     the detected level)
+        hash_engine_set_simd_level - limit the hashes flagged with
+                                     HASH_ENGINE_FLAG_SIMD to the specified
+                                     level (or the detected level, if it is
+                                     lower), returns the level in use.  This
+                                     affects all contexts, so it should only
+                                     be called while nothing is being hashed.
+        hash_engine_simd_name      - printable name of a level
+        hash_engine_simd_by_name   - level with the specified name, or -1
+ */
+
+hashEngineSimdLevel hash_engine_simd_detected(void);
+hashEngineSimdLevel hash_engine_simd_level(void);
+hashEngineSimdLevel hash_engine_set_simd_level(hashEngineSimdLevel level);
+const char *hash_engine_simd_name(hashEngineSimdLevel level);
+int hash_engine_simd_by_name(const char *name);
+
+/* digest formatting - the buffer must be at least
+   hash_engine_string_length(desc) + 1 bytes long */
+
+size_t hash_engine_string_length(const hashEngineDescriptor *desc);
+size_t hash_engine_digest_to_string(const hashEngineDescriptor *desc,
+                                    const unsigned char *digest,
+                                    int lowercase,
+                                    char *str);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* hash_engine_h */
@@ -0,0 +1,312 @@
+/*
+    Hash - hash_map.c
+
+    History:
+
+    v. 1.0.0 (10/18/2026) - Initial version
+    v. 1.0.1 (10/18/2026) - catch SIGBUS when a mapped file is truncated,
+                            so that the caller can fall back to reading
+                            it instead of being killed
+    v. 1.0.2 (10/18/2026) - only install the SIGBUS handler when asked
+                            to (hash_map_install_guard)
+
+    Copyright (c) 2026 Sriranga R. Veeraraghavan <ranga@calalum.org>
+
+    Permission is hereby granted, free of charge, to any person obtaining
+    a copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+    OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "hash_map.h"
+
+/*
+    Accessing a page of a mapping that is past the end of the file (for
+    example because the file was truncated while it was being hashed)
+    raises SIGBUS.  The pages may be read on any thread (the hash_multi
+    workers, the tree hashes' threads), so rather than jumping out of
+    the update, the handler replaces the rest of the mapping, from the
+    faulting page on, with zero filled pages, marks the mapping as
+    truncated and returns, so the read is retried and succeeds.  The
+    caller then checks hash_map_truncated() once the hashes have caught
+    up, and throws away the result and reads the file instead.
+
+    The handler only knows about the mappings in gGuards, a SIGBUS for
+    any other address is passed on to the previous handler.  Taking
+    over SIGBUS is a process wide change, so it is up to the program
+    to ask for it with hash_map_install_guard; without it, files are
+    mapped unguarded, as the engine's callers did before.
+ */
+
+typedef struct hashMapGuard {
+    uintptr_t start;
+    size_t length;
+    volatile sig_atomic_t truncated;
+} hashMapGuard;
+
+static hashMapGuard gGuards[HASH_MAP_MAX_GUARDS];
+static pthread_mutex_t gGuardLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_once_t gGuardOnce = PTHREAD_ONCE_INIT;
+static struct sigaction gPrevBusAction;
+static uintptr_t gPageSize = 0;
+
+// 0 - not asked for, 1 - installed, -1 - asked for, but failed
+
+static volatile int gGuardState = 0;
+
+/* busHandler - SIGBUS handler, see above */
+
+static void busHandler(int sig, siginfo_t *info, void *uctx)
+{
+    uintptr_t addr = (uintptr_t)info->si_addr;
+    uintptr_t start = 0;
+    uintptr_t from = 0;
+    uintptr_t end = 0;
+    size_t i = 0;
+
+    for (i = 0; i < HASH_MAP_MAX_GUARDS; i++) {
+        start = __atomic_load_n(&gGuards[i].start, __ATOMIC_ACQUIRE);
+        if (start == 0 ||
+            addr < start ||
+            addr - start >= gGuards[i].length) {
+            continue;
+        }
+
+        from = addr & ~(gPageSize - 1);
+        end = (start + gGuards[i].length + gPageSize - 1) &
+              ~(gPageSize - 1);
+        if (mmap((void *)from,
+                 (size_t)(end - from),
+                 PROT_READ,
+                 MAP_PRIVATE | MAP_ANON | MAP_FIXED,
+                 -1,
+                 0) == MAP_FAILED) {
+            break;
+        }
+        gGuards[i].truncated = 1;
+        return;
+    }
+
+    // not one of ours (or it couldn't be patched), so do whatever would
+    // have been done without this handler, for the default action the
+    // read is retried and the process is killed
+
+    if (gPrevBusAction.sa_flags & SA_SIGINFO) {
+        gPrevBusAction.sa_sigaction(sig, info, uctx);
+    } else if (gPrevBusAction.sa_handler != SIG_DFL &&
+               gPrevBusAction.sa_handler != SIG_IGN) {
+        gPrevBusAction.sa_handler(sig);
+    } else {
+        signal(sig, SIG_DFL);
+    }
+}
+
+/* guardInstall - install the SIGBUS handler, once */
+
+static void guardInstall(void)
+{
+    struct sigaction action;
+    long pageSize = sysconf(_SC_PAGESIZE);
+
+    gGuardState = -1;
+    if (pageSize <= 0) {
+        return;
+    }
+    gPageSize = (uintptr_t)pageSize;
+
+    memset(&action, 0, sizeof(action));
+    action.sa_sigaction = busHandler;
+    action.sa_flags = SA_SIGINFO;
+    sigemptyset(&action.sa_mask);
+
+    if (sigaction(SIGBUS, &action, &gPrevBusAction) == 0) {
+        gGuardState = 1;
+    }
+}
+
+int hash_map_install_guard(void)
+{
+    pthread_once(&gGuardOnce, guardInstall);
+    return (gGuardState == 1 ? 0 : -1);
+}
+
+/* guardAdd - start catching SIGBUS for a mapping, returns 0 on success */
+
+static int guardAdd(const void *data, size_t length)
+{
+    size_t i = 0;
+    int rc = -1;
+
+    pthread_mutex_lock(&gGuardLock);
+    for (i = 0; i < HASH_MAP_MAX_GUARDS; i++) {
+        if (gGuards[i].start == 0) {
+            gGuards[i].length = length;
+            gGuards[i].truncated = 0;
+            __atomic_store_n(&gGuards[i].start,
+                             (uintptr_t)data,
+                             __ATOMIC_RELEASE);
+            rc = 0;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&gGuardLock);
+
+    return rc;
+}
+
+/* guardFind - return the guard for a mapping, or NULL */
+
+static hashMapGuard *guardFind(const void *data)
+{
+    size_t i = 0;
+
+    if (data == NULL) {
+        return NULL;
+    }
+
+    for (i = 0; i < HASH_MAP_MAX_GUARDS; i++) {
+        if (__atomic_load_n(&gGuards[i].start, __ATOMIC_ACQUIRE) ==
+            (uintptr_t)data) {
+            return &gGuards[i];
+        }
+    }
+
+    return NULL;
+}
+
+int hash_map_fd(int fd, hashMappedFile *map)
+{
+    struct stat sb;
+    void *data = NULL;
+
+    if (map == NULL) {
+        return -1;
+    }
+
+    map->data = NULL;
+    map->length = 0;
+
+    if (fd < 0 || fstat(fd, &sb) != 0) {
+        return -1;
+    }
+
+    // only map regular files that are large enough for it to be
+    // worthwhile, and that fit in the address space
+
+    if (!S_ISREG(sb.st_mode) ||
+        sb.st_size < HASH_MAP_MIN_FILE_SIZE ||
+        (unsigned long long)sb.st_size > (unsigned long long)(SIZE_MAX / 2)) {
+        return -1;
+    }
+
+    data = mmap(NULL, (size_t)sb.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    if (data == MAP_FAILED) {
+        return -1;
+    }
+
+    // if the caller asked for the SIGBUS guard, but it couldn't be
+    // installed, or all of the guards are in use, a truncated file
+    // would kill the process, so the file is read instead
+
+    if (gGuardState != 0 &&
+        (gGuardState != 1 || guardAdd(data, (size_t)sb.st_size) != 0)) {
+        (void)munmap(data, (size_t)sb.st_size);
+        return -1;
+    }
+
+    // the mapping is read once, front to back, so ask for aggressive
+    // read ahead, and for huge pages where the kernel supports them for
+    // file mappings (these are only hints, so errors are ignored)
+
+#if defined(MADV_SEQUENTIAL)
+    (void)madvise(data, (size_t)sb.st_size, MADV_SEQUENTIAL);
+#else
+    (void)posix_madvise(data, (size_t)sb.st_size, POSIX_MADV_SEQUENTIAL);
+#endif
+#if defined(MADV_HUGEPAGE)
+    (void)madvise(data, (size_t)sb.st_size, MADV_HUGEPAGE);
+#endif
+
+    map->data = data;
+    map->length = (size_t)sb.st_size;
+
+    return 0;
+}
+
+int hash_map_path(const char *path, hashMappedFile *map)
+{
+    int fd = -1;
+    int rc = -1;
+
+    if (path == NULL) {
+        return -1;
+    }
+
+    fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return -1;
+    }
+
+    // the mapping stays valid after the file is closed
+
+    rc = hash_map_fd(fd, map);
+    close(fd);
+
+    return rc;
+}
+
+int hash_map_truncated(const hashMappedFile *map)
+{
+    hashMapGuard *guard = NULL;
+
+    if (map == NULL) {
+        return 0;
+    }
+
+    guard = guardFind(map->data);
+    return (guard != NULL && guard->truncated);
+}
+
+void hash_unmap(hashMappedFile *map)
+{
+    hashMapGuard *guard = NULL;
+
+    if (map == NULL || map->data == NULL) {
+        return;
+    }
+
+    guard = guardFind(map->data);
+    if (guard != NULL) {
+        pthread_mutex_lock(&gGuardLock);
+        __atomic_store_n(&guard->start, 0, __ATOMIC_RELEASE);
+        pthread_mutex_unlock(&gGuardLock);
+    }
+
+    (void)munmap((void *)map->data, map->length);
+
+    map->data = NULL;
+    map->length = 0;
+}
@@ -0,0 +1,128 @@
+/*
+    Hash - hash_map.h
+
+    Memory mapped input: maps a whole (regular) file read only, so that
+    it can be handed straight to the update functions without first
+    being copied into a read buffer, and so that the tree hashes (BLAKE3,
+    K12, etc.) can see all of the input at once.
+
+    History:
+
+    v. 1.0.0 (10/18/2026) - Initial version
+    v. 1.0.1 (10/18/2026) - add hash_map_truncated
+    v. 1.0.2 (10/18/2026) - add hash_map_install_guard, the SIGBUS
+                            handler is no longer installed implicitly
+
+    Copyright (c) 2026 Sriranga R. Veeraraghavan <ranga@calalum.org>
+
+    Permission is hereby granted, free of charge, to any person obtaining
+    a copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+    OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef hash_map_h
+#define hash_map_h
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Files smaller than this (1MB) are read rather than mapped, and at
+// most this many (64) mappings can be guarded at once
+
+enum {
+    HASH_MAP_MIN_FILE_SIZE = 1048576,
+    HASH_MAP_MAX_GUARDS = 64,
+};
+
+typedef struct hashMappedFile {
+    const unsigned char *data;
+    size_t length;
+} hashMappedFile;
+
+/*
+    hash_map_fd - map the file open on fd for sequential reading.
+                  returns 0 on success, or -1 if the file is not a
+                  regular file, is smaller than HASH_MAP_MIN_FILE_SIZE,
+                  or cannot be mapped; the caller should then fall back
+                  to reading the file.
+
+                  NOTE: if the file is truncated while it is mapped,
+                        reading the pages past the new end of the file
+                        raises SIGBUS, which kills the process unless
+                        hash_map_install_guard has been called.  with
+                        the guard, those pages read as zeros instead,
+                        check hash_map_truncated once the data has been
+                        used.  once HASH_MAP_MAX_GUARDS mappings are in
+                        use, -1 is returned (so the file is read)
+                        rather than mapping the file unguarded.
+ */
+
+int hash_map_fd(int fd, hashMappedFile *map);
+
+/* hash_map_path - open and map the file at path, see hash_map_fd */
+
+int hash_map_path(const char *path, hashMappedFile *map);
+
+/*
+    hash_map_install_guard - install a process wide SIGBUS handler that
+                             catches reads past the end of a truncated
+                             mapping.  SIGBUS for any other address is
+                             passed on to the handler that was installed
+                             before.  call it once, before mapping any
+                             files and before starting any threads that
+                             change the SIGBUS disposition.  returns 0 on
+                             success, or -1 if the handler could not be
+                             installed, in which case hash_map_fd never
+                             maps a file.
+
+                             NOTE: the handler calls mmap() to replace
+                                   the truncated pages, and mmap() is
+                                   not async-signal-safe in POSIX (it
+                                   is a system call on Linux and the
+                                   BSDs, where this works), so a program
+                                   that needs strict POSIX conformance
+                                   should not install the guard, and
+                                   should read files that may be
+                                   truncated (-n in the hash tool).
+ */
+
+int hash_map_install_guard(void);
+
+/*
+    hash_map_truncated - returns non-zero if part of the mapping could not
+                         be read (the file was truncated, or there was an
+                         I/O error) since it was mapped, in which case
+                         anything computed from it is wrong, and the
+                         caller should read the file instead.  the
+                         threads using the mapping must be done with it.
+                         always 0 without hash_map_install_guard.
+ */
+
+int hash_map_truncated(const hashMappedFile *map);
+
+/* hash_unmap - release a mapping created by hash_map_fd/hash_map_path */
+
+void hash_unmap(hashMappedFile *map);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* hash_map_h */
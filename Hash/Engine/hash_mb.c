@@ -0,0 +1,584 @@
+/*
+    Hash - hash_mb.c
+
+    History:
+
+    v. 1.0.0 (10/18/2026) - Initial version
+
+    Copyright (c) 2026 Sriranga R. Veeraraghavan <ranga@calalum.org>
+
+    Permission is hereby granted, free of charge, to any person obtaining
+    a copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+    OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <stdint.h>
+#include <string.h>
+
+#include "hash_mb.h"
+#include "sha_cpu.h"
+
+enum {
+    HASH_MB_BLOCK_LENGTH = 64,
+
+    /* streams are set up on the stack this many at a time */
+
+    HASH_MB_BATCH = 64,
+};
+
+typedef void (*mbCompressFn)(uint32_t *state,
+                             const uint8_t *blocks,
+                             size_t nblocks);
+
+typedef void (*mbKernelFn)(uint32_t *const *states,
+                           const uint8_t *const *blocks,
+                           size_t count,
+                           size_t nblocks);
+
+/*
+    mbStream - the parts of an MD5, SHA1 or SHA256 context that the
+               scheduler needs (they all use 64 byte blocks, 32-bit
+               state words, and a byte count), and the data still to be
+               added to it
+ */
+
+typedef struct mbStream {
+    uint32_t      *state;
+    uint64_t      *count;
+    uint8_t       *buffer;
+    const uint8_t *data;
+    size_t         length;
+} mbStream;
+
+static inline uint32_t mb_le32(uint32_t v)
+{
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+    return __builtin_bswap32(v);
+#else
+    return v;
+#endif
+}
+
+static inline uint32_t mb_be32(uint32_t v)
+{
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+    return v;
+#else
+    return __builtin_bswap32(v);
+#endif
+}
+
+/*
+    The rounds are written once, for any type that supports the C
+    operators (the GCC / clang vector extensions broadcast the scalar
+    constants), and expanded in each of the kernels.
+ */
+
+#define MB_ROTL(x, n) (((x) << (n)) | ((x) >> (32 - (n))))
+#define MB_ROTR(x, n) (((x) >> (n)) | ((x) << (32 - (n))))
+
+// MD5
+
+#define MD5_F(x, y, z) ((z) ^ ((x) & ((y) ^ (z))))
+#define MD5_G(x, y, z) ((y) ^ ((z) & ((x) ^ (y))))
+#define MD5_H(x, y, z) ((x) ^ (y) ^ (z))
+#define MD5_I(x, y, z) ((y) ^ ((x) | ~(z)))
+
+#define MD5_STEP(f, a, b, c, d, x, k, s) \
+    (a) += f((b), (c), (d)) + (x) + (uint32_t)(k); \
+    (a) = MB_ROTL((a), (s)) + (b)
+
+#define MD5_ROUNDS(a, b, c, d, x) \
+    MD5_STEP(MD5_F, a, b, c, d, x[ 0], 0xd76aa478,  7); \
+    MD5_STEP(MD5_F, d, a, b, c, x[ 1], 0xe8c7b756, 12); \
+    MD5_STEP(MD5_F, c, d, a, b, x[ 2], 0x242070db, 17); \
+    MD5_STEP(MD5_F, b, c, d, a, x[ 3], 0xc1bdceee, 22); \
+    MD5_STEP(MD5_F, a, b, c, d, x[ 4], 0xf57c0faf,  7); \
+    MD5_STEP(MD5_F, d, a, b, c, x[ 5], 0x4787c62a, 12); \
+    MD5_STEP(MD5_F, c, d, a, b, x[ 6], 0xa8304613, 17); \
+    MD5_STEP(MD5_F, b, c, d, a, x[ 7], 0xfd469501, 22); \
+    MD5_STEP(MD5_F, a, b, c, d, x[ 8], 0x698098d8,  7); \
+    MD5_STEP(MD5_F, d, a, b, c, x[ 9], 0x8b44f7af, 12); \
+    MD5_STEP(MD5_F, c, d, a, b, x[10], 0xffff5bb1, 17); \
+    MD5_STEP(MD5_F, b, c, d, a, x[11], 0x895cd7be, 22); \
+    MD5_STEP(MD5_F, a, b, c, d, x[12], 0x6b901122,  7); \
+    MD5_STEP(MD5_F, d, a, b, c, x[13], 0xfd987193, 12); \
+    MD5_STEP(MD5_F, c, d, a, b, x[14], 0xa679438e, 17); \
+    MD5_STEP(MD5_F, b, c, d, a, x[15], 0x49b40821, 22); \
+    MD5_STEP(MD5_G, a, b, c, d, x[ 1], 0xf61e2562,  5); \
+    MD5_STEP(MD5_G, d, a, b, c, x[ 6], 0xc040b340,  9); \
+    MD5_STEP(MD5_G, c, d, a, b, x[11], 0x265e5a51, 14); \
+    MD5_STEP(MD5_G, b, c, d, a, x[ 0], 0xe9b6c7aa, 20); \
+    MD5_STEP(MD5_G, a, b, c, d, x[ 5], 0xd62f105d,  5); \
+    MD5_STEP(MD5_G, d, a, b, c, x[10], 0x02441453,  9); \
+    MD5_STEP(MD5_G, c, d, a, b, x[15], 0xd8a1e681, 14); \
+    MD5_STEP(MD5_G, b, c, d, a, x[ 4], 0xe7d3fbc8, 20); \
+    MD5_STEP(MD5_G, a, b, c, d, x[ 9], 0x21e1cde6,  5); \
+    MD5_STEP(MD5_G, d, a, b, c, x[14], 0xc33707d6,  9); \
+    MD5_STEP(MD5_G, c, d, a, b, x[ 3], 0xf4d50d87, 14); \
+    MD5_STEP(MD5_G, b, c, d, a, x[ 8], 0x455a14ed, 20); \
+    MD5_STEP(MD5_G, a, b, c, d, x[13], 0xa9e3e905,  5); \
+    MD5_STEP(MD5_G, d, a, b, c, x[ 2], 0xfcefa3f8,  9); \
+    MD5_STEP(MD5_G, c, d, a, b, x[ 7], 0x676f02d9, 14); \
+    MD5_STEP(MD5_G, b, c, d, a, x[12], 0x8d2a4c8a, 20); \
+    MD5_STEP(MD5_H, a, b, c, d, x[ 5], 0xfffa3942,  4); \
+    MD5_STEP(MD5_H, d, a, b, c, x[ 8], 0x8771f681, 11); \
+    MD5_STEP(MD5_H, c, d, a, b, x[11], 0x6d9d6122, 16); \
+    MD5_STEP(MD5_H, b, c, d, a, x[14], 0xfde5380c, 23); \
+    MD5_STEP(MD5_H, a, b, c, d, x[ 1], 0xa4beea44,  4); \
+    MD5_STEP(MD5_H, d, a, b, c, x[ 4], 0x4bdecfa9, 11); \
+    MD5_STEP(MD5_H, c, d, a, b, x[ 7], 0xf6bb4b60, 16); \
+    MD5_STEP(MD5_H, b, c, d, a, x[10], 0xbebfbc70, 23); \
+    MD5_STEP(MD5_H, a, b, c, d, x[13], 0x289b7ec6,  4); \
+    MD5_STEP(MD5_H, d, a, b, c, x[ 0], 0xeaa127fa, 11); \
+    MD5_STEP(MD5_H, c, d, a, b, x[ 3], 0xd4ef3085, 16); \
+    MD5_STEP(MD5_H, b, c, d, a, x[ 6], 0x04881d05, 23); \
+    MD5_STEP(MD5_H, a, b, c, d, x[ 9], 0xd9d4d039,  4); \
+    MD5_STEP(MD5_H, d, a, b, c, x[12], 0xe6db99e5, 11); \
+    MD5_STEP(MD5_H, c, d, a, b, x[15], 0x1fa27cf8, 16); \
+    MD5_STEP(MD5_H, b, c, d, a, x[ 2], 0xc4ac5665, 23); \
+    MD5_STEP(MD5_I, a, b, c, d, x[ 0], 0xf4292244,  6); \
+    MD5_STEP(MD5_I, d, a, b, c, x[ 7], 0x432aff97, 10); \
+    MD5_STEP(MD5_I, c, d, a, b, x[14], 0xab9423a7, 15); \
+    MD5_STEP(MD5_I, b, c, d, a, x[ 5], 0xfc93a039, 21); \
+    MD5_STEP(MD5_I, a, b, c, d, x[12], 0x655b59c3,  6); \
+    MD5_STEP(MD5_I, d, a, b, c, x[ 3], 0x8f0ccc92, 10); \
+    MD5_STEP(MD5_I, c, d, a, b, x[10], 0xffeff47d, 15); \
+    MD5_STEP(MD5_I, b, c, d, a, x[ 1], 0x85845dd1, 21); \
+    MD5_STEP(MD5_I, a, b, c, d, x[ 8], 0x6fa87e4f,  6); \
+    MD5_STEP(MD5_I, d, a, b, c, x[15], 0xfe2ce6e0, 10); \
+    MD5_STEP(MD5_I, c, d, a, b, x[ 6], 0xa3014314, 15); \
+    MD5_STEP(MD5_I, b, c, d, a, x[13], 0x4e0811a1, 21); \
+    MD5_STEP(MD5_I, a, b, c, d, x[ 4], 0xf7537e82,  6); \
+    MD5_STEP(MD5_I, d, a, b, c, x[11], 0xbd3af235, 10); \
+    MD5_STEP(MD5_I, c, d, a, b, x[ 2], 0x2ad7d2bb, 15); \
+    MD5_STEP(MD5_I, b, c, d, a, x[ 9], 0xeb86d391, 21)
+
+// SHA1, the message schedule is kept in a 16 word circular buffer
+
+#define SHA1_F0(b, c, d) ((d) ^ ((b) & ((c) ^ (d))))
+#define SHA1_F1(b, c, d) ((b) ^ (c) ^ (d))
+#define SHA1_F2(b, c, d) (((b) & (c)) | ((d) & ((b) | (c))))
+
+#define SHA1_W(w, t) \
+    ((t) < 16 ? w[(t) & 15] : \
+     (w[(t) & 15] = MB_ROTL(w[((t) + 13) & 15] ^ w[((t) + 8) & 15] ^ \
+                            w[((t) + 2) & 15] ^ w[(t) & 15], 1)))
+
+#define SHA1_STEP(a, b, c, d, e, w, t) \
+    (e) += MB_ROTL((a), 5) + SHA1_W(w, t) + \
+           ((t) < 20 ? SHA1_F0((b), (c), (d)) + (uint32_t)0x5a827999 : \
+            (t) < 40 ? SHA1_F1((b), (c), (d)) + (uint32_t)0x6ed9eba1 : \
+            (t) < 60 ? SHA1_F2((b), (c), (d)) + (uint32_t)0x8f1bbcdc : \
+                       SHA1_F1((b), (c), (d)) + (uint32_t)0xca62c1d6); \
+    (b) = MB_ROTL((b), 30)
+
+#define SHA1_STEP5(a, b, c, d, e, w, t) \
+    SHA1_STEP(a, b, c, d, e, w, (t)); \
+    SHA1_STEP(e, a, b, c, d, w, (t) + 1); \
+    SHA1_STEP(d, e, a, b, c, w, (t) + 2); \
+    SHA1_STEP(c, d, e, a, b, w, (t) + 3); \
+    SHA1_STEP(b, c, d, e, a, w, (t) + 4)
+
+#define SHA1_STEP20(a, b, c, d, e, w, t) \
+    SHA1_STEP5(a, b, c, d, e, w, (t)); \
+    SHA1_STEP5(a, b, c, d, e, w, (t) + 5); \
+    SHA1_STEP5(a, b, c, d, e, w, (t) + 10); \
+    SHA1_STEP5(a, b, c, d, e, w, (t) + 15)
+
+#define SHA1_ROUNDS(a, b, c, d, e, w) \
+    SHA1_STEP20(a, b, c, d, e, w, 0); \
+    SHA1_STEP20(a, b, c, d, e, w, 20); \
+    SHA1_STEP20(a, b, c, d, e, w, 40); \
+    SHA1_STEP20(a, b, c, d, e, w, 60)
+
+// SHA256
+
+static const uint32_t gMbSha256K[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5,
+    0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+    0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc,
+    0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7,
+    0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+    0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3,
+    0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5,
+    0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+    0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+#define SHA256_CH(x, y, z)  ((z) ^ ((x) & ((y) ^ (z))))
+#define SHA256_MAJ(x, y, z) (((x) & (y)) | ((z) & ((x) | (y))))
+#define SHA256_S0(x) (MB_ROTR((x), 2) ^ MB_ROTR((x), 13) ^ MB_ROTR((x), 22))
+#define SHA256_S1(x) (MB_ROTR((x), 6) ^ MB_ROTR((x), 11) ^ MB_ROTR((x), 25))
+#define SHA256_s0(x) (MB_ROTR((x), 7) ^ MB_ROTR((x), 18) ^ ((x) >> 3))
+#define SHA256_s1(x) (MB_ROTR((x), 17) ^ MB_ROTR((x), 19) ^ ((x) >> 10))
+
+#define SHA256_W(w, t) \
+    ((t) < 16 ? w[(t) & 15] : \
+     (w[(t) & 15] += SHA256_s1(w[((t) + 14) & 15]) + w[((t) + 9) & 15] + \
+                     SHA256_s0(w[((t) + 1) & 15])))
+
+#define SHA256_STEP(a, b, c, d, e, f, g, h, w, t, t1) \
+    t1 = (h) + SHA256_S1(e) + SHA256_CH((e), (f), (g)) + \
+         gMbSha256K[t] + SHA256_W(w, t); \
+    (d) += t1; \
+    (h) = t1 + SHA256_S0(a) + SHA256_MAJ((a), (b), (c))
+
+#define SHA256_STEP8(a, b, c, d, e, f, g, h, w, t, t1) \
+    SHA256_STEP(a, b, c, d, e, f, g, h, w, (t), t1); \
+    SHA256_STEP(h, a, b, c, d, e, f, g, w, (t) + 1, t1); \
+    SHA256_STEP(g, h, a, b, c, d, e, f, w, (t) + 2, t1); \
+    SHA256_STEP(f, g, h, a, b, c, d, e, w, (t) + 3, t1); \
+    SHA256_STEP(e, f, g, h, a, b, c, d, w, (t) + 4, t1); \
+    SHA256_STEP(d, e, f, g, h, a, b, c, w, (t) + 5, t1); \
+    SHA256_STEP(c, d, e, f, g, h, a, b, w, (t) + 6, t1); \
+    SHA256_STEP(b, c, d, e, f, g, h, a, w, (t) + 7, t1)
+
+#define SHA256_ROUNDS(a, b, c, d, e, f, g, h, w, t1) \
+    SHA256_STEP8(a, b, c, d, e, f, g, h, w, 0, t1); \
+    SHA256_STEP8(a, b, c, d, e, f, g, h, w, 8, t1); \
+    SHA256_STEP8(a, b, c, d, e, f, g, h, w, 16, t1); \
+    SHA256_STEP8(a, b, c, d, e, f, g, h, w, 24, t1); \
+    SHA256_STEP8(a, b, c, d, e, f, g, h, w, 32, t1); \
+    SHA256_STEP8(a, b, c, d, e, f, g, h, w, 40, t1); \
+    SHA256_STEP8(a, b, c, d, e, f, g, h, w, 48, t1); \
+    SHA256_STEP8(a, b, c, d, e, f, g, h, w, 56, t1)
+
+/*
+    The kernels, for 8 lanes (AVX2) and 16 lanes (AVX-512).  The
+    instruction sets are enabled with target pragmas, so the rest of
+    the build doesn't need to be compiled for them.
+ */
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+
+#define HASH_MB_SIMD 1
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("avx2"))), apply_to = function)
+#else
+#pragma GCC push_options
+#pragma GCC target("avx2")
+#endif
+
+#define MB_LANES 8
+#define MB_VEC mbVec8
+#define MB_FN(x) mb_##x##_x8
+#include "hash_mb_lanes.h"
+#undef MB_LANES
+#undef MB_VEC
+#undef MB_FN
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#pragma clang attribute push (__attribute__((target("avx512f"))), apply_to = function)
+#else
+#pragma GCC pop_options
+#pragma GCC push_options
+#pragma GCC target("avx512f")
+#endif
+
+#define MB_LANES 16
+#define MB_VEC mbVec16
+#define MB_FN(x) mb_##x##_x16
+#include "hash_mb_lanes.h"
+#undef MB_LANES
+#undef MB_VEC
+#undef MB_FN
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#else
+#pragma GCC pop_options
+#endif
+
+#endif /* x86_64 */
+
+#if !defined(HASH_MB_SIMD)
+#define mb_md5_x8 NULL
+#define mb_md5_x16 NULL
+#define mb_sha1_x8 NULL
+#define mb_sha1_x16 NULL
+#define mb_sha256_x8 NULL
+#define mb_sha256_x16 NULL
+#endif
+
+/*
+    lane selection: gLanes is the number of lanes (1, 8 or 16), 0 until
+    it is first needed
+ */
+
+static size_t gLanes = 0;
+static int gShani = 0;
+
+void hash_mb_set_simd_level(hashEngineSimdLevel level)
+{
+    size_t lanes = 1;
+
+#if defined(HASH_MB_SIMD)
+    if (level >= HASH_ENGINE_SIMD_AVX512) {
+        lanes = 16;
+    } else if (level >= HASH_ENGINE_SIMD_AVX2) {
+        lanes = 8;
+    }
+    gShani = (level >= HASH_ENGINE_SIMD_SSE41 && sha_cpu_has_shani());
+#else
+    (void)level;
+#endif
+
+    gLanes = lanes;
+}
+
+static size_t mb_lanes(void)
+{
+    if (gLanes == 0) {
+        hash_mb_set_simd_level(hash_engine_simd_level());
+    }
+    return gLanes;
+}
+
+/*
+    mb_select - pick the kernel for type, and the fewest streams it is
+                worth using it for.  The kernel is compared with the
+                single stream code on the same cpu: the SHA-NI versions
+                of SHA1 and SHA256 are faster than several lanes of
+                AVX2 (SHA256 with SHA-NI is faster than all 8), while
+                the portable versions are beaten by 2 lanes.  Returns
+                the number of lanes, or 1 if the kernel isn't used.
+ */
+
+static size_t mb_select(HashType type, mbKernelFn *kernel, size_t *minLanes)
+{
+    mbKernelFn kernel8 = NULL;
+    mbKernelFn kernel16 = NULL;
+    size_t minLanes8 = 2;
+    size_t minLanes16 = 2;
+    size_t lanes = mb_lanes();
+
+    *kernel = NULL;
+    *minLanes = 0;
+
+    switch (type) {
+        case HASH_MD5:
+            kernel8 = mb_md5_x8;
+            kernel16 = mb_md5_x16;
+            minLanes8 = 3;
+            minLanes16 = 3;
+            break;
+        case HASH_SHA1:
+            kernel8 = mb_sha1_x8;
+            kernel16 = mb_sha1_x16;
+            if (gShani) {
+                minLanes8 = 8;
+                minLanes16 = 7;
+            }
+            break;
+        case HASH_SHA224:
+        case HASH_SHA256:
+            kernel8 = mb_sha256_x8;
+            kernel16 = mb_sha256_x16;
+            if (gShani) {
+                minLanes8 = HASH_MB_MAX_LANES + 1;
+                minLanes16 = 12;
+            }
+            break;
+        default:
+            return 1;
+    }
+
+    if (lanes == 16) {
+        *kernel = kernel16;
+        *minLanes = minLanes16;
+    } else if (lanes == 8) {
+        *kernel = kernel8;
+        *minLanes = minLanes8;
+    }
+
+    if (*kernel == NULL || *minLanes > lanes) {
+        *kernel = NULL;
+        return 1;
+    }
+
+    return lanes;
+}
+
+size_t hash_mb_lanes(HashType type)
+{
+    mbKernelFn kernel = NULL;
+    size_t minLanes = 0;
+
+    return mb_select(type, &kernel, &minLanes);
+}
+
+/*
+    mb_update - the scheduler.  Partial blocks left over from earlier
+                updates are completed (one block, on their own), then
+                the whole blocks of up to lanes streams are compressed
+                together, as many blocks at a time as the shortest of
+                them has, and finally the leftover bytes are buffered.
+                When there are fewer than minLanes streams left, they
+                are finished with the single stream compress function
+                (which is faster than a mostly empty vector if it uses
+                SHA-NI).
+ */
+
+static void mb_update(mbStream *streams,
+                      size_t count,
+                      mbCompressFn compress,
+                      mbKernelFn kernel,
+                      size_t lanes,
+                      size_t minLanes)
+{
+    uint32_t *states[HASH_MB_MAX_LANES];
+    const uint8_t *blocks[HASH_MB_MAX_LANES];
+    size_t active[HASH_MB_BATCH];
+    size_t nactive = 0;
+    size_t used = 0;
+    size_t n = 0;
+    size_t nblocks = 0;
+    size_t i = 0;
+    size_t j = 0;
+    mbStream *s = NULL;
+
+    for (i = 0; i < count; i++) {
+        s = &streams[i];
+        used = (size_t)(*s->count % HASH_MB_BLOCK_LENGTH);
+        *s->count += s->length;
+
+        if (used > 0) {
+            n = HASH_MB_BLOCK_LENGTH - used;
+            if (s->length < n) {
+                memcpy(s->buffer + used, s->data, s->length);
+                s->length = 0;
+                continue;
+            }
+            memcpy(s->buffer + used, s->data, n);
+            compress(s->state, s->buffer, 1);
+            s->data += n;
+            s->length -= n;
+        }
+
+        if (s->length >= HASH_MB_BLOCK_LENGTH) {
+            active[nactive++] = i;
+        }
+    }
+
+    while (nactive > 0) {
+
+        n = (nactive < lanes ? nactive : lanes);
+
+        if (kernel == NULL || n < minLanes) {
+            for (j = 0; j < n; j++) {
+                s = &streams[active[j]];
+                nblocks = s->length / HASH_MB_BLOCK_LENGTH;
+                compress(s->state, s->data, nblocks);
+                s->data += nblocks*HASH_MB_BLOCK_LENGTH;
+                s->length -= nblocks*HASH_MB_BLOCK_LENGTH;
+            }
+        } else {
+            nblocks = SIZE_MAX;
+            for (j = 0; j < n; j++) {
+                s = &streams[active[j]];
+                states[j] = s->state;
+                blocks[j] = s->data;
+                if (s->length / HASH_MB_BLOCK_LENGTH < nblocks) {
+                    nblocks = s->length / HASH_MB_BLOCK_LENGTH;
+                }
+            }
+
+            kernel(states, blocks, n, nblocks);
+
+            for (j = 0; j < n; j++) {
+                s = &streams[active[j]];
+                s->data += nblocks*HASH_MB_BLOCK_LENGTH;
+                s->length -= nblocks*HASH_MB_BLOCK_LENGTH;
+            }
+        }
+
+        // drop the streams that have no whole blocks left
+
+        for (i = 0, j = 0; i < nactive; i++) {
+            if (streams[active[i]].length >= HASH_MB_BLOCK_LENGTH) {
+                active[j++] = active[i];
+            }
+        }
+        nactive = j;
+    }
+
+    for (i = 0; i < count; i++) {
+        s = &streams[i];
+        if (s->length > 0) {
+            memcpy(s->buffer, s->data, s->length);
+        }
+    }
+}
+
+/*
+    MB_UPDATE - set up the streams for a batch of contexts of ctxType and
+                run the scheduler on them
+ */
+
+#define MB_UPDATE(ctxType, type, compressFn) \
+    mbStream streams[HASH_MB_BATCH]; \
+    mbKernelFn kernel = NULL; \
+    size_t minLanes = 0; \
+    size_t lanes = mb_select((type), &kernel, &minLanes); \
+    size_t n = 0; \
+    size_t i = 0; \
+    for (; count > 0; ctxs += n, data += n, lengths += n, count -= n) { \
+        n = (count < HASH_MB_BATCH ? count : HASH_MB_BATCH); \
+        for (i = 0; i < n; i++) { \
+            ctxType *ctx = ctxs[i]; \
+            streams[i].state = ctx->state; \
+            streams[i].count = &ctx->count; \
+            streams[i].buffer = ctx->buffer; \
+            streams[i].data = data[i]; \
+            streams[i].length = lengths[i]; \
+        } \
+        mb_update(streams, n, compressFn, kernel, lanes, minLanes); \
+    }
+
+void hash_mb_md5_update(md5_ctx *const *ctxs,
+                        const unsigned char *const *data,
+                        const size_t *lengths,
+                        size_t count)
+{
+    MB_UPDATE(md5_ctx, HASH_MD5, md5_compress)
+}
+
+void hash_mb_sha1_update(sha1_ctx *const *ctxs,
+                         const unsigned char *const *data,
+                         const size_t *lengths,
+                         size_t count)
+{
+    MB_UPDATE(sha1_ctx, HASH_SHA1, sha1_compress)
+}
+
+void hash_mb_sha256_update(sha256_ctx *const *ctxs,
+                           const unsigned char *const *data,
+                           const size_t *lengths,
+                           size_t count)
+{
+    MB_UPDATE(sha256_ctx, HASH_SHA256, sha256_compress)
+}
@@ -0,0 +1,97 @@
+/*
+    Hash - hash_mb.h
+
+    Multi-buffer hashing for MD5, SHA1, SHA224 and SHA256: independent
+    streams (e.g. several files being hashed at once) are interleaved
+    so that each one occupies a 32-bit lane of an AVX2 (8 lanes) or
+    AVX-512 (16 lanes) register, and one pass of the compression
+    function advances all of them.  These hashes can't be split into
+    independent pieces like BLAKE3 or K12, so running several streams
+    side by side is the only way to use the SIMD units.
+
+    History:
+
+    v. 1.0.0 (10/18/2026) - Initial version
+
+    Copyright (c) 2026 Sriranga R. Veeraraghavan <ranga@calalum.org>
+
+    Permission is hereby granted, free of charge, to any person obtaining
+    a copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+    OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef hash_mb_h
+#define hash_mb_h
+
+#include <stddef.h>
+
+#include "hash_engine.h"
+#include "md5.h"
+#include "sha1.h"
+#include "sha256.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum {
+    HASH_MB_MAX_LANES = 16,
+};
+
+/*
+    hash_mb_lanes - the number of streams that are hashed together for
+                    type (1 if the hash has no multi-buffer code, or the
+                    cpu doesn't have AVX2)
+ */
+
+size_t hash_mb_lanes(HashType type);
+
+/*
+    hash_mb_set_simd_level - use at most the specified SIMD level (see
+                             hash_engine_set_simd_level)
+ */
+
+void hash_mb_set_simd_level(hashEngineSimdLevel level);
+
+/*
+    hash_mb_md5_update, hash_mb_sha1_update, hash_mb_sha256_update -
+        add data[i] (lengths[i] bytes) to ctxs[i] for count contexts
+        (any number, they are hashed hash_mb_lanes at a time).  Each
+        call is equivalent to calling the update function once for
+        each context.  SHA224 contexts use hash_mb_sha256_update.
+ */
+
+void hash_mb_md5_update(md5_ctx *const *ctxs,
+                        const unsigned char *const *data,
+                        const size_t *lengths,
+                        size_t count);
+
+void hash_mb_sha1_update(sha1_ctx *const *ctxs,
+                         const unsigned char *const *data,
+                         const size_t *lengths,
+                         size_t count);
+
+void hash_mb_sha256_update(sha256_ctx *const *ctxs,
+                           const unsigned char *const *data,
+                           const size_t *lengths,
+                           size_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* hash_mb_h */
@@ -0,0 +1,238 @@
+/*
+    Hash - hash_mb_lanes.h
+
+    The multi-buffer compression functions, included by hash_mb.c once
+    for each vector width with:
+
+        MB_LANES - the number of 32-bit lanes
+        MB_VEC   - the name to use for the vector type
+        MB_FN(x) - the name to use for function x
+
+    and the instruction set for the width enabled with a target pragma.
+    Lanes count and above (when fewer streams than lanes are being
+    hashed) compress the first stream's blocks, and their results are
+    discarded.
+
+    History:
+
+    v. 1.0.0 (10/18/2026) - Initial version
+
+    Copyright (c) 2026 Sriranga R. Veeraraghavan <ranga@calalum.org>
+
+    Permission is hereby granted, free of charge, to any person obtaining
+    a copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+    OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+typedef uint32_t MB_VEC __attribute__((vector_size(MB_LANES*4)));
+
+/*
+    load the next block of every lane, transposed so that w[i] holds
+    word i of each lane's block
+ */
+
+static inline void MB_FN(load)(MB_VEC w[16],
+                               const uint8_t *const *p,
+                               int bigEndian)
+{
+    uint32_t words[16][MB_LANES] __attribute__((aligned(64)));
+    uint32_t v = 0;
+    int i = 0;
+    int j = 0;
+
+    for (j = 0; j < MB_LANES; j++) {
+        for (i = 0; i < 16; i++) {
+            memcpy(&v, p[j] + i*4, 4);
+            words[i][j] = (bigEndian ? mb_be32(v) : mb_le32(v));
+        }
+    }
+
+    memcpy(w, words, sizeof(words));
+}
+
+/* load word n of count states into a vector (zero for unused lanes) */
+
+static inline MB_VEC MB_FN(gather_state)(uint32_t *const *states,
+                                         size_t count,
+                                         int n)
+{
+    MB_VEC v = { 0 };
+    size_t j = 0;
+
+    for (j = 0; j < count; j++) {
+        v[j] = states[j][n];
+    }
+    return v;
+}
+
+static inline void MB_FN(scatter_state)(uint32_t *const *states,
+                                        size_t count,
+                                        int n,
+                                        MB_VEC v)
+{
+    size_t j = 0;
+
+    for (j = 0; j < count; j++) {
+        states[j][n] = v[j];
+    }
+}
+
+/* set up the lane pointers, the unused lanes repeat the first stream */
+
+static inline void MB_FN(lanes)(const uint8_t *p[MB_LANES],
+                                const uint8_t *const *blocks,
+                                size_t count)
+{
+    size_t j = 0;
+
+    for (j = 0; j < MB_LANES; j++) {
+        p[j] = blocks[j < count ? j : 0];
+    }
+}
+
+static void MB_FN(md5)(uint32_t *const *states,
+                       const uint8_t *const *blocks,
+                       size_t count,
+                       size_t nblocks)
+{
+    const uint8_t *p[MB_LANES];
+    MB_VEC a, b, c, d, aa, bb, cc, dd;
+    MB_VEC x[16];
+    int j = 0;
+
+    MB_FN(lanes)(p, blocks, count);
+
+    a = MB_FN(gather_state)(states, count, 0);
+    b = MB_FN(gather_state)(states, count, 1);
+    c = MB_FN(gather_state)(states, count, 2);
+    d = MB_FN(gather_state)(states, count, 3);
+
+    while (nblocks-- > 0) {
+
+        MB_FN(load)(x, p, 0);
+
+        aa = a;
+        bb = b;
+        cc = c;
+        dd = d;
+
+        MD5_ROUNDS(a, b, c, d, x);
+
+        a += aa;
+        b += bb;
+        c += cc;
+        d += dd;
+
+        for (j = 0; j < MB_LANES; j++) {
+            p[j] += 64;
+        }
+    }
+
+    MB_FN(scatter_state)(states, count, 0, a);
+    MB_FN(scatter_state)(states, count, 1, b);
+    MB_FN(scatter_state)(states, count, 2, c);
+    MB_FN(scatter_state)(states, count, 3, d);
+}
+
+static void MB_FN(sha1)(uint32_t *const *states,
+                        const uint8_t *const *blocks,
+                        size_t count,
+                        size_t nblocks)
+{
+    const uint8_t *p[MB_LANES];
+    MB_VEC a, b, c, d, e, aa, bb, cc, dd, ee;
+    MB_VEC w[16];
+    int j = 0;
+
+    MB_FN(lanes)(p, blocks, count);
+
+    a = MB_FN(gather_state)(states, count, 0);
+    b = MB_FN(gather_state)(states, count, 1);
+    c = MB_FN(gather_state)(states, count, 2);
+    d = MB_FN(gather_state)(states, count, 3);
+    e = MB_FN(gather_state)(states, count, 4);
+
+    while (nblocks-- > 0) {
+
+        MB_FN(load)(w, p, 1);
+
+        aa = a;
+        bb = b;
+        cc = c;
+        dd = d;
+        ee = e;
+
+        SHA1_ROUNDS(a, b, c, d, e, w);
+
+        a += aa;
+        b += bb;
+        c += cc;
+        d += dd;
+        e += ee;
+
+        for (j = 0; j < MB_LANES; j++) {
+            p[j] += 64;
+        }
+    }
+
+    MB_FN(scatter_state)(states, count, 0, a);
+    MB_FN(scatter_state)(states, count, 1, b);
+    MB_FN(scatter_state)(states, count, 2, c);
+    MB_FN(scatter_state)(states, count, 3, d);
+    MB_FN(scatter_state)(states, count, 4, e);
+}
+
+static void MB_FN(sha256)(uint32_t *const *states,
+                          const uint8_t *const *blocks,
+                          size_t count,
+                          size_t nblocks)
+{
+    const uint8_t *p[MB_LANES];
+    MB_VEC s[8], v[8], t1;
+    MB_VEC w[16];
+    int i = 0;
+    int j = 0;
+
+    MB_FN(lanes)(p, blocks, count);
+
+    for (i = 0; i < 8; i++) {
+        s[i] = MB_FN(gather_state)(states, count, i);
+    }
+
+    while (nblocks-- > 0) {
+
+        MB_FN(load)(w, p, 1);
+
+        for (i = 0; i < 8; i++) {
+            v[i] = s[i];
+        }
+
+        SHA256_ROUNDS(v[0], v[1], v[2], v[3], v[4], v[5], v[6], v[7], w, t1);
+
+        for (i = 0; i < 8; i++) {
+            s[i] += v[i];
+        }
+
+        for (j = 0; j < MB_LANES; j++) {
+            p[j] += 64;
+        }
+    }
+
+    for (i = 0; i < 8; i++) {
+        MB_FN(scatter_state)(states, count, i, s[i]);
+    }
+}
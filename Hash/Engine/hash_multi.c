@@ -0,0 +1,374 @@
+/*
+    Hash - hash_multi.c
+
+    History:
+
+    v. 1.0.0 (10/18/2026) - Initial version
+    v. 1.0.1 (10/18/2026) - add hash_multi_update_mapped
+    v. 1.0.2 (10/18/2026) - use a worker even for a single context, so
+                            that reading and hashing are pipelined
+
+    Copyright (c) 2026 Sriranga R. Veeraraghavan <ranga@calalum.org>
+
+    Permission is hereby granted, free of charge, to any person obtaining
+    a copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+    OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "hash_multi.h"
+
+/*
+    The ring is a sequence of buffers numbered by the order in which they
+    were submitted.  Buffer number n lives in slot n % bufferCount, and
+    the slot can be reused once every worker has consumed buffer n.
+    A slot's input normally points to its own buffer, but points into
+    the caller's memory for hash_multi_update_mapped.
+ */
+
+typedef struct hashMultiSlot {
+    unsigned char *data;
+    const unsigned char *input;
+    size_t length;
+} hashMultiSlot;
+
+typedef struct hashMultiWorker {
+    hashMultiContext *multi;
+    hashEngineContext *ctx;
+    unsigned long long consumed;
+    pthread_t thread;
+} hashMultiWorker;
+
+struct hashMultiContext {
+    hashEngineContext **ctxs;
+    size_t count;
+    int threaded;
+
+    hashMultiSlot *slots;
+    size_t bufferSize;
+    size_t bufferCount;
+
+    hashMultiWorker *workers;
+    size_t workersStarted;
+
+    pthread_mutex_t lock;
+    pthread_cond_t  dataReady;
+    pthread_cond_t  slotFree;
+    unsigned long long produced;
+    int shutdown;
+};
+
+/* the lowest buffer number not yet consumed by every worker, the lock
+   must be held */
+
+static unsigned long long minConsumed(const hashMultiContext *multi)
+{
+    unsigned long long min = multi->produced;
+    size_t i = 0;
+
+    for (i = 0; i < multi->count; i++) {
+        if (multi->workers[i].consumed < min) {
+            min = multi->workers[i].consumed;
+        }
+    }
+
+    return min;
+}
+
+/*
+    workerMain - consume buffers from the ring, in order, until shutdown
+ */
+
+static void *workerMain(void *arg)
+{
+    hashMultiWorker *worker = arg;
+    hashMultiContext *multi = worker->multi;
+    hashMultiSlot *slot = NULL;
+
+    pthread_mutex_lock(&multi->lock);
+
+    for (;;) {
+        while (worker->consumed == multi->produced && !multi->shutdown) {
+            pthread_cond_wait(&multi->dataReady, &multi->lock);
+        }
+
+        if (worker->consumed == multi->produced) {
+            break;
+        }
+
+        slot = &multi->slots[worker->consumed % multi->bufferCount];
+        pthread_mutex_unlock(&multi->lock);
+
+        hash_engine_update(worker->ctx, slot->input, slot->length);
+
+        pthread_mutex_lock(&multi->lock);
+        worker->consumed++;
+        pthread_cond_broadcast(&multi->slotFree);
+    }
+
+    pthread_mutex_unlock(&multi->lock);
+    return NULL;
+}
+
+hashMultiContext *hash_multi_new(hashEngineContext **ctxs,
+                                 size_t count,
+                                 int threaded,
+                                 size_t bufferSize,
+                                 size_t bufferCount)
+{
+    hashMultiContext *multi = NULL;
+    size_t i = 0;
+
+    if (ctxs == NULL || count == 0) {
+        return NULL;
+    }
+
+    multi = calloc(1, sizeof(hashMultiContext));
+    if (multi == NULL) {
+        return NULL;
+    }
+
+    multi->ctxs = ctxs;
+    multi->count = count;
+    multi->threaded = (threaded != 0);
+    multi->bufferSize = (bufferSize > 0 ?
+                         bufferSize : HASH_MULTI_DEFAULT_BUFFER_SIZE);
+
+    // inline updates only ever need a single buffer
+
+    multi->bufferCount = (!multi->threaded ? 1 :
+                          (bufferCount > 0 ?
+                           bufferCount : HASH_MULTI_DEFAULT_BUFFER_COUNT));
+
+    pthread_mutex_init(&multi->lock, NULL);
+    pthread_cond_init(&multi->dataReady, NULL);
+    pthread_cond_init(&multi->slotFree, NULL);
+
+    multi->slots = calloc(multi->bufferCount, sizeof(hashMultiSlot));
+    multi->workers = calloc(count, sizeof(hashMultiWorker));
+    if (multi->slots == NULL || multi->workers == NULL) {
+        hash_multi_free(multi);
+        return NULL;
+    }
+
+    for (i = 0; i < multi->bufferCount; i++) {
+        if (posix_memalign((void **)&multi->slots[i].data,
+                           HASH_MULTI_BUFFER_ALIGNMENT,
+                           multi->bufferSize) != 0) {
+            multi->slots[i].data = NULL;
+            hash_multi_free(multi);
+            return NULL;
+        }
+    }
+
+    for (i = 0; i < count; i++) {
+        multi->workers[i].multi = multi;
+        multi->workers[i].ctx = ctxs[i];
+    }
+
+    if (multi->threaded) {
+        for (i = 0; i < count; i++) {
+            if (pthread_create(&multi->workers[i].thread,
+                               NULL,
+                               workerMain,
+                               &multi->workers[i]) != 0) {
+                hash_multi_free(multi);
+                return NULL;
+            }
+            multi->workersStarted++;
+        }
+    }
+
+    return multi;
+}
+
+size_t hash_multi_buffer_size(const hashMultiContext *multi)
+{
+    return (multi != NULL ? multi->bufferSize : 0);
+}
+
+/* wait for the next slot to be free, and return it */
+
+static hashMultiSlot *acquireSlot(hashMultiContext *multi)
+{
+    hashMultiSlot *slot = NULL;
+
+    pthread_mutex_lock(&multi->lock);
+    while (multi->produced - minConsumed(multi) >= multi->bufferCount) {
+        pthread_cond_wait(&multi->slotFree, &multi->lock);
+    }
+    slot = &multi->slots[multi->produced % multi->bufferCount];
+    pthread_mutex_unlock(&multi->lock);
+
+    return slot;
+}
+
+/* publish the next slot to the workers */
+
+static void submitSlot(hashMultiContext *multi,
+                       const unsigned char *input,
+                       size_t length)
+{
+    hashMultiSlot *slot = NULL;
+
+    pthread_mutex_lock(&multi->lock);
+    slot = &multi->slots[multi->produced % multi->bufferCount];
+    slot->input = input;
+    slot->length = length;
+    multi->produced++;
+    pthread_cond_broadcast(&multi->dataReady);
+    pthread_mutex_unlock(&multi->lock);
+}
+
+unsigned char *hash_multi_acquire(hashMultiContext *multi)
+{
+    if (multi == NULL) {
+        return NULL;
+    }
+
+    if (!multi->threaded) {
+        return multi->slots[0].data;
+    }
+
+    return acquireSlot(multi)->data;
+}
+
+void hash_multi_submit(hashMultiContext *multi, size_t length)
+{
+    size_t i = 0;
+
+    if (multi == NULL || length == 0) {
+        return;
+    }
+
+    if (!multi->threaded) {
+        for (i = 0; i < multi->count; i++) {
+            hash_engine_update(multi->ctxs[i], multi->slots[0].data, length);
+        }
+        return;
+    }
+
+    submitSlot(multi,
+               multi->slots[multi->produced % multi->bufferCount].data,
+               length);
+}
+
+void hash_multi_update(hashMultiContext *multi,
+                       const void *data,
+                       size_t length)
+{
+    const unsigned char *p = data;
+    unsigned char *buffer = NULL;
+    size_t chunk = 0;
+    size_t i = 0;
+
+    if (multi == NULL || data == NULL) {
+        return;
+    }
+
+    // with inline updates there is no need to copy the data
+
+    if (!multi->threaded) {
+        for (i = 0; i < multi->count; i++) {
+            hash_engine_update(multi->ctxs[i], data, length);
+        }
+        return;
+    }
+
+    while (length > 0) {
+        chunk = (length > multi->bufferSize ? multi->bufferSize : length);
+        buffer = hash_multi_acquire(multi);
+        memcpy(buffer, p, chunk);
+        hash_multi_submit(multi, chunk);
+        p += chunk;
+        length -= chunk;
+    }
+}
+
+void hash_multi_update_mapped(hashMultiContext *multi,
+                              const void *data,
+                              size_t length)
+{
+    size_t i = 0;
+
+    if (multi == NULL || data == NULL || length == 0) {
+        return;
+    }
+
+    if (!multi->threaded) {
+        for (i = 0; i < multi->count; i++) {
+            hash_engine_update(multi->ctxs[i], data, length);
+        }
+        return;
+    }
+
+    // every worker reads the caller's memory directly
+
+    (void)acquireSlot(multi);
+    submitSlot(multi, data, length);
+}
+
+void hash_multi_wait(hashMultiContext *multi)
+{
+    if (multi == NULL || !multi->threaded) {
+        return;
+    }
+
+    pthread_mutex_lock(&multi->lock);
+    while (minConsumed(multi) < multi->produced) {
+        pthread_cond_wait(&multi->slotFree, &multi->lock);
+    }
+    pthread_mutex_unlock(&multi->lock);
+}
+
+void hash_multi_free(hashMultiContext *multi)
+{
+    size_t i = 0;
+
+    if (multi == NULL) {
+        return;
+    }
+
+    if (multi->workersStarted > 0) {
+        pthread_mutex_lock(&multi->lock);
+        multi->shutdown = 1;
+        pthread_cond_broadcast(&multi->dataReady);
+        pthread_mutex_unlock(&multi->lock);
+
+        for (i = 0; i < multi->workersStarted; i++) {
+            pthread_join(multi->workers[i].thread, NULL);
+        }
+    }
+
+    if (multi->slots != NULL) {
+        for (i = 0; i < multi->bufferCount; i++) {
+            free(multi->slots[i].data);
+        }
+        free(multi->slots);
+    }
+
+    free(multi->workers);
+
+    pthread_cond_destroy(&multi->slotFree);
+    pthread_cond_destroy(&multi->dataReady);
+    pthread_mutex_destroy(&multi->lock);
+
+    free(multi);
+}
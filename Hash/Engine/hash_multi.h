@@ -0,0 +1,125 @@
+/*
+    Hash - hash_multi.h
+
+    Single pass multi-digest support: one reader fills a ring of buffers
+    that is consumed by a set of hash contexts, each on its own worker
+    thread, so that computing N hashes of a file costs one read and
+    roughly the time of the slowest hash rather than the sum.  With a
+    single context, this is a read / hash pipeline: the next blocks are
+    read while the current one is being hashed.
+
+    History:
+
+    v. 1.0.0 (10/18/2026) - Initial version
+    v. 1.0.1 (10/18/2026) - add hash_multi_update_mapped
+    v. 1.0.2 (10/18/2026) - use a worker even for a single context
+
+    Copyright (c) 2026 Sriranga R. Veeraraghavan <ranga@calalum.org>
+
+    Permission is hereby granted, free of charge, to any person obtaining
+    a copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+    OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef hash_multi_h
+#define hash_multi_h
+
+#include "hash_engine.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Default ring geometry (queue depth x block size = 8 x 1MB), the
+// buffers are page aligned
+
+enum {
+    HASH_MULTI_DEFAULT_BUFFER_SIZE  = 1048576,
+    HASH_MULTI_DEFAULT_BUFFER_COUNT = 8,
+    HASH_MULTI_BUFFER_ALIGNMENT     = 4096,
+};
+
+typedef struct hashMultiContext hashMultiContext;
+
+/*
+    hash_multi_new - create a fan-out over count contexts (which remain
+                     owned by the caller).  If threaded is 0, updates are
+                     done inline by the caller's thread.  bufferSize (the
+                     block size) and bufferCount (the queue depth) may be
+                     0 to use the defaults.
+ */
+
+hashMultiContext *hash_multi_new(hashEngineContext **ctxs,
+                                 size_t count,
+                                 int threaded,
+                                 size_t bufferSize,
+                                 size_t bufferCount);
+
+/* the size of the buffers returned by hash_multi_acquire */
+
+size_t hash_multi_buffer_size(const hashMultiContext *multi);
+
+/*
+    hash_multi_acquire - return the next free buffer in the ring, waiting
+                         for the workers if all buffers are in use
+ */
+
+unsigned char *hash_multi_acquire(hashMultiContext *multi);
+
+/*
+    hash_multi_submit - hand the last acquired buffer, containing length
+                        bytes, to every context
+ */
+
+void hash_multi_submit(hashMultiContext *multi, size_t length);
+
+/*
+    hash_multi_update - copy data into the ring and submit it
+ */
+
+void hash_multi_update(hashMultiContext *multi,
+                       const void *data,
+                       size_t length);
+
+/*
+    hash_multi_update_mapped - hand data (e.g. a memory mapped file) to
+                               every context without copying it.  The
+                               data must remain valid until
+                               hash_multi_wait returns.
+ */
+
+void hash_multi_update_mapped(hashMultiContext *multi,
+                              const void *data,
+                              size_t length);
+
+/*
+    hash_multi_wait - wait until every context has consumed all of the
+                      submitted buffers; the contexts can then be
+                      finalized or reset by the caller
+ */
+
+void hash_multi_wait(hashMultiContext *multi);
+
+/* stop the workers and free the ring (but not the contexts) */
+
+void hash_multi_free(hashMultiContext *multi);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* hash_multi_h */
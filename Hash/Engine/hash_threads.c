@@ -0,0 +1,260 @@
+/*
+    Hash - hash_threads.c
+
+    History:
+
+    v. 1.0.0 (10/18/2026) - Initial version
+
+    Copyright (c) 2026 Sriranga R. Veeraraghavan <ranga@calalum.org>
+
+    Permission is hereby granted, free of charge, to any person obtaining
+    a copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+    OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <pthread.h>
+#include <unistd.h>
+
+#include "hash_threads.h"
+
+/*
+    Each hash_threads_run call queues a batch of count jobs.  Workers
+    take the next unclaimed job of the oldest batch, and the caller
+    takes the unclaimed jobs of its own batch, so a batch is finished
+    even if every worker is busy with other batches, and a job that
+    runs hash_threads_run itself only ever waits on jobs that some
+    thread is actively running.  A batch is removed from the queue
+    once all of its jobs have been claimed, and it is done once they
+    have all finished.
+ */
+
+typedef struct hashThreadsBatch {
+    struct hashThreadsBatch *next;
+    hashThreadsFn fn;
+    void *arg;
+    size_t count;
+    size_t claimed;
+    size_t finished;
+} hashThreadsBatch;
+
+static struct {
+    pthread_once_t once;
+    pthread_mutex_t lock;
+    pthread_cond_t queued;
+    pthread_cond_t done;
+    hashThreadsBatch *head;
+    hashThreadsBatch *tail;
+    size_t workers;
+} gPool = {
+    PTHREAD_ONCE_INIT,
+    PTHREAD_MUTEX_INITIALIZER,
+    PTHREAD_COND_INITIALIZER,
+    PTHREAD_COND_INITIALIZER,
+    NULL,
+    NULL,
+    0,
+};
+
+static pthread_once_t gCpusOnce = PTHREAD_ONCE_INIT;
+static size_t gCpus = 1;
+
+/* cpusInit - look up the number of cpus, once */
+
+static void cpusInit(void)
+{
+    long cpus = 1;
+
+#if defined(_SC_NPROCESSORS_ONLN)
+    cpus = sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+    gCpus = (cpus > 1 ? (size_t)cpus : 1);
+}
+
+/* batchUnlink - remove a batch from the queue, the lock must be held */
+
+static void batchUnlink(hashThreadsBatch *batch)
+{
+    hashThreadsBatch **p = &gPool.head;
+    hashThreadsBatch *prev = NULL;
+
+    while (*p != NULL) {
+        if (*p == batch) {
+            *p = batch->next;
+            if (gPool.tail == batch) {
+                gPool.tail = prev;
+            }
+            return;
+        }
+        prev = *p;
+        p = &(*p)->next;
+    }
+}
+
+/*
+    batchClaim - claim the next job of a batch with unclaimed jobs, the
+                 lock must be held.  returns the job's index.
+ */
+
+static size_t batchClaim(hashThreadsBatch *batch)
+{
+    size_t index = batch->claimed++;
+
+    if (batch->claimed == batch->count) {
+        batchUnlink(batch);
+    }
+
+    return index;
+}
+
+/* workerMain - run jobs from the queue, for the life of the process */
+
+static void *workerMain(void *arg)
+{
+    hashThreadsBatch *batch = NULL;
+    size_t index = 0;
+
+    (void)arg;
+
+    pthread_mutex_lock(&gPool.lock);
+    for (;;) {
+        while (gPool.head == NULL) {
+            pthread_cond_wait(&gPool.queued, &gPool.lock);
+        }
+
+        batch = gPool.head;
+        index = batchClaim(batch);
+        pthread_mutex_unlock(&gPool.lock);
+
+        batch->fn(batch->arg, index);
+
+        // the caller may return as soon as finished reaches count, so
+        // the batch can't be touched after this
+
+        pthread_mutex_lock(&gPool.lock);
+        if (++batch->finished == batch->count) {
+            pthread_cond_broadcast(&gPool.done);
+        }
+    }
+
+    // not reached
+    return NULL;
+}
+
+/* poolStart - start one worker per additional cpu */
+
+static void poolStart(void)
+{
+    pthread_t thread;
+    size_t i = 0;
+
+    pthread_once(&gCpusOnce, cpusInit);
+
+    for (i = 1; i < gCpus && i < HASH_THREADS_MAX; i++) {
+        if (pthread_create(&thread, NULL, workerMain, NULL) != 0) {
+            break;
+        }
+        pthread_detach(thread);
+        gPool.workers++;
+    }
+}
+
+size_t hash_threads_count(unsigned long long work,
+                          unsigned long long minPerThread,
+                          size_t maxThreads)
+{
+    unsigned long long count = work / (minPerThread > 0 ? minPerThread : 1);
+
+    if (count < 2) {
+        return 1;
+    }
+
+    pthread_once(&gCpusOnce, cpusInit);
+
+    if (count > gCpus) {
+        count = gCpus;
+    }
+    if (maxThreads > 0 && count > maxThreads) {
+        count = maxThreads;
+    }
+    if (count > HASH_THREADS_MAX) {
+        count = HASH_THREADS_MAX;
+    }
+
+    return (size_t)count;
+}
+
+void hash_threads_run(size_t count, hashThreadsFn fn, void *arg)
+{
+    hashThreadsBatch batch;
+    size_t index = 0;
+    size_t i = 0;
+
+    if (count == 0 || fn == NULL) {
+        return;
+    }
+
+    if (count > 1) {
+        pthread_once(&gPool.once, poolStart);
+    }
+
+    if (count == 1 || gPool.workers == 0) {
+        for (i = 0; i < count; i++) {
+            fn(arg, i);
+        }
+        return;
+    }
+
+    batch.next = NULL;
+    batch.fn = fn;
+    batch.arg = arg;
+    batch.count = count;
+    batch.claimed = 0;
+    batch.finished = 0;
+
+    pthread_mutex_lock(&gPool.lock);
+
+    if (gPool.tail != NULL) {
+        gPool.tail->next = &batch;
+    } else {
+        gPool.head = &batch;
+    }
+    gPool.tail = &batch;
+
+    if (count - 1 >= gPool.workers) {
+        pthread_cond_broadcast(&gPool.queued);
+    } else {
+        for (i = 1; i < count; i++) {
+            pthread_cond_signal(&gPool.queued);
+        }
+    }
+
+    while (batch.claimed < batch.count) {
+        index = batchClaim(&batch);
+        pthread_mutex_unlock(&gPool.lock);
+
+        fn(arg, index);
+
+        pthread_mutex_lock(&gPool.lock);
+        batch.finished++;
+    }
+
+    while (batch.finished < batch.count) {
+        pthread_cond_wait(&gPool.done, &gPool.lock);
+    }
+
+    pthread_mutex_unlock(&gPool.lock);
+}
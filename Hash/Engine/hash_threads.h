@@ -0,0 +1,84 @@
+/*
+    Hash - hash_threads.h
+
+    A process wide pool of worker threads for splitting a single large
+    update across cpus (tree leaves, subtrees, CRC segments, ...).  The
+    caller fills in an array of independent jobs and runs them with
+    hash_threads_run, which returns once all of them are done.  The
+    workers are started the first time they are needed, one per extra
+    cpu, and stay around for the life of the process, so an update
+    only pays for waking them, not for creating them.
+
+    History:
+
+    v. 1.0.0 (10/18/2026) - Initial version
+
+    Copyright (c) 2026 Sriranga R. Veeraraghavan <ranga@calalum.org>
+
+    Permission is hereby granted, free of charge, to any person obtaining
+    a copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+    OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef hash_threads_h
+#define hash_threads_h
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Upper limit on the number of threads a single update is split across
+
+enum {
+    HASH_THREADS_MAX = 64,
+};
+
+/* runs job index of the jobs at arg */
+
+typedef void (*hashThreadsFn)(void *arg, size_t index);
+
+/*
+    hash_threads_count - returns how many threads work (in any unit)
+                         should be split across, with at least
+                         minPerThread of it per thread, and at most one
+                         thread per cpu, maxThreads or HASH_THREADS_MAX,
+                         whichever is smallest.  returns 1 if the work
+                         isn't worth splitting.
+ */
+
+size_t hash_threads_count(unsigned long long work,
+                          unsigned long long minPerThread,
+                          size_t maxThreads);
+
+/*
+    hash_threads_run - run fn(arg, 0) ... fn(arg, count - 1) on the pool
+                       and the calling thread, and wait for all of
+                       them.  the calling thread runs the jobs that no
+                       worker has picked up, so this works (serially)
+                       without any workers, and may be called from a
+                       job.
+ */
+
+void hash_threads_run(size_t count, hashThreadsFn fn, void *arg);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* hash_threads_h */
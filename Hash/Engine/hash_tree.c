@@ -0,0 +1,1009 @@
+/*
+    Hash - hash_tree.c
+
+    Recursive directory hashing with a work-stealing pool of workers
+
+    History:
+
+    v. 1.0.0 (10/18/2026) - Initial version
+    v. 1.0.1 (10/18/2026) - look up and store digests in a hashCache
+    v. 1.0.2 (10/18/2026) - hash lists of files, report results as the
+                            files finish (unordered), stop early when
+                            the callback asks to
+    v. 1.0.3 (10/18/2026) - read a mapped file instead if it was
+                            truncated while it was being hashed
+
+    Copyright (c) 2026 Sriranga R. Veeraraghavan <ranga@calalum.org>
+
+    Permission is hereby granted, free of charge, to any person obtaining
+    a copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+    OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "hash_map.h"
+#include "hash_tree.h"
+
+/*
+    The walk appends files to a batch, in walk order.  When the batch is
+    full (or the walk is over), its files are sorted by size and dealt
+    round robin to one deque per worker, so every deque holds its share
+    of the batch, largest file first.  A worker takes files from the
+    front of its own deque, and once that is empty, steals from the
+    front of the others, so the largest remaining file is always the
+    next one started and the big files don't end up as stragglers.  The
+    caller's thread prints the results in walk order as the files are
+    finished, then starts the next batch.  With unordered results, the
+    workers also queue the files as they finish them, and the caller
+    reports them in that order instead.
+ */
+
+// With unordered results, the caller is only woken up once enough files
+// (or bytes) have been finished, or when a worker runs out of files, so
+// that it isn't woken for every small file
+
+enum {
+    HashTreeReportFiles = 256,
+    HashTreeReportBytes = 16777216,
+};
+
+typedef struct hashTreeFile {
+    char *path;
+    unsigned long long size;
+    hashCacheKey key;
+    unsigned int flags;
+    int err;
+    int done;
+} hashTreeFile;
+
+typedef struct hashTreeDeque {
+    pthread_mutex_t lock;
+    size_t *items;
+    size_t head;
+    size_t tail;
+} hashTreeDeque;
+
+typedef struct hashTree hashTree;
+
+typedef struct hashTreeWorker {
+    hashTree *tree;
+    size_t index;
+    hashEngineContext **ctxs;
+    unsigned char *buffer;
+    unsigned char *cached;
+    pthread_t thread;
+} hashTreeWorker;
+
+struct hashTree {
+    const hashTreeOptions *options;
+    hashTreeCallback callback;
+    void *arg;
+
+    hashTreeFile *files;
+    size_t fileCount;
+    unsigned char *digests;
+    size_t digestStride;
+    size_t *digestOffsets;
+    size_t *digestLengths;
+    const unsigned char **digestPtrs;
+
+    hashTreeDeque *deques;
+    hashTreeWorker *workers;
+    size_t workerCount;
+    size_t workersStarted;
+    size_t bufferSize;
+
+    pthread_mutex_t lock;
+    pthread_cond_t  workReady;
+    pthread_cond_t  fileDone;
+    unsigned long long generation;
+    size_t nextResult;
+    size_t *completed;
+    size_t completedCount;
+    size_t pendingFiles;
+    unsigned long long pendingBytes;
+    size_t batchBase;
+    int shutdown;
+    int failed;
+    int stopped;
+};
+
+typedef struct hashTreeOrder {
+    unsigned long long size;
+    size_t index;
+} hashTreeOrder;
+
+/* orderCompare - sort files by decreasing size, then in walk order */
+
+static int orderCompare(const void *a, const void *b)
+{
+    const hashTreeOrder *x = a;
+    const hashTreeOrder *y = b;
+
+    if (x->size != y->size) {
+        return (x->size > y->size ? -1 : 1);
+    }
+    return (x->index < y->index ? -1 : (x->index > y->index));
+}
+
+static int nameCompare(const void *a, const void *b)
+{
+    return strcmp(*(char *const *)a, *(char *const *)b);
+}
+
+/*
+    takeFile - take the next file for a worker, from its own deque or,
+               failing that, from another worker's.  returns SIZE_MAX
+               when every deque is empty.
+ */
+
+static size_t takeFile(hashTree *tree, size_t self)
+{
+    hashTreeDeque *deque = NULL;
+    size_t index = SIZE_MAX;
+    size_t i = 0;
+
+    for (i = 0; i < tree->workerCount && index == SIZE_MAX; i++) {
+        deque = &tree->deques[(self + i) % tree->workerCount];
+        pthread_mutex_lock(&deque->lock);
+        if (deque->head < deque->tail) {
+            index = deque->items[deque->head++];
+        }
+        pthread_mutex_unlock(&deque->lock);
+    }
+
+    return index;
+}
+
+static int keysEqual(const hashCacheKey *a, const hashCacheKey *b)
+{
+    return (a->device == b->device && a->inode == b->inode &&
+            a->size == b->size && a->mtime == b->mtime &&
+            a->ctime == b->ctime);
+}
+
+/*
+    lookupAll - copy the cached digests for every requested hash to
+                digests.  returns 1 if they were all cached.
+ */
+
+static int lookupAll(hashTree *tree,
+                     const hashCacheKey *key,
+                     unsigned char *digests)
+{
+    const hashTreeOptions *options = tree->options;
+    size_t i = 0;
+
+    for (i = 0; i < options->count; i++) {
+        if (hash_cache_lookup(options->cache,
+                              key,
+                              options->types[i],
+                              digests + tree->digestOffsets[i],
+                              tree->digestLengths[i]) != 0) {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+/*
+    hashOne - hash a file with every requested hash, storing the digests
+              in the batch's digest array.  With a cache, a file that
+              hasn't changed since it was last hashed isn't read (unless
+              the cache is being checked), and the new digests of the
+              other files are stored.  returns 0 or an errno value.
+ */
+
+static int hashOne(hashTreeWorker *worker, size_t index)
+{
+    hashTree *tree = worker->tree;
+    hashTreeFile *file = &tree->files[index];
+    unsigned char *digests = tree->digests + index*tree->digestStride;
+    hashCache *cache = tree->options->cache;
+    hashMappedFile map = { NULL, 0 };
+    hashCacheKey opened;
+    hashCacheKey closed;
+    struct stat sb;
+    ssize_t bytesRead = 0;
+    size_t count = tree->options->count;
+    size_t i = 0;
+    int mapped = 0;
+    int cached = 0;
+    int storable = (cache != NULL);
+    int rc = 0;
+    int err = 0;
+    int fd = -1;
+
+    if (cache != NULL) {
+        cached = lookupAll(tree, &file->key, worker->cached);
+        if (cached && !tree->options->paranoid) {
+            memcpy(digests, worker->cached, tree->digestStride);
+            file->flags = HASH_TREE_FLAG_CACHED;
+            return 0;
+        }
+    }
+
+    fd = open(file->path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return errno;
+    }
+
+    // the digests are only cached if the file didn't change while it
+    // was being read
+
+    if (cache != NULL) {
+        if (fstat(fd, &sb) == 0) {
+            hash_cache_key(&sb, &opened);
+        } else {
+            storable = 0;
+        }
+    }
+
+    for (i = 0; i < count; i++) {
+        hash_engine_reset(worker->ctxs[i]);
+    }
+
+    mapped = (!tree->options->noMap && hash_map_fd(fd, &map) == 0);
+    if (mapped) {
+        for (i = 0; i < count; i++) {
+            hash_engine_update(worker->ctxs[i], map.data, map.length);
+        }
+
+        // if the file was truncated, the hashes saw zeros instead of
+        // the missing pages, so start over reading the file
+
+        if (hash_map_truncated(&map)) {
+            for (i = 0; i < count; i++) {
+                hash_engine_reset(worker->ctxs[i]);
+            }
+            if (lseek(fd, 0, SEEK_SET) != 0) {
+                err = errno;
+            }
+            mapped = 0;
+        }
+        hash_unmap(&map);
+    }
+
+    if (!mapped && err == 0) {
+#if defined(POSIX_FADV_SEQUENTIAL)
+        (void)posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+        for (;;) {
+            bytesRead = read(fd, worker->buffer, tree->bufferSize);
+            if (bytesRead < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                err = errno;
+                break;
+            }
+            if (bytesRead == 0) {
+                break;
+            }
+            for (i = 0; i < count; i++) {
+                hash_engine_update(worker->ctxs[i],
+                                   worker->buffer,
+                                   (size_t)bytesRead);
+            }
+        }
+    }
+
+    if (storable) {
+        if (fstat(fd, &sb) == 0) {
+            hash_cache_key(&sb, &closed);
+            storable = keysEqual(&opened, &closed);
+        } else {
+            storable = 0;
+        }
+    }
+
+    close(fd);
+
+    // collisions (sha1dc) are not cached, so they are reported every time
+
+    for (i = 0; i < count && err == 0; i++) {
+        rc = hash_engine_final(worker->ctxs[i],
+                               digests + tree->digestOffsets[i]);
+        if (rc < 0) {
+            err = EINVAL;
+        } else if (rc > 0) {
+            storable = 0;
+        }
+    }
+
+    if (err != 0) {
+        return err;
+    }
+
+    if (cached && storable && keysEqual(&file->key, &opened) &&
+        memcmp(digests, worker->cached, tree->digestStride) != 0) {
+        file->flags = HASH_TREE_FLAG_CACHE_MISMATCH;
+    }
+
+    for (i = 0; i < count && storable; i++) {
+        (void)hash_cache_store(cache,
+                               &opened,
+                               tree->options->types[i],
+                               digests + tree->digestOffsets[i],
+                               tree->digestLengths[i]);
+    }
+
+    return 0;
+}
+
+/*
+    workerMain - hash files from the deques whenever a batch is started,
+                 until shutdown
+ */
+
+static void *workerMain(void *arg)
+{
+    hashTreeWorker *worker = arg;
+    hashTree *tree = worker->tree;
+    unsigned long long seen = 0;
+    size_t index = 0;
+    int err = 0;
+
+    pthread_mutex_lock(&tree->lock);
+
+    for (;;) {
+        while (tree->generation == seen && !tree->shutdown) {
+            pthread_cond_wait(&tree->workReady, &tree->lock);
+        }
+
+        if (tree->generation == seen) {
+            break;
+        }
+
+        seen = tree->generation;
+        pthread_mutex_unlock(&tree->lock);
+
+        while ((index = takeFile(tree, worker->index)) != SIZE_MAX) {
+            err = hashOne(worker, index);
+
+            pthread_mutex_lock(&tree->lock);
+            tree->files[index].err = err;
+            tree->files[index].done = 1;
+            if (tree->options->unordered) {
+                tree->completed[tree->completedCount++] = index;
+                tree->pendingFiles++;
+                tree->pendingBytes += tree->files[index].size;
+                if (tree->pendingFiles >= HashTreeReportFiles ||
+                    tree->pendingBytes >= HashTreeReportBytes) {
+                    tree->pendingFiles = 0;
+                    tree->pendingBytes = 0;
+                    pthread_cond_signal(&tree->fileDone);
+                }
+            } else if (index == tree->nextResult) {
+                pthread_cond_signal(&tree->fileDone);
+            }
+            pthread_mutex_unlock(&tree->lock);
+        }
+
+        pthread_mutex_lock(&tree->lock);
+        if (tree->pendingFiles > 0) {
+            tree->pendingFiles = 0;
+            tree->pendingBytes = 0;
+            pthread_cond_signal(&tree->fileDone);
+        }
+    }
+
+    pthread_mutex_unlock(&tree->lock);
+    return NULL;
+}
+
+/*
+    cancelPending - empty the deques once the callback has asked to stop,
+                    marking the files that weren't started as done
+ */
+
+static void cancelPending(hashTree *tree)
+{
+    hashTreeDeque *deque = NULL;
+    size_t index = 0;
+    size_t i = 0;
+
+    for (i = 0; i < tree->workerCount; i++) {
+        deque = &tree->deques[i];
+        pthread_mutex_lock(&deque->lock);
+        pthread_mutex_lock(&tree->lock);
+        while (deque->head < deque->tail) {
+            index = deque->items[deque->head++];
+            tree->files[index].err = ECANCELED;
+            tree->files[index].done = 1;
+            if (tree->options->unordered) {
+                tree->completed[tree->completedCount++] = index;
+            }
+        }
+        pthread_mutex_unlock(&tree->lock);
+        pthread_mutex_unlock(&deque->lock);
+    }
+}
+
+/*
+    reportFile - pass a finished file to the callback, and stop if the
+                 callback asks to
+ */
+
+static void reportFile(hashTree *tree, size_t index)
+{
+    hashTreeFile *file = &tree->files[index];
+    size_t i = 0;
+    int stop = 0;
+
+    if (file->err != 0) {
+        tree->failed = 1;
+        stop = tree->callback(tree->arg,
+                              tree->batchBase + index,
+                              file->path,
+                              file->err,
+                              0,
+                              NULL);
+    } else {
+        for (i = 0; i < tree->options->count; i++) {
+            tree->digestPtrs[i] = tree->digests + index*tree->digestStride +
+                                  tree->digestOffsets[i];
+        }
+        stop = tree->callback(tree->arg,
+                              tree->batchBase + index,
+                              file->path,
+                              0,
+                              file->flags,
+                              tree->digestPtrs);
+    }
+
+    if (stop != 0) {
+        tree->stopped = 1;
+        cancelPending(tree);
+    }
+}
+
+/*
+    runBatch - hash the files in the batch and report them, in walk order
+               (or as they finish).  returns 0 on success, 1 if the
+               callback stopped the walk.
+ */
+
+static int runBatch(hashTree *tree)
+{
+    hashTreeOrder *order = NULL;
+    hashTreeFile *file = NULL;
+    size_t scheduled = 0;
+    size_t reported = 0;
+    size_t index = 0;
+    size_t i = 0;
+    size_t j = 0;
+
+    if (tree->fileCount == 0) {
+        return 0;
+    }
+
+    order = malloc(tree->fileCount * sizeof(hashTreeOrder));
+    if (order == NULL) {
+        return -1;
+    }
+
+    // files that failed during the walk are already done
+
+    tree->completedCount = 0;
+
+    for (i = 0; i < tree->fileCount; i++) {
+        if (!tree->files[i].done) {
+            order[scheduled].size = tree->files[i].size;
+            order[scheduled].index = i;
+            scheduled++;
+        } else if (tree->options->unordered) {
+            tree->completed[tree->completedCount++] = i;
+        }
+    }
+
+    qsort(order, scheduled, sizeof(hashTreeOrder), orderCompare);
+
+    for (i = 0; i < tree->workerCount; i++) {
+        pthread_mutex_lock(&tree->deques[i].lock);
+        tree->deques[i].head = 0;
+        tree->deques[i].tail = 0;
+        for (j = i; j < scheduled; j += tree->workerCount) {
+            tree->deques[i].items[tree->deques[i].tail++] = order[j].index;
+        }
+        pthread_mutex_unlock(&tree->deques[i].lock);
+    }
+
+    free(order);
+
+    pthread_mutex_lock(&tree->lock);
+    tree->nextResult = 0;
+    if (scheduled > 0) {
+        tree->generation++;
+        pthread_cond_broadcast(&tree->workReady);
+    }
+
+    // once the callback has stopped the walk, the remaining files are
+    // only waited for (the ones being hashed still use the batch)
+
+    for (reported = 0; reported < tree->fileCount; reported++) {
+        if (tree->options->unordered) {
+            while (tree->completedCount <= reported) {
+                pthread_cond_wait(&tree->fileDone, &tree->lock);
+            }
+            index = tree->completed[reported];
+        } else {
+            index = reported;
+            while (!tree->files[index].done) {
+                pthread_cond_wait(&tree->fileDone, &tree->lock);
+            }
+        }
+        pthread_mutex_unlock(&tree->lock);
+
+        file = &tree->files[index];
+        if (!tree->stopped) {
+            reportFile(tree, index);
+        }
+
+        free(file->path);
+        file->path = NULL;
+
+        pthread_mutex_lock(&tree->lock);
+        tree->nextResult = reported + 1;
+    }
+
+    tree->batchBase += tree->fileCount;
+    tree->fileCount = 0;
+    pthread_mutex_unlock(&tree->lock);
+
+    return (tree->stopped ? 1 : 0);
+}
+
+/*
+    addFile - add a file (or, if err is not 0, a failure) to the batch,
+              taking ownership of path.  sb is the result of stat (or
+              NULL for a failure).  returns 0 on success, or 1 if the
+              walk was stopped.
+ */
+
+static int addFile(hashTree *tree,
+                   char *path,
+                   const struct stat *sb,
+                   int err)
+{
+    hashTreeFile *file = NULL;
+    int rc = 0;
+
+    if (tree->fileCount == HASH_TREE_BATCH_SIZE) {
+        rc = runBatch(tree);
+        if (rc != 0) {
+            free(path);
+            return rc;
+        }
+    }
+
+    file = &tree->files[tree->fileCount++];
+    memset(file, 0, sizeof(hashTreeFile));
+    file->path = path;
+    file->err = err;
+    file->done = (err != 0);
+    if (sb != NULL) {
+        file->size = (unsigned long long)sb->st_size;
+        hash_cache_key(sb, &file->key);
+    }
+
+    return 0;
+}
+
+/* joinPath - return dir/name in a new string */
+
+static char *joinPath(const char *dir, const char *name)
+{
+    size_t dirLength = strlen(dir);
+    size_t nameLength = strlen(name);
+    int slash = (dirLength > 0 && dir[dirLength - 1] != '/');
+    char *path = NULL;
+
+    path = malloc(dirLength + slash + nameLength + 1);
+    if (path == NULL) {
+        return NULL;
+    }
+
+    memcpy(path, dir, dirLength);
+    if (slash) {
+        path[dirLength] = '/';
+    }
+    memcpy(path + dirLength + slash, name, nameLength + 1);
+
+    return path;
+}
+
+/*
+    walkDir - add the files in the directory open on fd (named path) to
+              the batch, descending into its subdirectories in sorted
+              order.  fd is closed.  returns 0 on success, 1 if the
+              walk was stopped, or -1 if memory could not be allocated.
+ */
+
+static int walkDir(hashTree *tree, int fd, const char *path)
+{
+    struct stat sb;
+    struct dirent *entry = NULL;
+    DIR *dir = NULL;
+    char **names = NULL;
+    char **grown = NULL;
+    char *child = NULL;
+    size_t nameCount = 0;
+    size_t nameCapacity = 0;
+    size_t i = 0;
+    int childFd = -1;
+    int err = 0;
+    int rc = 0;
+
+    dir = fdopendir(fd);
+    if (dir == NULL) {
+        err = errno;
+        close(fd);
+        child = strdup(path);
+        return (child == NULL ? -1 : addFile(tree, child, NULL, err));
+    }
+
+    // read the whole directory before descending, so that only one
+    // descriptor per level is open, and sort the names so that the
+    // output does not depend on the file system's order
+
+    errno = 0;
+    while ((entry = readdir(dir)) != NULL) {
+        if (strcmp(entry->d_name, ".") == 0 ||
+            strcmp(entry->d_name, "..") == 0) {
+            continue;
+        }
+
+        if (nameCount == nameCapacity) {
+            nameCapacity = (nameCapacity > 0 ? nameCapacity*2 : 64);
+            grown = realloc(names, nameCapacity * sizeof(char *));
+            if (grown == NULL) {
+                rc = -1;
+                break;
+            }
+            names = grown;
+        }
+
+        names[nameCount] = strdup(entry->d_name);
+        if (names[nameCount] == NULL) {
+            rc = -1;
+            break;
+        }
+        nameCount++;
+        errno = 0;
+    }
+
+    if (rc == 0 && errno != 0) {
+        err = errno;
+        child = strdup(path);
+        rc = (child == NULL ? -1 : addFile(tree, child, NULL, err));
+    }
+
+    if (nameCount > 0) {
+        qsort(names, nameCount, sizeof(char *), nameCompare);
+    }
+
+    for (i = 0; i < nameCount && rc == 0; i++) {
+        child = joinPath(path, names[i]);
+        if (child == NULL) {
+            rc = -1;
+            break;
+        }
+
+        if (fstatat(dirfd(dir), names[i], &sb, AT_SYMLINK_NOFOLLOW) != 0) {
+            rc = addFile(tree, child, NULL, errno);
+        } else if (S_ISREG(sb.st_mode)) {
+            rc = addFile(tree, child, &sb, 0);
+        } else if (S_ISDIR(sb.st_mode)) {
+            childFd = openat(dirfd(dir),
+                             names[i],
+                             O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+            if (childFd < 0) {
+                rc = addFile(tree, child, NULL, errno);
+            } else {
+                rc = walkDir(tree, childFd, child);
+                free(child);
+            }
+        } else {
+            free(child);
+        }
+    }
+
+    for (i = 0; i < nameCount; i++) {
+        free(names[i]);
+    }
+    free(names);
+    closedir(dir);
+
+    return rc;
+}
+
+/* freeTree - stop the workers and release the tree's resources */
+
+static void freeTree(hashTree *tree)
+{
+    size_t i = 0;
+    size_t j = 0;
+
+    if (tree->workersStarted > 0) {
+        pthread_mutex_lock(&tree->lock);
+        tree->shutdown = 1;
+        pthread_cond_broadcast(&tree->workReady);
+        pthread_mutex_unlock(&tree->lock);
+
+        for (i = 0; i < tree->workersStarted; i++) {
+            pthread_join(tree->workers[i].thread, NULL);
+        }
+    }
+
+    for (i = 0; i < tree->workerCount; i++) {
+        if (tree->workers != NULL) {
+            if (tree->workers[i].ctxs != NULL) {
+                for (j = 0; j < tree->options->count; j++) {
+                    hash_engine_free(tree->workers[i].ctxs[j]);
+                }
+                free(tree->workers[i].ctxs);
+            }
+            free(tree->workers[i].buffer);
+            free(tree->workers[i].cached);
+        }
+        if (tree->deques != NULL) {
+            free(tree->deques[i].items);
+            pthread_mutex_destroy(&tree->deques[i].lock);
+        }
+    }
+
+    for (i = 0; tree->files != NULL && i < tree->fileCount; i++) {
+        free(tree->files[i].path);
+    }
+
+    free(tree->workers);
+    free(tree->deques);
+    free(tree->files);
+    free(tree->completed);
+    free(tree->digests);
+    free(tree->digestOffsets);
+    free(tree->digestLengths);
+    free(tree->digestPtrs);
+
+    pthread_cond_destroy(&tree->fileDone);
+    pthread_cond_destroy(&tree->workReady);
+    pthread_mutex_destroy(&tree->lock);
+}
+
+/* initTree - allocate the batch, the deques and the workers */
+
+static int initTree(hashTree *tree)
+{
+    const hashEngineDescriptor *desc = NULL;
+    const hashTreeOptions *options = tree->options;
+    size_t dequeCapacity = 0;
+    size_t i = 0;
+    size_t j = 0;
+    long cpus = 0;
+
+    pthread_mutex_init(&tree->lock, NULL);
+    pthread_cond_init(&tree->workReady, NULL);
+    pthread_cond_init(&tree->fileDone, NULL);
+
+    tree->workerCount = options->threads;
+    if (tree->workerCount == 0) {
+        cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        tree->workerCount = (cpus > 0 ? (size_t)cpus : 1);
+    }
+    if (tree->workerCount > HASH_TREE_MAX_THREADS) {
+        tree->workerCount = HASH_TREE_MAX_THREADS;
+    }
+
+    tree->bufferSize = (options->bufferSize > 0 ?
+                        options->bufferSize :
+                        HASH_TREE_DEFAULT_BUFFER_SIZE);
+
+    tree->digestOffsets = calloc(options->count, sizeof(size_t));
+    tree->digestLengths = calloc(options->count, sizeof(size_t));
+    tree->digestPtrs = calloc(options->count, sizeof(unsigned char *));
+    if (tree->digestOffsets == NULL || tree->digestLengths == NULL ||
+        tree->digestPtrs == NULL) {
+        return -1;
+    }
+
+    for (i = 0; i < options->count; i++) {
+        desc = hash_engine_descriptor(options->types[i]);
+        if (desc == NULL) {
+            return -1;
+        }
+        tree->digestOffsets[i] = tree->digestStride;
+        tree->digestLengths[i] = desc->digestLength;
+        tree->digestStride += desc->digestLength;
+    }
+
+    tree->files = calloc(HASH_TREE_BATCH_SIZE, sizeof(hashTreeFile));
+    tree->completed = malloc(HASH_TREE_BATCH_SIZE * sizeof(size_t));
+    tree->digests = malloc(HASH_TREE_BATCH_SIZE * tree->digestStride);
+    tree->deques = calloc(tree->workerCount, sizeof(hashTreeDeque));
+    tree->workers = calloc(tree->workerCount, sizeof(hashTreeWorker));
+    if (tree->files == NULL || tree->completed == NULL ||
+        tree->digests == NULL || tree->deques == NULL ||
+        tree->workers == NULL) {
+        return -1;
+    }
+
+    dequeCapacity = HASH_TREE_BATCH_SIZE / tree->workerCount + 1;
+
+    for (i = 0; i < tree->workerCount; i++) {
+        pthread_mutex_init(&tree->deques[i].lock, NULL);
+        tree->deques[i].items = malloc(dequeCapacity * sizeof(size_t));
+
+        tree->workers[i].tree = tree;
+        tree->workers[i].index = i;
+        tree->workers[i].ctxs = calloc(options->count,
+                                       sizeof(hashEngineContext *));
+        tree->workers[i].buffer = malloc(tree->bufferSize);
+        tree->workers[i].cached = malloc(tree->digestStride);
+        if (tree->deques[i].items == NULL ||
+            tree->workers[i].ctxs == NULL ||
+            tree->workers[i].buffer == NULL ||
+            tree->workers[i].cached == NULL) {
+            return -1;
+        }
+
+        for (j = 0; j < options->count; j++) {
+            tree->workers[i].ctxs[j] = hash_engine_new(options->types[j]);
+            if (tree->workers[i].ctxs[j] == NULL) {
+                return -1;
+            }
+        }
+    }
+
+    for (i = 0; i < tree->workerCount; i++) {
+        if (pthread_create(&tree->workers[i].thread,
+                           NULL,
+                           workerMain,
+                           &tree->workers[i]) != 0) {
+            return -1;
+        }
+        tree->workersStarted++;
+    }
+
+    return 0;
+}
+
+int hash_tree(const char *root,
+              const hashTreeOptions *options,
+              hashTreeCallback callback,
+              void *arg)
+{
+    hashTree tree;
+    struct stat sb;
+    char *path = NULL;
+    int fd = -1;
+    int rc = 0;
+
+    if (root == NULL || options == NULL || options->types == NULL ||
+        options->count == 0 || callback == NULL) {
+        return -1;
+    }
+
+    memset(&tree, 0, sizeof(tree));
+    tree.options = options;
+    tree.callback = callback;
+    tree.arg = arg;
+
+    if (initTree(&tree) != 0) {
+        freeTree(&tree);
+        return -1;
+    }
+
+    // the root itself is followed if it is a symbolic link
+
+    path = strdup(root);
+    if (path == NULL) {
+        rc = -1;
+    } else if (stat(root, &sb) != 0) {
+        rc = addFile(&tree, path, NULL, errno);
+    } else if (S_ISDIR(sb.st_mode)) {
+        fd = open(root, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (fd < 0) {
+            rc = addFile(&tree, path, NULL, errno);
+        } else {
+            rc = walkDir(&tree, fd, root);
+            free(path);
+        }
+    } else {
+        rc = addFile(&tree, path, &sb, 0);
+    }
+
+    if (rc == 0) {
+        rc = runBatch(&tree);
+    }
+
+    if (tree.stopped) {
+        rc = 1;
+    } else if (tree.failed) {
+        rc = -1;
+    }
+
+    freeTree(&tree);
+
+    return rc;
+}
+
+int hash_tree_list(hashTreeNextPath next,
+                   void *nextArg,
+                   const hashTreeOptions *options,
+                   hashTreeCallback callback,
+                   void *arg)
+{
+    hashTree tree;
+    struct stat sb;
+    const char *name = NULL;
+    char *path = NULL;
+    int rc = 0;
+
+    if (next == NULL || options == NULL || options->types == NULL ||
+        options->count == 0 || callback == NULL) {
+        return -1;
+    }
+
+    memset(&tree, 0, sizeof(tree));
+    tree.options = options;
+    tree.callback = callback;
+    tree.arg = arg;
+
+    if (initTree(&tree) != 0) {
+        freeTree(&tree);
+        return -1;
+    }
+
+    while (rc == 0 && (name = next(nextArg)) != NULL) {
+        path = strdup(name);
+        if (path == NULL) {
+            rc = -1;
+        } else if (stat(name, &sb) != 0) {
+            rc = addFile(&tree, path, NULL, errno);
+        } else if (S_ISDIR(sb.st_mode)) {
+            rc = addFile(&tree, path, NULL, EISDIR);
+        } else {
+            rc = addFile(&tree, path, &sb, 0);
+        }
+    }
+
+    if (rc == 0) {
+        rc = runBatch(&tree);
+    }
+
+    if (tree.stopped) {
+        rc = 1;
+    } else if (tree.failed) {
+        rc = -1;
+    }
+
+    freeTree(&tree);
+
+    return rc;
+}
@@ -0,0 +1,145 @@
+/*
+    Hash - hash_tree.h
+
+    Recursive directory hashing: a tree is walked in a deterministic
+    (sorted) order, its regular files are hashed by a pool of worker
+    threads, largest file first, and the results are handed back to the
+    caller in walk order.
+
+    History:
+
+    v. 1.0.0 (10/18/2026) - Initial version
+    v. 1.0.1 (10/18/2026) - look up and store digests in a hashCache
+    v. 1.0.2 (10/18/2026) - add hash_tree_list, unordered results, and
+                            a way for the callback to stop the walk
+
+    Copyright (c) 2026 Sriranga R. Veeraraghavan <ranga@calalum.org>
+
+    Permission is hereby granted, free of charge, to any person obtaining
+    a copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+    OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef hash_tree_h
+#define hash_tree_h
+
+#include "hash_cache.h"
+#include "hash_engine.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Files are scheduled in batches of up to HASH_TREE_BATCH_SIZE files (in
+// walk order), so that memory use does not grow with the size of the
+// tree and results start to appear before the walk is over.  Files of
+// HASH_MAP_MIN_FILE_SIZE bytes or more are memory mapped.
+
+enum {
+    HASH_TREE_BATCH_SIZE          = 16384,
+    HASH_TREE_DEFAULT_BUFFER_SIZE = 1048576,
+    HASH_TREE_MAX_THREADS         = 256,
+};
+
+// Result flags
+
+enum {
+
+    /* the digests came from the cache, the file was not read */
+
+    HASH_TREE_FLAG_CACHED         = 1 << 0,
+
+    /* paranoid mode: the file's size and times match the cache, but
+       its contents don't (the digests are the ones just computed) */
+
+    HASH_TREE_FLAG_CACHE_MISMATCH = 1 << 1,
+};
+
+/*
+    hashTreeCallback - called, on the caller's thread and in walk order
+                       (unless unordered is set), for each file (or
+                       directory that could not be read).  index is the
+                       file's position in the walk (or list), counting
+                       from 0.  digests[i] is the digest for the i-th
+                       requested hash, flags is a combination of the
+                       HASH_TREE_FLAG values.  If err is not 0, it is the
+                       errno value for the failure and digests is NULL.
+                       Return 0 to carry on, or anything else to stop:
+                       files that haven't been started are skipped, and
+                       no more results are reported.
+ */
+
+typedef int (*hashTreeCallback)(void *arg,
+                                size_t index,
+                                const char *path,
+                                int err,
+                                unsigned int flags,
+                                const unsigned char *const *digests);
+
+/*
+    hashTreeNextPath - return the next file to hash for hash_tree_list,
+                       or NULL at the end of the list.  The string only
+                       has to remain valid until the next call.
+ */
+
+typedef const char *(*hashTreeNextPath)(void *arg);
+
+typedef struct hashTreeOptions {
+    const HashType *types;      // the hashes to compute
+    size_t          count;      // the number of hashes
+    size_t          threads;    // worker threads, 0 for one per cpu
+    size_t          bufferSize; // read size, 0 for the default
+    int             noMap;      // if not 0, read files instead of mapping
+    hashCache      *cache;      // optional digest cache
+    int             paranoid;   // if not 0, read files even on cache hits
+    int             unordered;  // if not 0, report files as they finish
+} hashTreeOptions;
+
+/*
+    hash_tree - hash every regular file under root (which may itself be
+                a regular file).  Directory entries are visited in
+                strcmp order, symbolic links are not followed, and
+                special files are skipped.  returns 0 if every file was
+                hashed, or -1 if the arguments are invalid, resources
+                could not be allocated, or any file or directory failed
+                (the failures are also reported through callback), or
+                1 if callback stopped the walk.
+ */
+
+int hash_tree(const char *root,
+              const hashTreeOptions *options,
+              hashTreeCallback callback,
+              void *arg);
+
+/*
+    hash_tree_list - like hash_tree, for the files returned by next
+                     (called with nextArg), in batches, in list order.
+                     Symbolic links are followed, directories are
+                     reported as EISDIR failures.
+ */
+
+int hash_tree_list(hashTreeNextPath next,
+                   void *nextArg,
+                   const hashTreeOptions *options,
+                   hashTreeCallback callback,
+                   void *arg);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* hash_tree_h */
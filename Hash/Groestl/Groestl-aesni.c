@@ -0,0 +1,720 @@
+/*
+    Hash - Groestl-aesni.c
+
+    History:
+
+    v. 1.0.0 (10/18/2026) - Initial version
+
+    Copyright (c) 2026 Sriranga R. Veeraraghavan <ranga@calalum.org>
+
+    Permission is hereby granted, free of charge, to any person obtaining
+    a copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+    OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <string.h>
+
+#include "Groestl-aesni.h"
+
+/*
+    The rounds of P and Q are those of AES on an 8 row state: the table
+    code (Groestl-opt.c) looks up each column's bytes in 8KB of tables,
+    here the state is kept as rows, one row per SSE register, and:
+
+    - AddRoundConstant xors constants into whole rows,
+    - ShiftBytes rotates each row with a byte shuffle, which also undoes
+      the ShiftRows of AESENCLAST,
+    - SubBytes is AESENCLAST with a zero round key,
+    - MixBytes multiplies the rows by the circulant matrix
+      (2, 2, 3, 4, 5, 3, 5, 7) in GF(2^8), one byte per column.
+
+    For the short variants (Groestl-224/256) a row of P and the same row
+    of Q share a register, P in the low 8 bytes and Q in the high 8
+    bytes, so both permutations run together.  For the long variants
+    (Groestl-384/512) each row is a register, and P and Q are run one
+    after the other.
+
+    Messages and the chaining value are stored by columns (byte 8*c + r
+    is row r of column c), and are transposed into rows with byte
+    shuffles and unpacks.  The chaining value stays in rows while the
+    blocks passed to groestl_aesni_transform are compressed.
+ */
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+
+#define GROESTL_AESNI_X86 1
+
+#include <immintrin.h>
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("aes,ssse3"))), apply_to = function)
+#else
+#pragma GCC push_options
+#pragma GCC target("aes,ssse3")
+#endif
+
+/*
+    ShiftBytes shuffles, applied before AESENCLAST, whose ShiftRows
+    moves byte j to byte SR[j] = {0, 5, 10, 15, 4, 9, 14, 3, 8, 13, 2,
+    7, 12, 1, 6, 11}.  To rotate a row so that byte c comes from byte
+    S[c], the shuffle takes byte j from S[SR^-1[j]].
+ */
+
+/* short variants: row r of P (rotated by r) and of Q (by 1, 3, 5, 7,
+   0, 2, 4, 6) */
+
+static const unsigned char groestl_aesni_shift512[8][16]
+__attribute__((aligned(16))) = {
+    { 0, 14, 11,  7,  4,  1, 15, 12,  9,  5,  2,  8, 13, 10,  6,  3 },
+    { 1,  8, 13,  0,  5,  2,  9, 14, 11,  6,  3, 10, 15, 12,  7,  4 },
+    { 2, 10, 15,  1,  6,  3, 11,  8, 13,  7,  4, 12,  9, 14,  0,  5 },
+    { 3, 12,  9,  2,  7,  4, 13, 10, 15,  0,  5, 14, 11,  8,  1,  6 },
+    { 4, 13, 10,  3,  0,  5, 14, 11,  8,  1,  6, 15, 12,  9,  2,  7 },
+    { 5, 15, 12,  4,  1,  6,  8, 13, 10,  2,  7,  9, 14, 11,  3,  0 },
+    { 6,  9, 14,  5,  2,  7, 10, 15, 12,  3,  0, 11,  8, 13,  4,  1 },
+    { 7, 11,  8,  6,  3,  0, 12,  9, 14,  4,  1, 13, 10, 15,  5,  2 },
+};
+
+/* long variants: row r of P is rotated by 0, 1, 2, 3, 4, 5, 6, 11 and
+   row r of Q by 1, 3, 5, 11, 0, 2, 4, 6 */
+
+static const unsigned char groestl_aesni_shift1024P[8][16]
+__attribute__((aligned(16))) = {
+    {  0, 13, 10,  7,  4,  1, 14, 11,  8,  5,  2, 15, 12,  9,  6,  3 },
+    {  1, 14, 11,  8,  5,  2, 15, 12,  9,  6,  3,  0, 13, 10,  7,  4 },
+    {  2, 15, 12,  9,  6,  3,  0, 13, 10,  7,  4,  1, 14, 11,  8,  5 },
+    {  3,  0, 13, 10,  7,  4,  1, 14, 11,  8,  5,  2, 15, 12,  9,  6 },
+    {  4,  1, 14, 11,  8,  5,  2, 15, 12,  9,  6,  3,  0, 13, 10,  7 },
+    {  5,  2, 15, 12,  9,  6,  3,  0, 13, 10,  7,  4,  1, 14, 11,  8 },
+    {  6,  3,  0, 13, 10,  7,  4,  1, 14, 11,  8,  5,  2, 15, 12,  9 },
+    { 11,  8,  5,  2, 15, 12,  9,  6,  3,  0, 13, 10,  7,  4,  1, 14 },
+};
+
+static const unsigned char groestl_aesni_shift1024Q[8][16]
+__attribute__((aligned(16))) = {
+    {  1, 14, 11,  8,  5,  2, 15, 12,  9,  6,  3,  0, 13, 10,  7,  4 },
+    {  3,  0, 13, 10,  7,  4,  1, 14, 11,  8,  5,  2, 15, 12,  9,  6 },
+    {  5,  2, 15, 12,  9,  6,  3,  0, 13, 10,  7,  4,  1, 14, 11,  8 },
+    { 11,  8,  5,  2, 15, 12,  9,  6,  3,  0, 13, 10,  7,  4,  1, 14 },
+    {  0, 13, 10,  7,  4,  1, 14, 11,  8,  5,  2, 15, 12,  9,  6,  3 },
+    {  2, 15, 12,  9,  6,  3,  0, 13, 10,  7,  4,  1, 14, 11,  8,  5 },
+    {  4,  1, 14, 11,  8,  5,  2, 15, 12,  9,  6,  3,  0, 13, 10,  7 },
+    {  6,  3,  0, 13, 10,  7,  4,  1, 14, 11,  8,  5,  2, 15, 12,  9 },
+};
+
+/* groestl_aesni_xtime - multiply each byte by 2 in GF(2^8), modulo
+   x^8 + x^4 + x^3 + x + 1 */
+
+static inline __m128i groestl_aesni_xtime(__m128i x)
+{
+    const __m128i poly = _mm_set1_epi8(0x1b);
+    __m128i carry = _mm_cmpgt_epi8(_mm_setzero_si128(), x);
+
+    return _mm_xor_si128(_mm_add_epi8(x, x), _mm_and_si128(carry, poly));
+}
+
+/*
+    GROESTL_AESNI_MIX_BYTES - MixBytes on rows a (of type T, with the
+                              xor and xtime functions XOR and XTIME).
+                              Row i is written as 2*(u + 2*v) + w,
+                              where (indices mod 8)
+
+        u = a[i] + a[i+1] + a[i+2] + a[i+5] + a[i+7]
+        v = a[i+3] + a[i+4] + a[i+6] + a[i+7]
+        w = a[i+2] + a[i+4] + a[i+5] + a[i+6] + a[i+7]
+
+    and t[i] = a[i] + a[i+1] is shared between the rows
+ */
+
+#define GROESTL_AESNI_MIX_ROW(b, a, t, i, T, XOR, XTIME) \
+    do { \
+        T u, v, w; \
+        v = XOR(t[((i) + 3) & 7], t[((i) + 6) & 7]); \
+        w = XOR(XOR(a[((i) + 2) & 7], t[((i) + 4) & 7]), \
+                t[((i) + 6) & 7]); \
+        u = XOR(XOR(t[(i)], a[((i) + 2) & 7]), \
+                XOR(a[((i) + 5) & 7], a[((i) + 7) & 7])); \
+        u = XOR(u, XTIME(v)); \
+        b[(i)] = XOR(XTIME(u), w); \
+    } while (0)
+
+#define GROESTL_AESNI_MIX_BYTES(a, T, XOR, XTIME) \
+    do { \
+        T t[8], b[8]; \
+        int i_; \
+        for (i_ = 0; i_ < 8; i_++) { \
+            t[i_] = XOR(a[i_], a[(i_ + 1) & 7]); \
+        } \
+        GROESTL_AESNI_MIX_ROW(b, a, t, 0, T, XOR, XTIME); \
+        GROESTL_AESNI_MIX_ROW(b, a, t, 1, T, XOR, XTIME); \
+        GROESTL_AESNI_MIX_ROW(b, a, t, 2, T, XOR, XTIME); \
+        GROESTL_AESNI_MIX_ROW(b, a, t, 3, T, XOR, XTIME); \
+        GROESTL_AESNI_MIX_ROW(b, a, t, 4, T, XOR, XTIME); \
+        GROESTL_AESNI_MIX_ROW(b, a, t, 5, T, XOR, XTIME); \
+        GROESTL_AESNI_MIX_ROW(b, a, t, 6, T, XOR, XTIME); \
+        GROESTL_AESNI_MIX_ROW(b, a, t, 7, T, XOR, XTIME); \
+        for (i_ = 0; i_ < 8; i_++) { \
+            a[i_] = b[i_]; \
+        } \
+    } while (0)
+
+static inline void groestl_aesni_mix_bytes(__m128i a[8])
+{
+    GROESTL_AESNI_MIX_BYTES(a, __m128i, _mm_xor_si128, groestl_aesni_xtime);
+}
+
+/* groestl_aesni_sub_shift - ShiftBytes and SubBytes on rows x */
+
+#define GROESTL_AESNI_SUB_SHIFT(x, shift, zero, r) \
+    x[(r)] = _mm_aesenclast_si128( \
+                 _mm_shuffle_epi8(x[(r)], \
+                     _mm_load_si128((const __m128i *)shift[(r)])), \
+                 zero)
+
+static inline void groestl_aesni_sub_shift(__m128i x[8],
+                                           const unsigned char shift[8][16])
+{
+    const __m128i zero = _mm_setzero_si128();
+
+    GROESTL_AESNI_SUB_SHIFT(x, shift, zero, 0);
+    GROESTL_AESNI_SUB_SHIFT(x, shift, zero, 1);
+    GROESTL_AESNI_SUB_SHIFT(x, shift, zero, 2);
+    GROESTL_AESNI_SUB_SHIFT(x, shift, zero, 3);
+    GROESTL_AESNI_SUB_SHIFT(x, shift, zero, 4);
+    GROESTL_AESNI_SUB_SHIFT(x, shift, zero, 5);
+    GROESTL_AESNI_SUB_SHIFT(x, shift, zero, 6);
+    GROESTL_AESNI_SUB_SHIFT(x, shift, zero, 7);
+}
+
+#undef GROESTL_AESNI_SUB_SHIFT
+
+/*
+    groestl_aesni_perm512 - 10 rounds of P (low halves) and Q (high
+                            halves) of the short variants.  P's round
+                            constant goes into row 0, Q's into row 7,
+                            after every byte of Q is complemented.
+ */
+
+static void groestl_aesni_perm512(__m128i x[8])
+{
+    const __m128i pRow0 = _mm_setr_epi8(0x00, 0x10, 0x20, 0x30,
+                                        0x40, 0x50, 0x60, 0x70,
+                                        -1, -1, -1, -1, -1, -1, -1, -1);
+    const __m128i qRow7 = _mm_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0,
+                                        -0x01, -0x11, -0x21, -0x31,
+                                        -0x41, -0x51, -0x61, -0x71);
+    const __m128i qRows = _mm_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0,
+                                        -1, -1, -1, -1, -1, -1, -1, -1);
+    __m128i round;
+    int r = 0;
+
+    for (r = 0; r < 10; r++) {
+        round = _mm_set1_epi8((char)r);
+        x[0] = _mm_xor_si128(x[0], _mm_xor_si128(pRow0,
+                   _mm_andnot_si128(qRows, round)));
+        x[1] = _mm_xor_si128(x[1], qRows);
+        x[2] = _mm_xor_si128(x[2], qRows);
+        x[3] = _mm_xor_si128(x[3], qRows);
+        x[4] = _mm_xor_si128(x[4], qRows);
+        x[5] = _mm_xor_si128(x[5], qRows);
+        x[6] = _mm_xor_si128(x[6], qRows);
+        x[7] = _mm_xor_si128(x[7], _mm_xor_si128(qRow7,
+                   _mm_and_si128(qRows, round)));
+        groestl_aesni_sub_shift(x, groestl_aesni_shift512);
+        groestl_aesni_mix_bytes(x);
+    }
+}
+
+/* groestl_aesni_perm1024 - 14 rounds of P (q == 0) or Q (q == 1) of the
+                            long variants */
+
+static inline void groestl_aesni_perm1024(__m128i x[8], int q)
+{
+    const __m128i pRow0 = _mm_setr_epi8(0x00, 0x10, 0x20, 0x30,
+                                        0x40, 0x50, 0x60, 0x70,
+                                        -0x80, -0x70, -0x60, -0x50,
+                                        -0x40, -0x30, -0x20, -0x10);
+    const __m128i ones = _mm_set1_epi8(-1);
+    __m128i round;
+    int r = 0;
+
+    for (r = 0; r < 14; r++) {
+        round = _mm_set1_epi8((char)r);
+        if (q) {
+            x[0] = _mm_xor_si128(x[0], ones);
+            x[1] = _mm_xor_si128(x[1], ones);
+            x[2] = _mm_xor_si128(x[2], ones);
+            x[3] = _mm_xor_si128(x[3], ones);
+            x[4] = _mm_xor_si128(x[4], ones);
+            x[5] = _mm_xor_si128(x[5], ones);
+            x[6] = _mm_xor_si128(x[6], ones);
+            x[7] = _mm_xor_si128(x[7], _mm_xor_si128(
+                       _mm_xor_si128(pRow0, ones), round));
+            groestl_aesni_sub_shift(x, groestl_aesni_shift1024Q);
+        } else {
+            x[0] = _mm_xor_si128(x[0], _mm_xor_si128(pRow0, round));
+            groestl_aesni_sub_shift(x, groestl_aesni_shift1024P);
+        }
+        groestl_aesni_mix_bytes(x);
+    }
+}
+
+/* the bytes of each 16 byte pair of columns, ordered by row */
+
+#define GROESTL_AESNI_PAIR_ROWS(x) \
+    _mm_shuffle_epi8((x), _mm_setr_epi8(0, 8, 1, 9, 2, 10, 3, 11, \
+                                        4, 12, 5, 13, 6, 14, 7, 15))
+
+/*
+    groestl_aesni_rows512 - transpose the 8 columns at in into rows,
+                            two rows per register: rows 2k and 2k + 1
+                            are in pair[k]
+ */
+
+static inline void groestl_aesni_rows512(const unsigned char *in,
+                                         __m128i pair[4])
+{
+    __m128i y0, y1, y2, y3, a, b, c, d;
+
+    y0 = GROESTL_AESNI_PAIR_ROWS(_mm_loadu_si128((const __m128i *)in));
+    y1 = GROESTL_AESNI_PAIR_ROWS(_mm_loadu_si128((const __m128i *)(in + 16)));
+    y2 = GROESTL_AESNI_PAIR_ROWS(_mm_loadu_si128((const __m128i *)(in + 32)));
+    y3 = GROESTL_AESNI_PAIR_ROWS(_mm_loadu_si128((const __m128i *)(in + 48)));
+
+    // columns 0-3 of rows 0-3 and 4-7, then columns 4-7
+
+    a = _mm_unpacklo_epi16(y0, y1);
+    b = _mm_unpackhi_epi16(y0, y1);
+    c = _mm_unpacklo_epi16(y2, y3);
+    d = _mm_unpackhi_epi16(y2, y3);
+
+    pair[0] = _mm_unpacklo_epi32(a, c);
+    pair[1] = _mm_unpackhi_epi32(a, c);
+    pair[2] = _mm_unpacklo_epi32(b, d);
+    pair[3] = _mm_unpackhi_epi32(b, d);
+}
+
+/* groestl_aesni_rows1024 - transpose the 16 columns at in into rows */
+
+static inline void groestl_aesni_rows1024(const unsigned char *in,
+                                          __m128i row[8])
+{
+    __m128i y[8], lo[4], hi[4], e0, e1, f0, f1;
+    int j = 0;
+
+    for (j = 0; j < 8; j++) {
+        y[j] = GROESTL_AESNI_PAIR_ROWS(
+                   _mm_loadu_si128((const __m128i *)(in + 16*j)));
+    }
+
+    // lo[k] - columns 4k to 4k + 3 of rows 0-3, hi[k] - of rows 4-7
+
+    for (j = 0; j < 4; j++) {
+        lo[j] = _mm_unpacklo_epi16(y[2*j], y[2*j + 1]);
+        hi[j] = _mm_unpackhi_epi16(y[2*j], y[2*j + 1]);
+    }
+
+    e0 = _mm_unpacklo_epi32(lo[0], lo[1]);
+    e1 = _mm_unpackhi_epi32(lo[0], lo[1]);
+    f0 = _mm_unpacklo_epi32(lo[2], lo[3]);
+    f1 = _mm_unpackhi_epi32(lo[2], lo[3]);
+    row[0] = _mm_unpacklo_epi64(e0, f0);
+    row[1] = _mm_unpackhi_epi64(e0, f0);
+    row[2] = _mm_unpacklo_epi64(e1, f1);
+    row[3] = _mm_unpackhi_epi64(e1, f1);
+
+    e0 = _mm_unpacklo_epi32(hi[0], hi[1]);
+    e1 = _mm_unpackhi_epi32(hi[0], hi[1]);
+    f0 = _mm_unpacklo_epi32(hi[2], hi[3]);
+    f1 = _mm_unpackhi_epi32(hi[2], hi[3]);
+    row[4] = _mm_unpacklo_epi64(e0, f0);
+    row[5] = _mm_unpackhi_epi64(e0, f0);
+    row[6] = _mm_unpacklo_epi64(e1, f1);
+    row[7] = _mm_unpackhi_epi64(e1, f1);
+}
+
+#undef GROESTL_AESNI_PAIR_ROWS
+
+/* groestl_aesni_columns - store rows (cols bytes each, one after the
+                           other in rows) back as columns */
+
+static void groestl_aesni_columns(const unsigned char *rows,
+                                  unsigned char *out,
+                                  int cols)
+{
+    int r = 0, c = 0;
+
+    for (r = 0; r < 8; r++) {
+        for (c = 0; c < cols; c++) {
+            out[8*c + r] = rows[r*cols + c];
+        }
+    }
+}
+
+static void groestl_aesni_transform512(unsigned char *chaining,
+                                       const unsigned char *input,
+                                       int blocks)
+{
+    __m128i h[4], m[4], x[8];
+    unsigned char rows[64] __attribute__((aligned(16)));
+    int k = 0;
+
+    groestl_aesni_rows512(chaining, h);
+
+    for (; blocks > 0; blocks--, input += 64) {
+
+        // P(h + m) in the low halves, Q(m) in the high halves
+
+        groestl_aesni_rows512(input, m);
+        for (k = 0; k < 4; k++) {
+            __m128i p = _mm_xor_si128(h[k], m[k]);
+            x[2*k] = _mm_unpacklo_epi64(p, m[k]);
+            x[2*k + 1] = _mm_unpackhi_epi64(p, m[k]);
+        }
+
+        groestl_aesni_perm512(x);
+
+        // h = h + P(h + m) + Q(m)
+
+        for (k = 0; k < 4; k++) {
+            h[k] = _mm_xor_si128(h[k],
+                       _mm_xor_si128(_mm_unpacklo_epi64(x[2*k], x[2*k + 1]),
+                                     _mm_unpackhi_epi64(x[2*k], x[2*k + 1])));
+        }
+    }
+
+    for (k = 0; k < 4; k++) {
+        _mm_store_si128((__m128i *)(rows + 16*k), h[k]);
+    }
+    groestl_aesni_columns(rows, chaining, 8);
+}
+
+static void groestl_aesni_transform1024(unsigned char *chaining,
+                                        const unsigned char *input,
+                                        int blocks)
+{
+    __m128i h[8], p[8], q[8];
+    unsigned char rows[128] __attribute__((aligned(16)));
+    int r = 0;
+
+    groestl_aesni_rows1024(chaining, h);
+
+    for (; blocks > 0; blocks--, input += 128) {
+        groestl_aesni_rows1024(input, q);
+        for (r = 0; r < 8; r++) {
+            p[r] = _mm_xor_si128(h[r], q[r]);
+        }
+
+        groestl_aesni_perm1024(p, 0);
+        groestl_aesni_perm1024(q, 1);
+
+        for (r = 0; r < 8; r++) {
+            h[r] = _mm_xor_si128(h[r], _mm_xor_si128(p[r], q[r]));
+        }
+    }
+
+    for (r = 0; r < 8; r++) {
+        _mm_store_si128((__m128i *)(rows + 16*r), h[r]);
+    }
+    groestl_aesni_columns(rows, chaining, 16);
+}
+
+static void groestl_aesni_output512(unsigned char *chaining)
+{
+    __m128i h[4], x[8];
+    unsigned char rows[64] __attribute__((aligned(16)));
+    int k = 0;
+
+    // only P is needed, the high halves are ignored
+
+    groestl_aesni_rows512(chaining, h);
+    for (k = 0; k < 4; k++) {
+        x[2*k] = h[k];
+        x[2*k + 1] = _mm_unpackhi_epi64(h[k], h[k]);
+    }
+
+    groestl_aesni_perm512(x);
+
+    for (k = 0; k < 4; k++) {
+        h[k] = _mm_xor_si128(h[k], _mm_unpacklo_epi64(x[2*k], x[2*k + 1]));
+        _mm_store_si128((__m128i *)(rows + 16*k), h[k]);
+    }
+    groestl_aesni_columns(rows, chaining, 8);
+}
+
+static void groestl_aesni_output1024(unsigned char *chaining)
+{
+    __m128i h[8], p[8];
+    unsigned char rows[128] __attribute__((aligned(16)));
+    int r = 0;
+
+    groestl_aesni_rows1024(chaining, h);
+    for (r = 0; r < 8; r++) {
+        p[r] = h[r];
+    }
+
+    groestl_aesni_perm1024(p, 0);
+
+    for (r = 0; r < 8; r++) {
+        _mm_store_si128((__m128i *)(rows + 16*r), _mm_xor_si128(h[r], p[r]));
+    }
+    groestl_aesni_columns(rows, chaining, 16);
+}
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#else
+#pragma GCC pop_options
+#endif
+
+/*
+    VAES - the long variants' P (low 128 bits) and Q (high 128 bits)
+    run together in AVX2 registers, as the short variants' do in SSE
+    registers
+ */
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("avx2,vaes"))), apply_to = function)
+#else
+#pragma GCC push_options
+#pragma GCC target("avx2,vaes")
+#endif
+
+static inline __m256i groestl_vaes_xtime(__m256i x)
+{
+    const __m256i poly = _mm256_set1_epi8(0x1b);
+    __m256i carry = _mm256_cmpgt_epi8(_mm256_setzero_si256(), x);
+
+    return _mm256_xor_si256(_mm256_add_epi8(x, x),
+                            _mm256_and_si256(carry, poly));
+}
+
+static inline void groestl_vaes_mix_bytes(__m256i a[8])
+{
+    GROESTL_AESNI_MIX_BYTES(a, __m256i, _mm256_xor_si256, groestl_vaes_xtime);
+}
+
+static void groestl_vaes_perm1024(__m256i x[8])
+{
+    const __m128i pRow0 = _mm_setr_epi8(0x00, 0x10, 0x20, 0x30,
+                                        0x40, 0x50, 0x60, 0x70,
+                                        -0x80, -0x70, -0x60, -0x50,
+                                        -0x40, -0x30, -0x20, -0x10);
+    const __m128i ones = _mm_set1_epi8(-1);
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i row0 = _mm256_set_m128i(ones, pRow0);
+    const __m256i qRows = _mm256_set_m128i(ones, _mm_setzero_si128());
+    const __m256i row7 = _mm256_set_m128i(_mm_xor_si128(pRow0, ones),
+                                          _mm_setzero_si128());
+    __m256i shift[8], round;
+    int r = 0;
+
+    for (r = 0; r < 8; r++) {
+        shift[r] = _mm256_set_m128i(
+                       _mm_load_si128((const __m128i *)
+                                      groestl_aesni_shift1024Q[r]),
+                       _mm_load_si128((const __m128i *)
+                                      groestl_aesni_shift1024P[r]));
+    }
+
+    for (r = 0; r < 14; r++) {
+        round = _mm256_set1_epi8((char)r);
+        x[0] = _mm256_xor_si256(x[0], _mm256_xor_si256(row0,
+                   _mm256_andnot_si256(qRows, round)));
+        x[1] = _mm256_xor_si256(x[1], qRows);
+        x[2] = _mm256_xor_si256(x[2], qRows);
+        x[3] = _mm256_xor_si256(x[3], qRows);
+        x[4] = _mm256_xor_si256(x[4], qRows);
+        x[5] = _mm256_xor_si256(x[5], qRows);
+        x[6] = _mm256_xor_si256(x[6], qRows);
+        x[7] = _mm256_xor_si256(x[7], _mm256_xor_si256(row7,
+                   _mm256_and_si256(qRows, round)));
+
+        x[0] = _mm256_aesenclast_epi128(_mm256_shuffle_epi8(x[0], shift[0]), zero);
+        x[1] = _mm256_aesenclast_epi128(_mm256_shuffle_epi8(x[1], shift[1]), zero);
+        x[2] = _mm256_aesenclast_epi128(_mm256_shuffle_epi8(x[2], shift[2]), zero);
+        x[3] = _mm256_aesenclast_epi128(_mm256_shuffle_epi8(x[3], shift[3]), zero);
+        x[4] = _mm256_aesenclast_epi128(_mm256_shuffle_epi8(x[4], shift[4]), zero);
+        x[5] = _mm256_aesenclast_epi128(_mm256_shuffle_epi8(x[5], shift[5]), zero);
+        x[6] = _mm256_aesenclast_epi128(_mm256_shuffle_epi8(x[6], shift[6]), zero);
+        x[7] = _mm256_aesenclast_epi128(_mm256_shuffle_epi8(x[7], shift[7]), zero);
+
+        groestl_vaes_mix_bytes(x);
+    }
+}
+
+static void groestl_vaes_transform1024(unsigned char *chaining,
+                                       const unsigned char *input,
+                                       int blocks)
+{
+    __m128i h[8], m[8];
+    __m256i x[8];
+    unsigned char rows[128] __attribute__((aligned(16)));
+    int r = 0;
+
+    groestl_aesni_rows1024(chaining, h);
+
+    for (; blocks > 0; blocks--, input += 128) {
+        groestl_aesni_rows1024(input, m);
+        for (r = 0; r < 8; r++) {
+            x[r] = _mm256_set_m128i(m[r], _mm_xor_si128(h[r], m[r]));
+        }
+
+        groestl_vaes_perm1024(x);
+
+        for (r = 0; r < 8; r++) {
+            h[r] = _mm_xor_si128(h[r],
+                       _mm_xor_si128(_mm256_castsi256_si128(x[r]),
+                                     _mm256_extracti128_si256(x[r], 1)));
+        }
+    }
+
+    for (r = 0; r < 8; r++) {
+        _mm_store_si128((__m128i *)(rows + 16*r), h[r]);
+    }
+    groestl_aesni_columns(rows, chaining, 16);
+}
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#else
+#pragma GCC pop_options
+#endif
+
+#undef GROESTL_AESNI_MIX_ROW
+#undef GROESTL_AESNI_MIX_BYTES
+
+#endif /* __x86_64__ && (__GNUC__ || __clang__) */
+
+/* dispatch */
+
+static int gAllowAesni = 1;
+static int gAllowVaes = 1;
+static int gSelected = 0;
+static int gUseAesni = 0;
+static int gUseVaes = 0;
+
+/*
+    groestl_select - use AES-NI if allowed and the cpu has it (and SSSE3
+                     for the byte shuffles), and for the long variants,
+                     VAES with AVX2
+
+    VAES is only used for the long variants' compression function.  It
+    replaces two passes of the 128 bit permutation (P, then Q) with one
+    pass over both, and was measured (hashbench, Xeon with AVX-512) at
+    41.7 vs. 43.9 cycles/byte for 64 byte messages, 9.7 vs. 11.5 for 1KB
+    and 7.0 vs. 8.7 for 1MB and up, so it is selected whenever the cpu
+    has it.  The output transformation (P alone) and the short variants
+    (P and Q already share a 128 bit register) have nothing to gain.
+ */
+
+static void groestl_select(void)
+{
+    gUseAesni = 0;
+    gUseVaes = 0;
+
+#if defined(GROESTL_AESNI_X86)
+    if (gAllowAesni &&
+        __builtin_cpu_supports("aes") &&
+        __builtin_cpu_supports("ssse3")) {
+        gUseAesni = 1;
+        if (gAllowVaes &&
+            __builtin_cpu_supports("vaes") &&
+            __builtin_cpu_supports("avx2")) {
+            gUseVaes = 1;
+        }
+    }
+#endif
+
+    gSelected = 1;
+}
+
+int groestl_aesni_transform(void *chaining,
+                            const unsigned char *input,
+                            int blocks,
+                            int size)
+{
+    if (!gSelected) {
+        groestl_select();
+    }
+    if (!gUseAesni) {
+        return 0;
+    }
+
+#if defined(GROESTL_AESNI_X86)
+    if (size == 64) {
+        groestl_aesni_transform512((unsigned char *)chaining, input, blocks);
+    } else if (gUseVaes) {
+        groestl_vaes_transform1024((unsigned char *)chaining, input, blocks);
+    } else {
+        groestl_aesni_transform1024((unsigned char *)chaining, input, blocks);
+    }
+    return 1;
+#else
+    (void)chaining;
+    (void)input;
+    (void)blocks;
+    (void)size;
+    return 0;
+#endif
+}
+
+int groestl_aesni_output_transformation(void *chaining, int size)
+{
+    if (!gSelected) {
+        groestl_select();
+    }
+    if (!gUseAesni) {
+        return 0;
+    }
+
+#if defined(GROESTL_AESNI_X86)
+    if (size == 64) {
+        groestl_aesni_output512((unsigned char *)chaining);
+    } else {
+        groestl_aesni_output1024((unsigned char *)chaining);
+    }
+    return 1;
+#else
+    (void)chaining;
+    (void)size;
+    return 0;
+#endif
+}
+
+void groestl_use_aesni(int enable)
+{
+    gAllowAesni = (enable != 0);
+    groestl_select();
+}
+
+void groestl_use_vaes(int enable)
+{
+    gAllowVaes = (enable != 0);
+    groestl_select();
+}
+
+const char *groestl_implementation(void)
+{
+    if (!gSelected) {
+        groestl_select();
+    }
+    if (gUseVaes) {
+        return "aes-ni, vaes";
+    }
+    return (gUseAesni ? "aes-ni" : "portable");
+}
@@ -0,0 +1,84 @@
+/*
+    Hash - Groestl-aesni.h
+
+    AES-NI (and VAES) versions of the Groestl compression functions and
+    output transformation, which Groestl-opt.c uses when the cpu
+    supports them.
+
+    History:
+
+    v. 1.0.0 (10/18/2026) - Initial version
+
+    Copyright (c) 2026 Sriranga R. Veeraraghavan <ranga@calalum.org>
+
+    Permission is hereby granted, free of charge, to any person obtaining
+    a copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+    OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef groestl_aesni_h
+#define groestl_aesni_h
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+    groestl_aesni_transform - compress blocks message blocks from input
+                              into chaining, the state of a Groestl
+                              instance whose blocks are size (64 or 128)
+                              bytes long.  Return 1 if the blocks were
+                              compressed, or 0 if AES-NI isn't enabled,
+                              in which case the caller uses the table
+                              code.
+ */
+
+int groestl_aesni_transform(void *chaining,
+                            const unsigned char *input,
+                            int blocks,
+                            int size);
+
+/*
+    groestl_aesni_output_transformation - replace chaining with
+                                          P(chaining) + chaining, with
+                                          the same return value as
+                                          groestl_aesni_transform
+ */
+
+int groestl_aesni_output_transformation(void *chaining, int size);
+
+/*
+    groestl_use_aesni, groestl_use_vaes - allow (1, the default) or
+                                          disallow (0) the AES-NI
+                                          implementation, and its VAES
+                                          (AVX2) version of the long
+                                          variants (Groestl-384/512),
+                                          for benchmarking and testing
+ */
+
+void groestl_use_aesni(int enable);
+void groestl_use_vaes(int enable);
+
+/* groestl_implementation - name of the implementation in use */
+
+const char *groestl_implementation(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* groestl_aesni_h */
@@ -10,6 +10,9 @@
 #include "tables.h"
 #include <string.h>
 
+/* srv 2026-10-18 - AES-NI compression functions */
+#include "Groestl-aesni.h"
+
 /* 2021-07-21 srv - make internal function static */
 static void PrintState(u64 y[COLS512]) {
   int i;
@@ -197,10 +200,12 @@ inline void F512(u64 *h, const u64 *m) {
 /* the compression function (long variants) */
 static inline void F1024(u64 *h, const u64 *m) {
   /* srv 2020-11-27 - fixed for Xcode */
-  static u64 y[COLS1024] __attribute__((aligned(16)));
-  static u64 z[COLS1024] __attribute__((aligned(16)));
-  static u64 outQ[COLS1024] __attribute__((aligned(16)));
-  static u64 inP[COLS1024] __attribute__((aligned(16)));
+  /* srv 2026-10-18 - not static, contexts hashed on different threads
+     shared these */
+  u64 y[COLS1024] __attribute__((aligned(16)));
+  u64 z[COLS1024] __attribute__((aligned(16)));
+  u64 outQ[COLS1024] __attribute__((aligned(16)));
+  u64 inP[COLS1024] __attribute__((aligned(16)));
   int i;
 
   for (i = 0; i < COLS1024; i++) {
@@ -249,6 +254,14 @@ static void Transform(hashState *ctx,
 	       const u8 *input,
 	       int msglen) {
 #endif /* NIST_API */
+  /* srv 2026-10-18 - use AES-NI (Groestl-aesni.c) when the cpu has it */
+  if (msglen >= ctx->size &&
+      groestl_aesni_transform(ctx->chaining, input,
+                              msglen/ctx->size, ctx->size)) {
+    ctx->block_counter += msglen/ctx->size;
+    return;
+  }
+
   /* determine variant, SHORT or LONG, and select underlying
      compression function based on the variant */
   if (ctx->size == SHORT) {
@@ -287,6 +300,11 @@ static void OutputTransformation(hashState *ctx) {
   u64 y[COLS1024];
   u64 z[COLS1024];
 
+  /* srv 2026-10-18 - use AES-NI (Groestl-aesni.c) when the cpu has it */
+  if (groestl_aesni_output_transformation(ctx->chaining, ctx->size)) {
+    return;
+  }
+
   /* determine variant */
   switch (ctx->size) {
   case SHORT :
@@ -36,10 +36,17 @@
     v. 1.1.14 (08/05/2022) - Add support for K12
     v. 1.1.15 (06/09/2023) - fix deprication warnings
     v. 1.1.16 (01/31/2024) - Add support for advanced mode
+    v. 1.1.17 (10/18/2026) - Add hidden readblocksize and readqueuedepth
+                             preferences
+    v. 1.1.18 (10/18/2026) - Use the digest lengths from the in-tree MD5,
+                             SHA1 and SHA2 instead of CommonCrypto
+    v. 1.1.19 (10/18/2026) - Re-enable BLAKE2BP (256, 512) and BLAKE2SP
+                             (256), BLAKE2S has no 512-bit output
+    v. 1.1.20 (10/18/2026) - Add Skein tree hashing (256, 512, 1024)
 
     Based on: http://www.insanelymac.com/forum/topic/91735-a-full-cocoaxcodeinterface-builder-tutorial/
 
-    Copyright (c) 2014-2024 Sriranga R. Veeraraghavan <ranga@calalum.org>
+    Copyright (c) 2014-2026 Sriranga R. Veeraraghavan <ranga@calalum.org>
 
     Permission is hereby granted, free of charge, to any person obtaining
     a copy of this software and associated documentation files (the "Software"),
@@ -63,11 +70,14 @@
 #import <Foundation/Foundation.h>
 #import <AppKit/AppKit.h>
 #import <CoreFoundation/CoreFoundation.h>
-#import <CommonCrypto/CommonDigest.h>
 
 #import "HashConstants.h"
 #import "HashOperation.h"
 #import "HashAppController.h"
+#import "md5.h"
+#import "sha1.h"
+#import "sha256.h"
+#import "sha512.h"
 #import "rmd160.h"
 #import "Whirlpool.h"
 #import "tiger.h"
@@ -78,6 +88,8 @@ NSString *gAppGroup = @"CLN8R9E6QM.org.calalum.ranga.HashGroup";
 NSString *gPrefLowercase = @"lowercase";
 NSString *gPrefShowSize = @"showsize";
 NSString *gPrefAdvancedMode = @"advancedmode";
+NSString *gPrefReadBlockSize = @"readblocksize";
+NSString *gPrefReadQueueDepth = @"readqueuedepth";
 NSInteger gDefaultHash = HASH_SHA1;
 
 @implementation HashAppController
@@ -346,11 +358,11 @@ NSInteger gDefaultHash = HASH_SHA1;
         case HASH_WPOOL:
         case HASH_BLAKE2B_256:
         case HASH_BLAKE2B_512:
-        //case HASH_BLAKE2BP_256:
-        //case HASH_BLAKE2BP_512:
+        case HASH_BLAKE2BP_256:
+        case HASH_BLAKE2BP_512:
         case HASH_BLAKE2S_256:
         //case HASH_BLAKE2S_512:
-        //case HASH_BLAKE2SP_256:
+        case HASH_BLAKE2SP_256:
         //case HASH_BLAKE2SP_512:
         case HASH_BLAKE3:
         case HASH_SKEIN_256:
@@ -359,6 +371,9 @@ NSInteger gDefaultHash = HASH_SHA1;
         case HASH_SKEIN_1024:
         case HASH_SKEIN_1024_256:
         case HASH_SKEIN_1024_512:
+        case HASH_SKEIN_256_TREE:
+        case HASH_SKEIN_512_TREE:
+        case HASH_SKEIN_1024_TREE:
         case HASH_JH_224:
         case HASH_JH_256:
         case HASH_JH_384:
@@ -513,13 +528,19 @@ NSInteger gDefaultHash = HASH_SHA1;
                 case HASH_BLAKE2B_512:
                     [hashProgressStr appendString: @"BLAKE2B (512)"];
                     break;
-                //case HASH_BLAKE2BP_256:
-                //case HASH_BLAKE2BP_512:
+                case HASH_BLAKE2BP_256:
+                    [hashProgressStr appendString: @"BLAKE2BP (256)"];
+                    break;
+                case HASH_BLAKE2BP_512:
+                    [hashProgressStr appendString: @"BLAKE2BP (512)"];
+                    break;
                 case HASH_BLAKE2S_256:
                     [hashProgressStr appendString: @"BLAKE2S (256)"];
                     break;
                 //case HASH_BLAKE2S_512:
-                //case HASH_BLAKE2SP_256:
+                case HASH_BLAKE2SP_256:
+                    [hashProgressStr appendString: @"BLAKE2SP (256)"];
+                    break;
                 //case HASH_BLAKE2SP_512:
                 case HASH_BLAKE3:
                     [hashProgressStr appendString: @"BLAKE3"];
@@ -542,6 +563,15 @@ NSInteger gDefaultHash = HASH_SHA1;
                 case HASH_SKEIN_1024_512:
                     [hashProgressStr appendString: @"Skein (1024/512)"];
                     break;
+                case HASH_SKEIN_256_TREE:
+                    [hashProgressStr appendString: @"Skein Tree (256)"];
+                    break;
+                case HASH_SKEIN_512_TREE:
+                    [hashProgressStr appendString: @"Skein Tree (512)"];
+                    break;
+                case HASH_SKEIN_1024_TREE:
+                    [hashProgressStr appendString: @"Skein Tree (1024)"];
+                    break;
                 case HASH_JH_224:
                     [hashProgressStr appendString: @"JH (224)"];
                     break;
@@ -635,6 +665,17 @@ NSInteger gDefaultHash = HASH_SHA1;
                                              progress: hashProgress
                                             requester: self
                                                sender: hashSheet];
+
+            // the read block size and queue depth can be tuned using
+            // defaults write (0 or unset means use the default)
+
+            [hashOp setReadBlockSize:
+                        (size_t)MAX([hashDefaults integerForKey:
+                                     gPrefReadBlockSize], 0)
+                          queueDepth:
+                        (size_t)MAX([hashDefaults integerForKey:
+                                     gPrefReadQueueDepth], 0)];
+
             [hashQueue addOperation: hashOp];
 
             [self showHashSheet: sender];
@@ -1128,11 +1169,11 @@ NSInteger gDefaultHash = HASH_SHA1;
         case HASH_WPOOL:
         case HASH_BLAKE2B_256:
         case HASH_BLAKE2B_512:
-        //case HASH_BLAKE2BP_256:
-        //case HASH_BLAKE2BP_512:
+        case HASH_BLAKE2BP_256:
+        case HASH_BLAKE2BP_512:
         case HASH_BLAKE2S_256:
         //case HASH_BLAKE2S_512:
-        //case HASH_BLAKE2SP_256:
+        case HASH_BLAKE2SP_256:
         //case HASH_BLAKE2SP_512:
         case HASH_BLAKE3:
         case HASH_SKEIN_256:
@@ -1141,6 +1182,9 @@ NSInteger gDefaultHash = HASH_SHA1;
         case HASH_SKEIN_1024:
         case HASH_SKEIN_1024_256:
         case HASH_SKEIN_1024_512:
+        case HASH_SKEIN_256_TREE:
+        case HASH_SKEIN_512_TREE:
+        case HASH_SKEIN_1024_TREE:
         case HASH_JH_224:
         case HASH_JH_256:
         case HASH_JH_384:
@@ -1479,11 +1523,11 @@ NSInteger gDefaultHash = HASH_SHA1;
             digestLength = 1;
             break;
         case HASH_MD5:
-            digestLength = CC_MD5_DIGEST_LENGTH*sizeof(unsigned char);
+            digestLength = MD5_DIGEST_LENGTH*sizeof(unsigned char);
             break;
         case HASH_SHA1:
         case HASH_SHA1DC:
-            digestLength = CC_SHA1_DIGEST_LENGTH*sizeof(unsigned char);
+            digestLength = SHA1_DIGEST_LENGTH*sizeof(unsigned char);
             break;
         case HASH_TIGER:
         case HASH_TIGER2:
@@ -1495,7 +1539,7 @@ NSInteger gDefaultHash = HASH_SHA1;
         case HASH_BLAKE224:
         case HASH_GROESTL224:
         case HASH_LSH224:
-            digestLength = CC_SHA224_DIGEST_LENGTH*sizeof(unsigned char);
+            digestLength = SHA224_DIGEST_LENGTH*sizeof(unsigned char);
             break;
         case HASH_MD6_256:
         case HASH_SHA256:
@@ -1508,13 +1552,14 @@ NSInteger gDefaultHash = HASH_SHA1;
         case HASH_SKEIN_256:
         case HASH_SKEIN_512_256:
         case HASH_SKEIN_1024_256:
+        case HASH_SKEIN_256_TREE:
         case HASH_JH_256:
         case HASH_BLAKE256:
         case HASH_BLAKE3:
         case HASH_GROESTL256:
         case HASH_LSH256:
         case HASH_K12_256:
-            digestLength = CC_SHA256_DIGEST_LENGTH*sizeof(unsigned char);
+            digestLength = SHA256_DIGEST_LENGTH*sizeof(unsigned char);
             break;
         case HASH_SHA384:
         case HASH_SHA3_384:
@@ -1523,7 +1568,7 @@ NSInteger gDefaultHash = HASH_SHA1;
         case HASH_GROESTL384:
         case HASH_LSH384:
         case HASH_K12_384:
-            digestLength = CC_SHA384_DIGEST_LENGTH*sizeof(unsigned char);
+            digestLength = SHA384_DIGEST_LENGTH*sizeof(unsigned char);
             break;
         case HASH_MD6_512:
         case HASH_SHA512:
@@ -1535,15 +1580,17 @@ NSInteger gDefaultHash = HASH_SHA1;
         case HASH_BLAKE2SP_512:
         case HASH_SKEIN_512:
         case HASH_SKEIN_1024_512:
+        case HASH_SKEIN_512_TREE:
         case HASH_JH_512:
         case HASH_BLAKE512:
         case HASH_GROESTL512:
         case HASH_LSH512:
         case HASH_K12_512:
-            digestLength = CC_SHA512_DIGEST_LENGTH*sizeof(unsigned char);
+            digestLength = SHA512_DIGEST_LENGTH*sizeof(unsigned char);
             break;
         case HASH_SKEIN_1024:
-            digestLength = 2*(CC_SHA512_DIGEST_LENGTH*sizeof(unsigned char));
+        case HASH_SKEIN_1024_TREE:
+            digestLength = 2*(SHA512_DIGEST_LENGTH*sizeof(unsigned char));
             break;
         case HASH_RMD160:
             digestLength = RMD160_DIGEST_LENGTH*sizeof(unsigned char);
@@ -20,13 +20,18 @@
     v. 1.1.4 (05/26/2021) - Add support for LSH
     v. 1.1.5 (03/24/2022) - Add dock progress bar
     v. 1.1.6 (08/05/2022) - Add support for K12
+    v. 1.1.7 (10/18/2026) - Move HashType to the portable hash engine
+    v. 1.1.8 (10/18/2026) - Add FileHashMappedWindowSize
+    v. 1.1.9 (10/18/2026) - Add a configurable read block size and
+                            queue depth
+    v. 1.2.0 (10/18/2026) - Add FileHashCheckpointInterval
  
     Based on: http://www.joel.lopes-da-silva.com/2010/09/07/compute-md5-or-sha-hash-of-large-file-efficiently-on-ios-and-mac-os-x/
               http://www.cimgf.com/2008/02/23/nsoperation-example/
               http://www.raywenderlich.com/19788/how-to-use-nsoperations-and-nsoperationqueues
               http://www.informit.com/articles/article.aspx?p=1768318
 
-    Copyright (c) 2015-2022 Sriranga R. Veeraraghavan <ranga@calalum.org>
+    Copyright (c) 2015-2026 Sriranga R. Veeraraghavan <ranga@calalum.org>
 
     Permission is hereby granted, free of charge, to any person obtaining
     a copy of this software and associated documentation files (the "Software"),
@@ -50,75 +55,29 @@
 #ifndef HashOperation_h
 #define HashOperation_h
 
-// Supported Hash Types
-
-typedef enum {
-    HASH_NONE           =  0,
-    HASH_MD5            =  1,
-    HASH_SHA1           =  2,
-    HASH_SHA256         =  3,
-    HASH_RMD160         =  4,
-    HASH_SHA512         =  5,
-    HASH_WPOOL          =  6,
-    HASH_SHA3_256       =  7,
-    HASH_SHA3_512       =  8,
-    HASH_CRC32          =  9,
-    HASH_CKSUM          = 10,
-    HASH_RMD320         = 11,
-    HASH_BLAKE2B_256    = 12,
-    HASH_BLAKE2B_512    = 13,
-    HASH_SKEIN_256      = 14,
-    HASH_SKEIN_512      = 15,
-    HASH_SKEIN_1024     = 16,
-    HASH_SKEIN_512_256  = 17,
-    HASH_SKEIN_1024_256 = 18,
-    HASH_SKEIN_1024_512 = 19,
-    HASH_BLAKE2S_256    = 20,
-    HASH_BLAKE2S_512    = 21,
-    HASH_BLAKE2SP_256   = 22,
-    HASH_BLAKE2SP_512   = 23,
-    HASH_BLAKE2BP_256   = 24,
-    HASH_BLAKE2BP_512   = 25,
-    HASH_SHA224         = 26,
-    HASH_SHA384         = 27,
-    HASH_SHA3_224       = 28,
-    HASH_SHA3_384       = 29,
-    HASH_MD6_256        = 30,
-    HASH_MD6_512        = 31,
-    HASH_JH_224         = 32,
-    HASH_JH_256         = 33,
-    HASH_JH_384         = 34,
-    HASH_JH_512         = 35,
-    HASH_TIGER          = 36,
-    HASH_TIGER2         = 37,
-    HASH_HAS160         = 38,
-    HASH_BLAKE224       = 39,
-    HASH_BLAKE256       = 40,
-    HASH_BLAKE384       = 41,
-    HASH_BLAKE512       = 42,
-    HASH_GROESTL224     = 43,
-    HASH_GROESTL256     = 44,
-    HASH_GROESTL384     = 45,
-    HASH_GROESTL512     = 46,
-    HASH_SHA1DC         = 47,
-    HASH_SNEFRU128      = 48,
-    HASH_SNEFRU256      = 49,
-    HASH_SHAKE128       = 50,
-    HASH_SHAKE256       = 51,
-    HASH_BLAKE3         = 52,
-    HASH_LSH224         = 53,
-    HASH_LSH256         = 54,
-    HASH_LSH384         = 55,
-    HASH_LSH512         = 56,
-    HASH_K12_256        = 57,
-    HASH_K12_384        = 58,
-    HASH_K12_512        = 59,
-} HashType;
-
-// Default File Buffer Size (400K)
+// Supported Hash Types (see hash_engine.h)
+
+#import "hash_engine.h"
+
+// Default File Buffer Size (400K), and the default number of buffers
+// that can be read ahead of the hash
 
 enum {
     FileHashDefaultFileBufferSize = 409600,
+    FileHashDefaultReadQueueDepth = 4,
+};
+
+// Amount of a memory mapped file to hash between progress updates (64MB)
+
+enum {
+    FileHashMappedWindowSize = 67108864,
+};
+
+// Amount of a file to hash between checkpoints (1GB), files smaller
+// than this are not checkpointed
+
+enum {
+    FileHashCheckpointInterval = 1073741824,
 };
 
 @interface HashOperation : NSOperation {
@@ -130,6 +89,8 @@ enum {
     NSWindow *sender;
     HashType hashType;
     BOOL isLowerCase;
+    size_t readBlockSize;
+    size_t readQueueDepth;
 }
 
 -(id)initWithFileHashTypeAndProgress: (NSString *)path
@@ -138,6 +99,8 @@ enum {
                             progress: (NSProgressIndicator *)progressBar
                            requester: (id)requestingObj
                               sender: (NSWindow *)sendingObj;
+-(void)setReadBlockSize: (size_t)blockSize
+             queueDepth: (size_t)queueDepth;
 -(void)main;
 
 @end
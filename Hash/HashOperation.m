@@ -20,13 +20,27 @@
     v. 1.1.5 (03/24/2022) - Add dock progress bar
     v. 1.1.6 (08/05/2022) - Add support for K12
     v. 1.1.7 (11/13/2022) - replace malloc + memset with calloc
+    v. 1.1.8 (10/18/2026) - use the portable hash engine for init, update
+                            and final instead of per-hash switch statements
+    v. 1.1.9 (10/18/2026) - hash large files directly from a memory
+                            mapping instead of copying them into the
+                            read buffer
+    v. 1.2.0 (10/18/2026) - hash on a worker thread while the next
+                            blocks are read, with a configurable block
+                            size and queue depth
+    v. 1.2.1 (10/18/2026) - checkpoint the hash state of large files
+                            periodically and when cancelled, and resume
+                            from the checkpoint the next time the
+                            unchanged file is hashed
+    v. 1.2.2 (10/18/2026) - if a mapped file is truncated while it is
+                            being hashed, read it instead of crashing
 
     Based on: http://www.joel.lopes-da-silva.com/2010/09/07/compute-md5-or-sha-hash-of-large-file-efficiently-on-ios-and-mac-os-x/
               http://www.cimgf.com/2008/02/23/nsoperation-example/
               http://www.raywenderlich.com/19788/how-to-use-nsoperations-and-nsoperationqueues
               http://www.informit.com/articles/article.aspx?p=1768318
 
-    Copyright (c) 2015-2022 Sriranga R. Veeraraghavan <ranga@calalum.org>
+    Copyright (c) 2015-2026 Sriranga R. Veeraraghavan <ranga@calalum.org>
 
     Permission is hereby granted, free of charge, to any person obtaining
     a copy of this software and associated documentation files (the "Software"),
@@ -50,29 +64,17 @@
 #import <Foundation/Foundation.h>
 #import <AppKit/AppKit.h>
 #import <CoreFoundation/CoreFoundation.h>
-#import <CommonCrypto/CommonDigest.h>
+
+#include <sys/stat.h>
 
 #import "HashOperation.h"
 #import "HashAppController.h"
 #import "HashConstants.h"
-#import "crc.h"
-#import "md6.h"
-#import "rmd160.h"
-#import "rmd320.h"
-#import "Whirlpool.h"
-#import "keccak-tiny.h"
-#import "blake2.h"
-#import "blake3_impl.h"
-#import "skein.h"
-#import "jh.h"
-#import "tiger.h"
-#import "has160.h"
-#import "blake.h"
-#import "Groestl-opt.h"
-#import "sha1dc.h"
-#import "snefru.h"
-#import "lsh.h"
-#import "KangarooTwelve.h"
+#import "hash_cache.h"
+#import "hash_checkpoint.h"
+#import "hash_engine.h"
+#import "hash_map.h"
+#import "hash_multi.h"
 
 @implementation HashOperation
 
@@ -112,88 +114,88 @@
 
         // verify that a valid hash type was specified
 
-        switch (hash) {
-            case HASH_CKSUM:
-            case HASH_CRC32:
-            case HASH_MD5:
-            case HASH_MD6_256:
-            case HASH_MD6_512:
-            case HASH_SHA1:
-            case HASH_SHA1DC:
-            case HASH_SHA224:
-            case HASH_SHA256:
-            case HASH_SHA384:
-            case HASH_SHA512:
-            case HASH_SHAKE128:
-            case HASH_SHAKE256:
-            case HASH_SHA3_224:
-            case HASH_SHA3_256:
-            case HASH_SHA3_384:
-            case HASH_SHA3_512:
-            case HASH_RMD160:
-            case HASH_RMD320:
-            case HASH_WPOOL:
-            case HASH_BLAKE2B_256:
-            case HASH_BLAKE2B_512:
-            //case HASH_BLAKE2BP_256:
-            //case HASH_BLAKE2BP_512:
-            case HASH_BLAKE2S_256:
-            //case HASH_BLAKE2S_512:
-            //case HASH_BLAKE2SP_256:
-            //case HASH_BLAKE2SP_512:
-            case HASH_BLAKE3:
-            case HASH_SKEIN_256:
-            case HASH_SKEIN_512:
-            case HASH_SKEIN_512_256:
-            case HASH_SKEIN_1024:
-            case HASH_SKEIN_1024_256:
-            case HASH_SKEIN_1024_512:
-            case HASH_JH_224:
-            case HASH_JH_256:
-            case HASH_JH_384:
-            case HASH_JH_512:
-            case HASH_TIGER:
-            case HASH_TIGER2:
-            case HASH_HAS160:
-            case HASH_BLAKE224:
-            case HASH_BLAKE256:
-            case HASH_BLAKE384:
-            case HASH_BLAKE512:
-            case HASH_GROESTL224:
-            case HASH_GROESTL256:
-            case HASH_GROESTL384:
-            case HASH_GROESTL512:
-            case HASH_SNEFRU128:
-            case HASH_SNEFRU256:
-            case HASH_LSH224:
-            case HASH_LSH256:
-            case HASH_LSH384:
-            case HASH_LSH512:
-            case HASH_K12_256:
-            case HASH_K12_384:
-            case HASH_K12_512:
-
-                // valid hashType
-
-                hashType = hash;
-                break;
-
-            default:
-
-                // unknown or invalid hashType
-
-                hashType = HASH_NONE;
-                break;
-        }
+        hashType = (hash_engine_descriptor(hash) != NULL ? hash : HASH_NONE);
 
         progress = progressBar;
         requester = requestingObj;
         sender = sendingObj;
 
+        readBlockSize = FileHashDefaultFileBufferSize;
+        readQueueDepth = FileHashDefaultReadQueueDepth;
+
     }
     return self;
 }
 
+/*
+    setReadBlockSize - set the size of each read and the number of
+                       blocks that can be read ahead of the hash (0
+                       keeps the current value)
+*/
+
+-(void) setReadBlockSize: (size_t)blockSize
+              queueDepth: (size_t)queueDepth
+{
+    if (blockSize > 0) {
+        readBlockSize = blockSize;
+    }
+    if (queueDepth > 0) {
+        readQueueDepth = queueDepth;
+    }
+}
+
+/*
+    checkpointPathForFile - return the path of the checkpoint for the
+                            file identified by key and the current hash
+                            type, in the app's caches directory, or nil
+                            if the directory cannot be created
+*/
+
+-(NSString *) checkpointPathForFile: (const hashCacheKey *)key
+{
+    NSFileManager *fileManager = [NSFileManager defaultManager];
+    NSString *bundleId = [[NSBundle mainBundle] bundleIdentifier];
+    NSURL *cachesURL = nil;
+    NSURL *checkpointsURL = nil;
+    NSString *checkpointName = nil;
+
+    cachesURL = [fileManager URLForDirectory: NSCachesDirectory
+                                    inDomain: NSUserDomainMask
+                           appropriateForURL: nil
+                                      create: YES
+                                       error: nil];
+    if (cachesURL == nil) {
+        return nil;
+    }
+
+    if (bundleId != nil) {
+        cachesURL = [cachesURL URLByAppendingPathComponent: bundleId
+                                               isDirectory: YES];
+    }
+
+    checkpointsURL = [cachesURL URLByAppendingPathComponent: @"Checkpoints"
+                                                isDirectory: YES];
+
+    if ([fileManager createDirectoryAtURL: checkpointsURL
+              withIntermediateDirectories: YES
+                               attributes: nil
+                                    error: nil] != YES) {
+        return nil;
+    }
+
+    // the device and inode identify the file (the checkpoint itself
+    // records its size and times), so a renamed file keeps its
+    // checkpoint
+
+    checkpointName = [NSString stringWithFormat: @"%llx-%llx-%d.checkpoint",
+                      (unsigned long long)key->device,
+                      (unsigned long long)key->inode,
+                      (int)hashType];
+
+    return [[checkpointsURL URLByAppendingPathComponent: checkpointName
+                                            isDirectory: NO] path];
+}
+
 /*
     main - calculate the hash, abort if canceled
 */
@@ -216,12 +218,11 @@
 
         unsigned char *digest = NULL;
         size_t digestLength = 0;
-        size_t i = 0;
+        char *digestStr = NULL;
 
         /* read buffer and bytes read */
 
-        uint8_t buffer[FileHashDefaultFileBufferSize];
-        size_t bufferLength = FileHashDefaultFileBufferSize;
+        uint8_t *buffer = NULL;
         NSInteger bytesRead = 0;
         unsigned long long bytesSoFar = 0;
 
@@ -229,6 +230,22 @@
 
         NSInputStream *iStream = nil;
 
+        /* memory mapped file, and how much of it has been hashed */
+
+        hashMappedFile mappedFile = { NULL, 0 };
+        size_t mappedOffset = 0;
+
+        /* checkpoint for resuming large files, the identity of the
+           file, how much of the file has been hashed, and how much of
+           it was hashed when the checkpoint was last saved */
+
+        struct stat fileStat;
+        hashCacheKey fileKey;
+        NSString *checkpointPath = nil;
+        const char *checkpointFile = NULL;
+        unsigned long long hashedSoFar = 0;
+        unsigned long long savedOffset = 0;
+
         /* flags to indicate whether more data is available and whether
            reading has failed */
 
@@ -247,40 +264,12 @@
 
         double currentProgressPercentage = 0.0;
 
-        /* hash objects for the supported hashes */
-
-        crcContext crcHashObject;
-        CC_MD5_CTX md5HashObject;
-        CC_SHA1_CTX sha1HashObject;
-        SHA1_CTX sha1DCHashObject;
-        CC_SHA256_CTX sha256HashObject;
-        CC_SHA512_CTX sha512HashObject;
-        keccak_state sha3HashObject;
-        md6_state md6HashObject;
-        RMD160_CTX rmd160HashObject;
-        rmd320_ctx rmd320HashObject;
-        NESSIEstruct whirlpoolHashObject;
-        blake2b_state blake2bHashObject;
-        blake2s_state blake2sHashObject;
-        blake3_hasher blake3HashObject;
-        /*
-        blake2bp_state blake2bpHashObject;
-        blake2sp_state blake2spHashObject;
-        */
-        Skein_256_Ctxt_t skein256HashObject;
-        Skein_512_Ctxt_t skein512HashObject;
-        Skein1024_Ctxt_t skein1024HashObject;
-        JH_HashState jhHashObject;
-        tiger_ctx tigerHashObject;
-        has160_ctx has160HashObject;
-        state224 blake224HashObject;
-        state256 blake256HashObject;
-        state384 blake384HashObject;
-        state512 blake512HashObject;
-        groestl_HashState groestlHashObject;
-        snefru_ctx snefruHashObject;
-        union LSH_Context lshHashObject;
-        KangarooTwelve_Instance k12HashObject;
+        /* the hash engine descriptor and context for the selected hash,
+           and the queue of blocks waiting to be hashed */
+
+        const hashEngineDescriptor *hashDesc = NULL;
+        hashEngineContext *hashContext = NULL;
+        hashMultiContext *hashQueue = NULL;
 
         do {
 
@@ -301,323 +290,110 @@
                                                           fileSize];
             }
 
-            // set the digest length for the specified hash
-
-            switch (hashType) {
-                case HASH_CKSUM:
-                    digestLength = 1;
-                    break;
-                case HASH_CRC32:
-                    digestLength = 1;
-                    break;
-                case HASH_MD5:
-                    digestLength = CC_MD5_DIGEST_LENGTH*sizeof(*digest);
-                    break;
-                case HASH_SHA1:
-                case HASH_SHA1DC:
-                    digestLength = CC_SHA1_DIGEST_LENGTH*sizeof(*digest);
-                    break;
-                case HASH_TIGER:
-                case HASH_TIGER2:
-                    digestLength = tiger_hash_length*sizeof(*digest);
-                    break;
-                case HASH_SHA224:
-                case HASH_SHA3_224:
-                case HASH_JH_224:
-                case HASH_BLAKE224:
-                case HASH_GROESTL224:
-                case HASH_LSH224:
-                    digestLength = CC_SHA224_DIGEST_LENGTH*sizeof(*digest);
-                    break;
-                case HASH_MD6_256:
-                case HASH_SHA256:
-                case HASH_SHAKE128:
-                case HASH_SHA3_256:
-                case HASH_BLAKE2B_256:
-                case HASH_BLAKE2BP_256:
-                case HASH_BLAKE2S_256:
-                case HASH_BLAKE2SP_256:
-                case HASH_BLAKE3:
-                case HASH_SKEIN_256:
-                case HASH_SKEIN_512_256:
-                case HASH_SKEIN_1024_256:
-                case HASH_JH_256:
-                case HASH_BLAKE256:
-                case HASH_GROESTL256:
-                case HASH_LSH256:
-                case HASH_K12_256:
-                    digestLength = CC_SHA256_DIGEST_LENGTH*sizeof(*digest);
-                    break;
-                case HASH_SHA384:
-                case HASH_SHA3_384:
-                case HASH_JH_384:
-                case HASH_BLAKE384:
-                case HASH_GROESTL384:
-                case HASH_LSH384:
-                case HASH_K12_384:
-                    digestLength = CC_SHA384_DIGEST_LENGTH*sizeof(*digest);
-                    break;
-                case HASH_MD6_512:
-                case HASH_SHA512:
-                case HASH_SHAKE256:
-                case HASH_SHA3_512:
-                case HASH_BLAKE2B_512:
-                case HASH_BLAKE2BP_512:
-                case HASH_BLAKE2S_512:
-                case HASH_BLAKE2SP_512:
-                case HASH_SKEIN_512:
-                case HASH_SKEIN_1024_512:
-                case HASH_JH_512:
-                case HASH_BLAKE512:
-                case HASH_GROESTL512:
-                case HASH_LSH512:
-                case HASH_K12_512:
-                    digestLength = CC_SHA512_DIGEST_LENGTH*sizeof(*digest);
-                    break;
-                case HASH_SKEIN_1024:
-                    digestLength = 2*(CC_SHA512_DIGEST_LENGTH*sizeof(*digest));
-                    break;
-                case HASH_RMD160:
-                    digestLength = RMD160_DIGEST_LENGTH*sizeof(*digest);
-                    break;
-                case HASH_RMD320:
-                    digestLength = 2*(RMD160_DIGEST_LENGTH*sizeof(*digest));
-                    break;
-                case HASH_WPOOL:
-                    digestLength = NESSIE_DIGEST_LENGTH*sizeof(*digest);
-                    break;
-                case HASH_HAS160:
-                    digestLength = has160_hash_size*sizeof(*digest);
-                    break;
-                case HASH_SNEFRU128:
-                    digestLength = snefru128_hash_length*sizeof(*digest);
-                    break;
-                case HASH_SNEFRU256:
-                    digestLength = snefru256_hash_length*sizeof(*digest);
-                    break;
-                default:
-                    digestLength = 0;
-                    break;
-            }
+            // get the engine descriptor and digest length for the
+            // specified hash, return if an unknown hash was specified
 
-            // return if an unknown hash was specified
-
-            if (digestLength <= 0) {
+            hashDesc = hash_engine_descriptor(hashType);
+            if (hashDesc == NULL) {
                 break;
             }
 
-            // allocate space for the digest
+            digestLength = hashDesc->digestLength;
+
+            // allocate space for the digest, its string form, and the
+            // hash context
 
             digest = calloc(sizeof(unsigned char), digestLength);
             if (digest == NULL) {
                 break;
             }
 
-            // Create and open the read stream
+            digestStr = calloc(sizeof(char),
+                               hash_engine_string_length(hashDesc) + 1);
+            if (digestStr == NULL) {
+                break;
+            }
+
+            hashContext = hash_engine_new(hashType);
+            if (hashContext == NULL) {
+                break;
+            }
 
-            iStream = [NSInputStream inputStreamWithFileAtPath:filePath];
+            // the hash is computed on a worker thread, while this thread
+            // reads ahead by up to readQueueDepth blocks
 
-            if (iStream == nil) {
+            hashQueue = hash_multi_new(&hashContext,
+                                       1,
+                                       1,
+                                       readBlockSize,
+                                       readQueueDepth);
+            if (hashQueue == NULL) {
                 break;
             }
 
-            [iStream open];
+            // for large files, pick up from the last checkpoint if the
+            // file hasn't changed since it was saved
 
-            // initialize the hash object for the specified hash
+            if (stat([filePath fileSystemRepresentation], &fileStat) == 0 &&
+                S_ISREG(fileStat.st_mode) &&
+                (unsigned long long)fileStat.st_size >
+                    (unsigned long long)FileHashCheckpointInterval) {
+                hash_cache_key(&fileStat, &fileKey);
+                checkpointPath = [self checkpointPathForFile: &fileKey];
+            }
 
-            switch (hashType) {
-                case HASH_CKSUM:
-                    cksum_init(&crcHashObject);
-                    break;
-                case HASH_CRC32:
-                    crc32_init(&crcHashObject);
-                    break;
-                case HASH_MD5:
-                    CC_MD5_Init(&md5HashObject);
-                    break;
-                case HASH_MD6_256:
-                    md6_init(&md6HashObject, 256);
-                    break;
-                case HASH_MD6_512:
-                    md6_init(&md6HashObject, 512);
-                    break;
-                case HASH_SHA1:
-                    CC_SHA1_Init(&sha1HashObject);
-                    break;
-                case HASH_SHA1DC:
-                    SHA1DCInit(&sha1DCHashObject);
-                    break;
-                case HASH_SHA224:
-                    CC_SHA224_Init(&sha256HashObject);
-                    break;
-                case HASH_SHA256:
-                    CC_SHA256_Init(&sha256HashObject);
-                    break;
-                case HASH_SHA384:
-                    CC_SHA384_Init(&sha512HashObject);
-                    break;
-                case HASH_SHA512:
-                    CC_SHA512_Init(&sha512HashObject);
-                    break;
-                case HASH_SHAKE128:
-                    keccak_cleanse(&sha3HashObject);
-                    keccak_xof_init(&sha3HashObject, 128);
-                    break;
-                case HASH_SHAKE256:
-                    keccak_cleanse(&sha3HashObject);
-                    keccak_xof_init(&sha3HashObject, 256);
-                    break;
-                case HASH_SHA3_224:
-                    keccak_cleanse(&sha3HashObject);
-                    keccak_digest_init(&sha3HashObject, 224);
-                    break;
-                case HASH_SHA3_256:
-                    keccak_cleanse(&sha3HashObject);
-                    keccak_digest_init(&sha3HashObject, 256);
-                    break;
-                case HASH_SHA3_384:
-                    keccak_cleanse(&sha3HashObject);
-                    keccak_digest_init(&sha3HashObject, 384);
-                    break;
-                case HASH_SHA3_512:
-                    keccak_cleanse(&sha3HashObject);
-                    keccak_digest_init(&sha3HashObject, 512);
-                    break;
-                case HASH_RMD160:
-                    RMD160Init(&rmd160HashObject);
-                    break;
-                case HASH_RMD320:
-                    rmd320_init(&rmd320HashObject);
-                    break;
-                case HASH_WPOOL:
-                    NESSIEinit(&whirlpoolHashObject);
-                    break;
-                case HASH_BLAKE2B_256:
-                    blake2b_init(&blake2bHashObject, 32);
-                    break;
-                case HASH_BLAKE2B_512:
-                    blake2b_init(&blake2bHashObject, 64);
-                    break;
-                /*
-                case HASH_BLAKE2BP_256:
-                    blake2bp_init(&blake2bpHashObject, 32);
-                    break;
-                case HASH_BLAKE2BP_512:
-                    blake2bp_init(&blake2bpHashObject, 64);
-                    break;
-                */
-                case HASH_BLAKE2S_256:
-                    blake2s_init(&blake2sHashObject, 32);
-                    break;
-                /*
-                case HASH_BLAKE2S_512:
-                    blake2s_init(&blake2sHashObject, 64);
-                    break;
-                case HASH_BLAKE2SP_256:
-                    blake2sp_init(&blake2spHashObject, 32);
-                    break;
-                case HASH_BLAKE2SP_512:
-                    blake2sp_init(&blake2spHashObject, 64);
-                    break;
-                */
-                case HASH_BLAKE3:
-                    blake3_hasher_init(&blake3HashObject);
-                    break;
-                case HASH_SKEIN_256:
-                    Skein_256_Init(&skein256HashObject, 256);
-                    break;
-                case HASH_SKEIN_512_256:
-                    Skein_512_Init(&skein512HashObject, 256);
-                    break;
-                case HASH_SKEIN_512:
-                    Skein_512_Init(&skein512HashObject, 512);
-                    break;
-                case HASH_SKEIN_1024:
-                    Skein1024_Init(&skein1024HashObject, 1024);
-                    break;
-                case HASH_SKEIN_1024_256:
-                    Skein1024_Init(&skein1024HashObject, 256);
-                    break;
-                case HASH_SKEIN_1024_512:
-                    Skein1024_Init(&skein1024HashObject, 512);
-                    break;
-                case HASH_JH_224:
-                    JH_Init(&jhHashObject, 224);
-                    break;
-                case HASH_JH_256:
-                    JH_Init(&jhHashObject, 256);
-                    break;
-                case HASH_JH_384:
-                    JH_Init(&jhHashObject, 384);
-                    break;
-                case HASH_JH_512:
-                    JH_Init(&jhHashObject, 512);
-                    break;
-                case HASH_TIGER:
-                    rhash_tiger_init(&tigerHashObject);
-                    break;
-                case HASH_TIGER2:
-                    rhash_tiger2_init(&tigerHashObject);
-                    break;
-                case HASH_HAS160:
-                    rhash_has160_init(&has160HashObject);
-                    break;
-                case HASH_BLAKE224:
-                    blake224_init(&blake224HashObject);
-                    break;
-                case HASH_BLAKE256:
-                    blake256_init(&blake256HashObject);
-                    break;
-                case HASH_BLAKE384:
-                    blake384_init(&blake384HashObject);
-                    break;
-                case HASH_BLAKE512:
-                    blake512_init(&blake512HashObject);
-                    break;
-                case HASH_GROESTL224:
-                    groestl_Init(&groestlHashObject, 224);
-                    break;
-                case HASH_GROESTL256:
-                    groestl_Init(&groestlHashObject, 256);
-                    break;
-                case HASH_GROESTL384:
-                    groestl_Init(&groestlHashObject, 384);
-                    break;
-                case HASH_GROESTL512:
-                    groestl_Init(&groestlHashObject, 512);
-                    break;
-                case HASH_SNEFRU128:
-                    rhash_snefru128_init(&snefruHashObject);
-                    break;
-                case HASH_SNEFRU256:
-                    rhash_snefru256_init(&snefruHashObject);
-                    break;
-                case HASH_LSH224:
-                    lsh_init(&lshHashObject, LSH_TYPE_224);
-                    break;
-                case HASH_LSH256:
-                    lsh_init(&lshHashObject, LSH_TYPE_256);
-                    break;
-                case HASH_LSH384:
-                    lsh_init(&lshHashObject, LSH_TYPE_384);
-                    break;
-                case HASH_LSH512:
-                    lsh_init(&lshHashObject, LSH_TYPE_512);
-                    break;
-                case HASH_K12_256:
-                case HASH_K12_384:
-                case HASH_K12_512:
-                    KangarooTwelve_Initialize(&k12HashObject, 0);
-                    break;
-                default:
-                    hasMoreData = FALSE;
-                    readFailed = TRUE;
-                    break;
+            if (checkpointPath != nil) {
+                checkpointFile = [checkpointPath fileSystemRepresentation];
+                if (hash_checkpoint_load(checkpointFile,
+                                         &fileKey,
+                                         &hashContext,
+                                         1,
+                                         &hashedSoFar) != 0) {
+                    hashedSoFar = 0;
+                }
+                savedOffset = hashedSoFar;
             }
 
-            // clear the read buffer
+            // map large files, so that they can be hashed without
+            // copying them into the read buffer, otherwise create and
+            // open the read stream.  the SIGBUS guard is installed
+            // (once) first, so a file that is truncated while it is
+            // mapped can be read instead of crashing the app
+
+            (void)hash_map_install_guard();
+
+            if (hash_map_path([filePath fileSystemRepresentation],
+                              &mappedFile) != 0) {
+
+                iStream = [NSInputStream inputStreamWithFileAtPath:filePath];
+
+                if (iStream == nil) {
+                    break;
+                }
+
+                [iStream open];
+
+                if (hashedSoFar > 0 &&
+                    [iStream setProperty:
+                     [NSNumber numberWithUnsignedLongLong: hashedSoFar]
+                                  forKey: NSStreamFileCurrentOffsetKey] != YES) {
+
+                    // can't skip the part that was already hashed, so
+                    // start from the beginning
+
+                    hash_engine_reset(hashContext);
+                    hashedSoFar = 0;
+                    savedOffset = 0;
+                }
+            } else {
+                mappedOffset = (size_t)hashedSoFar;
+            }
 
-            memset(buffer, 0, bufferLength);
+            bytesSoFar = hashedSoFar;
+            if (fileSize > 0 && fileSize != (unsigned long long)-1) {
+                currentProgressPercentage =
+                    (double)(((double)bytesSoFar/(double)fileSize)*100);
+            }
 
             /*
                 Read the file one buffer at a time and update the hash
@@ -688,7 +464,54 @@
                     break;
                 }
 
-                bytesRead = [iStream read:buffer maxLength:bufferLength];
+                if (mappedFile.data != NULL) {
+
+                    // hand the next window of the mapping straight to
+                    // the hash, there's no reading to overlap with the
+                    // hashing, so wait for it to be hashed so that the
+                    // progress bar stays accurate
+
+                    bytesRead =
+                        (NSInteger)MIN(mappedFile.length - mappedOffset,
+                                       (size_t)FileHashMappedWindowSize);
+                    hash_multi_update_mapped(hashQueue,
+                                             mappedFile.data + mappedOffset,
+                                             (size_t)bytesRead);
+                    hash_multi_wait(hashQueue);
+                    mappedOffset += (size_t)bytesRead;
+
+                    // if the file was truncated, the hash saw zeros
+                    // instead of the missing pages, so start over
+                    // reading the file
+
+                    if (hash_map_truncated(&mappedFile)) {
+                        hash_unmap(&mappedFile);
+                        hash_engine_reset(hashContext);
+                        hashedSoFar = 0;
+                        savedOffset = 0;
+                        bytesSoFar = 0;
+
+                        iStream = [NSInputStream
+                                   inputStreamWithFileAtPath: filePath];
+                        if (iStream == nil) {
+                            readFailed = TRUE;
+                            break;
+                        }
+                        [iStream open];
+                        continue;
+                    }
+                } else {
+
+                    // read into the next free block in the queue, and
+                    // hand it to the hash
+
+                    buffer = hash_multi_acquire(hashQueue);
+                    bytesRead = [iStream read: buffer
+                                    maxLength: readBlockSize];
+                    if (bytesRead > 0) {
+                        hash_multi_submit(hashQueue, (size_t)bytesRead);
+                    }
+                }
 
                 // if the bytes read is less than 0, reading failed
 
@@ -706,6 +529,23 @@
                     continue;
                 }
 
+                // save a checkpoint every FileHashCheckpointInterval
+                // bytes, once the hash has caught up with the reads
+
+                hashedSoFar += (unsigned long long)bytesRead;
+                if (checkpointFile != NULL &&
+                    hashedSoFar - savedOffset >=
+                        (unsigned long long)FileHashCheckpointInterval) {
+                    hash_multi_wait(hashQueue);
+                    if (hash_checkpoint_save(checkpointFile,
+                                             &fileKey,
+                                             hashedSoFar,
+                                             &hashContext,
+                                             1) == 0) {
+                        savedOffset = hashedSoFar;
+                    }
+                }
+
                 // if a progress bar was specified, update it
                 // based on: http://cocoadev.com/HowToAddAProgressBar
 
@@ -735,405 +575,34 @@
                     }];
                 }
 
-                // update the hash with the data that was just read
-
-                switch (hashType) {
-                    case HASH_CKSUM:
-                        cksum_update(&crcHashObject,
-                                    (unsigned char *)buffer,
-                                     (uint32_t) bytesRead);
-                        break;
-                    case HASH_CRC32:
-                        crc32_update(&crcHashObject,
-                                    (const void *)buffer,
-                                    (size_t) bytesRead);
-                        break;
-                    case HASH_MD5:
-                        CC_MD5_Update(&md5HashObject,
-                                      (const void *)buffer,
-                                      (CC_LONG)bytesRead);
-                        break;
-                    case HASH_MD6_256:
-                    case HASH_MD6_512:
-
-                        /*
-                            Update the MD6 sum, passing in the number
-                            of bits (bytes*8) read (see md6sum.c in the
-                            reference implementation).
-                         */
-
-                        md6_update(&md6HashObject,
-                                   (unsigned char *)buffer,
-                                   bytesRead*8);
-                        break;
-                    case HASH_SHA1:
-                        CC_SHA1_Update(&sha1HashObject,
-                                       (const void *)buffer,
-                                       (CC_LONG)bytesRead);
-                        break;
-                    case HASH_SHA1DC:
-                        SHA1DCUpdate(&sha1DCHashObject,
-                                     (const char*)buffer,
-                                     (unsigned)bytesRead);
-                        break;
-                    case HASH_SHA224:
-                        CC_SHA224_Update(&sha256HashObject,
-                                         (const void *)buffer,
-                                         (CC_LONG)bytesRead);
-                        break;
-                    case HASH_SHA256:
-                        CC_SHA256_Update(&sha256HashObject,
-                                         (const void *)buffer,
-                                         (CC_LONG)bytesRead);
-                        break;
-                    case HASH_SHA384:
-                        CC_SHA384_Update(&sha512HashObject,
-                                         (const void *)buffer,
-                                         (CC_LONG)bytesRead);
-                        break;
-                    case HASH_SHA512:
-                        CC_SHA512_Update(&sha512HashObject,
-                                         (const void *)buffer,
-                                         (CC_LONG)bytesRead);
-                        break;
-                    case HASH_SHAKE128:
-                    case HASH_SHAKE256:
-                        keccak_xof_absorb(&sha3HashObject,
-                                          buffer,
-                                          bytesRead);
-                        break;
-                    case HASH_SHA3_224:
-                    case HASH_SHA3_256:
-                    case HASH_SHA3_384:
-                    case HASH_SHA3_512:
-
-                        /*
-                            Update the SHA3 sum, passing in the number
-                            of bits (bytes*8) read.
-                         */
-                        keccak_digest_update(&sha3HashObject,
-                                             buffer,
-                                             bytesRead);
-                        break;
-                    case HASH_RMD160:
-                        RMD160Update(&rmd160HashObject,
-                                     (const void *)buffer,
-                                     (uint32_t)bytesRead);
-                        break;
-                    case HASH_RMD320:
-                        rmd320_hash(&rmd320HashObject,
-                                    (const void *)buffer,
-                                    (size_t)bytesRead);
-                        break;
-                    case HASH_WPOOL:
-                        NESSIEadd(buffer,
-                                  (unsigned long)bytesRead*8,
-                                  &whirlpoolHashObject);
-                        break;
-                    case HASH_BLAKE2B_256:
-                    case HASH_BLAKE2B_512:
-                        blake2b_update(&blake2bHashObject,
-                                       (const uint8_t *)buffer,
-                                       (uint64_t)bytesRead);
-                        break;
-                    /*
-                    case HASH_BLAKE2BP_256:
-                    case HASH_BLAKE2BP_512:
-                        blake2bp_update(&blake2bpHashObject,
-                                       (const uint8_t *)buffer,
-                                       (uint64_t)bytesRead);
-                        break;
-                    */
-                    case HASH_BLAKE2S_256:
-                    //case HASH_BLAKE2S_512:
-                        blake2s_update(&blake2sHashObject,
-                                       (const uint8_t *)buffer,
-                                       (uint64_t)bytesRead);
-                        break;
-                    /*
-                    case HASH_BLAKE2SP_256:
-                    case HASH_BLAKE2SP_512:
-                        blake2sp_update(&blake2spHashObject,
-                                        (const uint8_t *)buffer,
-                                        (uint64_t)bytesRead);
-                        break;
-                    */
-                    case HASH_BLAKE3:
-                        blake3_hasher_update(&blake3HashObject,
-                                             buffer,
-                                             bytesRead);
-                        break;
-                    case HASH_SKEIN_256:
-                        Skein_256_Update(&skein256HashObject,
-                                         (const u08b_t *)buffer,
-                                         (size_t)bytesRead);
-                        break;
-                    case HASH_SKEIN_512:
-                    case HASH_SKEIN_512_256:
-                        Skein_512_Update(&skein512HashObject,
-                                         (const u08b_t *)buffer,
-                                         (size_t)bytesRead);
-                        break;
-                    case HASH_SKEIN_1024:
-                    case HASH_SKEIN_1024_256:
-                    case HASH_SKEIN_1024_512:
-                        Skein1024_Update(&skein1024HashObject,
-                                         (const u08b_t *)buffer,
-                                         (size_t)bytesRead);
-                        break;
-                    case HASH_JH_224:
-                    case HASH_JH_256:
-                    case HASH_JH_384:
-                    case HASH_JH_512:
-
-                        /*
-                            Update the JH sum, passing in the number
-                            of bits (bytes*8) read.
-                         */
-
-                        JH_Update(&jhHashObject,
-                                  (const JH_BitSequence *)buffer,
-                                  (JH_DataLength)(bytesRead*8));
-                        break;
-                    case HASH_TIGER:
-                    case HASH_TIGER2:
-                        rhash_tiger_update(&tigerHashObject,
-                                           (const unsigned char*)buffer,
-                                           (size_t)bytesRead);
-                        break;
-                    case HASH_HAS160:
-                        rhash_has160_update(&has160HashObject,
-                                           (const unsigned char*)buffer,
-                                           (size_t)bytesRead);
-                        break;
-                    case HASH_BLAKE224:
-                        blake224_update(&blake224HashObject,
-                                        (const uint8_t *)buffer,
-                                        bytesRead);
-                        break;
-                    case HASH_BLAKE256:
-                        blake256_update(&blake256HashObject,
-                                        (const uint8_t *)buffer,
-                                        bytesRead);
-                        break;
-                    case HASH_BLAKE384:
-                        blake384_update(&blake384HashObject,
-                                        (const uint8_t *)buffer,
-                                        bytesRead);
-                        break;
-                    case HASH_BLAKE512:
-                        blake512_update(&blake512HashObject,
-                                        (const uint8_t *)buffer,
-                                        bytesRead);
-                        break;
-                    case HASH_GROESTL224:
-                    case HASH_GROESTL256:
-                    case HASH_GROESTL384:
-                    case HASH_GROESTL512:
-                        groestl_Update(&groestlHashObject,
-                                       (const groestl_BitSequence *)buffer,
-                                       (groestl_DataLength)(bytesRead*8));
-                        break;
-                    case HASH_SNEFRU128:
-                    case HASH_SNEFRU256:
-                        rhash_snefru_update(&snefruHashObject,
-                                            (const unsigned char*)buffer,
-                                            (size_t)bytesRead);
-                        break;
-
-                    case HASH_LSH224:
-                    case HASH_LSH256:
-                    case HASH_LSH384:
-                    case HASH_LSH512:
-                        lsh_update(&lshHashObject,
-                                   (const lsh_u8 *)buffer,
-                                   (size_t)bytesRead*8);
-                        break;
-                    case HASH_K12_256:
-                    case HASH_K12_384:
-                    case HASH_K12_512:
-                        KangarooTwelve_Update(&k12HashObject,
-                                              (const unsigned char*)buffer,
-                                              (size_t)bytesRead);
-                        break;
-                    default:
-                        hasMoreData = FALSE;
-                        readFailed = TRUE;
-                        break;
-                }
             }
 
-            // finalize the hash
+            // wait for the hash to catch up with the reads, and finalize
+            // the hash
 
-            switch (hashType) {
-                case HASH_CKSUM:
-                    cksum_finalize(&crcHashObject, fileSize);
-                    break;
-                case HASH_CRC32:
-                    crc32_finalize(&crcHashObject);
-                    break;
-                case HASH_MD5:
-                    CC_MD5_Final(digest, &md5HashObject);
-                    break;
-                case HASH_MD6_256:
-                case HASH_MD6_512:
-                    md6_final(&md6HashObject, digest);
-                    break;
-                case HASH_SHA1:
-                    CC_SHA1_Final(digest, &sha1HashObject);
-                    break;
-                case HASH_SHA1DC:
-                    collision = SHA1DCFinal(digest, &sha1DCHashObject);
-                    break;
-                case HASH_SHA224:
-                    CC_SHA224_Final(digest, &sha256HashObject);
-                    break;
-                case HASH_SHA256:
-                    CC_SHA256_Final(digest, &sha256HashObject);
-                    break;
-                case HASH_SHA384:
-                    CC_SHA384_Final(digest, &sha512HashObject);
-                    break;
-                case HASH_SHA512:
-                    CC_SHA512_Final(digest, &sha512HashObject);
-                    break;
-                case HASH_SHAKE128:
-                case HASH_SHAKE256:
-                    keccak_xof_squeeze(&sha3HashObject,
-                                       digest,
-                                       digestLength);
-                    break;
-                case HASH_SHA3_224:
-                case HASH_SHA3_256:
-                case HASH_SHA3_384:
-                case HASH_SHA3_512:
-                    keccak_finalize(&sha3HashObject);
-                    keccak_squeeze(&sha3HashObject,
-                                   digest,
-                                   digestLength);
-                    break;
-                case HASH_RMD160:
-                    RMD160Final(digest, &rmd160HashObject);
-                    break;
-                case HASH_RMD320:
-                    rmd320_done(&rmd320HashObject, digest);
-                    break;
-                case HASH_WPOOL:
-                    NESSIEfinalize(&whirlpoolHashObject, digest);
-                    break;
-                case HASH_BLAKE2B_256:
-                    blake2b_final(&blake2bHashObject, digest, 32);
-                    break;
-                case HASH_BLAKE2B_512:
-                    blake2b_final(&blake2bHashObject, digest, 64);
-                    break;
-                /*
-                case HASH_BLAKE2BP_256:
-                    blake2bp_final(&blake2bpHashObject, digest, 32);
-                    break;
-                case HASH_BLAKE2BP_512:
-                    blake2bp_final(&blake2bpHashObject, digest, 64);
-                    break;
-                 */
-                case HASH_BLAKE2S_256:
-                    blake2s_final(&blake2sHashObject, digest, 32);
-                    break;
-                /*
-                case HASH_BLAKE2S_512:
-                    blake2s_final(&blake2sHashObject, digest, 64);
-                    break;
-                case HASH_BLAKE2SP_256:
-                    blake2sp_final(&blake2spHashObject, digest, 32);
-                    break;
-                case HASH_BLAKE2SP_512:
-                    blake2sp_final(&blake2spHashObject, digest, 64);
-                    break;
-                */
-                case HASH_BLAKE3:
-                    blake3_hasher_finalize(&blake3HashObject,
-                                           digest,
-                                           digestLength);
-                    break;
-                case HASH_SKEIN_256:
-                    Skein_256_Final(&skein256HashObject,
-                                    digest);
-                    break;
-                case HASH_SKEIN_512:
-                case HASH_SKEIN_512_256:
-                    Skein_512_Final(&skein512HashObject,
-                                    digest);
-                    break;
-                case HASH_SKEIN_1024:
-                case HASH_SKEIN_1024_256:
-                case HASH_SKEIN_1024_512:
-                    Skein1024_Final(&skein1024HashObject,
-                                    digest);
-                    break;
-                case HASH_JH_224:
-                case HASH_JH_256:
-                case HASH_JH_384:
-                case HASH_JH_512:
-                    JH_Final(&jhHashObject,
-                             (JH_BitSequence *)digest);
-                    break;
-                case HASH_TIGER:
-                case HASH_TIGER2:
-                    rhash_tiger_final(&tigerHashObject,
-                                      digest);
-                    break;
-                case HASH_HAS160:
-                    rhash_has160_final(&has160HashObject,
-                                       digest);
-                    break;
-                case HASH_BLAKE224:
-                    blake224_final(&blake224HashObject,
-                                   digest);
-                    break;
-                case HASH_BLAKE256:
-                    blake256_final(&blake256HashObject,
-                                   digest);
-                    break;
-                case HASH_BLAKE384:
-                    blake384_final(&blake384HashObject,
-                                   digest);
-                    break;
-                case HASH_BLAKE512:
-                    blake512_final(&blake512HashObject,
-                                   digest);
-                    break;
-                case HASH_GROESTL224:
-                case HASH_GROESTL256:
-                case HASH_GROESTL384:
-                case HASH_GROESTL512:
-                    groestl_Final(&groestlHashObject,
-                                  (groestl_BitSequence *)digest);
-                    break;
-                case HASH_SNEFRU128:
-                case HASH_SNEFRU256:
-                    rhash_snefru_final(&snefruHashObject,
-                                       digest);
-                    break;
-                case HASH_LSH224:
-                case HASH_LSH256:
-                case HASH_LSH384:
-                case HASH_LSH512:
-                    lsh_final(&lshHashObject, digest);
-                    break;
-                case HASH_K12_256:
-                case HASH_K12_384:
-                case HASH_K12_512:
-                    KangarooTwelve_Final(&k12HashObject,
-                                         0,
-                                         (const unsigned char *)"",
-                                         0);
-                    KangarooTwelve_Squeeze(&k12HashObject,
-                                           (unsigned char *)digest,
-                                           digestLength);
-                    break;
-                default:
-                    hasMoreData = FALSE;
-                    readFailed = TRUE;
-                    break;
+            hash_multi_wait(hashQueue);
+
+            // if the hash was cancelled, save how far it got, so that
+            // it can be resumed the next time, otherwise the checkpoint
+            // is no longer needed
+
+            if (checkpointFile != NULL) {
+                if (self.isCancelled == TRUE) {
+                    if (hashedSoFar > savedOffset) {
+                        (void)hash_checkpoint_save(checkpointFile,
+                                                   &fileKey,
+                                                   hashedSoFar,
+                                                   &hashContext,
+                                                   1);
+                    }
+                } else if (readFailed == FALSE) {
+                    hash_checkpoint_remove(checkpointFile);
+                }
+            }
+
+            collision = hash_engine_final(hashContext, digest);
+            if (collision < 0) {
+                readFailed = TRUE;
             }
 
             /* hide the dock progress bar */
@@ -1150,54 +619,64 @@
             // If the file was successfully read, covert the hash to a string
 
             if (readFailed == FALSE) {
-                if (hashType == HASH_CRC32 ||
-                    hashType == HASH_CKSUM) {
-                    hashResult = [NSMutableString stringWithFormat: @"%u",
-                                  crcHashObject.crc];
-                } else {
 
-                    /*
-                        allocate enough room to store the hash result,
-                        plus a collision detected message.
-                     */
-
-                    hashResult = [NSMutableString stringWithCapacity:
-                                  (2*digestLength) +
-                                  (hashType == HASH_SHA1DC ?
-                                   collisionMsgExtraBufferSize : 0) +
-                                  1];
-
-                    /*
-                        unless lowercase output was requested, output the
-                        hash in hex with capital letters for A-F
-                     */
-
-                    for (i = 0; i < digestLength; ++i) {
-                        [hashResult appendFormat:
-                         (isLowerCase ? @"%02x" : @"%02X"), (int)(digest[i])];
-                    }
+                /*
+                    unless lowercase output was requested, output the
+                    hash in hex with capital letters for A-F (CRC32 and
+                    cksum are output as decimal numbers)
+                 */
 
-                    /* if there was a collision, add the collision message */
+                hash_engine_digest_to_string(hashDesc,
+                                             digest,
+                                             isLowerCase,
+                                             digestStr);
 
-                    if (hashType == HASH_SHA1DC &&
-                        collision != 0) {
-                        [hashResult appendString: collisonMsg];
-                    }
+                /*
+                    allocate enough room to store the hash result,
+                    plus a collision detected message.
+                 */
+
+                hashResult = [NSMutableString stringWithCapacity:
+                              strlen(digestStr) +
+                              (collision > 0 ?
+                               collisionMsgExtraBufferSize : 0) +
+                              1];
+
+                [hashResult appendString:
+                 [NSString stringWithUTF8String: digestStr]];
+
+                /* if there was a collision, add the collision message */
+
+                if (collision > 0) {
+                    [hashResult appendString: collisonMsg];
                 }
             }
 
         } while (FALSE);
 
-        // clean up - close the read stream and free the digest
+        // clean up - stop the hash worker, close the read stream (or
+        // unmap the file), free the digest and the hash context
+
+        hash_multi_free(hashQueue);
 
         if (iStream != nil) {
             [iStream close];
         }
 
+        hash_unmap(&mappedFile);
+
         if (digest != NULL) {
             free(digest);
         }
 
+        if (digestStr != NULL) {
+            free(digestStr);
+        }
+
+        if (hashContext != NULL) {
+            hash_engine_free(hashContext);
+        }
+
         // call the hashComplete callback function if a requesting
         // object was specified
 
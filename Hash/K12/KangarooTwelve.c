@@ -19,6 +19,15 @@ http://creativecommons.org/publicdomain/zero/1.0/
 #include "KangarooTwelve.h"
 #include "KeccakP-1600-SnP.h"
 
+/* srv 2026-10-18 - hash the leaves of large inputs on multiple threads,
+   using the engine's thread pool */
+
+#if !defined(_WIN32) && !defined(K12_NO_PTHREADS)
+#define K12_USE_PTHREADS
+#include <stdlib.h>
+#include "hash_threads.h"
+#endif
+
 /* ---------------------------------------------------------------- */
 
 #define K12_security        128
@@ -169,6 +178,103 @@ void KangarooTwelve_Process8Leaves(const unsigned char *input, unsigned char *ou
 
 #endif  // KeccakP1600_disableParallelism
 
+#ifdef K12_USE_PTHREADS
+
+/*
+    Leaf scheduler: the complete leaves of a large input are split into
+    one contiguous range per thread, each thread writes the chaining
+    values of its leaves into a shared array (using the x2/x4/x8
+    implementations when available), and the chaining values are then
+    absorbed into the final node in order.
+ */
+
+#define K12_threadMinLeaves 64  /* at least 512KB per thread */
+
+typedef struct {
+    const unsigned char *input;
+    size_t leafCount;
+    unsigned char *output;
+} KangarooTwelve_LeafJob;
+
+static void KangarooTwelve_ComputeLeaves(const unsigned char *input, size_t leafCount, unsigned char *output)
+{
+#ifndef KeccakP1600_disableParallelism
+    if (KeccakP1600times8_IsAvailable()) {
+        for ( ; leafCount >= 8; leafCount -= 8) {
+            KangarooTwelve_Process8Leaves(input, output);
+            input += 8 * K12_chunkSize;
+            output += 8 * K12_capacityInBytes;
+        }
+    }
+    if (KeccakP1600times4_IsAvailable()) {
+        for ( ; leafCount >= 4; leafCount -= 4) {
+            KangarooTwelve_Process4Leaves(input, output);
+            input += 4 * K12_chunkSize;
+            output += 4 * K12_capacityInBytes;
+        }
+    }
+    if (KeccakP1600times2_IsAvailable()) {
+        for ( ; leafCount >= 2; leafCount -= 2) {
+            KangarooTwelve_Process2Leaves(input, output);
+            input += 2 * K12_chunkSize;
+            output += 2 * K12_capacityInBytes;
+        }
+    }
+#endif
+    for ( ; leafCount > 0; leafCount--) {
+        KangarooTwelve_F leaf;
+        KangarooTwelve_F_Initialize(&leaf);
+        KangarooTwelve_F_Absorb(&leaf, input, K12_chunkSize);
+        KangarooTwelve_F_AbsorbLastFewBits(&leaf, K12_suffixLeaf);
+        KangarooTwelve_F_Squeeze(&leaf, output, K12_capacityInBytes);
+        input += K12_chunkSize;
+        output += K12_capacityInBytes;
+    }
+}
+
+static void KangarooTwelve_LeafJobRun(void *arg, size_t index)
+{
+    KangarooTwelve_LeafJob *job = (KangarooTwelve_LeafJob *)arg + index;
+
+    KangarooTwelve_ComputeLeaves(job->input, job->leafCount, job->output);
+}
+
+/* Returns the number of input bytes processed, 0 if the input is too
+   small to be worth splitting across threads */
+
+static size_t KangarooTwelve_ProcessLeavesThreaded(KangarooTwelve_Instance *ktInstance, const unsigned char *input, size_t inputByteLen)
+{
+    KangarooTwelve_LeafJob jobs[HASH_THREADS_MAX];
+    size_t leafCount = inputByteLen / K12_chunkSize;
+    size_t threadCount = hash_threads_count(leafCount, K12_threadMinLeaves, 0);
+    size_t i, leaf = 0;
+    unsigned char *output;
+
+    if (threadCount < 2)
+        return 0;
+
+    output = (unsigned char *)malloc(leafCount * K12_capacityInBytes);
+    if (output == NULL)
+        return 0;
+
+    for (i = 0; i < threadCount; i++) {
+        jobs[i].leafCount = leafCount / threadCount + ((i < leafCount % threadCount) ? 1 : 0);
+        jobs[i].input = input + leaf * K12_chunkSize;
+        jobs[i].output = output + leaf * K12_capacityInBytes;
+        leaf += jobs[i].leafCount;
+    }
+
+    hash_threads_run(threadCount, KangarooTwelve_LeafJobRun, jobs);
+
+    KangarooTwelve_F_Absorb(&ktInstance->finalNode, output, leafCount * K12_capacityInBytes);
+    ktInstance->blockNumber += leafCount;
+    free(output);
+
+    return leafCount * K12_chunkSize;
+}
+
+#endif  // K12_USE_PTHREADS
+
 static unsigned int right_encode(unsigned char * encbuf, size_t value)
 {
     unsigned int n, i;
@@ -230,6 +336,14 @@ int KangarooTwelve_Update(KangarooTwelve_Instance *ktInstance, const unsigned ch
         }
     }
 
+#ifdef K12_USE_PTHREADS
+    {
+        size_t processed = KangarooTwelve_ProcessLeavesThreaded(ktInstance, input, inputByteLen);
+        input += processed;
+        inputByteLen -= processed;
+    }
+#endif
+
 #ifndef KeccakP1600_disableParallelism
     if (KeccakP1600times8_IsAvailable()) {
         ProcessLeaves(8);
@@ -26,7 +26,7 @@ Please refer to the XKCP for more details.
 #define KeccakP1600_stateSizeInBytes    200
 #define KeccakP1600_stateAlignment      8
 #define KeccakP1600_12rounds_FastLoop_supported
-#define KeccakP1600_disableParallelism
+#define KeccakP1600_24rounds_FastLoop_supported
 
 const char * KeccakP1600_GetImplementation(void);
 void KeccakP1600_Initialize(void *state);
@@ -36,6 +36,78 @@ void KeccakP1600_Permute_12rounds(void *state);
 void KeccakP1600_ExtractBytes(const void *state, unsigned char *data, unsigned int offset, unsigned int length);
 size_t KeccakP1600_12rounds_FastLoop_Absorb(void *state, unsigned int laneCount, const unsigned char *data, size_t dataByteLen);
 
+/* srv 2026-10-18 - the 24 round Keccak-f[1600] permutation, shared with
+   SHA-3 and SHAKE (see keccak-tiny-unrolled.c) */
+
+void KeccakP1600_Permute_24rounds(void *state);
+size_t KeccakP1600_24rounds_FastLoop_Absorb(void *state, unsigned int laneCount, const unsigned char *data, size_t dataByteLen);
+
+/*
+    srv 2026-10-18 - on x86_64, use the runtime dispatcher to select
+    between the AVX-512 and generic 64-bit single permutations, and the
+    SSSE3 / AVX2 / AVX-512 Keccak-p[1600]x2/x4/x8 implementations for
+    processing leaves in parallel.  The AVX2 single permutation is only
+    available as assembly, which isn't used (KeccakP1600_noAssembly).
+    The SIMD files enable their instruction sets with target pragmas
+    rather than per-file compiler flags, so that universal builds with
+    an arm64 slice still work.  Elsewhere, only the generic 64-bit
+    implementation is used.
+ */
+
+#if defined(__x86_64__) && !defined(_WIN32)
+
+#define KeccakP1600_noAssembly
+
+/* srv 2026-10-18 - allow the SIMD implementations to be turned off at
+   run time (see KangarooTwelve_DisableAVX512, etc.) */
+
+#define KeccakP1600_enable_simd_options
+
+void KeccakP1600_AVX512_Initialize(void *state);
+void KeccakP1600_AVX512_AddByte(void *state, unsigned char data, unsigned int offset);
+void KeccakP1600_AVX512_AddBytes(void *state, const unsigned char *data, unsigned int offset, unsigned int length);
+void KeccakP1600_AVX512_Permute_12rounds(void *state);
+void KeccakP1600_AVX512_ExtractBytes(const void *state, unsigned char *data, unsigned int offset, unsigned int length);
+size_t KeccakP1600_AVX512_12rounds_FastLoop_Absorb(void *state, unsigned int laneCount, const unsigned char *data, size_t dataByteLen);
+void KeccakP1600_AVX512_Permute_24rounds(void *state);
+size_t KeccakP1600_AVX512_24rounds_FastLoop_Absorb(void *state, unsigned int laneCount, const unsigned char *data, size_t dataByteLen);
+
+/* srv 2026-10-18 - the generic 64-bit implementation built for BMI1 and
+   BMI2 (KeccakP-1600-opt64-BMI.c), only its permutations are used */
+
+void KeccakP1600_BMI_Permute_12rounds(void *state);
+size_t KeccakP1600_BMI_12rounds_FastLoop_Absorb(void *state, unsigned int laneCount, const unsigned char *data, size_t dataByteLen);
+void KeccakP1600_BMI_Permute_24rounds(void *state);
+size_t KeccakP1600_BMI_24rounds_FastLoop_Absorb(void *state, unsigned int laneCount, const unsigned char *data, size_t dataByteLen);
+
+void KeccakP1600_opt64_Initialize(void *state);
+void KeccakP1600_opt64_AddByte(void *state, unsigned char data, unsigned int offset);
+void KeccakP1600_opt64_AddBytes(void *state, const unsigned char *data, unsigned int offset, unsigned int length);
+void KeccakP1600_opt64_Permute_12rounds(void *state);
+void KeccakP1600_opt64_ExtractBytes(const void *state, unsigned char *data, unsigned int offset, unsigned int length);
+size_t KeccakP1600_opt64_12rounds_FastLoop_Absorb(void *state, unsigned int laneCount, const unsigned char *data, size_t dataByteLen);
+void KeccakP1600_opt64_Permute_24rounds(void *state);
+size_t KeccakP1600_opt64_24rounds_FastLoop_Absorb(void *state, unsigned int laneCount, const unsigned char *data, size_t dataByteLen);
+
+/* Keccak-p[1600]×2 */
+
+int KeccakP1600times2_IsAvailable(void);
+const char * KeccakP1600times2_GetImplementation(void);
+
+/* Keccak-p[1600]×4 */
+
+int KeccakP1600times4_IsAvailable(void);
+const char * KeccakP1600times4_GetImplementation(void);
+
+/* Keccak-p[1600]×8 */
+
+int KeccakP1600times8_IsAvailable(void);
+const char * KeccakP1600times8_GetImplementation(void);
+
+#else
+
+#define KeccakP1600_disableParallelism
+
 // Instead of defining proxy functions which do nothing, simply rename the
 // symbols of the opt64 implementation where they are used.
 #define KeccakP1600_opt64_Initialize KeccakP1600_Initialize
@@ -44,5 +116,9 @@ size_t KeccakP1600_12rounds_FastLoop_Absorb(void *state, unsigned int laneCount,
 #define KeccakP1600_opt64_Permute_12rounds KeccakP1600_Permute_12rounds
 #define KeccakP1600_opt64_ExtractBytes KeccakP1600_ExtractBytes
 #define KeccakP1600_opt64_12rounds_FastLoop_Absorb KeccakP1600_12rounds_FastLoop_Absorb
+#define KeccakP1600_opt64_Permute_24rounds KeccakP1600_Permute_24rounds
+#define KeccakP1600_opt64_24rounds_FastLoop_Absorb KeccakP1600_24rounds_FastLoop_Absorb
+
+#endif /* __x86_64__ && !_WIN32 */
 
 #endif
@@ -0,0 +1,57 @@
+/*
+K12 based on the eXtended Keccak Code Package (XKCP)
+https://github.com/XKCP/XKCP
+
+The Keccak-p permutations, designed by Guido Bertoni, Joan Daemen, Michaël Peeters and Gilles Van Assche.
+
+Implementation by Gilles Van Assche and Ronny Van Keer, hereby denoted as "the implementer".
+
+For more information, feedback or questions, please refer to the Keccak Team website:
+https://keccak.team/
+
+To the extent possible under law, the implementer has waived all copyright
+and related or neighboring rights to the source code in this file.
+http://creativecommons.org/publicdomain/zero/1.0/
+
+---
+
+Please refer to the XKCP for more details.
+*/
+
+/*
+    srv 2026-10-18 - the generic 64-bit implementation built for cpus
+    with BMI1 and BMI2 (x86_64 only), where ANDN and RORX make lane
+    complementing unnecessary.  Only the permutations are used, the
+    state layout is the same as the generic 64-bit implementation's.
+ */
+
+#if defined(__x86_64__) && !defined(_WIN32)
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("bmi,bmi2"))), apply_to = function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("bmi,bmi2")
+#endif
+
+#define KeccakP1600_opt64_implementation_config "all rounds unrolled, BMI"
+#define KeccakP1600_opt64_fullUnrolling
+
+#define KeccakP1600_opt64_Initialize KeccakP1600_BMI_Initialize
+#define KeccakP1600_opt64_AddByte KeccakP1600_BMI_AddByte
+#define KeccakP1600_opt64_AddBytes KeccakP1600_BMI_AddBytes
+#define KeccakP1600_opt64_ExtractBytes KeccakP1600_BMI_ExtractBytes
+#define KeccakP1600_opt64_Permute_12rounds KeccakP1600_BMI_Permute_12rounds
+#define KeccakP1600_opt64_12rounds_FastLoop_Absorb KeccakP1600_BMI_12rounds_FastLoop_Absorb
+#define KeccakP1600_opt64_Permute_24rounds KeccakP1600_BMI_Permute_24rounds
+#define KeccakP1600_opt64_24rounds_FastLoop_Absorb KeccakP1600_BMI_24rounds_FastLoop_Absorb
+
+#include "KeccakP-1600-opt64.c"
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif /* __x86_64__ && !_WIN32 */
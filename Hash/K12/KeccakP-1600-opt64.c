@@ -24,8 +24,26 @@ Please refer to the XKCP for more details.
 #include "brg_endian.h"
 #include "KeccakP-1600-SnP.h"
 
+/*
+    srv 2026-10-18 - use lane complementing, which saves a NOT in most of
+    the chi steps.  The complemented lanes are only kept in registers
+    (see copyFromState and copyToState), the state in memory is the
+    same as that of the AVX-512 and BMI implementations, so that the
+    dispatcher can switch between them at any time, and a serialized
+    state can be resumed on any cpu.  KeccakP-1600-opt64-BMI.c includes
+    this file with its own configuration and function names.
+ */
+
+#ifndef KeccakP1600_opt64_implementation_config
+#define KeccakP1600_opt64_implementation_config "lane complementing, all rounds unrolled"
+#define KeccakP1600_opt64_fullUnrolling
+#define KeccakP1600_opt64_useLaneComplementing
+#endif
+
+/*
 #define KeccakP1600_opt64_implementation_config "all rounds unrolled"
 #define KeccakP1600_opt64_fullUnrolling
+*/
 /* Or */
 /*
 #define KeccakP1600_opt64_implementation_config "6 rounds unrolled"
@@ -105,14 +123,6 @@ static const uint64_t KeccakF1600RoundConstants[24] = {
 void KeccakP1600_opt64_Initialize(void *state)
 {
     memset(state, 0, 200);
-#ifdef KeccakP1600_opt64_useLaneComplementing
-    ((uint64_t*)state)[ 1] = ~(uint64_t)0;
-    ((uint64_t*)state)[ 2] = ~(uint64_t)0;
-    ((uint64_t*)state)[ 8] = ~(uint64_t)0;
-    ((uint64_t*)state)[12] = ~(uint64_t)0;
-    ((uint64_t*)state)[17] = ~(uint64_t)0;
-    ((uint64_t*)state)[20] = ~(uint64_t)0;
-#endif
 }
 
 /* ---------------------------------------------------------------- */
@@ -691,28 +701,34 @@ void KeccakP1600_opt64_AddBytes(void *state, const unsigned char *data, unsigned
 
 #endif /* UseBebigokimisa */
 
+#ifdef KeccakP1600_opt64_useLaneComplementing
+#define complementLane(x) (~(x))
+#else
+#define complementLane(x) (x)
+#endif
+
 #define copyFromState(X, state) \
     X##ba = state[ 0]; \
-    X##be = state[ 1]; \
-    X##bi = state[ 2]; \
+    X##be = complementLane(state[ 1]); \
+    X##bi = complementLane(state[ 2]); \
     X##bo = state[ 3]; \
     X##bu = state[ 4]; \
     X##ga = state[ 5]; \
     X##ge = state[ 6]; \
     X##gi = state[ 7]; \
-    X##go = state[ 8]; \
+    X##go = complementLane(state[ 8]); \
     X##gu = state[ 9]; \
     X##ka = state[10]; \
     X##ke = state[11]; \
-    X##ki = state[12]; \
+    X##ki = complementLane(state[12]); \
     X##ko = state[13]; \
     X##ku = state[14]; \
     X##ma = state[15]; \
     X##me = state[16]; \
-    X##mi = state[17]; \
+    X##mi = complementLane(state[17]); \
     X##mo = state[18]; \
     X##mu = state[19]; \
-    X##sa = state[20]; \
+    X##sa = complementLane(state[20]); \
     X##se = state[21]; \
     X##si = state[22]; \
     X##so = state[23]; \
@@ -720,26 +736,26 @@ void KeccakP1600_opt64_AddBytes(void *state, const unsigned char *data, unsigned
 
 #define copyToState(state, X) \
     state[ 0] = X##ba; \
-    state[ 1] = X##be; \
-    state[ 2] = X##bi; \
+    state[ 1] = complementLane(X##be); \
+    state[ 2] = complementLane(X##bi); \
     state[ 3] = X##bo; \
     state[ 4] = X##bu; \
     state[ 5] = X##ga; \
     state[ 6] = X##ge; \
     state[ 7] = X##gi; \
-    state[ 8] = X##go; \
+    state[ 8] = complementLane(X##go); \
     state[ 9] = X##gu; \
     state[10] = X##ka; \
     state[11] = X##ke; \
-    state[12] = X##ki; \
+    state[12] = complementLane(X##ki); \
     state[13] = X##ko; \
     state[14] = X##ku; \
     state[15] = X##ma; \
     state[16] = X##me; \
-    state[17] = X##mi; \
+    state[17] = complementLane(X##mi); \
     state[18] = X##mo; \
     state[19] = X##mu; \
-    state[20] = X##sa; \
+    state[20] = complementLane(X##sa); \
     state[21] = X##se; \
     state[22] = X##si; \
     state[23] = X##so; \
@@ -840,6 +856,86 @@ void KeccakP1600_opt64_AddBytes(void *state, const unsigned char *data, unsigned
 #error "Unrolling is not correctly specified!"
 #endif
 
+/* srv 2026-10-18 - all 24 rounds, for Keccak-f[1600] (SHA-3 and SHAKE) */
+
+#if ((defined(FullUnrolling)) || (Unrolling == 12))
+#define rounds24 \
+    prepareTheta \
+    thetaRhoPiChiIotaPrepareTheta( 0, A, E) \
+    thetaRhoPiChiIotaPrepareTheta( 1, E, A) \
+    thetaRhoPiChiIotaPrepareTheta( 2, A, E) \
+    thetaRhoPiChiIotaPrepareTheta( 3, E, A) \
+    thetaRhoPiChiIotaPrepareTheta( 4, A, E) \
+    thetaRhoPiChiIotaPrepareTheta( 5, E, A) \
+    thetaRhoPiChiIotaPrepareTheta( 6, A, E) \
+    thetaRhoPiChiIotaPrepareTheta( 7, E, A) \
+    thetaRhoPiChiIotaPrepareTheta( 8, A, E) \
+    thetaRhoPiChiIotaPrepareTheta( 9, E, A) \
+    thetaRhoPiChiIotaPrepareTheta(10, A, E) \
+    thetaRhoPiChiIotaPrepareTheta(11, E, A) \
+    thetaRhoPiChiIotaPrepareTheta(12, A, E) \
+    thetaRhoPiChiIotaPrepareTheta(13, E, A) \
+    thetaRhoPiChiIotaPrepareTheta(14, A, E) \
+    thetaRhoPiChiIotaPrepareTheta(15, E, A) \
+    thetaRhoPiChiIotaPrepareTheta(16, A, E) \
+    thetaRhoPiChiIotaPrepareTheta(17, E, A) \
+    thetaRhoPiChiIotaPrepareTheta(18, A, E) \
+    thetaRhoPiChiIotaPrepareTheta(19, E, A) \
+    thetaRhoPiChiIotaPrepareTheta(20, A, E) \
+    thetaRhoPiChiIotaPrepareTheta(21, E, A) \
+    thetaRhoPiChiIotaPrepareTheta(22, A, E) \
+    thetaRhoPiChiIota(23, E, A) \
+
+#elif (Unrolling == 6)
+#define rounds24 \
+    prepareTheta \
+    for(i=0; i<24; i+=6) { \
+        thetaRhoPiChiIotaPrepareTheta(i  , A, E) \
+        thetaRhoPiChiIotaPrepareTheta(i+1, E, A) \
+        thetaRhoPiChiIotaPrepareTheta(i+2, A, E) \
+        thetaRhoPiChiIotaPrepareTheta(i+3, E, A) \
+        thetaRhoPiChiIotaPrepareTheta(i+4, A, E) \
+        thetaRhoPiChiIotaPrepareTheta(i+5, E, A) \
+    } \
+
+#elif (Unrolling == 4)
+#define rounds24 \
+    prepareTheta \
+    for(i=0; i<24; i+=4) { \
+        thetaRhoPiChiIotaPrepareTheta(i  , A, E) \
+        thetaRhoPiChiIotaPrepareTheta(i+1, E, A) \
+        thetaRhoPiChiIotaPrepareTheta(i+2, A, E) \
+        thetaRhoPiChiIotaPrepareTheta(i+3, E, A) \
+    } \
+
+#elif (Unrolling == 3)
+#define rounds24 \
+    prepareTheta \
+    for(i=0; i<24; i+=3) { \
+        thetaRhoPiChiIotaPrepareTheta(i  , A, E) \
+        thetaRhoPiChiIotaPrepareTheta(i+1, E, A) \
+        thetaRhoPiChiIotaPrepareTheta(i+2, A, E) \
+        copyStateVariables(A, E) \
+    } \
+
+#elif (Unrolling == 2)
+#define rounds24 \
+    prepareTheta \
+    for(i=0; i<24; i+=2) { \
+        thetaRhoPiChiIotaPrepareTheta(i  , A, E) \
+        thetaRhoPiChiIotaPrepareTheta(i+1, E, A) \
+    } \
+
+#elif (Unrolling == 1)
+#define rounds24 \
+    prepareTheta \
+    for(i=0; i<24; i++) { \
+        thetaRhoPiChiIotaPrepareTheta(i  , A, E) \
+        copyStateVariables(A, E) \
+    } \
+
+#endif
+
 void KeccakP1600_opt64_Permute_12rounds(void *state)
 {
     declareABCDE
@@ -855,13 +951,24 @@ void KeccakP1600_opt64_Permute_12rounds(void *state)
 
 /* ---------------------------------------------------------------- */
 
+void KeccakP1600_opt64_Permute_24rounds(void *state)
+{
+    declareABCDE
+    #ifndef KeccakP1600_opt64_fullUnrolling
+    unsigned int i;
+    #endif
+    uint64_t *stateAsLanes = (uint64_t*)state;
+
+    copyFromState(A, stateAsLanes)
+    rounds24
+    copyToState(stateAsLanes, A)
+}
+
+/* ---------------------------------------------------------------- */
+
 static void KeccakP1600_opt64_ExtractBytesInLane(const void *state, unsigned int lanePosition, unsigned char *data, unsigned int offset, unsigned int length)
 {
     uint64_t lane = ((uint64_t*)state)[lanePosition];
-#ifdef KeccakP1600_opt64_useLaneComplementing
-    if ((lanePosition == 1) || (lanePosition == 2) || (lanePosition == 8) || (lanePosition == 12) || (lanePosition == 17) || (lanePosition == 20))
-        lane = ~lane;
-#endif
 #if (PLATFORM_BYTE_ORDER == IS_LITTLE_ENDIAN)
     {
         uint64_t lane1[1];
@@ -900,26 +1007,6 @@ static void KeccakP1600_opt64_ExtractLanes(const void *state, unsigned char *dat
     for(i=0; i<laneCount; i++)
         fromWordToBytes(data+(i*8), ((const uint64_t*)state)[i]);
 #endif
-#ifdef KeccakP1600_opt64_useLaneComplementing
-    if (laneCount > 1) {
-        ((uint64_t*)data)[ 1] = ~((uint64_t*)data)[ 1];
-        if (laneCount > 2) {
-            ((uint64_t*)data)[ 2] = ~((uint64_t*)data)[ 2];
-            if (laneCount > 8) {
-                ((uint64_t*)data)[ 8] = ~((uint64_t*)data)[ 8];
-                if (laneCount > 12) {
-                    ((uint64_t*)data)[12] = ~((uint64_t*)data)[12];
-                    if (laneCount > 17) {
-                        ((uint64_t*)data)[17] = ~((uint64_t*)data)[17];
-                        if (laneCount > 20) {
-                            ((uint64_t*)data)[20] = ~((uint64_t*)data)[20];
-                        }
-                    }
-                }
-            }
-        }
-    }
-#endif
 }
 
 /* ---------------------------------------------------------------- */
@@ -973,6 +1060,8 @@ void KeccakP1600_opt64_ExtractBytes(const void *state, unsigned char *data, unsi
   ((x & 0x00000000000000ffull) << 56))
 #endif
 
+/* srv 2026-10-18 - any lane count, for the SHA-3 and SHAKE rates */
+
 #define addInput(X, input, laneCount) \
     if (laneCount == 21) { \
         X##ba ^= HTOLE64(input[ 0]); \
@@ -997,6 +1086,165 @@ void KeccakP1600_opt64_ExtractBytes(const void *state, unsigned char *data, unsi
         X##mu ^= HTOLE64(input[19]); \
         X##sa ^= HTOLE64(input[20]); \
     } \
+    else { \
+        if (laneCount < 13) { \
+            if (laneCount < 6) { \
+                if (laneCount < 3) { \
+                    if (laneCount < 1) { \
+                    } \
+                    else { \
+                        X##ba ^= HTOLE64(input[ 0]); \
+                        if (laneCount < 2) { \
+                        } \
+                        else { \
+                            X##be ^= HTOLE64(input[ 1]); \
+                        } \
+                    } \
+                } \
+                else { \
+                    X##ba ^= HTOLE64(input[ 0]); \
+                    X##be ^= HTOLE64(input[ 1]); \
+                    X##bi ^= HTOLE64(input[ 2]); \
+                    if (laneCount < 4) { \
+                    } \
+                    else { \
+                        X##bo ^= HTOLE64(input[ 3]); \
+                        if (laneCount < 5) { \
+                        } \
+                        else { \
+                            X##bu ^= HTOLE64(input[ 4]); \
+                        } \
+                    } \
+                } \
+            } \
+            else { \
+                X##ba ^= HTOLE64(input[ 0]); \
+                X##be ^= HTOLE64(input[ 1]); \
+                X##bi ^= HTOLE64(input[ 2]); \
+                X##bo ^= HTOLE64(input[ 3]); \
+                X##bu ^= HTOLE64(input[ 4]); \
+                X##ga ^= HTOLE64(input[ 5]); \
+                if (laneCount < 9) { \
+                    if (laneCount < 7) { \
+                    } \
+                    else { \
+                        X##ge ^= HTOLE64(input[ 6]); \
+                        if (laneCount < 8) { \
+                        } \
+                        else { \
+                            X##gi ^= HTOLE64(input[ 7]); \
+                        } \
+                    } \
+                } \
+                else { \
+                    X##ge ^= HTOLE64(input[ 6]); \
+                    X##gi ^= HTOLE64(input[ 7]); \
+                    X##go ^= HTOLE64(input[ 8]); \
+                    if (laneCount < 11) { \
+                        if (laneCount < 10) { \
+                        } \
+                        else { \
+                            X##gu ^= HTOLE64(input[ 9]); \
+                        } \
+                    } \
+                    else { \
+                        X##gu ^= HTOLE64(input[ 9]); \
+                        X##ka ^= HTOLE64(input[10]); \
+                        if (laneCount < 12) { \
+                        } \
+                        else { \
+                            X##ke ^= HTOLE64(input[11]); \
+                        } \
+                    } \
+                } \
+            } \
+        } \
+        else { \
+            X##ba ^= HTOLE64(input[ 0]); \
+            X##be ^= HTOLE64(input[ 1]); \
+            X##bi ^= HTOLE64(input[ 2]); \
+            X##bo ^= HTOLE64(input[ 3]); \
+            X##bu ^= HTOLE64(input[ 4]); \
+            X##ga ^= HTOLE64(input[ 5]); \
+            X##ge ^= HTOLE64(input[ 6]); \
+            X##gi ^= HTOLE64(input[ 7]); \
+            X##go ^= HTOLE64(input[ 8]); \
+            X##gu ^= HTOLE64(input[ 9]); \
+            X##ka ^= HTOLE64(input[10]); \
+            X##ke ^= HTOLE64(input[11]); \
+            X##ki ^= HTOLE64(input[12]); \
+            if (laneCount < 19) { \
+                if (laneCount < 16) { \
+                    if (laneCount < 14) { \
+                    } \
+                    else { \
+                        X##ko ^= HTOLE64(input[13]); \
+                        if (laneCount < 15) { \
+                        } \
+                        else { \
+                            X##ku ^= HTOLE64(input[14]); \
+                        } \
+                    } \
+                } \
+                else { \
+                    X##ko ^= HTOLE64(input[13]); \
+                    X##ku ^= HTOLE64(input[14]); \
+                    X##ma ^= HTOLE64(input[15]); \
+                    if (laneCount < 17) { \
+                    } \
+                    else { \
+                        X##me ^= HTOLE64(input[16]); \
+                        if (laneCount < 18) { \
+                        } \
+                        else { \
+                            X##mi ^= HTOLE64(input[17]); \
+                        } \
+                    } \
+                } \
+            } \
+            else { \
+                X##ko ^= HTOLE64(input[13]); \
+                X##ku ^= HTOLE64(input[14]); \
+                X##ma ^= HTOLE64(input[15]); \
+                X##me ^= HTOLE64(input[16]); \
+                X##mi ^= HTOLE64(input[17]); \
+                X##mo ^= HTOLE64(input[18]); \
+                if (laneCount < 22) { \
+                    if (laneCount < 20) { \
+                    } \
+                    else { \
+                        X##mu ^= HTOLE64(input[19]); \
+                        if (laneCount < 21) { \
+                        } \
+                        else { \
+                            X##sa ^= HTOLE64(input[20]); \
+                        } \
+                    } \
+                } \
+                else { \
+                    X##mu ^= HTOLE64(input[19]); \
+                    X##sa ^= HTOLE64(input[20]); \
+                    X##se ^= HTOLE64(input[21]); \
+                    if (laneCount < 24) { \
+                        if (laneCount < 23) { \
+                        } \
+                        else { \
+                            X##si ^= HTOLE64(input[22]); \
+                        } \
+                    } \
+                    else { \
+                        X##si ^= HTOLE64(input[22]); \
+                        X##so ^= HTOLE64(input[23]); \
+                        if (laneCount < 25) { \
+                        } \
+                        else { \
+                            X##su ^= HTOLE64(input[24]); \
+                        } \
+                    } \
+                } \
+            } \
+        } \
+    } \
 
 #include <assert.h>
 
@@ -1024,3 +1272,26 @@ size_t KeccakP1600_opt64_12rounds_FastLoop_Absorb(void *state, unsigned int lane
     copyToState(stateAsLanes, A)
     return originalDataByteLen - dataByteLen;
 }
+
+/* ---------------------------------------------------------------- */
+
+size_t KeccakP1600_opt64_24rounds_FastLoop_Absorb(void *state, unsigned int laneCount, const unsigned char *data, size_t dataByteLen)
+{
+    size_t originalDataByteLen = dataByteLen;
+    declareABCDE
+    #ifndef KeccakP1600_opt64_fullUnrolling
+    unsigned int i;
+    #endif
+    uint64_t *stateAsLanes = (uint64_t*)state;
+    uint64_t *inDataAsLanes = (uint64_t*)data;
+
+    copyFromState(A, stateAsLanes)
+    while(dataByteLen >= laneCount*8) {
+        addInput(A, inDataAsLanes, laneCount)
+        rounds24
+        inDataAsLanes += laneCount;
+        dataByteLen -= laneCount*8;
+    }
+    copyToState(stateAsLanes, A)
+    return originalDataByteLen - dataByteLen;
+}
@@ -0,0 +1,232 @@
+/*
+    Hash - md5.c
+
+    History:
+
+    v. 1.0.0 (10/18/2026) - Initial version
+
+    Copyright (c) 2026 Sriranga R. Veeraraghavan <ranga@calalum.org>
+
+    Permission is hereby granted, free of charge, to any person obtaining
+    a copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+    OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <string.h>
+
+#include "md5.h"
+
+/* load a little endian 32-bit word */
+
+static inline uint32_t load32_le(const uint8_t *p)
+{
+    return ((uint32_t)p[0]) |
+           ((uint32_t)p[1] << 8) |
+           ((uint32_t)p[2] << 16) |
+           ((uint32_t)p[3] << 24);
+}
+
+static inline void store32_le(uint8_t *p, uint32_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+#define ROTL32(x, n) (((x) << (n)) | ((x) >> (32 - (n))))
+
+/*
+    The round functions, F and G are written so that they need one
+    fewer operation than the definitions in RFC 1321.
+ */
+
+#define F(x, y, z) ((z) ^ ((x) & ((y) ^ (z))))
+#define G(x, y, z) ((y) ^ ((z) & ((x) ^ (y))))
+#define H(x, y, z) ((x) ^ (y) ^ (z))
+#define I(x, y, z) ((y) ^ ((x) | ~(z)))
+
+#define STEP(f, a, b, c, d, x, k, s) \
+    (a) += f((b), (c), (d)) + (x) + (uint32_t)(k); \
+    (a) = ROTL32((a), (s)) + (b)
+
+/* md5_compress - run the compression function over nblocks blocks */
+
+void md5_compress(uint32_t state[4], const uint8_t *blocks, size_t nblocks)
+{
+    uint32_t a, b, c, d;
+    uint32_t x[16];
+    int i = 0;
+
+    while (nblocks-- > 0) {
+
+        for (i = 0; i < 16; i++) {
+            x[i] = load32_le(blocks + i*4);
+        }
+
+        a = state[0];
+        b = state[1];
+        c = state[2];
+        d = state[3];
+
+        STEP(F, a, b, c, d, x[ 0], 0xd76aa478,  7);
+        STEP(F, d, a, b, c, x[ 1], 0xe8c7b756, 12);
+        STEP(F, c, d, a, b, x[ 2], 0x242070db, 17);
+        STEP(F, b, c, d, a, x[ 3], 0xc1bdceee, 22);
+        STEP(F, a, b, c, d, x[ 4], 0xf57c0faf,  7);
+        STEP(F, d, a, b, c, x[ 5], 0x4787c62a, 12);
+        STEP(F, c, d, a, b, x[ 6], 0xa8304613, 17);
+        STEP(F, b, c, d, a, x[ 7], 0xfd469501, 22);
+        STEP(F, a, b, c, d, x[ 8], 0x698098d8,  7);
+        STEP(F, d, a, b, c, x[ 9], 0x8b44f7af, 12);
+        STEP(F, c, d, a, b, x[10], 0xffff5bb1, 17);
+        STEP(F, b, c, d, a, x[11], 0x895cd7be, 22);
+        STEP(F, a, b, c, d, x[12], 0x6b901122,  7);
+        STEP(F, d, a, b, c, x[13], 0xfd987193, 12);
+        STEP(F, c, d, a, b, x[14], 0xa679438e, 17);
+        STEP(F, b, c, d, a, x[15], 0x49b40821, 22);
+
+        STEP(G, a, b, c, d, x[ 1], 0xf61e2562,  5);
+        STEP(G, d, a, b, c, x[ 6], 0xc040b340,  9);
+        STEP(G, c, d, a, b, x[11], 0x265e5a51, 14);
+        STEP(G, b, c, d, a, x[ 0], 0xe9b6c7aa, 20);
+        STEP(G, a, b, c, d, x[ 5], 0xd62f105d,  5);
+        STEP(G, d, a, b, c, x[10], 0x02441453,  9);
+        STEP(G, c, d, a, b, x[15], 0xd8a1e681, 14);
+        STEP(G, b, c, d, a, x[ 4], 0xe7d3fbc8, 20);
+        STEP(G, a, b, c, d, x[ 9], 0x21e1cde6,  5);
+        STEP(G, d, a, b, c, x[14], 0xc33707d6,  9);
+        STEP(G, c, d, a, b, x[ 3], 0xf4d50d87, 14);
+        STEP(G, b, c, d, a, x[ 8], 0x455a14ed, 20);
+        STEP(G, a, b, c, d, x[13], 0xa9e3e905,  5);
+        STEP(G, d, a, b, c, x[ 2], 0xfcefa3f8,  9);
+        STEP(G, c, d, a, b, x[ 7], 0x676f02d9, 14);
+        STEP(G, b, c, d, a, x[12], 0x8d2a4c8a, 20);
+
+        STEP(H, a, b, c, d, x[ 5], 0xfffa3942,  4);
+        STEP(H, d, a, b, c, x[ 8], 0x8771f681, 11);
+        STEP(H, c, d, a, b, x[11], 0x6d9d6122, 16);
+        STEP(H, b, c, d, a, x[14], 0xfde5380c, 23);
+        STEP(H, a, b, c, d, x[ 1], 0xa4beea44,  4);
+        STEP(H, d, a, b, c, x[ 4], 0x4bdecfa9, 11);
+        STEP(H, c, d, a, b, x[ 7], 0xf6bb4b60, 16);
+        STEP(H, b, c, d, a, x[10], 0xbebfbc70, 23);
+        STEP(H, a, b, c, d, x[13], 0x289b7ec6,  4);
+        STEP(H, d, a, b, c, x[ 0], 0xeaa127fa, 11);
+        STEP(H, c, d, a, b, x[ 3], 0xd4ef3085, 16);
+        STEP(H, b, c, d, a, x[ 6], 0x04881d05, 23);
+        STEP(H, a, b, c, d, x[ 9], 0xd9d4d039,  4);
+        STEP(H, d, a, b, c, x[12], 0xe6db99e5, 11);
+        STEP(H, c, d, a, b, x[15], 0x1fa27cf8, 16);
+        STEP(H, b, c, d, a, x[ 2], 0xc4ac5665, 23);
+
+        STEP(I, a, b, c, d, x[ 0], 0xf4292244,  6);
+        STEP(I, d, a, b, c, x[ 7], 0x432aff97, 10);
+        STEP(I, c, d, a, b, x[14], 0xab9423a7, 15);
+        STEP(I, b, c, d, a, x[ 5], 0xfc93a039, 21);
+        STEP(I, a, b, c, d, x[12], 0x655b59c3,  6);
+        STEP(I, d, a, b, c, x[ 3], 0x8f0ccc92, 10);
+        STEP(I, c, d, a, b, x[10], 0xffeff47d, 15);
+        STEP(I, b, c, d, a, x[ 1], 0x85845dd1, 21);
+        STEP(I, a, b, c, d, x[ 8], 0x6fa87e4f,  6);
+        STEP(I, d, a, b, c, x[15], 0xfe2ce6e0, 10);
+        STEP(I, c, d, a, b, x[ 6], 0xa3014314, 15);
+        STEP(I, b, c, d, a, x[13], 0x4e0811a1, 21);
+        STEP(I, a, b, c, d, x[ 4], 0xf7537e82,  6);
+        STEP(I, d, a, b, c, x[11], 0xbd3af235, 10);
+        STEP(I, c, d, a, b, x[ 2], 0x2ad7d2bb, 15);
+        STEP(I, b, c, d, a, x[ 9], 0xeb86d391, 21);
+
+        state[0] += a;
+        state[1] += b;
+        state[2] += c;
+        state[3] += d;
+
+        blocks += MD5_BLOCK_LENGTH;
+    }
+}
+
+void md5_init(md5_ctx *ctx)
+{
+    ctx->state[0] = 0x67452301;
+    ctx->state[1] = 0xefcdab89;
+    ctx->state[2] = 0x98badcfe;
+    ctx->state[3] = 0x10325476;
+    ctx->count = 0;
+}
+
+void md5_update(md5_ctx *ctx, const void *data, size_t length)
+{
+    const uint8_t *in = data;
+    size_t used = (size_t)(ctx->count % MD5_BLOCK_LENGTH);
+    size_t n = 0;
+
+    ctx->count += length;
+
+    // fill up a partial block first
+
+    if (used > 0) {
+        n = MD5_BLOCK_LENGTH - used;
+        if (length < n) {
+            memcpy(ctx->buffer + used, in, length);
+            return;
+        }
+        memcpy(ctx->buffer + used, in, n);
+        md5_compress(ctx->state, ctx->buffer, 1);
+        in += n;
+        length -= n;
+    }
+
+    // whole blocks are compressed straight from the input
+
+    n = length / MD5_BLOCK_LENGTH;
+    if (n > 0) {
+        md5_compress(ctx->state, in, n);
+        in += n*MD5_BLOCK_LENGTH;
+        length -= n*MD5_BLOCK_LENGTH;
+    }
+
+    if (length > 0) {
+        memcpy(ctx->buffer, in, length);
+    }
+}
+
+void md5_final(md5_ctx *ctx, uint8_t digest[MD5_DIGEST_LENGTH])
+{
+    size_t used = (size_t)(ctx->count % MD5_BLOCK_LENGTH);
+    uint64_t bits = ctx->count << 3;
+    int i = 0;
+
+    // pad with 0x80, zeros, and the message length in bits
+
+    ctx->buffer[used++] = 0x80;
+    if (used > MD5_BLOCK_LENGTH - 8) {
+        memset(ctx->buffer + used, 0, MD5_BLOCK_LENGTH - used);
+        md5_compress(ctx->state, ctx->buffer, 1);
+        used = 0;
+    }
+    memset(ctx->buffer + used, 0, MD5_BLOCK_LENGTH - 8 - used);
+    store32_le(ctx->buffer + 56, (uint32_t)bits);
+    store32_le(ctx->buffer + 60, (uint32_t)(bits >> 32));
+    md5_compress(ctx->state, ctx->buffer, 1);
+
+    for (i = 0; i < 4; i++) {
+        store32_le(digest + i*4, ctx->state[i]);
+    }
+
+    memset(ctx, 0, sizeof(*ctx));
+}
@@ -0,0 +1,68 @@
+/*
+    Hash - md5.h
+
+    MD5 (RFC 1321), replaces CC_MD5 from CommonCrypto so that MD5 is
+    available on all platforms.
+
+    History:
+
+    v. 1.0.0 (10/18/2026) - Initial version
+
+    Copyright (c) 2026 Sriranga R. Veeraraghavan <ranga@calalum.org>
+
+    Permission is hereby granted, free of charge, to any person obtaining
+    a copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+    OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef md5_h
+#define md5_h
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum {
+    MD5_BLOCK_LENGTH  = 64,
+    MD5_DIGEST_LENGTH = 16,
+};
+
+typedef struct md5_ctx {
+    uint32_t state[4];
+    uint64_t count;                     /* bytes hashed so far */
+    uint8_t  buffer[MD5_BLOCK_LENGTH];
+} md5_ctx;
+
+void md5_init(md5_ctx *ctx);
+void md5_update(md5_ctx *ctx, const void *data, size_t length);
+void md5_final(md5_ctx *ctx, uint8_t digest[MD5_DIGEST_LENGTH]);
+
+/*
+    md5_compress - run the compression function over nblocks 64 byte
+                   blocks
+ */
+
+void md5_compress(uint32_t state[4], const uint8_t *blocks, size_t nblocks);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* md5_h */
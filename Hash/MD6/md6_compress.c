@@ -54,6 +54,10 @@
 
 #include "md6.h"
 
+/* 2026-10-18 srv - SIMD main compression loop */
+
+#include "md6_simd.h"
+
 /* Useful macros: min and max */
 #ifndef min
 #define min(a,b) ((a)<(b)? (a) : (b))
@@ -206,6 +210,12 @@ void md6_main_compression_loop( md6_word* A , int r )
 { md6_word x, S;
   int i,j;
 
+  /* 2026-10-18 srv - use the AVX2 / AVX-512 loop (md6_simd.c) when the
+     cpu supports it, each of its rounds runs the c steps in parallel */
+
+  if (md6_main_compression_loop_simd(A, r))
+    return;
+
   /*
   ** main computation loop for md6 compression
   */
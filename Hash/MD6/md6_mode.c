@@ -576,6 +576,10 @@ static int md6_compress_block( md6_word *C,
   return MD6_SUCCESS;
 }
 
+/* 2026-10-18 srv - md6_process and md6_push call each other */
+
+static int md6_push( md6_state *st, int ell, md6_word *C, int final );
+
 /* Process (compress) a node and its compressible ancestors. */
 
 /* 2021-07-27 srv - make internal function static */
@@ -602,7 +606,7 @@ static int md6_process( md6_state *st,
 **     MD6_NULLSTATE
 **     MD6_STATENOTINIT
 */
-{ int err, z, next_level;
+{ int err, z;
   md6_word C[c];
 
   /* check that input values are sensible */
@@ -642,7 +646,22 @@ static int md6_process( md6_state *st,
     { memcpy( st->hashval, C, md6_c*(w/8) );
       return MD6_SUCCESS;
     }
-  
+
+  /* 2026-10-18 srv - moved to md6_push so that md6_update_subtrees can
+     push the outputs of the subtrees it compresses */
+
+  return md6_push(st,ell,C,final);
+}
+
+/* 2026-10-18 srv - push the c-word output C of a node at level ell to
+   the next level, and process that level */
+
+static int md6_push( md6_state *st,
+                     int ell,
+                     md6_word *C,
+                     int final )
+{ int next_level;
+
   /* where should result go? To "next level" */
   next_level = min(ell+1,st->L+1);
   /* Start sequential mode with IV=0 at that level if necessary 
@@ -663,7 +682,146 @@ static int md6_process( md6_state *st,
 
   return md6_process(st,next_level,final);
 }
-/* Update -- incorporate data string into hash computation.
+
+/* 2026-10-18 srv - Parallel subtrees.
+**
+** In the tree levels (ell <= L), a node at level ell+1 depends only on
+** its four children, so a complete subtree of 4^h leaves can be
+** compressed without the stack in the state, and subtrees that don't
+** overlap can be compressed on different threads.  md6_update hands
+** the whole subtrees in its input to md6_update_subtrees, which
+** compresses them and pushes their roots onto the stack in order,
+** leaving the state exactly as the leaf-by-leaf path would.
+*/
+
+#if !defined(_WIN32) && !defined(MD6_NO_PTHREADS)
+#define MD6_SUBTREE_THREADS 1
+#include "hash_threads.h"
+#define md6_subtree_max_threads HASH_THREADS_MAX
+#else
+#define md6_subtree_max_threads 1
+#endif
+
+#define md6_subtree_height  4     /* levels of compression below root */
+#define md6_subtree_leaves  256   /* 4^md6_subtree_height             */
+#define md6_subtree_bytes   (md6_subtree_leaves*b*(w/8))    /* 128KB  */
+#define md6_subtree_batch   64    /* subtrees per md6_update_subtrees */
+#define md6_subtree_thread_min  (512*1024)   /* bytes per thread      */
+
+typedef struct {
+  md6_state *st;
+  const unsigned char *data;    /* first byte of the first subtree */
+  uint64_t first;               /* leaf index of the first subtree */
+  int count;                    /* number of subtrees              */
+  md6_word (*C)[c];             /* one root output per subtree     */
+  int err;
+} md6_subtree_job;
+
+static int md6_compress_subtree( md6_state *st,
+                                 const unsigned char *data,
+                                 uint64_t first,
+                                 md6_word *C )
+/* Compress the subtree of md6_subtree_leaves leaves starting at leaf
+** index first (a multiple of md6_subtree_leaves), whose data starts at
+** data, and put its root's c-word output into C.
+*/
+{ md6_word N[md6_subtree_height+2][b];
+  md6_word out[c];
+  uint64_t i_for_level[md6_subtree_height+2];
+  int fill[md6_subtree_height+2];
+  int ell, leaf, err;
+
+  for (ell=1; ell<=md6_subtree_height+1; ell++)
+    { i_for_level[ell] = first >> (2*(ell-1));
+      fill[ell] = 0;
+    }
+
+  for (leaf=0; leaf<md6_subtree_leaves; leaf++)
+    { memcpy(N[1], data + (size_t)leaf*b*(w/8), b*(w/8));
+      md6_reverse_little_endian(N[1],b);
+      for (ell=1; ; ell++)
+	{ err = md6_standard_compress(out, Q, st->K,
+				      ell, (int)i_for_level[ell],
+				      st->r, st->L, 0, 0, st->keylen, st->d,
+				      N[ell]);
+	  if (err) return err;
+	  i_for_level[ell]++;
+	  if (ell == md6_subtree_height+1)
+	    { memcpy(C, out, c*(w/8));
+	      break;
+	    }
+	  /* the parent's block is full after its fourth child */
+	  memcpy(&(N[ell+1][fill[ell+1]*c]), out, c*(w/8));
+	  if (++fill[ell+1] < b/c) break;
+	  fill[ell+1] = 0;
+	}
+    }
+  return MD6_SUCCESS;
+}
+
+static void md6_subtree_thread( void *arg, size_t index )
+{ md6_subtree_job *job = (md6_subtree_job *)arg + index;
+  int i;
+
+  job->err = MD6_SUCCESS;
+  for (i=0; i<job->count && job->err == MD6_SUCCESS; i++)
+    job->err = md6_compress_subtree(job->st,
+				    job->data + (size_t)i*md6_subtree_bytes,
+				    job->first + (uint64_t)i*md6_subtree_leaves,
+				    job->C[i]);
+}
+
+static int md6_update_subtrees( md6_state *st,
+                                const unsigned char *data,
+                                int count )
+/* Compress count (at most md6_subtree_batch) whole subtrees of data,
+** which start at a leaf on a subtree boundary, when the level 1 block
+** is empty.  Large batches are split across threads.
+*/
+{ md6_word C[md6_subtree_batch][c];
+  md6_subtree_job jobs[md6_subtree_max_threads];
+  int thread_count = 1, i, ell, err, next = 0;
+
+#if defined(MD6_SUBTREE_THREADS)
+  thread_count = (int)hash_threads_count((uint64_t)count*md6_subtree_bytes,
+					 md6_subtree_thread_min,
+					 (size_t)count);
+#endif
+
+  for (i=0; i<thread_count; i++)
+    { jobs[i].st = st;
+      jobs[i].count = count/thread_count + (i < count%thread_count ? 1 : 0);
+      jobs[i].data = data + (size_t)next*md6_subtree_bytes;
+      jobs[i].first = st->i_for_level[1] + (uint64_t)next*md6_subtree_leaves;
+      jobs[i].C = &C[next];
+      next += jobs[i].count;
+    }
+
+#if defined(MD6_SUBTREE_THREADS)
+  hash_threads_run((size_t)thread_count, md6_subtree_thread, jobs);
+#else
+  md6_subtree_thread(jobs, 0);
+#endif
+  for (i=0; i<thread_count; i++)
+    if (jobs[i].err) return jobs[i].err;
+
+  /* account for the nodes compressed below the roots, as
+     md6_compress_block would have */
+  for (ell=1; ell<=md6_subtree_height+1; ell++)
+    { st->i_for_level[ell] +=
+	(uint64_t)count*(md6_subtree_leaves >> (2*(ell-1)));
+      st->compression_calls +=
+	(uint64_t)count*(md6_subtree_leaves >> (2*(ell-1)));
+    }
+  st->bits_processed += (uint64_t)count*md6_subtree_bytes*8;
+
+  for (i=0; i<count; i++)
+    if ((err = md6_push(st, md6_subtree_height+1, C[i], 0)))
+      return err;
+  return MD6_SUCCESS;
+}
+
+/* Update -- incorporate data string into hash computation.
 */
 
 int md6_update( md6_state *st, 
@@ -688,7 +846,23 @@ int md6_update( md6_state *st,
   
   j = 0; /* j = number of bits processed so far with this update */
   while (j<databitlen)
-    { /* handle input string in portions (portion_size in bits)
+    { /* 2026-10-18 srv - when the level 1 block is empty and starts a
+      ** subtree, compress the whole subtrees that are followed by more
+      ** data straight from data (see md6_update_subtrees) */
+      if ( (st->bits[1] == 0) && (j % 8 == 0) &&
+	   (md6_subtree_height + 1 <= st->L) &&
+	   (st->i_for_level[1] % md6_subtree_leaves == 0) )
+	{ uint64_t count = (databitlen - j - 1) / (md6_subtree_bytes*8);
+	  if (count > 0)
+	    { if (count > md6_subtree_batch) count = md6_subtree_batch;
+	      if ((err=md6_update_subtrees(st, &(data[j/8]), (int)count)))
+		return err;
+	      j += (unsigned int)(count*md6_subtree_bytes*8);
+	      continue;
+	    }
+	}
+
+      /* handle input string in portions (portion_size in bits)
       ** portion_size may be zero (level 1 data block might be full, 
       ** having size b*w bits) */
       /* 06/28/2017 - add (unsigned int) cast to avoid Xcode warning (SRV) */
@@ -0,0 +1,328 @@
+/*
+    Hash - md6_simd.c
+
+    History:
+
+    v. 1.0.0 (10/18/2026) - Initial version
+
+    Copyright (c) 2026 Sriranga R. Veeraraghavan <ranga@calalum.org>
+
+    Permission is hereby granted, free of charge, to any person obtaining
+    a copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+    OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <string.h>
+
+#include "md6_simd.h"
+
+/*
+    Each step of the main compression loop reads words 17, 18, 21, 31,
+    67 and 89 back from the word it writes.  All of these are at least
+    one round (c = 16 steps) back, so the 16 steps of a round don't
+    depend on each other and run as 16 SIMD lanes: two AVX-512 registers
+    or four AVX2 registers.  The shift amounts differ from step to step
+    and are applied with the variable shifts (vpsrlvq / vpsllvq).
+
+    The taps that reach into the previous two rounds (17, 18, 21, 31)
+    are assembled from registers holding those rounds, so that the
+    round to round dependency doesn't go through memory.  With AVX-512
+    there are enough registers to keep the last six rounds, which
+    covers the other two taps (67, 89) as well; with AVX2 those are
+    loaded from A, which is written as each round completes.
+
+    Only the standard parameters (w = 64, n = 89, c = 16) are handled.
+ */
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__)) && \
+    (md6_w == 64)
+
+#define MD6_SIMD_X86 1
+
+#include <immintrin.h>
+
+/* md6_simd_S0, md6_simd_Smask - round constant and its update mask,
+   see md6_compress.c */
+
+#define md6_simd_S0    0x0123456789abcdefULL
+#define md6_simd_Smask 0x7311c2812425cfa0ULL
+
+#define md6_simd_next_S(S) \
+    (((S) << 1) ^ ((S) >> 63) ^ ((S) & md6_simd_Smask))
+
+/* ---- AVX2 ---- */
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("avx2"))), apply_to = function)
+#else
+#pragma GCC push_options
+#pragma GCC target("avx2")
+#endif
+
+/*
+    MD6_AVX2_WINDOW - the four words starting s (1, 2 or 3) words into
+                      b, continuing into a
+ */
+
+#define MD6_AVX2_WINDOW1(b, a) \
+    _mm256_alignr_epi8(_mm256_permute2x128_si256((b), (a), 0x21), (b), 8)
+#define MD6_AVX2_WINDOW2(b, a) \
+    _mm256_permute2x128_si256((b), (a), 0x21)
+#define MD6_AVX2_WINDOW3(b, a) \
+    _mm256_alignr_epi8((a), _mm256_permute2x128_si256((b), (a), 0x21), 8)
+
+static void md6_main_compression_loop_avx2(md6_word *A, int r)
+{
+    const __m256i rs0 = _mm256_setr_epi64x(10, 5, 13, 10);
+    const __m256i rs1 = _mm256_setr_epi64x(11, 12, 2, 7);
+    const __m256i rs2 = _mm256_setr_epi64x(14, 15, 7, 13);
+    const __m256i rs3 = _mm256_setr_epi64x(11, 7, 6, 12);
+    const __m256i ls0 = _mm256_setr_epi64x(11, 24, 9, 16);
+    const __m256i ls1 = _mm256_setr_epi64x(15, 9, 27, 15);
+    const __m256i ls2 = _mm256_setr_epi64x(6, 2, 29, 8);
+    const __m256i ls3 = _mm256_setr_epi64x(15, 5, 31, 9);
+    __m256i b0, b1, b2, b3, b4, b5, b6, b7;
+    __m256i x0, x1, x2, x3, s;
+    md6_word S = md6_simd_S0;
+    md6_word *out = A + 89;
+    int j = 0;
+
+    /* b0..b3 - the round before last, b4..b7 - the last round */
+
+    b0 = _mm256_loadu_si256((const __m256i *)(out - 32));
+    b1 = _mm256_loadu_si256((const __m256i *)(out - 28));
+    b2 = _mm256_loadu_si256((const __m256i *)(out - 24));
+    b3 = _mm256_loadu_si256((const __m256i *)(out - 20));
+    b4 = _mm256_loadu_si256((const __m256i *)(out - 16));
+    b5 = _mm256_loadu_si256((const __m256i *)(out - 12));
+    b6 = _mm256_loadu_si256((const __m256i *)(out - 8));
+    b7 = _mm256_loadu_si256((const __m256i *)(out - 4));
+
+    for (j = 0; j < r; j++, out += 16) {
+        s = _mm256_set1_epi64x((long long)S);
+
+#define MD6_AVX2_STEPS(x, rs, ls, k, bk, bk1, bk2, bk3, bk4) \
+        x = _mm256_xor_si256(s, \
+                _mm256_loadu_si256((const __m256i *)(out + 4*(k) - 89))); \
+        x = _mm256_xor_si256(x, MD6_AVX2_WINDOW3(bk3, bk4)); \
+        x = _mm256_xor_si256(x, \
+                _mm256_and_si256(MD6_AVX2_WINDOW2(bk3, bk4), \
+                                 MD6_AVX2_WINDOW3(bk2, bk3))); \
+        x = _mm256_xor_si256(x, \
+                _mm256_and_si256(MD6_AVX2_WINDOW1(bk, bk1), \
+                    _mm256_loadu_si256((const __m256i *) \
+                                       (out + 4*(k) - 67)))); \
+        x = _mm256_xor_si256(x, _mm256_srlv_epi64(x, rs)); \
+        x = _mm256_xor_si256(x, _mm256_sllv_epi64(x, ls)); \
+        _mm256_storeu_si256((__m256i *)(out + 4*(k)), x);
+
+        /* steps 4k..4k+3: tap 17 and 18 start in block 3+k, tap 21 in
+           block 2+k and tap 31 in block k */
+
+        MD6_AVX2_STEPS(x0, rs0, ls0, 0, b0, b1, b2, b3, b4)
+        MD6_AVX2_STEPS(x1, rs1, ls1, 1, b1, b2, b3, b4, b5)
+        MD6_AVX2_STEPS(x2, rs2, ls2, 2, b2, b3, b4, b5, b6)
+        MD6_AVX2_STEPS(x3, rs3, ls3, 3, b3, b4, b5, b6, b7)
+
+#undef MD6_AVX2_STEPS
+
+        b0 = b4; b1 = b5; b2 = b6; b3 = b7;
+        b4 = x0; b5 = x1; b6 = x2; b7 = x3;
+
+        S = md6_simd_next_S(S);
+    }
+}
+
+#undef MD6_AVX2_WINDOW1
+#undef MD6_AVX2_WINDOW2
+#undef MD6_AVX2_WINDOW3
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#else
+#pragma GCC pop_options
+#endif
+
+/* ---- AVX-512 ---- */
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("avx512f"))), apply_to = function)
+#else
+#pragma GCC push_options
+#pragma GCC target("avx512f")
+#endif
+
+static void md6_main_compression_loop_avx512(md6_word *A, int r)
+{
+    const __m512i rsLo = _mm512_setr_epi64(10, 5, 13, 10, 11, 12, 2, 7);
+    const __m512i rsHi = _mm512_setr_epi64(14, 15, 7, 13, 11, 7, 6, 12);
+    const __m512i lsLo = _mm512_setr_epi64(11, 24, 9, 16, 15, 9, 27, 15);
+    const __m512i lsHi = _mm512_setr_epi64(6, 2, 29, 8, 15, 5, 31, 9);
+    __m512i r1Lo, r1Hi, r2Lo, r2Hi, r3Lo, r3Hi;
+    __m512i r4Lo, r4Hi, r5Lo, r5Hi, r6Lo, r6Hi;
+    __m512i xLo, xHi, s;
+    md6_word history[96];
+    md6_word S = md6_simd_S0;
+    md6_word *out = A + 89;
+    int j = 0;
+
+    /* rK - the round K rounds back; before the first round, the n
+       input words are the tail of rounds 6..1 */
+
+    memset(history, 0, 7 * sizeof(md6_word));
+    memcpy(history + 7, A, 89 * sizeof(md6_word));
+
+    r6Lo = _mm512_loadu_si512((const void *)(history + 0));
+    r6Hi = _mm512_loadu_si512((const void *)(history + 8));
+    r5Lo = _mm512_loadu_si512((const void *)(history + 16));
+    r5Hi = _mm512_loadu_si512((const void *)(history + 24));
+    r4Lo = _mm512_loadu_si512((const void *)(history + 32));
+    r4Hi = _mm512_loadu_si512((const void *)(history + 40));
+    r3Lo = _mm512_loadu_si512((const void *)(history + 48));
+    r3Hi = _mm512_loadu_si512((const void *)(history + 56));
+    r2Lo = _mm512_loadu_si512((const void *)(history + 64));
+    r2Hi = _mm512_loadu_si512((const void *)(history + 72));
+    r1Lo = _mm512_loadu_si512((const void *)(history + 80));
+    r1Hi = _mm512_loadu_si512((const void *)(history + 88));
+
+    for (j = 0; j < r; j++, out += 16) {
+        s = _mm512_set1_epi64((long long)S);
+
+        /* tap 89 starts 7 words into round 6 */
+
+        xLo = _mm512_xor_si512(s, _mm512_alignr_epi64(r6Hi, r6Lo, 7));
+        xHi = _mm512_xor_si512(s, _mm512_alignr_epi64(r5Lo, r6Hi, 7));
+
+        /* tap 17 starts 15 words into round 2 */
+
+        xLo = _mm512_xor_si512(xLo, _mm512_alignr_epi64(r1Lo, r2Hi, 7));
+        xHi = _mm512_xor_si512(xHi, _mm512_alignr_epi64(r1Hi, r1Lo, 7));
+
+        /* taps 18 and 21 start 14 and 11 words into round 2 */
+
+        xLo = _mm512_xor_si512(xLo,
+                  _mm512_and_si512(_mm512_alignr_epi64(r1Lo, r2Hi, 6),
+                                   _mm512_alignr_epi64(r1Lo, r2Hi, 3)));
+        xHi = _mm512_xor_si512(xHi,
+                  _mm512_and_si512(_mm512_alignr_epi64(r1Hi, r1Lo, 6),
+                                   _mm512_alignr_epi64(r1Hi, r1Lo, 3)));
+
+        /* taps 31 and 67 start 1 word into round 2 and 13 words into
+           round 5 */
+
+        xLo = _mm512_xor_si512(xLo,
+                  _mm512_and_si512(_mm512_alignr_epi64(r2Hi, r2Lo, 1),
+                                   _mm512_alignr_epi64(r4Lo, r5Hi, 5)));
+        xHi = _mm512_xor_si512(xHi,
+                  _mm512_and_si512(_mm512_alignr_epi64(r1Lo, r2Hi, 1),
+                                   _mm512_alignr_epi64(r4Hi, r4Lo, 5)));
+
+        xLo = _mm512_xor_si512(xLo, _mm512_srlv_epi64(xLo, rsLo));
+        xHi = _mm512_xor_si512(xHi, _mm512_srlv_epi64(xHi, rsHi));
+        xLo = _mm512_xor_si512(xLo, _mm512_sllv_epi64(xLo, lsLo));
+        xHi = _mm512_xor_si512(xHi, _mm512_sllv_epi64(xHi, lsHi));
+
+        _mm512_storeu_si512((void *)out, xLo);
+        _mm512_storeu_si512((void *)(out + 8), xHi);
+
+        r6Lo = r5Lo; r6Hi = r5Hi;
+        r5Lo = r4Lo; r5Hi = r4Hi;
+        r4Lo = r3Lo; r4Hi = r3Hi;
+        r3Lo = r2Lo; r3Hi = r2Hi;
+        r2Lo = r1Lo; r2Hi = r1Hi;
+        r1Lo = xLo;  r1Hi = xHi;
+
+        S = md6_simd_next_S(S);
+    }
+}
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#else
+#pragma GCC pop_options
+#endif
+
+#endif /* __x86_64__ && (__GNUC__ || __clang__) && md6_w == 64 */
+
+/* dispatch */
+
+typedef void (*md6LoopFn)(md6_word *A, int r);
+
+static int gAllowAvx2 = 1;
+static int gAllowAvx512 = 1;
+static int gSelected = 0;
+static md6LoopFn gLoop = NULL;
+static const char *gImplementation = "portable";
+
+/*
+    md6_select - pick the loop, NULL means the reference code (racing
+                 threads pick the same one)
+ */
+
+static void md6_select(void)
+{
+    gLoop = NULL;
+    gImplementation = "portable";
+
+#if defined(MD6_SIMD_X86)
+    if (gAllowAvx2 && __builtin_cpu_supports("avx2")) {
+        gLoop = md6_main_compression_loop_avx2;
+        gImplementation = "avx2";
+    }
+    if (gAllowAvx512 && __builtin_cpu_supports("avx512f")) {
+        gLoop = md6_main_compression_loop_avx512;
+        gImplementation = "avx512";
+    }
+#endif
+
+    gSelected = 1;
+}
+
+int md6_main_compression_loop_simd(md6_word *A, int r)
+{
+    md6LoopFn fn = NULL;
+
+    if (!gSelected) {
+        md6_select();
+    }
+    fn = gLoop;
+    if (fn == NULL) {
+        return 0;
+    }
+    fn(A, r);
+    return 1;
+}
+
+void md6_use_avx2(int enable)
+{
+    gAllowAvx2 = (enable != 0);
+    md6_select();
+}
+
+void md6_use_avx512(int enable)
+{
+    gAllowAvx512 = (enable != 0);
+    md6_select();
+}
+
+const char *md6_implementation(void)
+{
+    if (!gSelected) {
+        md6_select();
+    }
+    return gImplementation;
+}
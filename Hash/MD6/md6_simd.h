@@ -0,0 +1,71 @@
+/*
+    Hash - md6_simd.h
+
+    AVX2 and AVX-512 versions of the MD6 main compression loop, which
+    md6_main_compression_loop (md6_compress.c) uses when the cpu
+    supports them.
+
+    History:
+
+    v. 1.0.0 (10/18/2026) - Initial version
+
+    Copyright (c) 2026 Sriranga R. Veeraraghavan <ranga@calalum.org>
+
+    Permission is hereby granted, free of charge, to any person obtaining
+    a copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+    OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef md6_simd_h
+#define md6_simd_h
+
+#include "md6.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+    md6_main_compression_loop_simd - run r rounds of the main
+                                     compression loop on A, whose first
+                                     n words are already set up.  Return
+                                     1 if the rounds were run, or 0 if no
+                                     SIMD implementation is enabled, in
+                                     which case the caller uses the
+                                     reference loop.
+ */
+
+int md6_main_compression_loop_simd(md6_word *A, int r);
+
+/*
+    md6_use_avx2, md6_use_avx512 - allow (1, the default) or disallow (0)
+                                   the AVX2 and AVX-512 implementations,
+                                   for benchmarking and testing
+ */
+
+void md6_use_avx2(int enable);
+void md6_use_avx512(int enable);
+
+/* md6_implementation - name of the implementation in use */
+
+const char *md6_implementation(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* md6_simd_h */
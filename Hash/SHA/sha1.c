@@ -0,0 +1,379 @@
+/*
+    Hash - sha1.c
+
+    History:
+
+    v. 1.0.0 (10/18/2026) - Initial version
+
+    Copyright (c) 2026 Sriranga R. Veeraraghavan <ranga@calalum.org>
+
+    Permission is hereby granted, free of charge, to any person obtaining
+    a copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+    OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <string.h>
+
+#include "sha1.h"
+#include "sha_cpu.h"
+
+typedef void (*sha1CompressFn)(uint32_t state[5],
+                               const uint8_t *blocks,
+                               size_t nblocks);
+
+static inline uint32_t load32_be(const uint8_t *p)
+{
+    return ((uint32_t)p[0] << 24) |
+           ((uint32_t)p[1] << 16) |
+           ((uint32_t)p[2] << 8) |
+           ((uint32_t)p[3]);
+}
+
+static inline void store32_be(uint8_t *p, uint32_t v)
+{
+    p[0] = (uint8_t)(v >> 24);
+    p[1] = (uint8_t)(v >> 16);
+    p[2] = (uint8_t)(v >> 8);
+    p[3] = (uint8_t)v;
+}
+
+#define ROTL32(x, n) (((x) << (n)) | ((x) >> (32 - (n))))
+
+/*
+    sha1_compress_portable - the compression function in C, the message
+                             schedule is kept in a 16 word circular
+                             buffer
+ */
+
+#define SHA1_W(t) \
+    (w[(t) & 15] = ROTL32(w[((t) + 13) & 15] ^ w[((t) + 8) & 15] ^ \
+                          w[((t) + 2) & 15] ^ w[(t) & 15], 1))
+
+#define SHA1_ROUND(a, b, c, d, e, f, k, x) \
+    (e) += ROTL32((a), 5) + (f) + (uint32_t)(k) + (x); \
+    (b) = ROTL32((b), 30)
+
+#define F0(b, c, d) ((d) ^ ((b) & ((c) ^ (d))))
+#define F1(b, c, d) ((b) ^ (c) ^ (d))
+#define F2(b, c, d) (((b) & (c)) | ((d) & ((b) | (c))))
+
+#define R0(a, b, c, d, e, t) \
+    SHA1_ROUND(a, b, c, d, e, F0(b, c, d), 0x5a827999, w[t])
+#define R1(a, b, c, d, e, t) \
+    SHA1_ROUND(a, b, c, d, e, F0(b, c, d), 0x5a827999, SHA1_W(t))
+#define R2(a, b, c, d, e, t) \
+    SHA1_ROUND(a, b, c, d, e, F1(b, c, d), 0x6ed9eba1, SHA1_W(t))
+#define R3(a, b, c, d, e, t) \
+    SHA1_ROUND(a, b, c, d, e, F2(b, c, d), 0x8f1bbcdc, SHA1_W(t))
+#define R4(a, b, c, d, e, t) \
+    SHA1_ROUND(a, b, c, d, e, F1(b, c, d), 0xca62c1d6, SHA1_W(t))
+
+/* five rounds, rotating the working variables */
+
+#define ROUNDS5(R, t) \
+    R(a, b, c, d, e, (t)); \
+    R(e, a, b, c, d, (t) + 1); \
+    R(d, e, a, b, c, (t) + 2); \
+    R(c, d, e, a, b, (t) + 3); \
+    R(b, c, d, e, a, (t) + 4)
+
+static void sha1_compress_portable(uint32_t state[5],
+                                   const uint8_t *blocks,
+                                   size_t nblocks)
+{
+    uint32_t a, b, c, d, e;
+    uint32_t w[16];
+    int i = 0;
+
+    while (nblocks-- > 0) {
+
+        for (i = 0; i < 16; i++) {
+            w[i] = load32_be(blocks + i*4);
+        }
+
+        a = state[0];
+        b = state[1];
+        c = state[2];
+        d = state[3];
+        e = state[4];
+
+        ROUNDS5(R0, 0);
+        ROUNDS5(R0, 5);
+        ROUNDS5(R0, 10);
+        R0(a, b, c, d, e, 15);
+        R1(e, a, b, c, d, 16);
+        R1(d, e, a, b, c, 17);
+        R1(c, d, e, a, b, 18);
+        R1(b, c, d, e, a, 19);
+
+        ROUNDS5(R2, 20);
+        ROUNDS5(R2, 25);
+        ROUNDS5(R2, 30);
+        ROUNDS5(R2, 35);
+
+        ROUNDS5(R3, 40);
+        ROUNDS5(R3, 45);
+        ROUNDS5(R3, 50);
+        ROUNDS5(R3, 55);
+
+        ROUNDS5(R4, 60);
+        ROUNDS5(R4, 65);
+        ROUNDS5(R4, 70);
+        ROUNDS5(R4, 75);
+
+        state[0] += a;
+        state[1] += b;
+        state[2] += c;
+        state[3] += d;
+        state[4] += e;
+
+        blocks += SHA1_BLOCK_LENGTH;
+    }
+}
+
+/*
+    sha1_compress_shani - the compression function using the SHA
+                          extensions.  Each SHA1RNDS4 does four rounds,
+                          and the message schedule for the next rounds
+                          is computed with SHA1MSG1, SHA1MSG2 and XOR
+                          while the current rounds run.  SSE4.1 and
+                          SHA are enabled for just this function with a
+                          target pragma.
+ */
+
+#if defined(SHA_CPU_X86)
+
+#include <immintrin.h>
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("sha,sse4.1"))), apply_to = function)
+#else
+#pragma GCC push_options
+#pragma GCC target("sha,sse4.1")
+#endif
+
+/*
+    four rounds (group g of 20) with message m, then the schedule for
+    the later groups: mnext is the message of the next group, mprev the
+    one of the previous group, and mprev2 the one before that
+ */
+
+#define SHANI_ROUNDS4(g, ecur, eother, m, mnext, mprev, mprev2) \
+    if ((g) == 0) { \
+        ecur = _mm_add_epi32(ecur, m); \
+    } else { \
+        ecur = _mm_sha1nexte_epu32(ecur, m); \
+    } \
+    eother = abcd; \
+    if ((g) >= 3 && (g) <= 18) { \
+        mnext = _mm_sha1msg2_epu32(mnext, m); \
+    } \
+    abcd = _mm_sha1rnds4_epu32(abcd, ecur, (g) / 5); \
+    if ((g) >= 1 && (g) <= 16) { \
+        mprev = _mm_sha1msg1_epu32(mprev, m); \
+    } \
+    if ((g) >= 2 && (g) <= 17) { \
+        mprev2 = _mm_xor_si128(mprev2, m); \
+    }
+
+static void sha1_compress_shani(uint32_t state[5],
+                                const uint8_t *blocks,
+                                size_t nblocks)
+{
+    const __m128i mask = _mm_set_epi64x(0x0001020304050607ULL,
+                                        0x08090a0b0c0d0e0fULL);
+    __m128i abcd, abcdSave, e0, e0Save, e1;
+    __m128i m0, m1, m2, m3;
+
+    abcd = _mm_loadu_si128((const __m128i *)state);
+    abcd = _mm_shuffle_epi32(abcd, 0x1b);
+    e0 = _mm_set_epi32((int)state[4], 0, 0, 0);
+
+    while (nblocks-- > 0) {
+
+        abcdSave = abcd;
+        e0Save = e0;
+
+        m0 = _mm_shuffle_epi8(
+                _mm_loadu_si128((const __m128i *)(blocks + 0)), mask);
+        m1 = _mm_shuffle_epi8(
+                _mm_loadu_si128((const __m128i *)(blocks + 16)), mask);
+        m2 = _mm_shuffle_epi8(
+                _mm_loadu_si128((const __m128i *)(blocks + 32)), mask);
+        m3 = _mm_shuffle_epi8(
+                _mm_loadu_si128((const __m128i *)(blocks + 48)), mask);
+
+        SHANI_ROUNDS4( 0, e0, e1, m0, m1, m3, m2);
+        SHANI_ROUNDS4( 1, e1, e0, m1, m2, m0, m3);
+        SHANI_ROUNDS4( 2, e0, e1, m2, m3, m1, m0);
+        SHANI_ROUNDS4( 3, e1, e0, m3, m0, m2, m1);
+        SHANI_ROUNDS4( 4, e0, e1, m0, m1, m3, m2);
+        SHANI_ROUNDS4( 5, e1, e0, m1, m2, m0, m3);
+        SHANI_ROUNDS4( 6, e0, e1, m2, m3, m1, m0);
+        SHANI_ROUNDS4( 7, e1, e0, m3, m0, m2, m1);
+        SHANI_ROUNDS4( 8, e0, e1, m0, m1, m3, m2);
+        SHANI_ROUNDS4( 9, e1, e0, m1, m2, m0, m3);
+        SHANI_ROUNDS4(10, e0, e1, m2, m3, m1, m0);
+        SHANI_ROUNDS4(11, e1, e0, m3, m0, m2, m1);
+        SHANI_ROUNDS4(12, e0, e1, m0, m1, m3, m2);
+        SHANI_ROUNDS4(13, e1, e0, m1, m2, m0, m3);
+        SHANI_ROUNDS4(14, e0, e1, m2, m3, m1, m0);
+        SHANI_ROUNDS4(15, e1, e0, m3, m0, m2, m1);
+        SHANI_ROUNDS4(16, e0, e1, m0, m1, m3, m2);
+        SHANI_ROUNDS4(17, e1, e0, m1, m2, m0, m3);
+        SHANI_ROUNDS4(18, e0, e1, m2, m3, m1, m0);
+        SHANI_ROUNDS4(19, e1, e0, m3, m0, m2, m1);
+
+        e0 = _mm_sha1nexte_epu32(e0, e0Save);
+        abcd = _mm_add_epi32(abcd, abcdSave);
+
+        blocks += SHA1_BLOCK_LENGTH;
+    }
+
+    abcd = _mm_shuffle_epi32(abcd, 0x1b);
+    _mm_storeu_si128((__m128i *)state, abcd);
+    state[4] = (uint32_t)_mm_extract_epi32(e0, 3);
+}
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#else
+#pragma GCC pop_options
+#endif
+
+#endif /* SHA_CPU_X86 */
+
+/* dispatch */
+
+static int gAllowShani = 1;
+static sha1CompressFn gCompress = NULL;
+static const char *gImplementation = "portable";
+
+static sha1CompressFn sha1_select(void)
+{
+#if defined(SHA_CPU_X86)
+    if (gAllowShani && sha_cpu_has_shani()) {
+        gImplementation = "sha-ni";
+        return sha1_compress_shani;
+    }
+#endif
+    gImplementation = "portable";
+    return sha1_compress_portable;
+}
+
+/*
+    sha1_compress - the implementation is picked on the first call
+                    (racing threads pick the same one)
+ */
+
+void sha1_compress(uint32_t state[5], const uint8_t *blocks, size_t nblocks)
+{
+    sha1CompressFn fn = gCompress;
+
+    if (fn == NULL) {
+        fn = sha1_select();
+        gCompress = fn;
+    }
+
+    fn(state, blocks, nblocks);
+}
+
+void sha1_use_shani(int enable)
+{
+    gAllowShani = (enable != 0);
+    gCompress = sha1_select();
+}
+
+const char *sha1_implementation(void)
+{
+    if (gCompress == NULL) {
+        gCompress = sha1_select();
+    }
+    return gImplementation;
+}
+
+void sha1_init(sha1_ctx *ctx)
+{
+    ctx->state[0] = 0x67452301;
+    ctx->state[1] = 0xefcdab89;
+    ctx->state[2] = 0x98badcfe;
+    ctx->state[3] = 0x10325476;
+    ctx->state[4] = 0xc3d2e1f0;
+    ctx->count = 0;
+}
+
+void sha1_update(sha1_ctx *ctx, const void *data, size_t length)
+{
+    const uint8_t *in = data;
+    size_t used = (size_t)(ctx->count % SHA1_BLOCK_LENGTH);
+    size_t n = 0;
+
+    ctx->count += length;
+
+    // fill up a partial block first
+
+    if (used > 0) {
+        n = SHA1_BLOCK_LENGTH - used;
+        if (length < n) {
+            memcpy(ctx->buffer + used, in, length);
+            return;
+        }
+        memcpy(ctx->buffer + used, in, n);
+        sha1_compress(ctx->state, ctx->buffer, 1);
+        in += n;
+        length -= n;
+    }
+
+    // whole blocks are compressed straight from the input
+
+    n = length / SHA1_BLOCK_LENGTH;
+    if (n > 0) {
+        sha1_compress(ctx->state, in, n);
+        in += n*SHA1_BLOCK_LENGTH;
+        length -= n*SHA1_BLOCK_LENGTH;
+    }
+
+    if (length > 0) {
+        memcpy(ctx->buffer, in, length);
+    }
+}
+
+void sha1_final(sha1_ctx *ctx, uint8_t digest[SHA1_DIGEST_LENGTH])
+{
+    size_t used = (size_t)(ctx->count % SHA1_BLOCK_LENGTH);
+    uint64_t bits = ctx->count << 3;
+    int i = 0;
+
+    // pad with 0x80, zeros, and the message length in bits
+
+    ctx->buffer[used++] = 0x80;
+    if (used > SHA1_BLOCK_LENGTH - 8) {
+        memset(ctx->buffer + used, 0, SHA1_BLOCK_LENGTH - used);
+        sha1_compress(ctx->state, ctx->buffer, 1);
+        used = 0;
+    }
+    memset(ctx->buffer + used, 0, SHA1_BLOCK_LENGTH - 8 - used);
+    store32_be(ctx->buffer + 56, (uint32_t)(bits >> 32));
+    store32_be(ctx->buffer + 60, (uint32_t)bits);
+    sha1_compress(ctx->state, ctx->buffer, 1);
+
+    for (i = 0; i < 5; i++) {
+        store32_be(digest + i*4, ctx->state[i]);
+    }
+
+    memset(ctx, 0, sizeof(*ctx));
+}
@@ -0,0 +1,84 @@
+/*
+    Hash - sha1.h
+
+    SHA-1 (FIPS 180-4), replaces CC_SHA1 from CommonCrypto so that
+    SHA-1 is available on all platforms.  On x86_64 cpus with the SHA
+    extensions (SHA-NI), the compression function uses the SHA1RNDS4
+    and SHA1MSG1/2 instructions.
+
+    Note: this is plain SHA-1, without the collision detection done by
+    sha1dc.
+
+    History:
+
+    v. 1.0.0 (10/18/2026) - Initial version
+
+    Copyright (c) 2026 Sriranga R. Veeraraghavan <ranga@calalum.org>
+
+    Permission is hereby granted, free of charge, to any person obtaining
+    a copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+    OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef sha1_h
+#define sha1_h
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum {
+    SHA1_BLOCK_LENGTH  = 64,
+    SHA1_DIGEST_LENGTH = 20,
+};
+
+typedef struct sha1_ctx {
+    uint32_t state[5];
+    uint64_t count;                     /* bytes hashed so far */
+    uint8_t  buffer[SHA1_BLOCK_LENGTH];
+} sha1_ctx;
+
+void sha1_init(sha1_ctx *ctx);
+void sha1_update(sha1_ctx *ctx, const void *data, size_t length);
+void sha1_final(sha1_ctx *ctx, uint8_t digest[SHA1_DIGEST_LENGTH]);
+
+/*
+    sha1_compress - run the compression function over nblocks 64 byte
+                    blocks, using the best implementation for this cpu
+ */
+
+void sha1_compress(uint32_t state[5], const uint8_t *blocks, size_t nblocks);
+
+/*
+    sha1_use_shani - allow (1, the default) or disallow (0) the SHA-NI
+                     implementation, for benchmarking and testing
+ */
+
+void sha1_use_shani(int enable);
+
+/* sha1_implementation - return the name of the implementation in use */
+
+const char *sha1_implementation(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* sha1_h */
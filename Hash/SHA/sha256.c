@@ -0,0 +1,411 @@
+/*
+    Hash - sha256.c
+
+    History:
+
+    v. 1.0.0 (10/18/2026) - Initial version
+
+    Copyright (c) 2026 Sriranga R. Veeraraghavan <ranga@calalum.org>
+
+    Permission is hereby granted, free of charge, to any person obtaining
+    a copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+    OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <string.h>
+
+#include "sha256.h"
+#include "sha_cpu.h"
+
+typedef void (*sha256CompressFn)(uint32_t state[8],
+                                 const uint8_t *blocks,
+                                 size_t nblocks);
+
+static const uint32_t gSha256K[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5,
+    0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+    0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc,
+    0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7,
+    0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+    0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3,
+    0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5,
+    0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+    0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+static inline uint32_t load32_be(const uint8_t *p)
+{
+    return ((uint32_t)p[0] << 24) |
+           ((uint32_t)p[1] << 16) |
+           ((uint32_t)p[2] << 8) |
+           ((uint32_t)p[3]);
+}
+
+static inline void store32_be(uint8_t *p, uint32_t v)
+{
+    p[0] = (uint8_t)(v >> 24);
+    p[1] = (uint8_t)(v >> 16);
+    p[2] = (uint8_t)(v >> 8);
+    p[3] = (uint8_t)v;
+}
+
+#define ROTR32(x, n) (((x) >> (n)) | ((x) << (32 - (n))))
+
+#define CH(x, y, z)  ((z) ^ ((x) & ((y) ^ (z))))
+#define MAJ(x, y, z) (((x) & (y)) | ((z) & ((x) | (y))))
+#define S0(x) (ROTR32((x), 2) ^ ROTR32((x), 13) ^ ROTR32((x), 22))
+#define S1(x) (ROTR32((x), 6) ^ ROTR32((x), 11) ^ ROTR32((x), 25))
+#define s0(x) (ROTR32((x), 7) ^ ROTR32((x), 18) ^ ((x) >> 3))
+#define s1(x) (ROTR32((x), 17) ^ ROTR32((x), 19) ^ ((x) >> 10))
+
+/*
+    sha256_compress_portable - the compression function in C, the
+                               message schedule is kept in a 16 word
+                               circular buffer
+ */
+
+#define SHA256_W(t) \
+    (w[(t) & 15] += s1(w[((t) + 14) & 15]) + w[((t) + 9) & 15] + \
+                    s0(w[((t) + 1) & 15]))
+
+#define SHA256_ROUND(a, b, c, d, e, f, g, h, t, x) \
+    t1 = (h) + S1(e) + CH((e), (f), (g)) + gSha256K[t] + (x); \
+    (d) += t1; \
+    (h) = t1 + S0(a) + MAJ((a), (b), (c))
+
+/* eight rounds, rotating the working variables */
+
+#define ROUNDS8(t, W) \
+    SHA256_ROUND(a, b, c, d, e, f, g, h, (t),     W((t))); \
+    SHA256_ROUND(h, a, b, c, d, e, f, g, (t) + 1, W((t) + 1)); \
+    SHA256_ROUND(g, h, a, b, c, d, e, f, (t) + 2, W((t) + 2)); \
+    SHA256_ROUND(f, g, h, a, b, c, d, e, (t) + 3, W((t) + 3)); \
+    SHA256_ROUND(e, f, g, h, a, b, c, d, (t) + 4, W((t) + 4)); \
+    SHA256_ROUND(d, e, f, g, h, a, b, c, (t) + 5, W((t) + 5)); \
+    SHA256_ROUND(c, d, e, f, g, h, a, b, (t) + 6, W((t) + 6)); \
+    SHA256_ROUND(b, c, d, e, f, g, h, a, (t) + 7, W((t) + 7))
+
+#define W_LOADED(t) w[(t)]
+
+static void sha256_compress_portable(uint32_t state[8],
+                                     const uint8_t *blocks,
+                                     size_t nblocks)
+{
+    uint32_t a, b, c, d, e, f, g, h, t1;
+    uint32_t w[16];
+    int i = 0;
+
+    while (nblocks-- > 0) {
+
+        for (i = 0; i < 16; i++) {
+            w[i] = load32_be(blocks + i*4);
+        }
+
+        a = state[0];
+        b = state[1];
+        c = state[2];
+        d = state[3];
+        e = state[4];
+        f = state[5];
+        g = state[6];
+        h = state[7];
+
+        ROUNDS8(0, W_LOADED);
+        ROUNDS8(8, W_LOADED);
+        ROUNDS8(16, SHA256_W);
+        ROUNDS8(24, SHA256_W);
+        ROUNDS8(32, SHA256_W);
+        ROUNDS8(40, SHA256_W);
+        ROUNDS8(48, SHA256_W);
+        ROUNDS8(56, SHA256_W);
+
+        state[0] += a;
+        state[1] += b;
+        state[2] += c;
+        state[3] += d;
+        state[4] += e;
+        state[5] += f;
+        state[6] += g;
+        state[7] += h;
+
+        blocks += SHA256_BLOCK_LENGTH;
+    }
+}
+
+/*
+    sha256_compress_shani - the compression function using the SHA
+                            extensions.  The state is kept as ABEF and
+                            CDGH, each SHA256RNDS2 does two rounds, and
+                            the message schedule is computed with
+                            SHA256MSG1 and SHA256MSG2 while the rounds
+                            run.  SSE4.1 and SHA are enabled for just
+                            this function with a target pragma.
+ */
+
+#if defined(SHA_CPU_X86)
+
+#include <immintrin.h>
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("sha,sse4.1"))), apply_to = function)
+#else
+#pragma GCC push_options
+#pragma GCC target("sha,sse4.1")
+#endif
+
+/*
+    four rounds (group g of 16) with message m, then the schedule for
+    the later groups: mnext is the message of the next group, and
+    mprev the one of the previous group
+ */
+
+#define SHANI_ROUNDS4(g, m, mnext, mprev) \
+    msg = _mm_add_epi32((m), \
+            _mm_loadu_si128((const __m128i *)&gSha256K[(g)*4])); \
+    cdgh = _mm_sha256rnds2_epu32(cdgh, abef, msg); \
+    if ((g) >= 3 && (g) <= 14) { \
+        tmp = _mm_alignr_epi8((m), (mprev), 4); \
+        mnext = _mm_add_epi32((mnext), tmp); \
+        mnext = _mm_sha256msg2_epu32((mnext), (m)); \
+    } \
+    msg = _mm_shuffle_epi32(msg, 0x0e); \
+    abef = _mm_sha256rnds2_epu32(abef, cdgh, msg); \
+    if ((g) >= 1 && (g) <= 12) { \
+        mprev = _mm_sha256msg1_epu32((mprev), (m)); \
+    }
+
+static void sha256_compress_shani(uint32_t state[8],
+                                  const uint8_t *blocks,
+                                  size_t nblocks)
+{
+    const __m128i mask = _mm_set_epi64x(0x0c0d0e0f08090a0bULL,
+                                        0x0405060700010203ULL);
+    __m128i abef, cdgh, abefSave, cdghSave, msg, tmp;
+    __m128i m0, m1, m2, m3;
+
+    // DCBA, HGFE -> ABEF, CDGH
+
+    tmp = _mm_loadu_si128((const __m128i *)&state[0]);
+    cdgh = _mm_loadu_si128((const __m128i *)&state[4]);
+    tmp = _mm_shuffle_epi32(tmp, 0xb1);
+    cdgh = _mm_shuffle_epi32(cdgh, 0x1b);
+    abef = _mm_alignr_epi8(tmp, cdgh, 8);
+    cdgh = _mm_blend_epi16(cdgh, tmp, 0xf0);
+
+    while (nblocks-- > 0) {
+
+        abefSave = abef;
+        cdghSave = cdgh;
+
+        m0 = _mm_shuffle_epi8(
+                _mm_loadu_si128((const __m128i *)(blocks + 0)), mask);
+        m1 = _mm_shuffle_epi8(
+                _mm_loadu_si128((const __m128i *)(blocks + 16)), mask);
+        m2 = _mm_shuffle_epi8(
+                _mm_loadu_si128((const __m128i *)(blocks + 32)), mask);
+        m3 = _mm_shuffle_epi8(
+                _mm_loadu_si128((const __m128i *)(blocks + 48)), mask);
+
+        SHANI_ROUNDS4( 0, m0, m1, m3);
+        SHANI_ROUNDS4( 1, m1, m2, m0);
+        SHANI_ROUNDS4( 2, m2, m3, m1);
+        SHANI_ROUNDS4( 3, m3, m0, m2);
+        SHANI_ROUNDS4( 4, m0, m1, m3);
+        SHANI_ROUNDS4( 5, m1, m2, m0);
+        SHANI_ROUNDS4( 6, m2, m3, m1);
+        SHANI_ROUNDS4( 7, m3, m0, m2);
+        SHANI_ROUNDS4( 8, m0, m1, m3);
+        SHANI_ROUNDS4( 9, m1, m2, m0);
+        SHANI_ROUNDS4(10, m2, m3, m1);
+        SHANI_ROUNDS4(11, m3, m0, m2);
+        SHANI_ROUNDS4(12, m0, m1, m3);
+        SHANI_ROUNDS4(13, m1, m2, m0);
+        SHANI_ROUNDS4(14, m2, m3, m1);
+        SHANI_ROUNDS4(15, m3, m0, m2);
+
+        abef = _mm_add_epi32(abef, abefSave);
+        cdgh = _mm_add_epi32(cdgh, cdghSave);
+
+        blocks += SHA256_BLOCK_LENGTH;
+    }
+
+    // ABEF, CDGH -> DCBA, HGFE
+
+    tmp = _mm_shuffle_epi32(abef, 0x1b);
+    cdgh = _mm_shuffle_epi32(cdgh, 0xb1);
+    abef = _mm_blend_epi16(tmp, cdgh, 0xf0);
+    cdgh = _mm_alignr_epi8(cdgh, tmp, 8);
+
+    _mm_storeu_si128((__m128i *)&state[0], abef);
+    _mm_storeu_si128((__m128i *)&state[4], cdgh);
+}
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#else
+#pragma GCC pop_options
+#endif
+
+#endif /* SHA_CPU_X86 */
+
+/* dispatch */
+
+static int gAllowShani = 1;
+static sha256CompressFn gCompress = NULL;
+static const char *gImplementation = "portable";
+
+static sha256CompressFn sha256_select(void)
+{
+#if defined(SHA_CPU_X86)
+    if (gAllowShani && sha_cpu_has_shani()) {
+        gImplementation = "sha-ni";
+        return sha256_compress_shani;
+    }
+#endif
+    gImplementation = "portable";
+    return sha256_compress_portable;
+}
+
+/*
+    sha256_compress - the implementation is picked on the first call
+                      (racing threads pick the same one)
+ */
+
+void sha256_compress(uint32_t state[8],
+                     const uint8_t *blocks,
+                     size_t nblocks)
+{
+    sha256CompressFn fn = gCompress;
+
+    if (fn == NULL) {
+        fn = sha256_select();
+        gCompress = fn;
+    }
+
+    fn(state, blocks, nblocks);
+}
+
+void sha256_use_shani(int enable)
+{
+    gAllowShani = (enable != 0);
+    gCompress = sha256_select();
+}
+
+const char *sha256_implementation(void)
+{
+    if (gCompress == NULL) {
+        gCompress = sha256_select();
+    }
+    return gImplementation;
+}
+
+void sha224_init(sha256_ctx *ctx)
+{
+    ctx->state[0] = 0xc1059ed8;
+    ctx->state[1] = 0x367cd507;
+    ctx->state[2] = 0x3070dd17;
+    ctx->state[3] = 0xf70e5939;
+    ctx->state[4] = 0xffc00b31;
+    ctx->state[5] = 0x68581511;
+    ctx->state[6] = 0x64f98fa7;
+    ctx->state[7] = 0xbefa4fa4;
+    ctx->count = 0;
+    ctx->digestLength = SHA224_DIGEST_LENGTH;
+}
+
+void sha256_init(sha256_ctx *ctx)
+{
+    ctx->state[0] = 0x6a09e667;
+    ctx->state[1] = 0xbb67ae85;
+    ctx->state[2] = 0x3c6ef372;
+    ctx->state[3] = 0xa54ff53a;
+    ctx->state[4] = 0x510e527f;
+    ctx->state[5] = 0x9b05688c;
+    ctx->state[6] = 0x1f83d9ab;
+    ctx->state[7] = 0x5be0cd19;
+    ctx->count = 0;
+    ctx->digestLength = SHA256_DIGEST_LENGTH;
+}
+
+void sha256_update(sha256_ctx *ctx, const void *data, size_t length)
+{
+    const uint8_t *in = data;
+    size_t used = (size_t)(ctx->count % SHA256_BLOCK_LENGTH);
+    size_t n = 0;
+
+    ctx->count += length;
+
+    // fill up a partial block first
+
+    if (used > 0) {
+        n = SHA256_BLOCK_LENGTH - used;
+        if (length < n) {
+            memcpy(ctx->buffer + used, in, length);
+            return;
+        }
+        memcpy(ctx->buffer + used, in, n);
+        sha256_compress(ctx->state, ctx->buffer, 1);
+        in += n;
+        length -= n;
+    }
+
+    // whole blocks are compressed straight from the input
+
+    n = length / SHA256_BLOCK_LENGTH;
+    if (n > 0) {
+        sha256_compress(ctx->state, in, n);
+        in += n*SHA256_BLOCK_LENGTH;
+        length -= n*SHA256_BLOCK_LENGTH;
+    }
+
+    if (length > 0) {
+        memcpy(ctx->buffer, in, length);
+    }
+}
+
+void sha256_final(sha256_ctx *ctx, uint8_t *digest)
+{
+    size_t used = (size_t)(ctx->count % SHA256_BLOCK_LENGTH);
+    uint64_t bits = ctx->count << 3;
+    size_t i = 0;
+
+    // pad with 0x80, zeros, and the message length in bits
+
+    ctx->buffer[used++] = 0x80;
+    if (used > SHA256_BLOCK_LENGTH - 8) {
+        memset(ctx->buffer + used, 0, SHA256_BLOCK_LENGTH - used);
+        sha256_compress(ctx->state, ctx->buffer, 1);
+        used = 0;
+    }
+    memset(ctx->buffer + used, 0, SHA256_BLOCK_LENGTH - 8 - used);
+    store32_be(ctx->buffer + 56, (uint32_t)(bits >> 32));
+    store32_be(ctx->buffer + 60, (uint32_t)bits);
+    sha256_compress(ctx->state, ctx->buffer, 1);
+
+    for (i = 0; i < ctx->digestLength/4; i++) {
+        store32_be(digest + i*4, ctx->state[i]);
+    }
+
+    memset(ctx, 0, sizeof(*ctx));
+}
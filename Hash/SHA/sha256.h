@@ -0,0 +1,91 @@
+/*
+    Hash - sha256.h
+
+    SHA-224 and SHA-256 (FIPS 180-4), replace CC_SHA224 / CC_SHA256 from
+    CommonCrypto so that they are available on all platforms.  On
+    x86_64 cpus with the SHA extensions (SHA-NI), the compression
+    function uses the SHA256RNDS2 and SHA256MSG1/2 instructions.
+
+    History:
+
+    v. 1.0.0 (10/18/2026) - Initial version
+
+    Copyright (c) 2026 Sriranga R. Veeraraghavan <ranga@calalum.org>
+
+    Permission is hereby granted, free of charge, to any person obtaining
+    a copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+    OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef sha256_h
+#define sha256_h
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum {
+    SHA256_BLOCK_LENGTH  = 64,
+    SHA224_DIGEST_LENGTH = 28,
+    SHA256_DIGEST_LENGTH = 32,
+};
+
+/* SHA-224 uses the same context, with a different initial state */
+
+typedef struct sha256_ctx {
+    uint32_t state[8];
+    uint64_t count;                     /* bytes hashed so far */
+    uint8_t  buffer[SHA256_BLOCK_LENGTH];
+    size_t   digestLength;
+} sha256_ctx;
+
+void sha224_init(sha256_ctx *ctx);
+void sha256_init(sha256_ctx *ctx);
+void sha256_update(sha256_ctx *ctx, const void *data, size_t length);
+
+/* sha256_final - write ctx->digestLength (28 or 32) bytes of digest */
+
+void sha256_final(sha256_ctx *ctx, uint8_t *digest);
+
+/*
+    sha256_compress - run the compression function over nblocks 64 byte
+                      blocks, using the best implementation for this cpu
+ */
+
+void sha256_compress(uint32_t state[8],
+                     const uint8_t *blocks,
+                     size_t nblocks);
+
+/*
+    sha256_use_shani - allow (1, the default) or disallow (0) the SHA-NI
+                       implementation, for benchmarking and testing
+ */
+
+void sha256_use_shani(int enable);
+
+/* sha256_implementation - return the name of the implementation in use */
+
+const char *sha256_implementation(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* sha256_h */
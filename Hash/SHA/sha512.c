@@ -0,0 +1,488 @@
+/*
+    Hash - sha512.c
+
+    History:
+
+    v. 1.0.0 (10/18/2026) - Initial version
+    v. 1.0.1 (10/18/2026) - compute the AVX2 message schedule 16 words
+                            ahead of the rounds, instead of all of it
+                            before them
+
+    Copyright (c) 2026 Sriranga R. Veeraraghavan <ranga@calalum.org>
+
+    Permission is hereby granted, free of charge, to any person obtaining
+    a copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+    OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <string.h>
+
+#include "sha512.h"
+#include "sha_cpu.h"
+
+typedef void (*sha512CompressFn)(uint64_t state[8],
+                                 const uint8_t *blocks,
+                                 size_t nblocks);
+
+static const uint64_t gSha512K[80] = {
+    0x428a2f98d728ae22ULL, 0x7137449123ef65cdULL,
+    0xb5c0fbcfec4d3b2fULL, 0xe9b5dba58189dbbcULL,
+    0x3956c25bf348b538ULL, 0x59f111f1b605d019ULL,
+    0x923f82a4af194f9bULL, 0xab1c5ed5da6d8118ULL,
+    0xd807aa98a3030242ULL, 0x12835b0145706fbeULL,
+    0x243185be4ee4b28cULL, 0x550c7dc3d5ffb4e2ULL,
+    0x72be5d74f27b896fULL, 0x80deb1fe3b1696b1ULL,
+    0x9bdc06a725c71235ULL, 0xc19bf174cf692694ULL,
+    0xe49b69c19ef14ad2ULL, 0xefbe4786384f25e3ULL,
+    0x0fc19dc68b8cd5b5ULL, 0x240ca1cc77ac9c65ULL,
+    0x2de92c6f592b0275ULL, 0x4a7484aa6ea6e483ULL,
+    0x5cb0a9dcbd41fbd4ULL, 0x76f988da831153b5ULL,
+    0x983e5152ee66dfabULL, 0xa831c66d2db43210ULL,
+    0xb00327c898fb213fULL, 0xbf597fc7beef0ee4ULL,
+    0xc6e00bf33da88fc2ULL, 0xd5a79147930aa725ULL,
+    0x06ca6351e003826fULL, 0x142929670a0e6e70ULL,
+    0x27b70a8546d22ffcULL, 0x2e1b21385c26c926ULL,
+    0x4d2c6dfc5ac42aedULL, 0x53380d139d95b3dfULL,
+    0x650a73548baf63deULL, 0x766a0abb3c77b2a8ULL,
+    0x81c2c92e47edaee6ULL, 0x92722c851482353bULL,
+    0xa2bfe8a14cf10364ULL, 0xa81a664bbc423001ULL,
+    0xc24b8b70d0f89791ULL, 0xc76c51a30654be30ULL,
+    0xd192e819d6ef5218ULL, 0xd69906245565a910ULL,
+    0xf40e35855771202aULL, 0x106aa07032bbd1b8ULL,
+    0x19a4c116b8d2d0c8ULL, 0x1e376c085141ab53ULL,
+    0x2748774cdf8eeb99ULL, 0x34b0bcb5e19b48a8ULL,
+    0x391c0cb3c5c95a63ULL, 0x4ed8aa4ae3418acbULL,
+    0x5b9cca4f7763e373ULL, 0x682e6ff3d6b2b8a3ULL,
+    0x748f82ee5defb2fcULL, 0x78a5636f43172f60ULL,
+    0x84c87814a1f0ab72ULL, 0x8cc702081a6439ecULL,
+    0x90befffa23631e28ULL, 0xa4506cebde82bde9ULL,
+    0xbef9a3f7b2c67915ULL, 0xc67178f2e372532bULL,
+    0xca273eceea26619cULL, 0xd186b8c721c0c207ULL,
+    0xeada7dd6cde0eb1eULL, 0xf57d4f7fee6ed178ULL,
+    0x06f067aa72176fbaULL, 0x0a637dc5a2c898a6ULL,
+    0x113f9804bef90daeULL, 0x1b710b35131c471bULL,
+    0x28db77f523047d84ULL, 0x32caab7b40c72493ULL,
+    0x3c9ebe0a15c9bebcULL, 0x431d67c49c100d4cULL,
+    0x4cc5d4becb3e42b6ULL, 0x597f299cfc657e2aULL,
+    0x5fcb6fab3ad6faecULL, 0x6c44198c4a475817ULL,
+};
+
+static inline uint64_t load64_be(const uint8_t *p)
+{
+    return ((uint64_t)p[0] << 56) |
+           ((uint64_t)p[1] << 48) |
+           ((uint64_t)p[2] << 40) |
+           ((uint64_t)p[3] << 32) |
+           ((uint64_t)p[4] << 24) |
+           ((uint64_t)p[5] << 16) |
+           ((uint64_t)p[6] << 8) |
+           ((uint64_t)p[7]);
+}
+
+static inline void store64_be(uint8_t *p, uint64_t v)
+{
+    p[0] = (uint8_t)(v >> 56);
+    p[1] = (uint8_t)(v >> 48);
+    p[2] = (uint8_t)(v >> 40);
+    p[3] = (uint8_t)(v >> 32);
+    p[4] = (uint8_t)(v >> 24);
+    p[5] = (uint8_t)(v >> 16);
+    p[6] = (uint8_t)(v >> 8);
+    p[7] = (uint8_t)v;
+}
+
+#define ROTR64(x, n) (((x) >> (n)) | ((x) << (64 - (n))))
+
+#define CH(x, y, z)  ((z) ^ ((x) & ((y) ^ (z))))
+#define MAJ(x, y, z) (((x) & (y)) | ((z) & ((x) | (y))))
+#define S0(x) (ROTR64((x), 28) ^ ROTR64((x), 34) ^ ROTR64((x), 39))
+#define S1(x) (ROTR64((x), 14) ^ ROTR64((x), 18) ^ ROTR64((x), 41))
+#define s0(x) (ROTR64((x), 1) ^ ROTR64((x), 8) ^ ((x) >> 7))
+#define s1(x) (ROTR64((x), 19) ^ ROTR64((x), 61) ^ ((x) >> 6))
+
+/* one round, kw is the round constant plus the message word */
+
+#define SHA512_ROUND(a, b, c, d, e, f, g, h, kw) \
+    t1 = (h) + S1(e) + CH((e), (f), (g)) + (kw); \
+    (d) += t1; \
+    (h) = t1 + S0(a) + MAJ((a), (b), (c))
+
+/* eight rounds, rotating the working variables */
+
+#define ROUNDS8(t, KW) \
+    SHA512_ROUND(a, b, c, d, e, f, g, h, KW((t))); \
+    SHA512_ROUND(h, a, b, c, d, e, f, g, KW((t) + 1)); \
+    SHA512_ROUND(g, h, a, b, c, d, e, f, KW((t) + 2)); \
+    SHA512_ROUND(f, g, h, a, b, c, d, e, KW((t) + 3)); \
+    SHA512_ROUND(e, f, g, h, a, b, c, d, KW((t) + 4)); \
+    SHA512_ROUND(d, e, f, g, h, a, b, c, KW((t) + 5)); \
+    SHA512_ROUND(c, d, e, f, g, h, a, b, KW((t) + 6)); \
+    SHA512_ROUND(b, c, d, e, f, g, h, a, KW((t) + 7))
+
+/*
+    sha512_compress_portable - the compression function in C, the
+                               message schedule is kept in a 16 word
+                               circular buffer
+ */
+
+#define KW_LOADED(t) (gSha512K[(t)] + w[(t)])
+
+#define KW_SCHEDULE(t) \
+    (gSha512K[(t)] + \
+     (w[(t) & 15] += s1(w[((t) + 14) & 15]) + w[((t) + 9) & 15] + \
+                     s0(w[((t) + 1) & 15])))
+
+static void sha512_compress_portable(uint64_t state[8],
+                                     const uint8_t *blocks,
+                                     size_t nblocks)
+{
+    uint64_t a, b, c, d, e, f, g, h, t1;
+    uint64_t w[16];
+    int i = 0;
+
+    while (nblocks-- > 0) {
+
+        for (i = 0; i < 16; i++) {
+            w[i] = load64_be(blocks + i*8);
+        }
+
+        a = state[0];
+        b = state[1];
+        c = state[2];
+        d = state[3];
+        e = state[4];
+        f = state[5];
+        g = state[6];
+        h = state[7];
+
+        ROUNDS8(0, KW_LOADED);
+        ROUNDS8(8, KW_LOADED);
+        for (i = 16; i < 80; i += 16) {
+            ROUNDS8(i, KW_SCHEDULE);
+            ROUNDS8(i + 8, KW_SCHEDULE);
+        }
+
+        state[0] += a;
+        state[1] += b;
+        state[2] += c;
+        state[3] += d;
+        state[4] += e;
+        state[5] += f;
+        state[6] += g;
+        state[7] += h;
+
+        blocks += SHA512_BLOCK_LENGTH;
+    }
+}
+
+/*
+    sha512_compress_avx2 - the compression function with the message
+                           schedule computed four words at a time in
+                           AVX2 registers, and stored with the round
+                           constants already added.  The rounds are the
+                           same C code as the portable version, but
+                           compiled for BMI2, so the rotates become
+                           RORX.  AVX2 and BMI2 are enabled for just
+                           this function with a target pragma.
+
+                           The schedule for rounds t + 16 .. t + 23 is
+                           computed while rounds t .. t + 7 run, so the
+                           (vector) schedule and the (scalar) rounds
+                           overlap rather than the rounds waiting for
+                           all 80 words.
+ */
+
+#if defined(SHA_CPU_X86)
+
+#include <immintrin.h>
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("avx2,bmi2"))), apply_to = function)
+#else
+#pragma GCC push_options
+#pragma GCC target("avx2,bmi2")
+#endif
+
+static inline __m256i rotr64x4(__m256i x, int n)
+{
+    return _mm256_or_si256(_mm256_srli_epi64(x, n),
+                           _mm256_slli_epi64(x, 64 - n));
+}
+
+static inline __m256i sigma0x4(__m256i x)
+{
+    return _mm256_xor_si256(_mm256_xor_si256(rotr64x4(x, 1),
+                                             rotr64x4(x, 8)),
+                            _mm256_srli_epi64(x, 7));
+}
+
+static inline __m256i sigma1x4(__m256i x)
+{
+    return _mm256_xor_si256(_mm256_xor_si256(rotr64x4(x, 19),
+                                             rotr64x4(x, 61)),
+                            _mm256_srli_epi64(x, 6));
+}
+
+/* words 1..4 of the eight words in lo (0..3) and hi (4..7) */
+
+static inline __m256i shift1x4(__m256i lo, __m256i hi)
+{
+    return _mm256_alignr_epi8(_mm256_permute2x128_si256(lo, hi, 0x21),
+                              lo,
+                              8);
+}
+
+#define KW_STORED(t) kw[(t)]
+
+/*
+    SCHEDULE4 - w[t..t+3] = s1(w[t-2]) + w[t-7] + s0(w[t-15]) + w[t-16],
+                plus the round constants, into kw[t..t+3].  x0..x3 hold
+                the last 16 words; the upper two words depend on the
+                lower two, so s1 is done twice
+ */
+
+#define SCHEDULE4(t) \
+    x = _mm256_add_epi64(x0, sigma0x4(shift1x4(x0, x1))); \
+    x = _mm256_add_epi64(x, shift1x4(x2, x3)); \
+    x = _mm256_add_epi64(x, \
+            sigma1x4(_mm256_permute2x128_si256(x3, x3, 0x81))); \
+    x = _mm256_add_epi64(x, \
+            sigma1x4(_mm256_permute2x128_si256(x, x, 0x08))); \
+    _mm256_store_si256((__m256i *)&kw[(t)], \
+        _mm256_add_epi64(x, \
+            _mm256_loadu_si256((const __m256i *)&gSha512K[(t)]))); \
+    x0 = x1; \
+    x1 = x2; \
+    x2 = x3; \
+    x3 = x
+
+static void sha512_compress_avx2(uint64_t state[8],
+                                 const uint8_t *blocks,
+                                 size_t nblocks)
+{
+    const __m256i bswap = _mm256_set_epi64x(0x08090a0b0c0d0e0fULL,
+                                            0x0001020304050607ULL,
+                                            0x08090a0b0c0d0e0fULL,
+                                            0x0001020304050607ULL);
+    uint64_t a, b, c, d, e, f, g, h, t1;
+    uint64_t kw[80] __attribute__((aligned(32)));
+    __m256i x0, x1, x2, x3, x;
+    int t = 0;
+
+    while (nblocks-- > 0) {
+
+        // x0..x3 hold the last 16 words of the schedule
+
+        x0 = _mm256_shuffle_epi8(
+                _mm256_loadu_si256((const __m256i *)(blocks + 0)), bswap);
+        x1 = _mm256_shuffle_epi8(
+                _mm256_loadu_si256((const __m256i *)(blocks + 32)), bswap);
+        x2 = _mm256_shuffle_epi8(
+                _mm256_loadu_si256((const __m256i *)(blocks + 64)), bswap);
+        x3 = _mm256_shuffle_epi8(
+                _mm256_loadu_si256((const __m256i *)(blocks + 96)), bswap);
+
+        for (t = 0; t < 16; t += 4) {
+            x = (t == 0 ? x0 : t == 4 ? x1 : t == 8 ? x2 : x3);
+            _mm256_store_si256((__m256i *)&kw[t],
+                _mm256_add_epi64(x,
+                    _mm256_loadu_si256((const __m256i *)&gSha512K[t])));
+        }
+
+        a = state[0];
+        b = state[1];
+        c = state[2];
+        d = state[3];
+        e = state[4];
+        f = state[5];
+        g = state[6];
+        h = state[7];
+
+        for (t = 0; t < 64; t += 8) {
+            SCHEDULE4(t + 16);
+            SCHEDULE4(t + 20);
+            ROUNDS8(t, KW_STORED);
+        }
+        ROUNDS8(64, KW_STORED);
+        ROUNDS8(72, KW_STORED);
+
+        state[0] += a;
+        state[1] += b;
+        state[2] += c;
+        state[3] += d;
+        state[4] += e;
+        state[5] += f;
+        state[6] += g;
+        state[7] += h;
+
+        blocks += SHA512_BLOCK_LENGTH;
+    }
+}
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#else
+#pragma GCC pop_options
+#endif
+
+#endif /* SHA_CPU_X86 */
+
+/* dispatch */
+
+static int gAllowAvx2 = 1;
+static sha512CompressFn gCompress = NULL;
+static const char *gImplementation = "portable";
+
+static sha512CompressFn sha512_select(void)
+{
+#if defined(SHA_CPU_X86)
+    if (gAllowAvx2 && sha_cpu_has_avx2_bmi2()) {
+        gImplementation = "avx2";
+        return sha512_compress_avx2;
+    }
+#endif
+    gImplementation = "portable";
+    return sha512_compress_portable;
+}
+
+/*
+    sha512_compress - the implementation is picked on the first call
+                      (racing threads pick the same one)
+ */
+
+void sha512_compress(uint64_t state[8],
+                     const uint8_t *blocks,
+                     size_t nblocks)
+{
+    sha512CompressFn fn = gCompress;
+
+    if (fn == NULL) {
+        fn = sha512_select();
+        gCompress = fn;
+    }
+
+    fn(state, blocks, nblocks);
+}
+
+void sha512_use_avx2(int enable)
+{
+    gAllowAvx2 = (enable != 0);
+    gCompress = sha512_select();
+}
+
+const char *sha512_implementation(void)
+{
+    if (gCompress == NULL) {
+        gCompress = sha512_select();
+    }
+    return gImplementation;
+}
+
+void sha384_init(sha512_ctx *ctx)
+{
+    ctx->state[0] = 0xcbbb9d5dc1059ed8ULL;
+    ctx->state[1] = 0x629a292a367cd507ULL;
+    ctx->state[2] = 0x9159015a3070dd17ULL;
+    ctx->state[3] = 0x152fecd8f70e5939ULL;
+    ctx->state[4] = 0x67332667ffc00b31ULL;
+    ctx->state[5] = 0x8eb44a8768581511ULL;
+    ctx->state[6] = 0xdb0c2e0d64f98fa7ULL;
+    ctx->state[7] = 0x47b5481dbefa4fa4ULL;
+    ctx->count[0] = 0;
+    ctx->count[1] = 0;
+    ctx->digestLength = SHA384_DIGEST_LENGTH;
+}
+
+void sha512_init(sha512_ctx *ctx)
+{
+    ctx->state[0] = 0x6a09e667f3bcc908ULL;
+    ctx->state[1] = 0xbb67ae8584caa73bULL;
+    ctx->state[2] = 0x3c6ef372fe94f82bULL;
+    ctx->state[3] = 0xa54ff53a5f1d36f1ULL;
+    ctx->state[4] = 0x510e527fade682d1ULL;
+    ctx->state[5] = 0x9b05688c2b3e6c1fULL;
+    ctx->state[6] = 0x1f83d9abfb41bd6bULL;
+    ctx->state[7] = 0x5be0cd19137e2179ULL;
+    ctx->count[0] = 0;
+    ctx->count[1] = 0;
+    ctx->digestLength = SHA512_DIGEST_LENGTH;
+}
+
+void sha512_update(sha512_ctx *ctx, const void *data, size_t length)
+{
+    const uint8_t *in = data;
+    size_t used = (size_t)(ctx->count[0] % SHA512_BLOCK_LENGTH);
+    size_t n = 0;
+
+    ctx->count[0] += length;
+    if (ctx->count[0] < length) {
+        ctx->count[1]++;
+    }
+
+    // fill up a partial block first
+
+    if (used > 0) {
+        n = SHA512_BLOCK_LENGTH - used;
+        if (length < n) {
+            memcpy(ctx->buffer + used, in, length);
+            return;
+        }
+        memcpy(ctx->buffer + used, in, n);
+        sha512_compress(ctx->state, ctx->buffer, 1);
+        in += n;
+        length -= n;
+    }
+
+    // whole blocks are compressed straight from the input
+
+    n = length / SHA512_BLOCK_LENGTH;
+    if (n > 0) {
+        sha512_compress(ctx->state, in, n);
+        in += n*SHA512_BLOCK_LENGTH;
+        length -= n*SHA512_BLOCK_LENGTH;
+    }
+
+    if (length > 0) {
+        memcpy(ctx->buffer, in, length);
+    }
+}
+
+void sha512_final(sha512_ctx *ctx, uint8_t *digest)
+{
+    size_t used = (size_t)(ctx->count[0] % SHA512_BLOCK_LENGTH);
+    size_t i = 0;
+
+    // pad with 0x80, zeros, and the 128-bit message length in bits
+
+    ctx->buffer[used++] = 0x80;
+    if (used > SHA512_BLOCK_LENGTH - 16) {
+        memset(ctx->buffer + used, 0, SHA512_BLOCK_LENGTH - used);
+        sha512_compress(ctx->state, ctx->buffer, 1);
+        used = 0;
+    }
+    memset(ctx->buffer + used, 0, SHA512_BLOCK_LENGTH - 16 - used);
+    store64_be(ctx->buffer + 112,
+               (ctx->count[1] << 3) | (ctx->count[0] >> 61));
+    store64_be(ctx->buffer + 120, ctx->count[0] << 3);
+    sha512_compress(ctx->state, ctx->buffer, 1);
+
+    for (i = 0; i < ctx->digestLength/8; i++) {
+        store64_be(digest + i*8, ctx->state[i]);
+    }
+
+    memset(ctx, 0, sizeof(*ctx));
+}
@@ -0,0 +1,93 @@
+/*
+    Hash - sha512.h
+
+    SHA-384 and SHA-512 (FIPS 180-4), replace CC_SHA384 / CC_SHA512
+    from CommonCrypto so that they are available on all platforms.  On
+    x86_64 cpus with AVX2 and BMI2, the message schedule is computed
+    four words at a time with AVX2, and the rounds use the BMI2
+    rotates (RORX), which don't change the flags.
+
+    History:
+
+    v. 1.0.0 (10/18/2026) - Initial version
+
+    Copyright (c) 2026 Sriranga R. Veeraraghavan <ranga@calalum.org>
+
+    Permission is hereby granted, free of charge, to any person obtaining
+    a copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+    OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef sha512_h
+#define sha512_h
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum {
+    SHA512_BLOCK_LENGTH  = 128,
+    SHA384_DIGEST_LENGTH = 48,
+    SHA512_DIGEST_LENGTH = 64,
+};
+
+/* SHA-384 uses the same context, with a different initial state */
+
+typedef struct sha512_ctx {
+    uint64_t state[8];
+    uint64_t count[2];                  /* bytes hashed so far, low word
+                                           first */
+    uint8_t  buffer[SHA512_BLOCK_LENGTH];
+    size_t   digestLength;
+} sha512_ctx;
+
+void sha384_init(sha512_ctx *ctx);
+void sha512_init(sha512_ctx *ctx);
+void sha512_update(sha512_ctx *ctx, const void *data, size_t length);
+
+/* sha512_final - write ctx->digestLength (48 or 64) bytes of digest */
+
+void sha512_final(sha512_ctx *ctx, uint8_t *digest);
+
+/*
+    sha512_compress - run the compression function over nblocks 128 byte
+                      blocks, using the best implementation for this cpu
+ */
+
+void sha512_compress(uint64_t state[8],
+                     const uint8_t *blocks,
+                     size_t nblocks);
+
+/*
+    sha512_use_avx2 - allow (1, the default) or disallow (0) the AVX2 /
+                      BMI2 implementation, for benchmarking and testing
+ */
+
+void sha512_use_avx2(int enable);
+
+/* sha512_implementation - return the name of the implementation in use */
+
+const char *sha512_implementation(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* sha512_h */
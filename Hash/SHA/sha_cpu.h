@@ -0,0 +1,81 @@
+/*
+    Hash - sha_cpu.h
+
+    Run time detection of the x86_64 instructions used by the SHA-1 and
+    SHA-2 implementations.
+
+    History:
+
+    v. 1.0.0 (10/18/2026) - Initial version
+
+    Copyright (c) 2026 Sriranga R. Veeraraghavan <ranga@calalum.org>
+
+    Permission is hereby granted, free of charge, to any person obtaining
+    a copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+    OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef sha_cpu_h
+#define sha_cpu_h
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+
+#include <cpuid.h>
+
+#define SHA_CPU_X86 1
+
+/*
+    sha_cpu_has_shani - return 1 if the cpu has the SHA extensions and
+                        SSE4.1 (used to shuffle the state words)
+
+    __builtin_cpu_supports("sha") isn't available in older compilers,
+    so cpuid is checked directly.
+ */
+
+static inline int sha_cpu_has_shani(void)
+{
+    unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+
+    if (__get_cpuid(1, &eax, &ebx, &ecx, &edx) == 0 ||
+        (ecx & bit_SSE4_1) == 0 ||
+        (ecx & bit_SSSE3) == 0) {
+        return 0;
+    }
+
+    if (__get_cpuid_max(0, NULL) < 7) {
+        return 0;
+    }
+
+    __cpuid_count(7, 0, eax, ebx, ecx, edx);
+
+    // SHA is bit 29 of ebx
+
+    return ((ebx & (1U << 29)) != 0);
+}
+
+/* sha_cpu_has_avx2_bmi2 - return 1 if the cpu (and OS) support AVX2 and BMI2 */
+
+static inline int sha_cpu_has_avx2_bmi2(void)
+{
+    __builtin_cpu_init();
+    return (__builtin_cpu_supports("avx2") &&
+            __builtin_cpu_supports("bmi2"));
+}
+
+#endif /* __x86_64__ */
+
+#endif /* sha_cpu_h */
@@ -40,7 +40,8 @@
 typedef int64_t ssize_t;
 #elif SIZEOF_SIZE_T == 4
 /* srv 2020-11-27 - MacOSX includes a definition of ssize_t */
-#ifndef _SSIZE_T
+/* glibc defines ssize_t and marks it with __ssize_t_defined */
+#if !defined(_SSIZE_T) && !defined(__ssize_t_defined)
 typedef int32_t ssize_t;
 #endif /* _SSIZE_T */
 #else
@@ -0,0 +1,280 @@
+/*
+    Hash - sha3_many.c
+
+    History:
+
+    v. 1.0.0 (10/18/2026) - Initial version
+
+    Copyright (c) 2026 Sriranga R. Veeraraghavan <ranga@calalum.org>
+
+    Permission is hereby granted, free of charge, to any person obtaining
+    a copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+    OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <string.h>
+
+#include "keccak-tiny.h"
+#include "sha3_many.h"
+
+/*
+    Four messages are absorbed at once, one per 64-bit lane, using the
+    same scheme as blake2_many.c: the lanes absorb their next full block
+    together until one of them has no full blocks left, and that message
+    is then finished (padded and squeezed) by keccak-tiny, before the
+    lane is refilled with the next message.
+ */
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+
+#define SHA3_MANY_SIMD 1
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("avx2"))), apply_to = function)
+#else
+#pragma GCC push_options
+#pragma GCC target("avx2")
+#endif
+
+enum {
+    SHA3_LANES = 4,
+};
+
+typedef uint64_t keccakLanes __attribute__((vector_size(32)));
+
+static const uint8_t sha3_many_rho[24] = {
+     1,  3,  6, 10, 15, 21, 28, 36, 45, 55,  2, 14,
+    27, 41, 56,  8, 25, 43, 62, 18, 39, 61, 20, 44,
+};
+
+static const uint8_t sha3_many_pi[24] = {
+    10,  7, 11, 17, 18,  3,  5, 16,  8, 21, 24,  4,
+    15, 23, 19, 13, 12,  2, 20, 14, 22,  9,  6,  1,
+};
+
+static const uint64_t sha3_many_RC[24] = {
+    0x0000000000000001ULL, 0x0000000000008082ULL,
+    0x800000000000808aULL, 0x8000000080008000ULL,
+    0x000000000000808bULL, 0x0000000080000001ULL,
+    0x8000000080008081ULL, 0x8000000000008009ULL,
+    0x000000000000008aULL, 0x0000000000000088ULL,
+    0x0000000080008009ULL, 0x000000008000000aULL,
+    0x000000008000808bULL, 0x800000000000008bULL,
+    0x8000000000008089ULL, 0x8000000000008003ULL,
+    0x8000000000008002ULL, 0x8000000000000080ULL,
+    0x000000000000800aULL, 0x800000008000000aULL,
+    0x8000000080008081ULL, 0x8000000000008080ULL,
+    0x0000000080000001ULL, 0x8000000080008008ULL,
+};
+
+#define ROL_LANES(x, n) (((x) << (n)) | ((x) >> (64 - (n))))
+
+/* keccakf_lanes - Keccak-f[1600] on each lane */
+
+static void keccakf_lanes(keccakLanes a[25])
+{
+    keccakLanes b[5];
+    keccakLanes t;
+    int round = 0, x = 0, y = 0, i = 0;
+
+    for (round = 0; round < 24; round++) {
+
+        // theta
+
+        for (x = 0; x < 5; x++) {
+            b[x] = a[x] ^ a[x + 5] ^ a[x + 10] ^ a[x + 15] ^ a[x + 20];
+        }
+        for (x = 0; x < 5; x++) {
+            t = b[(x + 4) % 5] ^ ROL_LANES(b[(x + 1) % 5], 1);
+            for (y = 0; y < 25; y += 5) {
+                a[y + x] ^= t;
+            }
+        }
+
+        // rho and pi
+
+        t = a[1];
+        for (i = 0; i < 24; i++) {
+            b[0] = a[sha3_many_pi[i]];
+            a[sha3_many_pi[i]] = ROL_LANES(t, sha3_many_rho[i]);
+            t = b[0];
+        }
+
+        // chi
+
+        for (y = 0; y < 25; y += 5) {
+            for (x = 0; x < 5; x++) {
+                b[x] = a[y + x];
+            }
+            for (x = 0; x < 5; x++) {
+                a[y + x] = b[x] ^ (~b[(x + 1) % 5] & b[(x + 2) % 5]);
+            }
+        }
+
+        // iota
+
+        a[0] ^= sha3_many_RC[round];
+    }
+}
+
+/* a message that is being absorbed in a lane */
+
+typedef struct sha3ManyLane {
+    size_t index;           /* message number */
+    const uint8_t *next;    /* next block */
+    size_t blocks;          /* full blocks left */
+    size_t length;          /* bytes left */
+    int active;
+} sha3ManyLane;
+
+static void sha3_many_avx2(const uint8_t *const *inputs,
+                           const size_t *lengths,
+                           size_t count,
+                           uint8_t *out,
+                           size_t bits)
+{
+    sha3ManyLane lanes[SHA3_LANES];
+    keccakLanes a[25];
+    keccak_state S;
+    size_t rate = KECCAK_RATE(bits);
+    size_t outlen = bits / 8;
+    size_t next = 0, steps = 0, s = 0;
+    uint64_t w[SHA3_LANES];
+    int i = 0, j = 0, active = 0;
+
+    memset(lanes, 0, sizeof(lanes));
+    memset(a, 0, sizeof(a));
+
+    for (;;) {
+
+        // refill the empty lanes, messages shorter than a block are
+        // hashed now
+
+        active = 0;
+        for (j = 0; j < SHA3_LANES; j++) {
+            while (!lanes[j].active && next < count) {
+                if (lengths[next] < rate) {
+                    sha3_many(&inputs[next], &lengths[next], 1,
+                              out + next*outlen, bits, 0);
+                    next++;
+                    continue;
+                }
+                lanes[j].index = next;
+                lanes[j].next = inputs[next];
+                lanes[j].length = lengths[next];
+                lanes[j].blocks = lengths[next] / rate;
+                lanes[j].active = 1;
+                for (i = 0; i < 25; i++) {
+                    a[i][j] = 0;
+                }
+                next++;
+            }
+            if (lanes[j].active) {
+                if (active == 0 || lanes[j].blocks < steps) {
+                    steps = lanes[j].blocks;
+                }
+                active++;
+            }
+        }
+
+        if (active == 0) {
+            break;
+        }
+
+        // absorb until a lane runs out of full blocks, the lanes without
+        // a message just permute their (ignored) state
+
+        for (s = 0; s < steps; s++) {
+            for (i = 0; i < (int)(rate / 8); i++) {
+                for (j = 0; j < SHA3_LANES; j++) {
+                    w[j] = 0;
+                    if (lanes[j].active) {
+                        memcpy(&w[j], lanes[j].next + 8*i, sizeof(uint64_t));
+                    }
+                }
+                a[i] ^= (keccakLanes){ w[0], w[1], w[2], w[3] };
+            }
+            for (j = 0; j < SHA3_LANES; j++) {
+                if (lanes[j].active) {
+                    lanes[j].next += rate;
+                }
+            }
+            keccakf_lanes(a);
+        }
+
+        // pad and squeeze the messages that have no full blocks left
+
+        for (j = 0; j < SHA3_LANES; j++) {
+            if (!lanes[j].active) {
+                continue;
+            }
+            lanes[j].blocks -= steps;
+            lanes[j].length -= steps * rate;
+            if (lanes[j].blocks > 0) {
+                continue;
+            }
+            keccak_digest_init(&S, bits);
+            for (i = 0; i < 25; i++) {
+                w[0] = a[i][j];
+                memcpy(S.a + 8*i, &w[0], sizeof(uint64_t));
+            }
+            keccak_digest_update(&S, lanes[j].next, lanes[j].length);
+            keccak_digest_sum(&S, out + lanes[j].index*outlen, outlen);
+            lanes[j].active = 0;
+        }
+    }
+}
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#else
+#pragma GCC pop_options
+#endif
+
+#endif /* __x86_64__ && (__GNUC__ || __clang__) */
+
+int sha3_many(const uint8_t *const *inputs,
+              const size_t *lengths,
+              size_t count,
+              uint8_t *out,
+              size_t bits,
+              int useSimd)
+{
+    keccak_state S;
+    size_t i = 0;
+
+    if (bits != 224 && bits != 256 && bits != 384 && bits != 512) {
+        return -1;
+    }
+
+#if defined(SHA3_MANY_SIMD)
+    if (useSimd && count > 1 && __builtin_cpu_supports("avx2")) {
+        sha3_many_avx2(inputs, lengths, count, out, bits);
+        return 0;
+    }
+#else
+    (void)useSimd;
+#endif
+
+    for (i = 0; i < count; i++) {
+        keccak_digest_init(&S, bits);
+        keccak_digest_update(&S, inputs[i], lengths[i]);
+        keccak_digest_sum(&S, out + i*(bits/8), bits/8);
+    }
+
+    return 0;
+}
@@ -0,0 +1,63 @@
+/*
+    Hash - sha3_many.h
+
+    Batch hashing of many independent messages with SHA3.  On x86_64
+    cpus with AVX2, the messages are absorbed four at a time, one
+    message per 64-bit lane of a four way Keccak-f[1600].
+
+    History:
+
+    v. 1.0.0 (10/18/2026) - Initial version
+
+    Copyright (c) 2026 Sriranga R. Veeraraghavan <ranga@calalum.org>
+
+    Permission is hereby granted, free of charge, to any person obtaining
+    a copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+    OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef sha3_many_h
+#define sha3_many_h
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+    sha3_many - hash count messages (inputs[i], which is lengths[i] bytes
+                long) with SHA3-(bits), bits is 224, 256, 384 or 512,
+                writing bits/8 bytes of digest for each message to
+                out + i*bits/8.  If useSimd is 0, or the cpu doesn't
+                support AVX2, the messages are hashed one at a time.
+                returns 0 on success, or -1 if bits isn't supported.
+ */
+
+int sha3_many(const uint8_t *const *inputs,
+              const size_t *lengths,
+              size_t count,
+              uint8_t *out,
+              size_t bits,
+              int useSimd);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* sha3_many_h */
@@ -320,6 +320,31 @@ enum
 #define SKEIN1024_ROUNDS_TOTAL (8*((((SKEIN_ROUNDS    ) + 5) % 10) + 5))
 #endif
 
+/*****************************************************************
+** srv 2026-10-18 - Skein block functions for SKEIN_LANES messages
+**    at once (see skein_block.c), used for the leaves of a tree
+**    hash.  X[i][l] is state word i of lane l, T0[l] is the
+**    position tweak word of lane l, T1 is the other tweak word,
+**    which is the same for all lanes.  Each lane processes blkCnt
+**    blocks starting at blkPtr[l].  Return 1 if the blocks were
+**    processed, or 0 if no SIMD implementation is enabled, in
+**    which case the caller processes the lanes one at a time.
+******************************************************************/
+#define SKEIN_LANES             (8)
+
+int  Skein_256_Process_Lanes(u64b_t X[SKEIN_256_STATE_WORDS][SKEIN_LANES], u64b_t T0[SKEIN_LANES], u64b_t T1,
+                             const u08b_t *const blkPtr[SKEIN_LANES], size_t blkCnt, size_t byteCntAdd);
+int  Skein_512_Process_Lanes(u64b_t X[SKEIN_512_STATE_WORDS][SKEIN_LANES], u64b_t T0[SKEIN_LANES], u64b_t T1,
+                             const u08b_t *const blkPtr[SKEIN_LANES], size_t blkCnt, size_t byteCntAdd);
+int  Skein1024_Process_Lanes(u64b_t X[SKEIN1024_STATE_WORDS][SKEIN_LANES], u64b_t T0[SKEIN_LANES], u64b_t T1,
+                             const u08b_t *const blkPtr[SKEIN_LANES], size_t blkCnt, size_t byteCntAdd);
+
+int  Skein_Lanes_Enabled(void);                 /* 1 if the lane functions are available */
+const char *Skein_Lanes_Implementation(void);   /* "avx512f", "avx2" or "portable" */
+void Skein_Use_AVX2(int enable);                /* allow (1, the default) or disallow (0) */
+void Skein_Use_AVX512(int enable);              /*   an implementation, for benchmarking */
+
+
 #ifdef __cplusplus
 }
 #endif
@@ -702,3 +702,232 @@ uint_t Skein1024_Unroll_Cnt(void)
     }
 #endif
 #endif
+
+/*****************************************************************
+** srv 2026-10-18 - Threefish for several messages at once
+**
+** The rounds of one Threefish block depend on each other, so a single
+** message gets little from SIMD.  The leaves of a Skein tree (see
+** skein_tree.c) are independent messages, so eight of them are hashed
+** at once, with each state word held in a vector of eight lanes.  The
+** AVX2 and AVX-512 versions are the same C code (skein_block_lanes.h),
+** built for each instruction set with target pragmas.
+******************************************************************/
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__)) && !defined(SKEIN_ROUNDS)
+
+#define SKEIN_LANES_X86 1
+
+typedef u64b_t Skein_Lanes_t __attribute__((vector_size(8*SKEIN_LANES)));
+
+#undef  ks                                      /* the lane code uses arrays */
+#undef  ts
+
+#define LI256(R)                                                            \
+    X0   += ks[((R)+1) % 5];                                                \
+    X1   += ks[((R)+2) % 5] + ts[((R)+1) % 3];                              \
+    X2   += ks[((R)+3) % 5] + ts[((R)+2) % 3];                              \
+    X3   += ks[((R)+4) % 5] + (u64b_t) ((R)+1);
+
+#define LR256_8_rounds(R)                                                   \
+    Round256(0,1,2,3,R_256_0,0) Round256(0,3,2,1,R_256_1,0)                 \
+    Round256(0,1,2,3,R_256_2,0) Round256(0,3,2,1,R_256_3,0)                 \
+    LI256(2*(R))                                                            \
+    Round256(0,1,2,3,R_256_4,0) Round256(0,3,2,1,R_256_5,0)                 \
+    Round256(0,1,2,3,R_256_6,0) Round256(0,3,2,1,R_256_7,0)                 \
+    LI256(2*(R)+1)
+
+#define LI512(R)                                                            \
+    X0   += ks[((R)+1) % 9];                                                \
+    X1   += ks[((R)+2) % 9];                                                \
+    X2   += ks[((R)+3) % 9];                                                \
+    X3   += ks[((R)+4) % 9];                                                \
+    X4   += ks[((R)+5) % 9];                                                \
+    X5   += ks[((R)+6) % 9] + ts[((R)+1) % 3];                              \
+    X6   += ks[((R)+7) % 9] + ts[((R)+2) % 3];                              \
+    X7   += ks[((R)+8) % 9] + (u64b_t) ((R)+1);
+
+#define LR512_8_rounds(R)                                                   \
+    Round512(0,1,2,3,4,5,6,7,R_512_0,0) Round512(2,1,4,7,6,5,0,3,R_512_1,0) \
+    Round512(4,1,6,3,0,5,2,7,R_512_2,0) Round512(6,1,0,7,2,5,4,3,R_512_3,0) \
+    LI512(2*(R))                                                            \
+    Round512(0,1,2,3,4,5,6,7,R_512_4,0) Round512(2,1,4,7,6,5,0,3,R_512_5,0) \
+    Round512(4,1,6,3,0,5,2,7,R_512_6,0) Round512(6,1,0,7,2,5,4,3,R_512_7,0) \
+    LI512(2*(R)+1)
+
+#define LI1024(R)                                                           \
+    X00  += ks[((R)+ 1) % 17];                                              \
+    X01  += ks[((R)+ 2) % 17];                                              \
+    X02  += ks[((R)+ 3) % 17];                                              \
+    X03  += ks[((R)+ 4) % 17];                                              \
+    X04  += ks[((R)+ 5) % 17];                                              \
+    X05  += ks[((R)+ 6) % 17];                                              \
+    X06  += ks[((R)+ 7) % 17];                                              \
+    X07  += ks[((R)+ 8) % 17];                                              \
+    X08  += ks[((R)+ 9) % 17];                                              \
+    X09  += ks[((R)+10) % 17];                                              \
+    X10  += ks[((R)+11) % 17];                                              \
+    X11  += ks[((R)+12) % 17];                                              \
+    X12  += ks[((R)+13) % 17];                                              \
+    X13  += ks[((R)+14) % 17] + ts[((R)+1) % 3];                            \
+    X14  += ks[((R)+15) % 17] + ts[((R)+2) % 3];                            \
+    X15  += ks[((R)+16) % 17] + (u64b_t) ((R)+1);
+
+#define LR1024_8_rounds(R)                                                  \
+    Round1024(00,01,02,03,04,05,06,07,08,09,10,11,12,13,14,15,R1024_0,0)    \
+    Round1024(00,09,02,13,06,11,04,15,10,07,12,03,14,05,08,01,R1024_1,0)    \
+    Round1024(00,07,02,05,04,03,06,01,12,15,14,13,08,11,10,09,R1024_2,0)    \
+    Round1024(00,15,02,11,06,13,04,09,14,01,08,05,10,03,12,07,R1024_3,0)    \
+    LI1024(2*(R))                                                           \
+    Round1024(00,01,02,03,04,05,06,07,08,09,10,11,12,13,14,15,R1024_4,0)    \
+    Round1024(00,09,02,13,06,11,04,15,10,07,12,03,14,05,08,01,R1024_5,0)    \
+    Round1024(00,07,02,05,04,03,06,01,12,15,14,13,08,11,10,09,R1024_6,0)    \
+    Round1024(00,15,02,11,06,13,04,09,14,01,08,05,10,03,12,07,R1024_7,0)    \
+    LI1024(2*(R)+1)
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("avx2"))), apply_to = function)
+#else
+#pragma GCC push_options
+#pragma GCC target("avx2")
+#endif
+
+#define SKEIN_LANES_NAME(f) f##_AVX2
+#include "skein_block_lanes.h"
+#undef  SKEIN_LANES_NAME
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#else
+#pragma GCC pop_options
+#endif
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("avx512f"))), apply_to = function)
+#else
+#pragma GCC push_options
+#pragma GCC target("avx512f")
+#endif
+
+#define SKEIN_LANES_NAME(f) f##_AVX512
+#include "skein_block_lanes.h"
+#undef  SKEIN_LANES_NAME
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#else
+#pragma GCC pop_options
+#endif
+
+#endif /* __x86_64__ && (__GNUC__ || __clang__) && !SKEIN_ROUNDS */
+
+typedef void (*Skein_256_Lanes_Fn)(u64b_t X[SKEIN_256_STATE_WORDS][SKEIN_LANES],u64b_t T0[SKEIN_LANES],u64b_t T1,
+                                   const u08b_t *const blkPtr[SKEIN_LANES],size_t blkCnt,size_t byteCntAdd);
+typedef void (*Skein_512_Lanes_Fn)(u64b_t X[SKEIN_512_STATE_WORDS][SKEIN_LANES],u64b_t T0[SKEIN_LANES],u64b_t T1,
+                                   const u08b_t *const blkPtr[SKEIN_LANES],size_t blkCnt,size_t byteCntAdd);
+typedef void (*Skein1024_Lanes_Fn)(u64b_t X[SKEIN1024_STATE_WORDS][SKEIN_LANES],u64b_t T0[SKEIN_LANES],u64b_t T1,
+                                   const u08b_t *const blkPtr[SKEIN_LANES],size_t blkCnt,size_t byteCntAdd);
+
+static int                 gSkeinAllowAVX2   = 1;
+static int                 gSkeinAllowAVX512 = 1;
+static int                 gSkeinSelected    = 0;
+static Skein_256_Lanes_Fn  gSkein256Lanes    = NULL;
+static Skein_512_Lanes_Fn  gSkein512Lanes    = NULL;
+static Skein1024_Lanes_Fn  gSkein1024Lanes   = NULL;
+static const char         *gSkeinLanesImpl   = "portable";
+
+/* pick the lane functions, NULL means one message at a time */
+static void Skein_Lanes_Select(void)
+    {
+    gSkein256Lanes  = NULL;
+    gSkein512Lanes  = NULL;
+    gSkein1024Lanes = NULL;
+    gSkeinLanesImpl = "portable";
+
+#if defined(SKEIN_LANES_X86)
+    if (gSkeinAllowAVX2 && __builtin_cpu_supports("avx2"))
+        {
+        gSkein256Lanes  = Skein_256_Lanes_AVX2;
+        gSkein512Lanes  = Skein_512_Lanes_AVX2;
+        gSkein1024Lanes = Skein1024_Lanes_AVX2;
+        gSkeinLanesImpl = "avx2";
+        }
+    if (gSkeinAllowAVX512 && __builtin_cpu_supports("avx512f"))
+        {
+        gSkein256Lanes  = Skein_256_Lanes_AVX512;
+        gSkein512Lanes  = Skein_512_Lanes_AVX512;
+        gSkein1024Lanes = Skein1024_Lanes_AVX512;
+        gSkeinLanesImpl = "avx512f";
+        }
+#endif
+
+    gSkeinSelected = 1;
+    }
+
+int Skein_256_Process_Lanes(u64b_t X[SKEIN_256_STATE_WORDS][SKEIN_LANES],u64b_t T0[SKEIN_LANES],u64b_t T1,
+                            const u08b_t *const blkPtr[SKEIN_LANES],size_t blkCnt,size_t byteCntAdd)
+    {
+    Skein_256_Lanes_Fn fn;
+
+    if (!gSkeinSelected)
+        Skein_Lanes_Select();
+    fn = gSkein256Lanes;
+    if (fn == NULL || blkCnt == 0)
+        return 0;
+    fn(X,T0,T1,blkPtr,blkCnt,byteCntAdd);
+    return 1;
+    }
+
+int Skein_512_Process_Lanes(u64b_t X[SKEIN_512_STATE_WORDS][SKEIN_LANES],u64b_t T0[SKEIN_LANES],u64b_t T1,
+                            const u08b_t *const blkPtr[SKEIN_LANES],size_t blkCnt,size_t byteCntAdd)
+    {
+    Skein_512_Lanes_Fn fn;
+
+    if (!gSkeinSelected)
+        Skein_Lanes_Select();
+    fn = gSkein512Lanes;
+    if (fn == NULL || blkCnt == 0)
+        return 0;
+    fn(X,T0,T1,blkPtr,blkCnt,byteCntAdd);
+    return 1;
+    }
+
+int Skein1024_Process_Lanes(u64b_t X[SKEIN1024_STATE_WORDS][SKEIN_LANES],u64b_t T0[SKEIN_LANES],u64b_t T1,
+                            const u08b_t *const blkPtr[SKEIN_LANES],size_t blkCnt,size_t byteCntAdd)
+    {
+    Skein1024_Lanes_Fn fn;
+
+    if (!gSkeinSelected)
+        Skein_Lanes_Select();
+    fn = gSkein1024Lanes;
+    if (fn == NULL || blkCnt == 0)
+        return 0;
+    fn(X,T0,T1,blkPtr,blkCnt,byteCntAdd);
+    return 1;
+    }
+
+int Skein_Lanes_Enabled(void)
+    {
+    if (!gSkeinSelected)
+        Skein_Lanes_Select();
+    return (gSkein512Lanes != NULL);
+    }
+
+const char *Skein_Lanes_Implementation(void)
+    {
+    if (!gSkeinSelected)
+        Skein_Lanes_Select();
+    return gSkeinLanesImpl;
+    }
+
+void Skein_Use_AVX2(int enable)
+    {
+    gSkeinAllowAVX2 = (enable != 0);
+    Skein_Lanes_Select();
+    }
+
+void Skein_Use_AVX512(int enable)
+    {
+    gSkeinAllowAVX512 = (enable != 0);
+    Skein_Lanes_Select();
+    }
@@ -0,0 +1,208 @@
+/***********************************************************************
+**
+** Skein block functions for SKEIN_LANES independent messages at once.
+**
+** srv 2026-10-18 - included by skein_block.c once for each instruction
+** set, with SKEIN_LANES_NAME() defined to give the functions unique
+** names.  Each state word is a Skein_Lanes_t vector holding that word
+** for every lane, so the rounds are the Round256/512/1024 macros above,
+** run on vectors.  The block of lane l is at blkPtr[l] + the offset of
+** the block, the tweaks only differ in T0 (the position of the block).
+**
+************************************************************************/
+
+/* word i of each lane's block, for the WCNT words of the block at off */
+static void SKEIN_LANES_NAME(Skein_Lanes_Get)(Skein_Lanes_t *w,const u08b_t *const blkPtr[SKEIN_LANES],size_t off,size_t wCnt)
+    {
+    u64b_t  t[SKEIN_LANES];
+    size_t  i,l;
+
+    for (i=0;i<wCnt;i++)
+        {
+        for (l=0;l<SKEIN_LANES;l++)
+            memcpy(&t[l],blkPtr[l]+off+8*i,sizeof(t[l]));
+        memcpy(&w[i],t,sizeof(w[i]));
+        }
+    }
+
+/*****************************  Skein_256 ******************************/
+static void SKEIN_LANES_NAME(Skein_256_Lanes)(u64b_t Xw[SKEIN_256_STATE_WORDS][SKEIN_LANES],u64b_t T0[SKEIN_LANES],u64b_t T1,
+                                              const u08b_t *const blkPtr[SKEIN_LANES],size_t blkCnt,size_t byteCntAdd)
+    {
+    enum
+        {
+        WCNT = SKEIN_256_STATE_WORDS
+        };
+    Skein_Lanes_t  X0,X1,X2,X3;
+    Skein_Lanes_t  ks[WCNT+1],ts[3],w[WCNT];
+    size_t         i,off = 0;
+
+    for (i=0;i<WCNT;i++)
+        memcpy(&ks[i],Xw[i],sizeof(ks[i]));
+    memcpy(&ts[0],T0,sizeof(ts[0]));
+
+    do  {
+        ts[0] += byteCntAdd;
+        ts[1]  = (Skein_Lanes_t){ 0 } + T1;
+        ts[2]  = ts[0] ^ ts[1];
+        ks[4]  = ks[0] ^ ks[1] ^ ks[2] ^ ks[3] ^ SKEIN_KS_PARITY;
+
+        SKEIN_LANES_NAME(Skein_Lanes_Get)(w,blkPtr,off,WCNT);
+
+        X0 = w[0] + ks[0];
+        X1 = w[1] + ks[1] + ts[0];
+        X2 = w[2] + ks[2] + ts[1];
+        X3 = w[3] + ks[3];
+
+        LR256_8_rounds(0); LR256_8_rounds(1); LR256_8_rounds(2);
+        LR256_8_rounds(3); LR256_8_rounds(4); LR256_8_rounds(5);
+        LR256_8_rounds(6); LR256_8_rounds(7); LR256_8_rounds(8);
+
+        ks[0] = X0 ^ w[0];
+        ks[1] = X1 ^ w[1];
+        ks[2] = X2 ^ w[2];
+        ks[3] = X3 ^ w[3];
+
+        T1  &= ~SKEIN_T1_FLAG_FIRST;
+        off += SKEIN_256_BLOCK_BYTES;
+        }
+    while (--blkCnt);
+
+    for (i=0;i<WCNT;i++)
+        memcpy(Xw[i],&ks[i],sizeof(ks[i]));
+    memcpy(T0,&ts[0],sizeof(ts[0]));
+    }
+
+/*****************************  Skein_512 ******************************/
+static void SKEIN_LANES_NAME(Skein_512_Lanes)(u64b_t Xw[SKEIN_512_STATE_WORDS][SKEIN_LANES],u64b_t T0[SKEIN_LANES],u64b_t T1,
+                                              const u08b_t *const blkPtr[SKEIN_LANES],size_t blkCnt,size_t byteCntAdd)
+    {
+    enum
+        {
+        WCNT = SKEIN_512_STATE_WORDS
+        };
+    Skein_Lanes_t  X0,X1,X2,X3,X4,X5,X6,X7;
+    Skein_Lanes_t  ks[WCNT+1],ts[3],w[WCNT];
+    size_t         i,off = 0;
+
+    for (i=0;i<WCNT;i++)
+        memcpy(&ks[i],Xw[i],sizeof(ks[i]));
+    memcpy(&ts[0],T0,sizeof(ts[0]));
+
+    do  {
+        ts[0] += byteCntAdd;
+        ts[1]  = (Skein_Lanes_t){ 0 } + T1;
+        ts[2]  = ts[0] ^ ts[1];
+        ks[8]  = ks[0] ^ ks[1] ^ ks[2] ^ ks[3] ^
+                 ks[4] ^ ks[5] ^ ks[6] ^ ks[7] ^ SKEIN_KS_PARITY;
+
+        SKEIN_LANES_NAME(Skein_Lanes_Get)(w,blkPtr,off,WCNT);
+
+        X0 = w[0] + ks[0];
+        X1 = w[1] + ks[1];
+        X2 = w[2] + ks[2];
+        X3 = w[3] + ks[3];
+        X4 = w[4] + ks[4];
+        X5 = w[5] + ks[5] + ts[0];
+        X6 = w[6] + ks[6] + ts[1];
+        X7 = w[7] + ks[7];
+
+        LR512_8_rounds(0); LR512_8_rounds(1); LR512_8_rounds(2);
+        LR512_8_rounds(3); LR512_8_rounds(4); LR512_8_rounds(5);
+        LR512_8_rounds(6); LR512_8_rounds(7); LR512_8_rounds(8);
+
+        ks[0] = X0 ^ w[0];
+        ks[1] = X1 ^ w[1];
+        ks[2] = X2 ^ w[2];
+        ks[3] = X3 ^ w[3];
+        ks[4] = X4 ^ w[4];
+        ks[5] = X5 ^ w[5];
+        ks[6] = X6 ^ w[6];
+        ks[7] = X7 ^ w[7];
+
+        T1  &= ~SKEIN_T1_FLAG_FIRST;
+        off += SKEIN_512_BLOCK_BYTES;
+        }
+    while (--blkCnt);
+
+    for (i=0;i<WCNT;i++)
+        memcpy(Xw[i],&ks[i],sizeof(ks[i]));
+    memcpy(T0,&ts[0],sizeof(ts[0]));
+    }
+
+/*****************************  Skein1024 ******************************/
+static void SKEIN_LANES_NAME(Skein1024_Lanes)(u64b_t Xw[SKEIN1024_STATE_WORDS][SKEIN_LANES],u64b_t T0[SKEIN_LANES],u64b_t T1,
+                                              const u08b_t *const blkPtr[SKEIN_LANES],size_t blkCnt,size_t byteCntAdd)
+    {
+    enum
+        {
+        WCNT = SKEIN1024_STATE_WORDS
+        };
+    Skein_Lanes_t  X00,X01,X02,X03,X04,X05,X06,X07,
+                   X08,X09,X10,X11,X12,X13,X14,X15;
+    Skein_Lanes_t  ks[WCNT+1],ts[3],w[WCNT];
+    size_t         i,off = 0;
+
+    for (i=0;i<WCNT;i++)
+        memcpy(&ks[i],Xw[i],sizeof(ks[i]));
+    memcpy(&ts[0],T0,sizeof(ts[0]));
+
+    do  {
+        ts[0] += byteCntAdd;
+        ts[1]  = (Skein_Lanes_t){ 0 } + T1;
+        ts[2]  = ts[0] ^ ts[1];
+        ks[16] = ks[ 0] ^ ks[ 1] ^ ks[ 2] ^ ks[ 3] ^
+                 ks[ 4] ^ ks[ 5] ^ ks[ 6] ^ ks[ 7] ^
+                 ks[ 8] ^ ks[ 9] ^ ks[10] ^ ks[11] ^
+                 ks[12] ^ ks[13] ^ ks[14] ^ ks[15] ^ SKEIN_KS_PARITY;
+
+        SKEIN_LANES_NAME(Skein_Lanes_Get)(w,blkPtr,off,WCNT);
+
+        X00 = w[ 0] + ks[ 0];
+        X01 = w[ 1] + ks[ 1];
+        X02 = w[ 2] + ks[ 2];
+        X03 = w[ 3] + ks[ 3];
+        X04 = w[ 4] + ks[ 4];
+        X05 = w[ 5] + ks[ 5];
+        X06 = w[ 6] + ks[ 6];
+        X07 = w[ 7] + ks[ 7];
+        X08 = w[ 8] + ks[ 8];
+        X09 = w[ 9] + ks[ 9];
+        X10 = w[10] + ks[10];
+        X11 = w[11] + ks[11];
+        X12 = w[12] + ks[12];
+        X13 = w[13] + ks[13] + ts[0];
+        X14 = w[14] + ks[14] + ts[1];
+        X15 = w[15] + ks[15];
+
+        LR1024_8_rounds(0); LR1024_8_rounds(1); LR1024_8_rounds(2);
+        LR1024_8_rounds(3); LR1024_8_rounds(4); LR1024_8_rounds(5);
+        LR1024_8_rounds(6); LR1024_8_rounds(7); LR1024_8_rounds(8);
+        LR1024_8_rounds(9);
+
+        ks[ 0] = X00 ^ w[ 0];
+        ks[ 1] = X01 ^ w[ 1];
+        ks[ 2] = X02 ^ w[ 2];
+        ks[ 3] = X03 ^ w[ 3];
+        ks[ 4] = X04 ^ w[ 4];
+        ks[ 5] = X05 ^ w[ 5];
+        ks[ 6] = X06 ^ w[ 6];
+        ks[ 7] = X07 ^ w[ 7];
+        ks[ 8] = X08 ^ w[ 8];
+        ks[ 9] = X09 ^ w[ 9];
+        ks[10] = X10 ^ w[10];
+        ks[11] = X11 ^ w[11];
+        ks[12] = X12 ^ w[12];
+        ks[13] = X13 ^ w[13];
+        ks[14] = X14 ^ w[14];
+        ks[15] = X15 ^ w[15];
+
+        T1  &= ~SKEIN_T1_FLAG_FIRST;
+        off += SKEIN1024_BLOCK_BYTES;
+        }
+    while (--blkCnt);
+
+    for (i=0;i<WCNT;i++)
+        memcpy(Xw[i],&ks[i],sizeof(ks[i]));
+    memcpy(T0,&ts[0],sizeof(ts[0]));
+    }
@@ -0,0 +1,494 @@
+/*
+    Hash - skein_tree.c
+
+    History:
+
+    v. 1.0.0 (10/18/2026) - Initial version
+
+    Copyright (c) 2026 Sriranga R. Veeraraghavan <ranga@calalum.org>
+
+    Permission is hereby granted, free of charge, to any person obtaining
+    a copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+    OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "skein.h"
+#include "skein_tree.h"
+
+#if !defined(_WIN32) && !defined(SKEIN_NO_PTHREADS)
+#define SKEIN_TREE_THREADS 1
+#include "hash_threads.h"
+#endif
+
+/*
+    The tree is built bottom up as the leaves complete: each output is
+    pushed into its level, where it is hashed into the node being
+    filled.  A full node is finalized and its output pushed one level
+    up.  The only exception is the level below maxLevel, whose outputs
+    all go into a single node, however long.  The final call flushes
+    the partial nodes from the bottom up, and the level that has only
+    one output left is the root.
+ */
+
+enum {
+    SKEIN_TREE_THREAD_MIN  = 524288,    /* bytes of leaves per thread */
+    SKEIN_TREE_BATCH_BYTES = 1048576,   /* leaf outputs per threaded batch */
+};
+
+/* per state size wrappers around the Skein API */
+
+static void skein_tree_ctx_update(skein_tree_ctx *ctx,
+                                  size_t blockBytes,
+                                  const u08b_t *msg,
+                                  size_t msgByteCnt)
+{
+    switch (blockBytes) {
+        case SKEIN_256_BLOCK_BYTES:
+            Skein_256_Update(&ctx->c256, msg, msgByteCnt);
+            break;
+        case SKEIN_512_BLOCK_BYTES:
+            Skein_512_Update(&ctx->c512, msg, msgByteCnt);
+            break;
+        default:
+            Skein1024_Update(&ctx->c1024, msg, msgByteCnt);
+            break;
+    }
+}
+
+static void skein_tree_ctx_final(skein_tree_ctx *ctx,
+                                 size_t blockBytes,
+                                 u08b_t *out)
+{
+    switch (blockBytes) {
+        case SKEIN_256_BLOCK_BYTES:
+            Skein_256_Final_Pad(&ctx->c256, out);
+            break;
+        case SKEIN_512_BLOCK_BYTES:
+            Skein_512_Final_Pad(&ctx->c512, out);
+            break;
+        default:
+            Skein1024_Final_Pad(&ctx->c1024, out);
+            break;
+    }
+}
+
+/* the chaining variables of a context */
+
+static u64b_t *skein_tree_ctx_words(skein_tree_ctx *ctx, size_t blockBytes)
+{
+    switch (blockBytes) {
+        case SKEIN_256_BLOCK_BYTES:
+            return ctx->c256.X;
+        case SKEIN_512_BLOCK_BYTES:
+            return ctx->c512.X;
+        default:
+            return ctx->c1024.X;
+    }
+}
+
+/*
+    skein_tree_ctx_start - start a UBI call at tree level treeLevel
+                           whose first byte is at position pos in the
+                           level's input
+ */
+
+static void skein_tree_ctx_start(const skein_tree_state *S,
+                                 skein_tree_ctx *ctx,
+                                 u64b_t pos,
+                                 unsigned int treeLevel)
+{
+    memcpy(ctx, &S->cfg, sizeof(*ctx));
+    ctx->h.T[0] = pos;
+    Skein_Set_Tree_Level(ctx->h, treeLevel);
+}
+
+/*
+    skein_tree_leaves - hash count complete leaves, the first of which
+                        is leaf first, writing each leaf's output to
+                        out.  Groups of SKEIN_LANES leaves are hashed
+                        in the SIMD lanes when they are enabled.
+ */
+
+static void skein_tree_leaves(skein_tree_state *S,
+                              const u08b_t *msg,
+                              u64b_t first,
+                              size_t count,
+                              u08b_t *out)
+{
+    const size_t wordCnt = S->blockBytes / 8;
+    const size_t blkCnt = S->leafBytes / S->blockBytes;
+    u64b_t X[SKEIN_MAX_STATE_WORDS][SKEIN_LANES];
+    u64b_t T0[SKEIN_LANES];
+    u64b_t T1 = 0;
+    u64b_t words[SKEIN_MAX_STATE_WORDS];
+    const u08b_t *blkPtr[SKEIN_LANES];
+    const u64b_t *cv = skein_tree_ctx_words(&S->cfg, S->blockBytes);
+    skein_tree_ctx ctx;
+    size_t i = 0, l = 0;
+    int ok = 0;
+
+    for ( ; count >= SKEIN_LANES && Skein_Lanes_Enabled();
+          count -= SKEIN_LANES) {
+        for (l = 0; l < SKEIN_LANES; l++) {
+            for (i = 0; i < wordCnt; i++) {
+                X[i][l] = cv[i];
+            }
+            T0[l] = (first + l) * S->leafBytes;
+            blkPtr[l] = msg + l * S->leafBytes;
+        }
+
+        // leaves are at least two blocks long, all but the last block
+        // go in one call, the last block sets the final flag
+
+        T1 = S->cfg.h.T[1] | SKEIN_T1_TREE_LEVEL(1);
+        switch (S->blockBytes) {
+            case SKEIN_256_BLOCK_BYTES:
+                ok = Skein_256_Process_Lanes(X, T0, T1, blkPtr,
+                                             blkCnt - 1, S->blockBytes);
+                break;
+            case SKEIN_512_BLOCK_BYTES:
+                ok = Skein_512_Process_Lanes(X, T0, T1, blkPtr,
+                                             blkCnt - 1, S->blockBytes);
+                break;
+            default:
+                ok = Skein1024_Process_Lanes(X, T0, T1, blkPtr,
+                                             blkCnt - 1, S->blockBytes);
+                break;
+        }
+        if (!ok) {
+            break;
+        }
+
+        T1 = (T1 & ~SKEIN_T1_FLAG_FIRST) | SKEIN_T1_FLAG_FINAL;
+        for (l = 0; l < SKEIN_LANES; l++) {
+            blkPtr[l] += (blkCnt - 1) * S->blockBytes;
+        }
+        switch (S->blockBytes) {
+            case SKEIN_256_BLOCK_BYTES:
+                Skein_256_Process_Lanes(X, T0, T1, blkPtr,
+                                        1, S->blockBytes);
+                break;
+            case SKEIN_512_BLOCK_BYTES:
+                Skein_512_Process_Lanes(X, T0, T1, blkPtr,
+                                        1, S->blockBytes);
+                break;
+            default:
+                Skein1024_Process_Lanes(X, T0, T1, blkPtr,
+                                        1, S->blockBytes);
+                break;
+        }
+
+        for (l = 0; l < SKEIN_LANES; l++) {
+            for (i = 0; i < wordCnt; i++) {
+                words[i] = X[i][l];
+            }
+            Skein_Put64_LSB_First(out, words, S->blockBytes);
+            out += S->blockBytes;
+        }
+        msg += SKEIN_LANES * S->leafBytes;
+        first += SKEIN_LANES;
+    }
+
+    for ( ; count > 0; count--) {
+        skein_tree_ctx_start(S, &ctx, first * S->leafBytes, 1);
+        skein_tree_ctx_update(&ctx, S->blockBytes, msg, S->leafBytes);
+        skein_tree_ctx_final(&ctx, S->blockBytes, out);
+        msg += S->leafBytes;
+        out += S->blockBytes;
+        first++;
+    }
+}
+
+/*
+    skein_tree_push - add an output (blockBytes long) to level l, which
+                      is hashed at tree level l + 1
+ */
+
+static void skein_tree_push(skein_tree_state *S,
+                            unsigned int l,
+                            const u08b_t *out)
+{
+    skein_tree_level *lvl = NULL;
+    u08b_t nodeOut[SKEIN1024_STATE_BYTES];
+
+    for (;;) {
+        lvl = &S->level[l];
+        if (l >= S->levels) {
+            S->levels = l + 1;
+        }
+        if (lvl->count == 0) {
+            memcpy(lvl->first, out, S->blockBytes);
+        }
+        lvl->count++;
+
+        if (lvl->nodeFill == 0) {
+            skein_tree_ctx_start(S, &lvl->node,
+                                 lvl->nodeIndex * S->nodeBytes,
+                                 l + 2);
+        }
+        skein_tree_ctx_update(&lvl->node, S->blockBytes, out, S->blockBytes);
+        lvl->nodeFill += S->blockBytes;
+
+        // the level below maxLevel has a single node of any length
+
+        if (l + 2 == S->maxLevel || lvl->nodeFill < S->nodeBytes) {
+            return;
+        }
+
+        skein_tree_ctx_final(&lvl->node, S->blockBytes, nodeOut);
+        lvl->nodeFill = 0;
+        lvl->nodeIndex++;
+        out = nodeOut;
+        l++;
+    }
+}
+
+#if defined(SKEIN_TREE_THREADS)
+
+typedef struct skeinTreeJob {
+    skein_tree_state *S;
+    const u08b_t *msg;
+    u64b_t first;
+    size_t count;
+    u08b_t *out;
+} skeinTreeJob;
+
+static void skein_tree_job(void *arg, size_t index)
+{
+    skeinTreeJob *job = (skeinTreeJob *)arg + index;
+
+    skein_tree_leaves(job->S, job->msg, job->first, job->count, job->out);
+}
+
+/*
+    skein_tree_leaves_threaded - hash count complete leaves, split into
+                                 one range per thread.  Returns the
+                                 number of leaves hashed, 0 if there
+                                 are too few leaves for more than one
+                                 thread.
+ */
+
+static size_t skein_tree_leaves_threaded(skein_tree_state *S,
+                                         const u08b_t *msg,
+                                         size_t count)
+{
+    skeinTreeJob jobs[HASH_THREADS_MAX];
+    size_t batch = SKEIN_TREE_BATCH_BYTES / S->blockBytes;
+    size_t threadCount = 0, i = 0, leaf = 0;
+    u08b_t *out = NULL;
+
+    if (count > batch) {
+        count = batch;
+    }
+    threadCount = hash_threads_count((unsigned long long)count * S->leafBytes,
+                                     SKEIN_TREE_THREAD_MIN,
+                                     count);
+    if (threadCount < 2) {
+        return 0;
+    }
+
+    out = (u08b_t *)malloc(count * S->blockBytes);
+    if (out == NULL) {
+        return 0;
+    }
+
+    for (i = 0; i < threadCount; i++) {
+        jobs[i].S = S;
+        jobs[i].count = count / threadCount +
+                        (i < count % threadCount ? 1 : 0);
+        jobs[i].first = S->leafIndex + leaf;
+        jobs[i].msg = msg + leaf * S->leafBytes;
+        jobs[i].out = out + leaf * S->blockBytes;
+        leaf += jobs[i].count;
+    }
+
+    hash_threads_run(threadCount, skein_tree_job, jobs);
+
+    for (i = 0; i < count; i++) {
+        skein_tree_push(S, 0, out + i * S->blockBytes);
+    }
+    S->leafIndex += count;
+    free(out);
+
+    return count;
+}
+
+#endif /* SKEIN_TREE_THREADS */
+
+int skein_tree_init(skein_tree_state *S,
+                    size_t stateBits,
+                    size_t hashBitLen,
+                    unsigned int leafLevel,
+                    unsigned int fanout,
+                    unsigned int maxLevel)
+{
+    u64b_t treeInfo = 0;
+    int err = SKEIN_FAIL;
+
+    if (S == NULL || hashBitLen == 0 ||
+        leafLevel < 1 || leafLevel > 32 ||
+        fanout < 1 || fanout > 32 ||
+        maxLevel < 2 || maxLevel > 255) {
+        return SKEIN_FAIL;
+    }
+
+    memset(S, 0, sizeof(*S));
+    treeInfo = SKEIN_CFG_TREE_INFO(leafLevel, fanout, maxLevel);
+
+    switch (stateBits) {
+        case 256:
+            err = Skein_256_InitExt(&S->cfg.c256, hashBitLen, treeInfo,
+                                    NULL, 0);
+            break;
+        case 512:
+            err = Skein_512_InitExt(&S->cfg.c512, hashBitLen, treeInfo,
+                                    NULL, 0);
+            break;
+        case 1024:
+            err = Skein1024_InitExt(&S->cfg.c1024, hashBitLen, treeInfo,
+                                    NULL, 0);
+            break;
+        default:
+            return SKEIN_FAIL;
+    }
+
+    S->blockBytes = stateBits / 8;
+    S->leafBytes = S->blockBytes << leafLevel;
+    S->nodeBytes = S->blockBytes << fanout;
+    S->maxLevel = maxLevel;
+
+    return err;
+}
+
+void skein_tree_update(skein_tree_state *S,
+                       const u08b_t *msg,
+                       size_t msgByteCnt)
+{
+    u08b_t out[SKEIN_LANES * SKEIN1024_STATE_BYTES];
+    size_t n = 0, i = 0;
+
+    while (msgByteCnt > 0) {
+
+        // fill the current leaf, it is finished once it is full since
+        // a leaf's output doesn't depend on whether it is the last
+
+        if (S->leafFill > 0 || msgByteCnt < S->leafBytes) {
+            if (S->leafFill == 0) {
+                skein_tree_ctx_start(S, &S->leaf,
+                                     S->leafIndex * S->leafBytes, 1);
+            }
+            n = S->leafBytes - S->leafFill;
+            if (n > msgByteCnt) {
+                n = msgByteCnt;
+            }
+            skein_tree_ctx_update(&S->leaf, S->blockBytes, msg, n);
+            S->leafFill += n;
+            msg += n;
+            msgByteCnt -= n;
+            if (S->leafFill == S->leafBytes) {
+                skein_tree_ctx_final(&S->leaf, S->blockBytes, out);
+                skein_tree_push(S, 0, out);
+                S->leafFill = 0;
+                S->leafIndex++;
+            }
+            continue;
+        }
+
+        // complete leaves straight from the input, on threads if
+        // there are enough of them, otherwise a group of lanes at a time
+
+#if defined(SKEIN_TREE_THREADS)
+        n = skein_tree_leaves_threaded(S, msg, msgByteCnt / S->leafBytes);
+        if (n > 0) {
+            msg += n * S->leafBytes;
+            msgByteCnt -= n * S->leafBytes;
+            continue;
+        }
+#endif
+        while (msgByteCnt >= S->leafBytes) {
+            n = msgByteCnt / S->leafBytes;
+            if (n > SKEIN_LANES) {
+                n = SKEIN_LANES;
+            }
+            skein_tree_leaves(S, msg, S->leafIndex, n, out);
+            for (i = 0; i < n; i++) {
+                skein_tree_push(S, 0, out + i * S->blockBytes);
+            }
+            S->leafIndex += n;
+            msg += n * S->leafBytes;
+            msgByteCnt -= n * S->leafBytes;
+        }
+    }
+}
+
+int skein_tree_final(skein_tree_state *S, u08b_t *hashVal)
+{
+    u08b_t out[SKEIN1024_STATE_BYTES];
+    skein_tree_level *lvl = NULL;
+    skein_tree_ctx ctx;
+    unsigned int l = 0;
+
+    // the last partial leaf, or an empty leaf for an empty message
+
+    if (S->leafFill > 0 || S->leafIndex == 0) {
+        if (S->leafFill == 0) {
+            skein_tree_ctx_start(S, &S->leaf, 0, 1);
+        }
+        skein_tree_ctx_final(&S->leaf, S->blockBytes, out);
+        skein_tree_push(S, 0, out);
+        S->leafFill = 0;
+        S->leafIndex++;
+    }
+
+    // flush the partial nodes until a level has a single output
+
+    for (l = 0; l < S->levels; l++) {
+        lvl = &S->level[l];
+        if (lvl->count == 1) {
+            memcpy(out, lvl->first, S->blockBytes);
+            break;
+        }
+        if (l + 2 == S->maxLevel) {
+            skein_tree_ctx_final(&lvl->node, S->blockBytes, out);
+            break;
+        }
+        if (lvl->nodeFill > 0) {
+            skein_tree_ctx_final(&lvl->node, S->blockBytes, out);
+            lvl->nodeFill = 0;
+            lvl->nodeIndex++;
+            skein_tree_push(S, l + 1, out);
+        }
+    }
+
+    // the output stage, keyed with the root
+
+    memcpy(&ctx, &S->cfg, sizeof(ctx));
+    Skein_Get64_LSB_First(skein_tree_ctx_words(&ctx, S->blockBytes),
+                          out,
+                          S->blockBytes / 8);
+    switch (S->blockBytes) {
+        case SKEIN_256_BLOCK_BYTES:
+            return Skein_256_Output(&ctx.c256, hashVal);
+        case SKEIN_512_BLOCK_BYTES:
+            return Skein_512_Output(&ctx.c512, hashVal);
+        default:
+            return Skein1024_Output(&ctx.c1024, hashVal);
+    }
+}
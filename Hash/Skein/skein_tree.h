@@ -0,0 +1,125 @@
+/*
+    Hash - skein_tree.h
+
+    Skein tree hashing (section 3.5.6 of the Skein 1.3 specification).
+    The message is split into leaves of blockBytes * 2^leafLevel bytes,
+    the outputs of each level are grouped into nodes of
+    blockBytes * 2^fanout bytes, and the tree is at most maxLevel levels
+    high.  Leaves are hashed as soon as they are complete, so the tree
+    is streamed with O(height) state.  Runs of complete leaves in one
+    update are hashed on several threads, and eight at a time in SIMD
+    lanes (see Skein_512_Process_Lanes).
+
+    History:
+
+    v. 1.0.0 (10/18/2026) - Initial version
+
+    Copyright (c) 2026 Sriranga R. Veeraraghavan <ranga@calalum.org>
+
+    Permission is hereby granted, free of charge, to any person obtaining
+    a copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+    OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef skein_tree_h
+#define skein_tree_h
+
+#include <stddef.h>
+
+#include "skein.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+    tree parameters used by the engine: 64KB leaves for every state size
+    (Y_l is 11, 10 and 9 for Skein-256, 512 and 1024, see hash_engine.c),
+    2^8 outputs per node (Y_f) and at most 255 levels (Y_m)
+ */
+
+enum {
+    SKEIN_TREE_DEFAULT_LEAF_BYTES = 65536,
+    SKEIN_TREE_DEFAULT_FANOUT     = 8,
+    SKEIN_TREE_DEFAULT_MAX_LEVEL  = 255,
+    SKEIN_TREE_MAX_LEVELS         = 64,
+};
+
+typedef union skein_tree_ctx {
+    Skein_Ctxt_Hdr_t h;
+    Skein_256_Ctxt_t c256;
+    Skein_512_Ctxt_t c512;
+    Skein1024_Ctxt_t c1024;
+} skein_tree_ctx;
+
+/* the chaining values pushed into one level of the tree */
+
+typedef struct skein_tree_level {
+    u64b_t          count;          /* outputs pushed into this level */
+    u64b_t          nodeIndex;      /* index of the node being filled */
+    size_t          nodeFill;       /* bytes in that node */
+    skein_tree_ctx  node;
+    u08b_t          first[SKEIN1024_STATE_BYTES];
+} skein_tree_level;
+
+/*
+    skein_tree_state - contains no pointers, so it may be copied.
+    level[0] holds the leaf outputs, which are hashed at tree level 1.
+ */
+
+typedef struct skein_tree_state {
+    size_t            blockBytes;
+    size_t            leafBytes;
+    size_t            nodeBytes;
+    unsigned int      maxLevel;
+    unsigned int      levels;       /* levels in use */
+    skein_tree_ctx    cfg;          /* the context after the config block */
+    skein_tree_ctx    leaf;         /* the leaf being filled */
+    u64b_t            leafIndex;
+    size_t            leafFill;
+    skein_tree_level  level[SKEIN_TREE_MAX_LEVELS];
+} skein_tree_state;
+
+/*
+    skein_tree_init - start a tree hash with a state size of stateBits
+                      (256, 512 or 1024), with hashBitLen bits of output.
+                      leafLevel (Y_l) and fanout (Y_f) must be at least
+                      1, and maxLevel (Y_m) between 2 and 255.  Returns
+                      SKEIN_SUCCESS, or SKEIN_FAIL if a parameter is out
+                      of range.
+ */
+
+int skein_tree_init(skein_tree_state *S,
+                    size_t stateBits,
+                    size_t hashBitLen,
+                    unsigned int leafLevel,
+                    unsigned int fanout,
+                    unsigned int maxLevel);
+
+void skein_tree_update(skein_tree_state *S,
+                       const u08b_t *msg,
+                       size_t msgByteCnt);
+
+/* write (hashBitLen + 7) / 8 bytes of output to hashVal */
+
+int skein_tree_final(skein_tree_state *S, u08b_t *hashVal);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* skein_tree_h */
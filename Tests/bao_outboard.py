@@ -0,0 +1,152 @@
+#!/usr/bin/env python3
+#
+# Hash - bao_outboard.py
+#
+# An independent implementation of BLAKE3 and of the Bao outboard
+# format (an 8 byte little endian content length followed by the
+# parent nodes of the tree in pre-order), written from the BLAKE3
+# paper and the Bao spec, that prints the outboard sizes and SHA256
+# digests used by test_bao.c.  If Python's blake3 module is installed,
+# the root hashes are checked against it.
+#
+# History:
+#
+# v. 1.0.0 (10/18/2026) - Initial version
+#
+# Copyright (c) 2026 Sriranga R. Veeraraghavan <ranga@calalum.org>
+#
+# Permission is hereby granted, free of charge, to any person obtaining
+# a copy of this software and associated documentation files (the "Software"),
+# to deal in the Software without restriction, including without limitation
+# the rights to use, copy, modify, merge, publish, distribute, sublicense,
+# and/or sell copies of the Software, and to permit persons to whom the
+# Software is furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included
+# in all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+# OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+# THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+# FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+# DEALINGS IN THE SOFTWARE.
+
+import hashlib
+import struct
+
+IV = [0x6A09E667, 0xBB67AE85, 0x3C6EF372, 0xA54FF53A,
+      0x510E527F, 0x9B05688C, 0x1F83D9AB, 0x5BE0CD19]
+PERMUTATION = [2, 6, 3, 10, 7, 0, 4, 13, 1, 11, 12, 5, 9, 14, 15, 8]
+
+CHUNK_START = 1
+CHUNK_END = 2
+PARENT = 4
+ROOT = 8
+
+CHUNK_LEN = 1024
+MASK = 0xffffffff
+
+# the lengths of the test messages, see test_bao.c
+
+LENGTHS = [0, 1, 1024, 1025, 2048, 3073, 100000]
+
+
+def rotr(x, n):
+    return ((x >> n) | (x << (32 - n))) & MASK
+
+
+def g(v, a, b, c, d, x, y):
+    v[a] = (v[a] + v[b] + x) & MASK
+    v[d] = rotr(v[d] ^ v[a], 16)
+    v[c] = (v[c] + v[d]) & MASK
+    v[b] = rotr(v[b] ^ v[c], 12)
+    v[a] = (v[a] + v[b] + y) & MASK
+    v[d] = rotr(v[d] ^ v[a], 8)
+    v[c] = (v[c] + v[d]) & MASK
+    v[b] = rotr(v[b] ^ v[c], 7)
+
+
+def compress(cv, block, blockLen, counter, flags):
+    m = list(struct.unpack('<16I', block.ljust(64, b'\0')))
+    v = cv[:] + IV[:4] + [counter & MASK, counter >> 32, blockLen, flags]
+    for _ in range(7):
+        g(v, 0, 4, 8, 12, m[0], m[1])
+        g(v, 1, 5, 9, 13, m[2], m[3])
+        g(v, 2, 6, 10, 14, m[4], m[5])
+        g(v, 3, 7, 11, 15, m[6], m[7])
+        g(v, 0, 5, 10, 15, m[8], m[9])
+        g(v, 1, 6, 11, 12, m[10], m[11])
+        g(v, 2, 7, 8, 13, m[12], m[13])
+        g(v, 3, 4, 9, 14, m[14], m[15])
+        m = [m[i] for i in PERMUTATION]
+    return [v[i] ^ v[i + 8] for i in range(8)]
+
+
+def chunkCV(data, index, isRoot):
+    cv = IV[:]
+    blocks = [data[i:i + 64] for i in range(0, len(data), 64)] or [b'']
+    for i, block in enumerate(blocks):
+        flags = CHUNK_START if i == 0 else 0
+        if i == len(blocks) - 1:
+            flags |= CHUNK_END | (ROOT if isRoot else 0)
+        cv = compress(cv, block, len(block), index, flags)
+    return cv
+
+
+def parentCV(left, right, isRoot):
+    block = struct.pack('<16I', *(left + right))
+    return compress(IV[:], block, 64, 0, PARENT | (ROOT if isRoot else 0))
+
+
+def toBytes(cv):
+    return struct.pack('<8I', *cv)
+
+
+def subtree(data, first, count, nodes, isRoot):
+    """hash count chunks from chunk first, appending the parent nodes to
+       nodes in pre-order, returns the chaining value"""
+    if count == 1:
+        chunk = data[first * CHUNK_LEN:(first + 1) * CHUNK_LEN]
+        return chunkCV(chunk, first, isRoot)
+
+    # the left subtree has the largest power of 2 chunks that leaves at
+    # least one for the right subtree
+
+    left = 1
+    while left * 2 < count:
+        left *= 2
+
+    slot = len(nodes)
+    nodes.append(None)
+    leftCV = subtree(data, first, left, nodes, False)
+    rightCV = subtree(data, first + left, count - left, nodes, False)
+    nodes[slot] = toBytes(leftCV) + toBytes(rightCV)
+    return parentCV(leftCV, rightCV, isRoot)
+
+
+def outboard(data):
+    """returns the BLAKE3 hash and the Bao outboard of data"""
+    nodes = []
+    count = max(1, (len(data) + CHUNK_LEN - 1) // CHUNK_LEN)
+    root = subtree(data, 0, count, nodes, True)
+    return toBytes(root), struct.pack('<Q', len(data)) + b''.join(nodes)
+
+
+def main():
+    try:
+        import blake3
+    except ImportError:
+        blake3 = None
+
+    for length in LENGTHS:
+        message = bytes(i % 251 for i in range(length))
+        root, tree = outboard(message)
+        if blake3 is not None:
+            assert root == blake3.blake3(message).digest(), length
+        print(length, len(tree), hashlib.sha256(tree).hexdigest())
+
+
+if __name__ == '__main__':
+    main()
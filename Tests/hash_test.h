@@ -0,0 +1,334 @@
+/*
+    Hash - hash_test.h
+
+    Helpers shared by the engine's tests (see Tests/CMakeLists.txt):
+    a failure counter and check macro, hex conversion, the test
+    message, and the known digests of the test message for every hash
+    the engine supports.
+
+    The digests of the MD5, SHA1, SHA2, SHA3, SHAKE, BLAKE2b, BLAKE2s,
+    BLAKE3, RMD160 and CRC32 entries were checked against Python's
+    hashlib, zlib and blake3 modules, and the cksum entry against
+    coreutils' cksum.  The other entries were recorded from the engine
+    (at every SIMD level it supports on the cpu), so that changes to
+    the SIMD and threaded code can't change them unnoticed.
+
+    History:
+
+    v. 1.0.0 (10/18/2026) - Initial version
+
+    Copyright (c) 2026 Sriranga R. Veeraraghavan <ranga@calalum.org>
+
+    Permission is hereby granted, free of charge, to any person obtaining
+    a copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+    OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef hash_test_h
+#define hash_test_h
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "hash_engine.h"
+
+// Length of the test message, long enough to span several chunks,
+// leaves or blocks of every hash (and one Skein tree leaf)
+
+enum {
+    HashTestMessageLength = 100000,
+    HashTestMaxDigest = 128,
+};
+
+static int gHashTestFailures = 0;
+
+/* HASH_TEST_CHECK - count and report a failed check */
+
+#define HASH_TEST_CHECK(cond, ...) \
+    do { \
+        if (!(cond)) { \
+            gHashTestFailures++; \
+            fprintf(stderr, "%s:%d: FAILED: ", __FILE__, __LINE__); \
+            fprintf(stderr, __VA_ARGS__); \
+            fprintf(stderr, "\n"); \
+        } \
+    } while (0)
+
+/* hash_test_result - the exit status for main */
+
+static inline int hash_test_result(const char *name)
+{
+    if (gHashTestFailures > 0) {
+        fprintf(stderr, "%s: %d check(s) failed\n", name, gHashTestFailures);
+        return 1;
+    }
+    printf("%s: all checks passed\n", name);
+    return 0;
+}
+
+/* hash_test_message - fill buf with the first length bytes of the test
+                       message, i mod 251 for byte i */
+
+static inline void hash_test_message(unsigned char *buf, size_t length)
+{
+    size_t i = 0;
+
+    for (i = 0; i < length; i++) {
+        buf[i] = (unsigned char)(i % 251);
+    }
+}
+
+/* hash_test_hex - convert length bytes of hex to binary, returns 0 if
+                   hex is exactly 2*length hex digits */
+
+static inline int hash_test_hex(const char *hex,
+                                unsigned char *out,
+                                size_t length)
+{
+    unsigned int byte = 0;
+    size_t i = 0;
+
+    if (strlen(hex) != 2*length) {
+        return -1;
+    }
+
+    for (i = 0; i < length; i++) {
+        if (sscanf(hex + 2*i, "%2x", &byte) != 1) {
+            return -1;
+        }
+        out[i] = (unsigned char)byte;
+    }
+
+    return 0;
+}
+
+/* the digests of the HashTestMessageLength byte test message */
+
+typedef struct hashTestVector {
+    const char *name;
+    const char *digest;
+} hashTestVector;
+
+static const hashTestVector gHashTestVectors[] = {
+    { "md5",
+      "28cb595c158e9b74e34ae9e8da710fff" },
+    { "sha1",
+      "23a1065a0f6a485119049bf2799179dd0154efbb" },
+    { "sha256",
+      "cd2df694e424bc7968cc37f47751019e5ca0cd1bdf2e479ea537c3a1"
+      "c32ee1aa" },
+    { "rmd160",
+      "fbae58818cd79a8d4a73604dc496b35ed93a3d0d" },
+    { "sha512",
+      "9a63314a71907982aa89ca2dfd6e22b5c5a436df3a7b55f93785d7f7"
+      "971324a3fd500ae72e066a5367b1f2d407a820503c6e2f13df5885f8"
+      "3a49aedb0706db84" },
+    { "whirlpool",
+      "33531739d91482ebcaa945768d19f28107b8dcf0d18f1652b2d44bef"
+      "487f31b94193b7897c514056aa5e6fe105a2fcf7655ba8a2979da738"
+      "4f5d443b595d97c2" },
+    { "sha3-256",
+      "b751df62942bc84db9f6a5c2def78558162c2857d5b126d7a2e56a0a"
+      "357cdf62" },
+    { "sha3-512",
+      "04ffdd636dc25b3e900d12778cacbbd5c98300786b0b83e5c34b088b"
+      "d2aa201f3fc41dbe4c0e30cc6fa1c60e28354a02942b7ddf9e7a2f86"
+      "3ec6494472f1de47" },
+    { "crc32",
+      "b353b8fa" },
+    { "cksum",
+      "eff7f53e" },
+    { "rmd320",
+      "3ff05233e1ee497ffac753016c0c6acfe5ed56070d8c07c2ccacdbee"
+      "e82a8f5e75ea00f3114e1a02" },
+    { "blake2b-256",
+      "916cfaa800ee55811e82095babeb88ea29c9ef8a36e8d7e20c7b772c"
+      "344c9e1c" },
+    { "blake2b-512",
+      "a0b4e1c912a57364ed019d57296b9f14fd4ac7a36dc5b324706ba2b1"
+      "497cf7b58b813ef6d86efab3a9461768ea9a552ab97554f8c4b010ed"
+      "26d04ae6158bcedf" },
+    { "skein-256",
+      "a9c672f2fd31d9b1cd8391791fa762324936ca63206ef8b207b1e1bf"
+      "621bcaa8" },
+    { "skein-512",
+      "880bcdf817f39f7ef1667cda171334db295d831e40d6bd8ac0578bc6"
+      "82ada4f1e9b49270cf24edf4557542719c138e4b3091c05122a2c6a4"
+      "30e962574c6d182b" },
+    { "skein-1024",
+      "60b7c83a4f22ee7c05fedfa57cf2f9317f28aa4ed8ab262e95c86fe7"
+      "19e6860789a81e6bf029e87aec24d6db537b5a37eda325a262dbbefd"
+      "f9a4865e4cbf4afd4c6abb4a2242ed9351657a7f56af7d8a3a8073dd"
+      "43876f181c6b4c3479200e5bdeb654058b251c1971fc581a96799fa7"
+      "a75eef3e633a66080d400ea75fd1367b" },
+    { "skein-512-256",
+      "72b041c9edb5f88ae5fc33bcda9ec1cbaa37c2ebfcd12c5d04a36046"
+      "8fa18a32" },
+    { "skein-1024-256",
+      "536af977c57cd7a789da91962425becfb1751c0a3b574e9ee0d976a8"
+      "ead38045" },
+    { "skein-1024-512",
+      "0e0e08fc81917d5c8ef30a7c7bee839172018457d5f453d02ed7e371"
+      "902acdf20bfab64ab54e009aa7b1139da1a6020ed1e2f6a4154ec960"
+      "493aff0951e27b9f" },
+    { "blake2s-256",
+      "10c2558d16898bc400b03527d108e5a9bd0af54519981c24e9e296c3"
+      "58b34f72" },
+    { "blake2sp-256",
+      "eb7050ea034453a75de798404d87f5568c4c0c6a7cccba79bd5863a4"
+      "0a33d10b" },
+    { "blake2bp-256",
+      "ccd3d02bfacf9da8234027dff73a5c12deb23568143ea0c45080334b"
+      "64f9205f" },
+    { "blake2bp-512",
+      "5cdeae115c2491fb0b9c70267e9d3294e47d4f30f3218d8f9b3e2ed5"
+      "8cf7a67e05c08ce328a86fd4e0d09fc239d3f397480290a8576f9dbd"
+      "c97222fae9bba448" },
+    { "sha224",
+      "71acd81c6642486e8678c8df0ddb39607fff31c6573444384583d084" },
+    { "sha384",
+      "733e508f6f8e154f52b87add09a5b732df33fb64e82704ba62f20ece"
+      "df03faa1d73bd72e17b2b42a7265ba2223b026ce" },
+    { "sha3-224",
+      "98c0926f75e7c1907450b43b5d3c50ebff848a33d554f4e8764f0dbe" },
+    { "sha3-384",
+      "1c771bd5027191aa0d06ae42f555c94d98f68b6059da56881f6bab6b"
+      "183ec9371be7717e9c3e9c67eca086f29124f57d" },
+    { "md6-256",
+      "01e78cb28a553a79149fb7ef7caa174a7bcfa2226d34b09ff2c18abd"
+      "62c8d36b" },
+    { "md6-512",
+      "b9bb80a29e71029f73c41ccea04959a89f86943470593653dfd258f1"
+      "f8cf5884ab54cd25999fab70728444ae9207e995f91844c82f147cb2"
+      "27445729628522da" },
+    { "jh-224",
+      "3dfddfc9f11e18865563585c3383fc4bc0577747e11ed3f1554b7b72" },
+    { "jh-256",
+      "b02105c4e5571be6d9bea1e0e081399fd8ef601356c12ccc9dcab2c6"
+      "b2ee4ccc" },
+    { "jh-384",
+      "b98399631fc477bce069050232ddf2248a1ba900d8caa6dd5f1aaf96"
+      "0ccfa2b9296ce1bc9b5c75b0f094a7c266909ef5" },
+    { "jh-512",
+      "c6d16acb38deeb2d60262bc1075615ef59530731d2ac17d234f4fe9d"
+      "439482206c9f0c8a6dfaed4f7c0df35d8fc8ed44b4276f026114cac9"
+      "29afca0834b5b141" },
+    { "tiger",
+      "ba127dc47c835606abc2b64f138d96b80ad4ca965d8f04e3" },
+    { "tiger2",
+      "a1de2c17439ec21b1d304b1be60aa363b1159ed4043693ee" },
+    { "has160",
+      "bf51c687547a3ffeb292653296606d867d1dfd0c" },
+    { "blake-224",
+      "aa45b28de261e1ab2fc97fd9fc0d2f19b928d19b6421b4f12d657be6" },
+    { "blake-256",
+      "3728ae7ae6e4adc6018847d55d3284e9de60a105abf76fbae4cceb8f"
+      "7a98a2a4" },
+    { "blake-384",
+      "63b59c6382aea06500d1cb958d4e58ae17608e11b3b3a8e18de032c5"
+      "06488c82b0351a93680d71d859ada69a6ec6c623" },
+    { "blake-512",
+      "393e241bbd9feede6207cbce80507f22e35a790cb3474b4d71dba8d9"
+      "e79557c06c51765a2215cc73222ed43fb0d76af7835123992e469741"
+      "022f7f28c06bd39d" },
+    { "groestl-224",
+      "c38898080995899e40b7b922b77de534a3c21c35d6a2da9663b34e05" },
+    { "groestl-256",
+      "f4ec8dea547049eafbee3be18a545767b3b47e1c72265117df218a18"
+      "f70b70ad" },
+    { "groestl-384",
+      "28d284077e2355e7223e50cb97b46806b7189066f156bf7cc5caa146"
+      "9de614ff2289c5f0f7005e60276e8ca9d7b00457" },
+    { "groestl-512",
+      "762ad965b73abe1222bf34116a254d3d4d9ad930052b249663c987f8"
+      "587e936d4ca575665ded4279592aa57855bb93c09275561e9155b7dd"
+      "a2562029506a7811" },
+    { "sha1dc",
+      "23a1065a0f6a485119049bf2799179dd0154efbb" },
+    { "snefru-128",
+      "b24ea4138af40bb10bd5c3f651a7496e" },
+    { "snefru-256",
+      "a630f20ab6d6e9bf56aa0d8fd3b88b1aa108d0322705b15973563b3c"
+      "fbecec09" },
+    { "shake128",
+      "a6363a40f31648db6dcb023ccc35292538f72cfefe74236c75da71b7"
+      "72ccaf5b" },
+    { "shake256",
+      "1881aed1179964f22eeb159c42f3d19a305178fc396b437c8f8214eb"
+      "8bea80aa0948be5ac01df755724e7fe83317c646fd4df48af94a5fd6"
+      "be534d95b1f54aa6" },
+    { "blake3",
+      "d93c23eedaf165a7e0be908ba86f1a7a520d568d2d13cde787c8580c"
+      "5c72cc54" },
+    { "lsh-224",
+      "dbc47bd13a76f1f53eabbd034a9989d09ad872d0e8c9cfbd26d4f49b" },
+    { "lsh-256",
+      "9c975a21f654a655b24f3120693d256007fdfdc0e9b3297490fc3824"
+      "596a14a5" },
+    { "lsh-384",
+      "7e78ffb363951f4d7dd9929634cbaec449277a577c6ec518c700c6aa"
+      "9917fe5269c61969c350e12eea00d6cefe8cb699" },
+    { "lsh-512",
+      "f5766c350dc058187c1e959b88ca74f445e006d94e4007eca64b8e99"
+      "8169a2e55e794169f98db563039f8c283b5e7792b5c59c32d8aaca89"
+      "7dc747be61fe1873" },
+    { "k12-256",
+      "9bc07b25f06d738be68375643c1b2755b54c402c9fd3827e4783cddb"
+      "b320e5e5" },
+    { "k12-384",
+      "9bc07b25f06d738be68375643c1b2755b54c402c9fd3827e4783cddb"
+      "b320e5e593cffd087308f07d75aa51c73a28fb74" },
+    { "k12-512",
+      "9bc07b25f06d738be68375643c1b2755b54c402c9fd3827e4783cddb"
+      "b320e5e593cffd087308f07d75aa51c73a28fb7411f8b90f52743720"
+      "fc021aafaa61e9d2" },
+    { "skein-256-tree",
+      "60fc701a8cac7e8d8ccf2d4d298c02fc80c2abd0b0dc9617e013ccff"
+      "caf3e8d3" },
+    { "skein-512-tree",
+      "af87ccdb1e0ac258ff33e0514e68c0c14bf67070024cbd9eeeb1106d"
+      "3e0f5a2c5a072dd5fbcfe0d864269212e108f4bd111ba0db2e21d6c7"
+      "7d2265757ca81051" },
+    { "skein-1024-tree",
+      "9c052138bd1b4dbcc8624d1fb225566dc778d19e590aef75261e5e2f"
+      "41f141b44d4e97483863e0467d49021c0693e632554262696e7fa075"
+      "e0225dd8bdd61c2f1eccff494f5c15646cfab9d94f7384f938dbc162"
+      "130c0a19bd3e81f8eaa4d4fa00c117211f71e573c0df590a4cedbbdc"
+      "e03eb048bd22ad0bfbdda53786d2a0aa" },
+};
+
+/* hash_test_expected - the known digest of the test message for desc,
+                        returns -1 if there is none */
+
+static inline int hash_test_expected(const hashEngineDescriptor *desc,
+                                     unsigned char *digest)
+{
+    size_t i = 0;
+
+    for (i = 0; i < sizeof(gHashTestVectors)/sizeof(gHashTestVectors[0]); i++) {
+        if (strcmp(gHashTestVectors[i].name, desc->name) == 0) {
+            return hash_test_hex(gHashTestVectors[i].digest,
+                                 digest,
+                                 desc->digestLength);
+        }
+    }
+
+    return -1;
+}
+
+#endif /* hash_test_h */
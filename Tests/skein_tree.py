@@ -0,0 +1,226 @@
+#!/usr/bin/env python3
+#
+# Hash - skein_tree.py
+#
+# An independent implementation of Skein (Threefish-256/512/1024, UBI,
+# and the tree hashing mode of section 3.5.6 of the Skein 1.3 paper),
+# written from the paper rather than from Hash's C code, that prints
+# the known answers used by test_skein_tree.c.  The sequential hashes
+# are checked against the paper's Skein-512-512 example and against
+# Hash's (reference) Skein digests of the test message.
+#
+# The 16MB messages take a few minutes, run with -q to skip them.
+#
+# History:
+#
+# v. 1.0.0 (10/18/2026) - Initial version
+#
+# Copyright (c) 2026 Sriranga R. Veeraraghavan <ranga@calalum.org>
+#
+# Permission is hereby granted, free of charge, to any person obtaining
+# a copy of this software and associated documentation files (the "Software"),
+# to deal in the Software without restriction, including without limitation
+# the rights to use, copy, modify, merge, publish, distribute, sublicense,
+# and/or sell copies of the Software, and to permit persons to whom the
+# Software is furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included
+# in all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+# OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+# THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+# FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+# DEALINGS IN THE SOFTWARE.
+
+import struct
+import sys
+
+MASK = (1 << 64) - 1
+C240 = 0x1BD11BDAA9FC1A22
+
+# rotation constants R[d mod 8][j] and word permutations, by the number
+# of words in the state (Tables 4 and 3 of the paper)
+
+ROTATIONS = {
+    4: [(14, 16), (52, 57), (23, 40), (5, 37),
+        (25, 33), (46, 12), (58, 22), (32, 32)],
+    8: [(46, 36, 19, 37), (33, 27, 14, 42), (17, 49, 36, 39),
+        (44, 9, 54, 56), (39, 30, 34, 24), (13, 50, 10, 17),
+        (25, 29, 39, 43), (8, 35, 56, 22)],
+    16: [(24, 13, 8, 47, 8, 17, 22, 37), (38, 19, 10, 55, 49, 18, 23, 52),
+         (33, 4, 51, 13, 34, 41, 59, 17), (5, 20, 48, 41, 47, 28, 16, 25),
+         (41, 9, 37, 31, 12, 47, 44, 30), (16, 34, 56, 51, 4, 53, 42, 41),
+         (31, 44, 47, 46, 19, 42, 44, 25), (9, 48, 35, 52, 23, 31, 37, 20)],
+}
+
+PERMUTATIONS = {
+    4: [0, 3, 2, 1],
+    8: [2, 1, 4, 7, 6, 5, 0, 3],
+    16: [0, 9, 2, 13, 6, 11, 4, 15, 10, 7, 12, 3, 14, 5, 8, 1],
+}
+
+T_CFG = 4
+T_MSG = 48
+T_OUT = 63
+
+# the known answers: state bits, output bits, Y_l, Y_f, Y_m, message
+# length (see test_skein_tree.c)
+
+VECTORS = [
+    (256, 256, 1, 1, 2, 0),
+    (256, 256, 1, 1, 2, 1),
+    (256, 256, 1, 1, 2, 64),
+    (256, 256, 1, 1, 2, 65),
+    (256, 256, 1, 1, 2, 1000),
+    (512, 512, 1, 1, 3, 3000),
+    (512, 512, 1, 2, 255, 5000),
+    (1024, 1024, 2, 1, 2, 5000),
+    (1024, 1024, 1, 1, 255, 10000),
+    (256, 1024, 1, 1, 255, 1000),
+    (512, 256, 2, 2, 4, 20000),
+    (512, 512, 1, 1, 255, 100000),
+]
+
+# the engine's skein-*-tree hashes use 64KB leaves, 256 children per
+# node and Y_m = 255, these are long enough to fill a level 2 node
+
+ENGINE_LENGTH = 16 * 1048576 + 12345
+
+
+def rotl(x, n):
+    return ((x << n) | (x >> (64 - n))) & MASK
+
+
+def threefish(key, tweak, block):
+    words = len(key)
+    rounds = 80 if words == 16 else 72
+    k = key + [C240]
+    for w in key:
+        k[words] ^= w
+    t = [tweak[0], tweak[1], tweak[0] ^ tweak[1]]
+
+    def subkey(s):
+        ks = [k[(s + i) % (words + 1)] for i in range(words)]
+        ks[words - 3] = (ks[words - 3] + t[s % 3]) & MASK
+        ks[words - 2] = (ks[words - 2] + t[(s + 1) % 3]) & MASK
+        ks[words - 1] = (ks[words - 1] + s) & MASK
+        return ks
+
+    v = block[:]
+    for d in range(rounds):
+        if d % 4 == 0:
+            v = [(a + b) & MASK for a, b in zip(v, subkey(d // 4))]
+        f = [0] * words
+        for j in range(words // 2):
+            x0, x1 = v[2 * j], v[2 * j + 1]
+            f[2 * j] = (x0 + x1) & MASK
+            f[2 * j + 1] = rotl(x1, ROTATIONS[words][d % 8][j]) ^ f[2 * j]
+        v = [f[i] for i in PERMUTATIONS[words]]
+    return [(a + b) & MASK for a, b in zip(v, subkey(rounds // 4))]
+
+
+def ubi(g, message, tweak):
+    """UBI(g, message, tweak), tweak holds the type, level and starting
+       position"""
+    words = len(g)
+    blockBytes = words * 8
+    blocks = [message[i:i + blockBytes]
+              for i in range(0, len(message), blockBytes)] or [b'']
+    h = g
+    position = tweak & ((1 << 96) - 1)
+    for i, block in enumerate(blocks):
+        position += len(block)
+        t = (tweak >> 96 << 96) | position
+        if i == 0:
+            t |= 1 << 126
+        if i == len(blocks) - 1:
+            t |= 1 << 127
+        m = list(struct.unpack('<%dQ' % words, block.ljust(blockBytes, b'\0')))
+        e = threefish(h, [t & MASK, t >> 64], m)
+        h = [a ^ b for a, b in zip(e, m)]
+    return h
+
+
+def toBytes(words):
+    return struct.pack('<%dQ' % len(words), *words)
+
+
+def skein(stateBits, outputBits, message, tree=None):
+    """Skein-stateBits-outputBits of message, tree is (Y_l, Y_f, Y_m) or
+       None for sequential hashing"""
+    words = stateBits // 64
+    blockBytes = stateBits // 8
+    yl, yf, ym = tree if tree else (0, 0, 0)
+
+    config = struct.pack('<IHHQBBB', 0x33414853, 1, 0, outputBits, yl, yf, ym)
+    k = ubi([0] * words, config.ljust(32, b'\0'), T_CFG << 120)
+
+    if tree is None:
+        g = ubi(k, message, T_MSG << 120)
+    else:
+        leafBytes = blockBytes << yl
+        nodeBytes = blockBytes << yf
+        parts = [message[i:i + leafBytes]
+                 for i in range(0, len(message), leafBytes)] or [b'']
+        level = b''.join(
+            toBytes(ubi(k, p, (T_MSG << 120) | (1 << 112) | (i * leafBytes)))
+            for i, p in enumerate(parts))
+        l = 1
+        while True:
+            if len(level) == blockBytes:
+                g = list(struct.unpack('<%dQ' % words, level))
+                break
+            if l == ym - 1:
+                g = ubi(k, level, (T_MSG << 120) | (ym << 112))
+                break
+            parts = [level[i:i + nodeBytes]
+                     for i in range(0, len(level), nodeBytes)]
+            level = b''.join(
+                toBytes(ubi(k, p,
+                            (T_MSG << 120) | ((l + 1) << 112) | (i * nodeBytes)))
+                for i, p in enumerate(parts))
+            l += 1
+
+    output = b''
+    i = 0
+    while len(output) * 8 < outputBits:
+        output += toBytes(ubi(g, struct.pack('<Q', i), T_OUT << 120))
+        i += 1
+    return output[:(outputBits + 7) // 8]
+
+
+def testMessage(length):
+    return (bytes(range(251)) * (length // 251 + 1))[:length]
+
+
+def main():
+    # the Skein-512-512 example from the paper, and Hash's sequential
+    # digests of the 100000 byte test message (Tests/hash_test.h)
+
+    assert skein(512, 512, b'\xff').hex().startswith(
+        '71b7bce6fe6452227b9ced6014249e5b')
+    assert skein(256, 256, testMessage(100000)).hex().startswith(
+        'a9c672f2fd31d9b1cd8391791fa76232')
+    assert skein(1024, 512, testMessage(100000)).hex().startswith(
+        '0e0e08fc81917d5c8ef30a7c7bee8391')
+
+    for stateBits, outputBits, yl, yf, ym, length in VECTORS:
+        digest = skein(stateBits, outputBits, testMessage(length),
+                       (yl, yf, ym))
+        print(stateBits, outputBits, yl, yf, ym, length, digest.hex())
+
+    if '-q' not in sys.argv:
+        message = testMessage(ENGINE_LENGTH)
+        for stateBits in (256, 512, 1024):
+            yl = 0
+            while (stateBits // 8) << (yl + 1) <= 65536:
+                yl += 1
+            digest = skein(stateBits, stateBits, message, (yl, 8, 255))
+            print('skein-%d-tree' % stateBits, ENGINE_LENGTH, digest.hex())
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,283 @@
+/*
+    Hash - test_bao.c
+
+    Checks the Bao outboard trees (blake3_bao_encode_outboard) and the
+    verification of byte ranges against them (blake3_bao_verify, which
+    hash --verify-slice uses).  The known outboards were produced by
+    bao_outboard.py, an independent Python implementation of BLAKE3 and
+    the Bao outboard format, whose root hashes were checked against
+    Python's blake3 module; their SHA256 digests are listed below.
+
+    History:
+
+    v. 1.0.0 (10/18/2026) - Initial version
+
+    Copyright (c) 2026 Sriranga R. Veeraraghavan <ranga@calalum.org>
+
+    Permission is hereby granted, free of charge, to any person obtaining
+    a copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+    OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "blake3.h"
+#include "hash_test.h"
+
+typedef struct testOutboard {
+    size_t length;          /* content length */
+    size_t outboardLength;
+    const char *sha256;     /* of the outboard */
+} testOutboard;
+
+static const testOutboard gOutboards[] = {
+    { 0, 8,
+      "af5570f5a1810b7af78caf4bc70a660f0df51e42baf91d4de5b2328de0e83dfc" },
+    { 1, 8,
+      "7c9fa136d4413fa6173637e883b6998d32e1d675f88cddff9dcbcf331820f4b8" },
+    { 1024, 8,
+      "fef02424157f106b48d04276276c15ebba9c516e6024d4f82ea2f648af3e09c8" },
+    { 1025, 72,
+      "77be04208af7ea3306c6beb012ddad376aefe7ffab186615301fb03288b3a9c6" },
+    { 2048, 72,
+      "0f7134c7bbabb92a7aebc29ae8a0ed34bffb7f77e056ca22062173cf2fc92377" },
+    { 3073, 200,
+      "2a82729a7afca3ee4b0f3bab0db0366ea0f641d52803e8c245785b8ebfe47dc1" },
+    { HashTestMessageLength, 6216,
+      "3cc8b55a355e4ce83b5f974ee20450edebc031497aef9051485686a583a587b2" },
+};
+
+// Ranges of the test message that are verified, and the byte that is
+// corrupted (in chunk 50, bytes 51200 - 52223)
+
+typedef struct testRange {
+    uint64_t start;
+    uint64_t length;
+    int hitsCorrupted;
+} testRange;
+
+static const testRange gRanges[] = {
+    { 0, HashTestMessageLength, 1 },
+    { 0, 1, 0 },
+    { 1023, 2, 0 },
+    { 0, 51200, 0 },
+    { 51199, 2, 1 },
+    { 52223, 1, 1 },
+    { 52224, 1000, 0 },
+    { 50000, 10000, 1 },
+    { 99999, 1, 0 },
+    { 98000, 1ULL << 40, 0 },
+};
+
+enum {
+    TestCorrupted = 51234,
+};
+
+/* digestOf - the digest of a buffer with the named hash */
+
+static void digestOf(const char *name,
+                     const unsigned char *data,
+                     size_t length,
+                     unsigned char *digest)
+{
+    const hashEngineDescriptor *desc = hash_engine_descriptor_by_name(name);
+    hashEngineContext *ctx = hash_engine_new(desc->type);
+
+    memset(digest, 0, desc->digestLength);
+    if (ctx != NULL) {
+        hash_engine_update(ctx, data, length);
+        hash_engine_final(ctx, digest);
+        hash_engine_free(ctx);
+    }
+}
+
+static void testEncode(const unsigned char *message)
+{
+    const testOutboard *test = NULL;
+    unsigned char *outboard = NULL;
+    unsigned char root[BLAKE3_OUT_LEN];
+    unsigned char want[HashTestMaxDigest];
+    unsigned char digest[HashTestMaxDigest];
+    size_t i = 0;
+
+    for (i = 0; i < sizeof(gOutboards)/sizeof(gOutboards[0]); i++) {
+        test = &gOutboards[i];
+        HASH_TEST_CHECK(blake3_bao_outboard_size(test->length) ==
+                        test->outboardLength,
+                        "outboard of %zu bytes has the wrong size",
+                        test->length);
+
+        outboard = malloc(test->outboardLength);
+        if (outboard == NULL) {
+            continue;
+        }
+        blake3_bao_encode_outboard(message, test->length, outboard, root);
+
+        digestOf("sha256", outboard, test->outboardLength, digest);
+        HASH_TEST_CHECK(hash_test_hex(test->sha256, want, 32) == 0 &&
+                        memcmp(digest, want, 32) == 0,
+                        "outboard of %zu bytes is wrong", test->length);
+
+        digestOf("blake3", message, test->length, digest);
+        HASH_TEST_CHECK(memcmp(root, digest, BLAKE3_OUT_LEN) == 0,
+                        "root of %zu bytes isn't the BLAKE3 digest",
+                        test->length);
+
+        HASH_TEST_CHECK(blake3_bao_verify(root,
+                                          outboard,
+                                          test->outboardLength,
+                                          message,
+                                          test->length,
+                                          0,
+                                          test->length,
+                                          NULL,
+                                          NULL) == 0,
+                        "%zu bytes don't verify", test->length);
+
+        free(outboard);
+    }
+}
+
+static void testVerify(const unsigned char *message)
+{
+    const hashEngineDescriptor *blake3 =
+        hash_engine_descriptor_by_name("blake3");
+    unsigned char *outboard = NULL;
+    unsigned char *corrupted = NULL;
+    unsigned char root[BLAKE3_OUT_LEN];
+    unsigned char expected[HashTestMaxDigest];
+    size_t outboardLength = blake3_bao_outboard_size(HashTestMessageLength);
+    uint64_t badStart = 0;
+    uint64_t badLength = 0;
+    size_t i = 0;
+    int rc = 0;
+
+    outboard = malloc(outboardLength);
+    corrupted = malloc(HashTestMessageLength);
+    if (outboard == NULL || corrupted == NULL) {
+        goto done;
+    }
+
+    blake3_bao_encode_outboard(message,
+                               HashTestMessageLength,
+                               outboard,
+                               root);
+    HASH_TEST_CHECK(hash_test_expected(blake3, expected) == 0 &&
+                    memcmp(root, expected, BLAKE3_OUT_LEN) == 0,
+                    "root of the test message is wrong");
+
+    memcpy(corrupted, message, HashTestMessageLength);
+    corrupted[TestCorrupted] ^= 0x01;
+
+    for (i = 0; i < sizeof(gRanges)/sizeof(gRanges[0]); i++) {
+        HASH_TEST_CHECK(blake3_bao_verify(root,
+                                          outboard,
+                                          outboardLength,
+                                          message,
+                                          HashTestMessageLength,
+                                          gRanges[i].start,
+                                          gRanges[i].length,
+                                          NULL,
+                                          NULL) == 0,
+                        "bytes %llu+%llu don't verify",
+                        (unsigned long long)gRanges[i].start,
+                        (unsigned long long)gRanges[i].length);
+
+        // only the ranges that need the corrupted chunk fail, and the
+        // failure is reported in that chunk
+
+        badStart = 0;
+        badLength = 0;
+        rc = blake3_bao_verify(root,
+                               outboard,
+                               outboardLength,
+                               corrupted,
+                               HashTestMessageLength,
+                               gRanges[i].start,
+                               gRanges[i].length,
+                               &badStart,
+                               &badLength);
+        if (gRanges[i].hitsCorrupted) {
+            HASH_TEST_CHECK(rc != 0 &&
+                            badStart <= TestCorrupted &&
+                            TestCorrupted < badStart + badLength &&
+                            badStart >= 51200 &&
+                            badStart + badLength <= 52224,
+                            "bytes %llu+%llu: corruption reported at "
+                            "%llu+%llu",
+                            (unsigned long long)gRanges[i].start,
+                            (unsigned long long)gRanges[i].length,
+                            (unsigned long long)badStart,
+                            (unsigned long long)badLength);
+        } else {
+            HASH_TEST_CHECK(rc == 0,
+                            "bytes %llu+%llu failed away from the "
+                            "corruption",
+                            (unsigned long long)gRanges[i].start,
+                            (unsigned long long)gRanges[i].length);
+        }
+    }
+
+    // a corrupted tree, the wrong root, or the wrong length fail
+
+    outboard[outboardLength / 2] ^= 0x01;
+    HASH_TEST_CHECK(blake3_bao_verify(root, outboard, outboardLength,
+                                      message, HashTestMessageLength,
+                                      0, HashTestMessageLength,
+                                      NULL, NULL) != 0,
+                    "a corrupted outboard verified");
+    outboard[outboardLength / 2] ^= 0x01;
+
+    root[0] ^= 0x01;
+    HASH_TEST_CHECK(blake3_bao_verify(root, outboard, outboardLength,
+                                      message, HashTestMessageLength,
+                                      0, 1,
+                                      NULL, NULL) != 0,
+                    "verified against the wrong root");
+    root[0] ^= 0x01;
+
+    HASH_TEST_CHECK(blake3_bao_verify(root, outboard, outboardLength,
+                                      message, HashTestMessageLength - 1,
+                                      0, 1,
+                                      NULL, NULL) != 0,
+                    "verified a shorter file");
+    HASH_TEST_CHECK(blake3_bao_verify(root, outboard, outboardLength - 1,
+                                      message, HashTestMessageLength,
+                                      0, 1,
+                                      NULL, NULL) != 0,
+                    "verified with a truncated outboard");
+
+done:
+    free(corrupted);
+    free(outboard);
+}
+
+int main(void)
+{
+    unsigned char *message = NULL;
+
+    message = malloc(HashTestMessageLength);
+    if (message == NULL) {
+        return 1;
+    }
+    hash_test_message(message, HashTestMessageLength);
+
+    testEncode(message);
+    testVerify(message);
+
+    free(message);
+
+    return hash_test_result("test_bao");
+}
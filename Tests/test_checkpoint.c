@@ -0,0 +1,329 @@
+/*
+    Hash - test_checkpoint.c
+
+    Checks hash_checkpoint_save / hash_checkpoint_load (resuming a file
+    that hasn't changed) and the append variants (resuming a file that
+    has grown since), with several hashes in one checkpoint, against
+    the known digests of the test message.  Checkpoints for a file that
+    has changed, or for other hashes, must not be used.
+
+    History:
+
+    v. 1.0.0 (10/18/2026) - Initial version
+
+    Copyright (c) 2026 Sriranga R. Veeraraghavan <ranga@calalum.org>
+
+    Permission is hereby granted, free of charge, to any person obtaining
+    a copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+    OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "hash_checkpoint.h"
+#include "hash_test.h"
+
+// The hashes in the checkpoint, and where the file is checkpointed
+
+static const char *gHashes[] = {
+    "sha256", "blake3", "k12-256", "md6-256", "skein-512-tree", "crc32",
+};
+
+enum {
+    TestHashCount = sizeof(gHashes)/sizeof(gHashes[0]),
+    TestSplit = 40000,
+    TestAppendPrefix = 60000,
+};
+
+static hashEngineContext *gCtxs[TestHashCount];
+
+/* newContexts - create (or reset) the contexts for gHashes */
+
+static int newContexts(void)
+{
+    size_t i = 0;
+
+    for (i = 0; i < TestHashCount; i++) {
+        if (gCtxs[i] == NULL) {
+            gCtxs[i] = hash_engine_new(
+                hash_engine_descriptor_by_name(gHashes[i])->type);
+            if (gCtxs[i] == NULL) {
+                return -1;
+            }
+        } else {
+            hash_engine_reset(gCtxs[i]);
+        }
+    }
+
+    return 0;
+}
+
+/* updateContexts - add the bytes [from, to) of the message */
+
+static void updateContexts(const unsigned char *message,
+                           size_t from,
+                           size_t to)
+{
+    size_t i = 0;
+
+    for (i = 0; i < TestHashCount; i++) {
+        hash_engine_update(gCtxs[i], message + from, to - from);
+    }
+}
+
+/* checkContexts - finish the contexts and compare them to the known
+                   digests */
+
+static void checkContexts(const char *what)
+{
+    const hashEngineDescriptor *desc = NULL;
+    unsigned char expected[HashTestMaxDigest];
+    unsigned char digest[HashTestMaxDigest];
+    size_t i = 0;
+
+    for (i = 0; i < TestHashCount; i++) {
+        desc = gCtxs[i]->desc;
+        memset(digest, 0, sizeof(digest));
+        HASH_TEST_CHECK(hash_test_expected(desc, expected) == 0 &&
+                        hash_engine_final(gCtxs[i], digest) >= 0 &&
+                        memcmp(digest, expected, desc->digestLength) == 0,
+                        "%s: wrong digest %s", desc->name, what);
+    }
+}
+
+/* writeFile - replace the contents of the file open on fd */
+
+static int writeFile(int fd, const unsigned char *data, size_t length)
+{
+    if (ftruncate(fd, 0) != 0 || lseek(fd, 0, SEEK_SET) != 0) {
+        return -1;
+    }
+    return (write(fd, data, length) == (ssize_t)length ? 0 : -1);
+}
+
+/* fileKey - the cache key of the file open on fd */
+
+static int fileKey(int fd, hashCacheKey *key)
+{
+    struct stat sb;
+
+    if (fstat(fd, &sb) != 0) {
+        return -1;
+    }
+    hash_cache_key(&sb, key);
+    return 0;
+}
+
+/* testResume - checkpoint part way through an unchanged file */
+
+static void testResume(int fd,
+                       const char *checkpoint,
+                       const unsigned char *message)
+{
+    hashCacheKey key;
+    hashCacheKey changed;
+    unsigned long long offset = 0;
+
+    HASH_TEST_CHECK(writeFile(fd, message, HashTestMessageLength) == 0 &&
+                    fileKey(fd, &key) == 0,
+                    "cannot write the test file");
+
+    newContexts();
+    updateContexts(message, 0, TestSplit);
+    HASH_TEST_CHECK(hash_checkpoint_save(checkpoint,
+                                         &key,
+                                         TestSplit,
+                                         gCtxs,
+                                         TestHashCount) == 0,
+                    "cannot save the checkpoint");
+
+    // resuming from the checkpoint gives the digests of the whole file
+
+    newContexts();
+    HASH_TEST_CHECK(hash_checkpoint_load(checkpoint,
+                                         &key,
+                                         gCtxs,
+                                         TestHashCount,
+                                         &offset) == 0 &&
+                    offset == TestSplit,
+                    "cannot resume from the checkpoint (offset %llu)",
+                    offset);
+    updateContexts(message, (size_t)offset, HashTestMessageLength);
+    checkContexts("after resuming");
+
+    // a checkpoint of a changed file isn't used, and the contexts are
+    // left ready to hash the file from the start
+
+    changed = key;
+    changed.mtime++;
+    newContexts();
+    HASH_TEST_CHECK(hash_checkpoint_load(checkpoint,
+                                         &changed,
+                                         gCtxs,
+                                         TestHashCount,
+                                         &offset) != 0,
+                    "resumed a changed file");
+    updateContexts(message, 0, HashTestMessageLength);
+    checkContexts("after rejecting a changed file");
+
+    // nor is a checkpoint of fewer hashes
+
+    newContexts();
+    HASH_TEST_CHECK(hash_checkpoint_load(checkpoint,
+                                         &key,
+                                         gCtxs,
+                                         TestHashCount - 1,
+                                         &offset) != 0,
+                    "resumed with the wrong hashes");
+
+    hash_checkpoint_remove(checkpoint);
+    newContexts();
+    HASH_TEST_CHECK(hash_checkpoint_load(checkpoint,
+                                         &key,
+                                         gCtxs,
+                                         TestHashCount,
+                                         &offset) != 0,
+                    "resumed from a removed checkpoint");
+}
+
+/* testAppend - checkpoint the end of a file, then append to it */
+
+static void testAppend(int fd,
+                       const char *checkpoint,
+                       const unsigned char *message)
+{
+    hashCacheKey key;
+    unsigned char *modified = NULL;
+    unsigned long long offset = 0;
+
+    HASH_TEST_CHECK(writeFile(fd, message, TestAppendPrefix) == 0 &&
+                    fileKey(fd, &key) == 0,
+                    "cannot write the test file");
+
+    newContexts();
+    updateContexts(message, 0, TestAppendPrefix);
+    HASH_TEST_CHECK(hash_checkpoint_save_append(checkpoint,
+                                                fd,
+                                                &key,
+                                                TestAppendPrefix,
+                                                gCtxs,
+                                                TestHashCount) == 0,
+                    "cannot save the append checkpoint");
+
+    // append the rest of the message, only it needs to be hashed
+
+    HASH_TEST_CHECK(lseek(fd, 0, SEEK_END) == TestAppendPrefix &&
+                    write(fd,
+                          message + TestAppendPrefix,
+                          HashTestMessageLength - TestAppendPrefix) ==
+                        (ssize_t)(HashTestMessageLength - TestAppendPrefix) &&
+                    fileKey(fd, &key) == 0,
+                    "cannot append to the test file");
+
+    newContexts();
+    HASH_TEST_CHECK(hash_checkpoint_load_append(checkpoint,
+                                                fd,
+                                                &key,
+                                                gCtxs,
+                                                TestHashCount,
+                                                &offset) == 0 &&
+                    offset == TestAppendPrefix,
+                    "cannot resume the appended file (offset %llu)",
+                    offset);
+    updateContexts(message, (size_t)offset, HashTestMessageLength);
+    checkContexts("after resuming the appended file");
+
+    // an append checkpoint isn't used by hash_checkpoint_load
+
+    newContexts();
+    HASH_TEST_CHECK(hash_checkpoint_load(checkpoint,
+                                         &key,
+                                         gCtxs,
+                                         TestHashCount,
+                                         &offset) != 0,
+                    "resumed an append checkpoint as unchanged");
+
+    // a file whose prefix changed has to be hashed from the start
+
+    modified = malloc(HashTestMessageLength);
+    if (modified != NULL) {
+        memcpy(modified, message, HashTestMessageLength);
+        modified[TestAppendPrefix - 1] ^= 1;
+        HASH_TEST_CHECK(writeFile(fd, modified, HashTestMessageLength) == 0 &&
+                        fileKey(fd, &key) == 0,
+                        "cannot rewrite the test file");
+
+        newContexts();
+        HASH_TEST_CHECK(hash_checkpoint_load_append(checkpoint,
+                                                    fd,
+                                                    &key,
+                                                    gCtxs,
+                                                    TestHashCount,
+                                                    &offset) != 0,
+                        "resumed a file whose prefix changed");
+        free(modified);
+    }
+
+    // as does a file that is now shorter than the checkpoint
+
+    HASH_TEST_CHECK(writeFile(fd, message, TestAppendPrefix - 1) == 0 &&
+                    fileKey(fd, &key) == 0,
+                    "cannot rewrite the test file");
+    newContexts();
+    HASH_TEST_CHECK(hash_checkpoint_load_append(checkpoint,
+                                                fd,
+                                                &key,
+                                                gCtxs,
+                                                TestHashCount,
+                                                &offset) != 0,
+                    "resumed a file that was truncated");
+
+    hash_checkpoint_remove(checkpoint);
+}
+
+int main(void)
+{
+    char file[] = "/tmp/hash_test_checkpoint.XXXXXX";
+    char checkpoint[sizeof(file) + 4];
+    unsigned char *message = NULL;
+    size_t i = 0;
+    int fd = -1;
+
+    message = malloc(HashTestMessageLength);
+    fd = mkstemp(file);
+    if (message == NULL || fd < 0 || newContexts() != 0) {
+        fprintf(stderr, "test_checkpoint: cannot set up the test\n");
+        return 1;
+    }
+    hash_test_message(message, HashTestMessageLength);
+    snprintf(checkpoint, sizeof(checkpoint), "%s.ck", file);
+
+    testResume(fd, checkpoint, message);
+    testAppend(fd, checkpoint, message);
+
+    close(fd);
+    unlink(file);
+    for (i = 0; i < TestHashCount; i++) {
+        hash_engine_free(gCtxs[i]);
+    }
+    free(message);
+
+    return hash_test_result("test_checkpoint");
+}
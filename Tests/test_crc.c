@@ -0,0 +1,218 @@
+/*
+    Hash - test_crc.c
+
+    Checks the CRC32 and cksum updates (with and without PCLMULQDQ) and
+    hash_crc32_combine / hash_cksum_combine: the CRC of a message split
+    in two, with the halves checksummed separately and combined, must
+    be the one-shot CRC of the whole message.  The known CRCs are
+    zlib's crc32() and coreutils' cksum of the test message.
+
+    History:
+
+    v. 1.0.0 (10/18/2026) - Initial version
+
+    Copyright (c) 2026 Sriranga R. Veeraraghavan <ranga@calalum.org>
+
+    Permission is hereby granted, free of charge, to any person obtaining
+    a copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+    OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "crc.h"
+#include "hash_test.h"
+
+// Known CRCs of the test message, and of a 20MB + 3 byte one (long
+// enough to be split across threads)
+
+enum {
+    TestLongLength = 20*1048576 + 3,
+};
+
+static const uint32_t gCrc32 = 0xb353b8faU;
+static const uint32_t gCksum = 0xeff7f53eU;
+static const uint32_t gLongCrc32 = 0x4d29e7beU;
+static const uint32_t gLongCksum = 0xc5fea46aU;
+
+// Where the test message is split, around the 16 byte slices and 64
+// byte folds
+
+static const size_t gSplits[] = {
+    0, 1, 15, 16, 17, 63, 64, 65, 127, 4096, 50000, 99999,
+    HashTestMessageLength,
+};
+
+/* crc32Of, cksumOf - the CRC32, and the cksum register (before the
+                      length is added), of a buffer */
+
+static uint32_t crc32Of(const unsigned char *buf, size_t length)
+{
+    crcContext ctx;
+
+    crc32_init(&ctx);
+    crc32_update(&ctx, buf, length);
+    crc32_finalize(&ctx);
+    return ctx.crc;
+}
+
+static uint32_t cksumOf(const unsigned char *buf, size_t length)
+{
+    crcContext ctx;
+
+    cksum_init(&ctx);
+    cksum_update(&ctx, (unsigned char *)buf, (uint32_t)length);
+    return ctx.crc;
+}
+
+/* cksumFinal - the cksum of length bytes with the register crc */
+
+static uint32_t cksumFinal(uint32_t crc, unsigned long long length)
+{
+    crcContext ctx;
+
+    ctx.crc = crc;
+    cksum_finalize(&ctx, length);
+    return ctx.crc;
+}
+
+static void testOneShot(const unsigned char *message,
+                        const unsigned char *longMessage)
+{
+    HASH_TEST_CHECK(crc32Of(message, HashTestMessageLength) == gCrc32,
+                    "%s: wrong CRC32", crc_implementation());
+    HASH_TEST_CHECK(cksumFinal(cksumOf(message, HashTestMessageLength),
+                               HashTestMessageLength) == gCksum,
+                    "%s: wrong cksum", crc_implementation());
+
+    if (longMessage != NULL) {
+        HASH_TEST_CHECK(crc32Of(longMessage, TestLongLength) == gLongCrc32,
+                        "%s: wrong CRC32 of the long message",
+                        crc_implementation());
+        HASH_TEST_CHECK(cksumFinal(cksumOf(longMessage, TestLongLength),
+                                   TestLongLength) == gLongCksum,
+                        "%s: wrong cksum of the long message",
+                        crc_implementation());
+    }
+}
+
+static void testCombine(const unsigned char *message)
+{
+    size_t split = 0;
+    size_t i = 0;
+    uint32_t crc = 0;
+
+    for (i = 0; i < sizeof(gSplits)/sizeof(gSplits[0]); i++) {
+        split = gSplits[i];
+
+        crc = hash_crc32_combine(crc32Of(message, split),
+                                 crc32Of(message + split,
+                                         HashTestMessageLength - split),
+                                 HashTestMessageLength - split);
+        HASH_TEST_CHECK(crc == gCrc32,
+                        "%s: CRC32 combined at %zu is %08x",
+                        crc_implementation(), split, crc);
+
+        crc = hash_cksum_combine(cksumOf(message, split),
+                                 cksumOf(message + split,
+                                         HashTestMessageLength - split),
+                                 HashTestMessageLength - split);
+        crc = cksumFinal(crc, HashTestMessageLength);
+        HASH_TEST_CHECK(crc == gCksum,
+                        "%s: cksum combined at %zu is %08x",
+                        crc_implementation(), split, crc);
+    }
+}
+
+/*
+    testAssociative - combining three CRCs in either order gives the same
+                      CRC, for lengths far larger than can be hashed here
+ */
+
+static void testAssociative(void)
+{
+    static const unsigned long long lengths[] = {
+        1, 3, 1000, 1ULL << 32, (1ULL << 32) + 5, 123456789012ULL,
+    };
+    const uint32_t a = 0x12345678U;
+    const uint32_t b = 0x9abcdef0U;
+    const uint32_t c = 0x0fedcba9U;
+    size_t i = 0;
+    size_t j = 0;
+    unsigned long long lb = 0;
+    unsigned long long lc = 0;
+
+    for (i = 0; i < sizeof(lengths)/sizeof(lengths[0]); i++) {
+        for (j = 0; j < sizeof(lengths)/sizeof(lengths[0]); j++) {
+            lb = lengths[i];
+            lc = lengths[j];
+            HASH_TEST_CHECK(hash_crc32_combine(hash_crc32_combine(a, b, lb),
+                                               c,
+                                               lc) ==
+                            hash_crc32_combine(a,
+                                               hash_crc32_combine(b, c, lc),
+                                               lb + lc),
+                            "CRC32 combine isn't associative for %llu, %llu",
+                            lb, lc);
+            HASH_TEST_CHECK(hash_cksum_combine(hash_cksum_combine(a, b, lb),
+                                               c,
+                                               lc) ==
+                            hash_cksum_combine(a,
+                                               hash_cksum_combine(b, c, lc),
+                                               lb + lc),
+                            "cksum combine isn't associative for %llu, %llu",
+                            lb, lc);
+        }
+    }
+
+    // combining with an empty message changes nothing
+
+    HASH_TEST_CHECK(hash_crc32_combine(a, 0, 0) == a &&
+                    hash_cksum_combine(a, 0, 0) == a,
+                    "combining with an empty message changed the CRC");
+}
+
+int main(void)
+{
+    unsigned char *message = NULL;
+    unsigned char *longMessage = NULL;
+    int pclmul = 0;
+
+    message = malloc(HashTestMessageLength);
+    longMessage = malloc(TestLongLength);
+    if (message == NULL) {
+        return 1;
+    }
+    hash_test_message(message, HashTestMessageLength);
+    if (longMessage != NULL) {
+        hash_test_message(longMessage, TestLongLength);
+    }
+
+    // the portable code first, then PCLMULQDQ where the cpu has it
+
+    for (pclmul = 0; pclmul < 2; pclmul++) {
+        crc_use_pclmul(pclmul);
+        testOneShot(message, longMessage);
+        testCombine(message);
+        printf("%s: checked\n", crc_implementation());
+    }
+
+    testAssociative();
+
+    free(longMessage);
+    free(message);
+
+    return hash_test_result("test_crc");
+}
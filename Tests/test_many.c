@@ -0,0 +1,264 @@
+/*
+    Hash - test_many.c
+
+    Checks hash_engine_hash_many and hash_engine_update_many for every
+    hash the engine supports, at the portable and the detected SIMD
+    levels.  The digests of a batch of messages of assorted lengths,
+    including runs of equal lengths that fill the SIMD lanes, must be
+    those of hashing each message on its own, and the whole test
+    message must give its known digest.
+
+    History:
+
+    v. 1.0.0 (10/18/2026) - Initial version
+
+    Copyright (c) 2026 Sriranga R. Veeraraghavan <ranga@calalum.org>
+
+    Permission is hereby granted, free of charge, to any person obtaining
+    a copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+    OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "hash_test.h"
+
+// Lengths of the messages in a batch, message i starts at byte i of the
+// test message; the last one is the whole test message
+
+static const size_t gLengths[] = {
+    0, 1, 3, 55, 56, 63, 64, 65, 111, 112, 127, 128, 129, 136, 168,
+    1000, 1023, 1024, 1024, 1024, 1024, 1024, 1024, 1024, 1024, 1024,
+    1025, 2048, 2048, 2048, 2048, 4096, 4096, 4096, 4096, 4096, 4096,
+    4096, 4096, 8192, 8193, 16384, 16384, 16384, 16384, 65536,
+    HashTestMessageLength,
+};
+
+enum {
+    TestCount = sizeof(gLengths)/sizeof(gLengths[0]),
+    TestRounds = 5,
+};
+
+/* hashOne - the digest of one message, with a single context */
+
+static void hashOne(const hashEngineDescriptor *desc,
+                    const unsigned char *data,
+                    size_t length,
+                    unsigned char *digest)
+{
+    hashEngineContext *ctx = hash_engine_new(desc->type);
+
+    memset(digest, 0, desc->digestLength);
+    if (ctx != NULL) {
+        hash_engine_update(ctx, data, length);
+        hash_engine_final(ctx, digest);
+        hash_engine_free(ctx);
+    }
+}
+
+static void testHashMany(const hashEngineDescriptor *desc,
+                         const unsigned char *message,
+                         const unsigned char *expected)
+{
+    const unsigned char *inputs[TestCount];
+    unsigned char *digests = NULL;
+    unsigned char digest[HashTestMaxDigest];
+    size_t i = 0;
+
+    digests = calloc(TestCount, desc->digestLength);
+    if (digests == NULL) {
+        return;
+    }
+
+    for (i = 0; i < TestCount; i++) {
+        inputs[i] = (i == TestCount - 1 ? message : message + i);
+    }
+
+    HASH_TEST_CHECK(hash_engine_hash_many(desc->type,
+                                          inputs,
+                                          gLengths,
+                                          TestCount,
+                                          digests) == 0,
+                    "%s: hash_many failed", desc->name);
+
+    for (i = 0; i < TestCount; i++) {
+        hashOne(desc, inputs[i], gLengths[i], digest);
+        HASH_TEST_CHECK(memcmp(digests + i*desc->digestLength,
+                               digest,
+                               desc->digestLength) == 0,
+                        "%s: hash_many digest %zu (%zu bytes) is wrong",
+                        desc->name, i, gLengths[i]);
+    }
+
+    HASH_TEST_CHECK(memcmp(digests + (TestCount - 1)*desc->digestLength,
+                           expected,
+                           desc->digestLength) == 0,
+                    "%s: hash_many digest of the test message is wrong",
+                    desc->name);
+
+    // a batch of one, and an empty batch
+
+    HASH_TEST_CHECK(hash_engine_hash_many(desc->type,
+                                          inputs + TestCount - 1,
+                                          gLengths + TestCount - 1,
+                                          1,
+                                          digests) == 0 &&
+                    memcmp(digests, expected, desc->digestLength) == 0,
+                    "%s: hash_many of one message is wrong", desc->name);
+    HASH_TEST_CHECK(hash_engine_hash_many(desc->type,
+                                          inputs,
+                                          gLengths,
+                                          0,
+                                          digests) == 0,
+                    "%s: hash_many of no messages failed", desc->name);
+
+    free(digests);
+}
+
+/*
+    testUpdateMany - update lanes * 2 + 1 contexts together in rounds of
+                     uneven lengths; context 0 is given the whole test
+                     message, the others start at different offsets
+ */
+
+static void testUpdateMany(const hashEngineDescriptor *desc,
+                           const unsigned char *message,
+                           const unsigned char *expected)
+{
+    hashEngineContext *ctxs[2*16 + 1];
+    hashEngineContext *other = NULL;
+    const unsigned char *data[2*16 + 1];
+    size_t lengths[2*16 + 1];
+    size_t offsets[2*16 + 1];
+    size_t ends[2*16 + 1];
+    unsigned char digest[HashTestMaxDigest];
+    unsigned char want[HashTestMaxDigest];
+    size_t count = 0;
+    size_t round = 0;
+    size_t i = 0;
+
+    count = 2*hash_engine_lanes(desc->type) + 1;
+    if (count > sizeof(ctxs)/sizeof(ctxs[0])) {
+        count = sizeof(ctxs)/sizeof(ctxs[0]);
+    }
+
+    memset(ctxs, 0, sizeof(ctxs));
+    for (i = 0; i < count; i++) {
+        ctxs[i] = hash_engine_new(desc->type);
+        if (ctxs[i] == NULL) {
+            goto done;
+        }
+        offsets[i] = (i == 0 ? 0 : 97*i);
+        ends[i] = (i == 0 ?
+                   HashTestMessageLength :
+                   HashTestMessageLength - 1031*i);
+    }
+
+    for (round = 0; round < TestRounds; round++) {
+        for (i = 0; i < count; i++) {
+            lengths[i] = (round == TestRounds - 1 ?
+                          ends[i] - offsets[i] :
+                          (ends[i] - offsets[i]) / (TestRounds - round) +
+                              (i*13) % 64);
+            if (lengths[i] > ends[i] - offsets[i]) {
+                lengths[i] = ends[i] - offsets[i];
+            }
+            data[i] = message + offsets[i];
+            offsets[i] += lengths[i];
+        }
+        HASH_TEST_CHECK(hash_engine_update_many(ctxs,
+                                                data,
+                                                lengths,
+                                                count) == 0,
+                        "%s: update_many failed", desc->name);
+    }
+
+    for (i = 0; i < count; i++) {
+        memset(digest, 0, sizeof(digest));
+        hash_engine_final(ctxs[i], digest);
+        if (i == 0) {
+            memcpy(want, expected, desc->digestLength);
+        } else {
+            hashOne(desc, message + 97*i, ends[i] - 97*i, want);
+        }
+        HASH_TEST_CHECK(memcmp(digest, want, desc->digestLength) == 0,
+                        "%s: update_many digest %zu is wrong",
+                        desc->name, i);
+    }
+
+    // contexts of different hashes are refused
+
+    other = hash_engine_new(desc->type == HASH_MD5 ? HASH_SHA1 : HASH_MD5);
+    if (other != NULL && count > 1) {
+        hash_engine_free(ctxs[count - 1]);
+        ctxs[count - 1] = other;
+        HASH_TEST_CHECK(hash_engine_update_many(ctxs,
+                                                data,
+                                                lengths,
+                                                count) != 0,
+                        "%s: update_many accepted a mix of hashes",
+                        desc->name);
+    } else {
+        hash_engine_free(other);
+    }
+
+done:
+    for (i = 0; i < count; i++) {
+        hash_engine_free(ctxs[i]);
+    }
+}
+
+int main(void)
+{
+    const hashEngineDescriptor *desc = NULL;
+    hashEngineSimdLevel levels[2];
+    unsigned char *message = NULL;
+    unsigned char expected[HashTestMaxDigest];
+    size_t tested = 0;
+    size_t i = 0;
+    size_t n = 0;
+
+    message = malloc(HashTestMessageLength);
+    if (message == NULL) {
+        return 1;
+    }
+    hash_test_message(message, HashTestMessageLength);
+
+    levels[0] = HASH_ENGINE_SIMD_PORTABLE;
+    levels[1] = hash_engine_simd_detected();
+
+    for (i = 0; i < 2; i++) {
+        hash_engine_set_simd_level(levels[i]);
+        tested = 0;
+
+        for (n = 0; (desc = hash_engine_descriptor_at(n)) != NULL; n++) {
+            HASH_TEST_CHECK(hash_test_expected(desc, expected) == 0,
+                            "%s: no known digest", desc->name);
+            if (hash_test_expected(desc, expected) != 0) {
+                continue;
+            }
+
+            testHashMany(desc, message, expected);
+            testUpdateMany(desc, message, expected);
+            tested++;
+        }
+
+        printf("%s: %zu hashes\n", hash_engine_simd_name(levels[i]), tested);
+    }
+
+    free(message);
+
+    return hash_test_result("test_many");
+}
@@ -0,0 +1,195 @@
+/*
+    Hash - test_serialize.c
+
+    Checks hash_engine_serialize / hash_engine_deserialize for every hash
+    the engine supports, at the portable and the detected SIMD levels:
+    a context that is serialized part way through the test message,
+    restored into a new context and finished there must give the known
+    digest, and so must the original context.  Corrupted states, and
+    states of another hash, must be rejected.
+
+    History:
+
+    v. 1.0.0 (10/18/2026) - Initial version
+
+    Copyright (c) 2026 Sriranga R. Veeraraghavan <ranga@calalum.org>
+
+    Permission is hereby granted, free of charge, to any person obtaining
+    a copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+    OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "hash_test.h"
+
+// Where the test message is split, the ends of the first block, chunk
+// or leaf of the various hashes, and the middle of them
+
+static const size_t gSplits[] = {
+    0, 1, 63, 64, 65, 1023, 1025, 4097, 8193, 65536, 65537, 99999,
+    HashTestMessageLength,
+};
+
+/* testRoundTrip - split the message at split, see above */
+
+static void testRoundTrip(const hashEngineDescriptor *desc,
+                          const unsigned char *message,
+                          const unsigned char *expected,
+                          size_t split)
+{
+    hashEngineContext *ctx = NULL;
+    hashEngineContext *copy = NULL;
+    unsigned char *state = NULL;
+    unsigned char digest[HashTestMaxDigest];
+    size_t size = 0;
+
+    ctx = hash_engine_new(desc->type);
+    copy = hash_engine_new(desc->type);
+    HASH_TEST_CHECK(ctx != NULL && copy != NULL,
+                    "%s: cannot create contexts", desc->name);
+    if (ctx == NULL || copy == NULL) {
+        goto done;
+    }
+
+    hash_engine_update(ctx, message, split);
+
+    size = hash_engine_serialized_size(ctx);
+    state = malloc(size);
+    HASH_TEST_CHECK(size > 0 && state != NULL,
+                    "%s: no serialized size", desc->name);
+    if (state == NULL) {
+        goto done;
+    }
+
+    HASH_TEST_CHECK(hash_engine_serialize(ctx, state, size - 1) == 0,
+                    "%s: serialized into a short buffer", desc->name);
+    HASH_TEST_CHECK(hash_engine_serialize(ctx, state, size) == size,
+                    "%s: serialize failed at %zu", desc->name, split);
+    HASH_TEST_CHECK(hash_engine_deserialize(copy, state, size) == 0,
+                    "%s: deserialize failed at %zu", desc->name, split);
+
+    hash_engine_update(copy, message + split, HashTestMessageLength - split);
+    memset(digest, 0, sizeof(digest));
+    HASH_TEST_CHECK(hash_engine_final(copy, digest) >= 0 &&
+                    memcmp(digest, expected, desc->digestLength) == 0,
+                    "%s: wrong digest after restoring at %zu",
+                    desc->name, split);
+
+    hash_engine_update(ctx, message + split, HashTestMessageLength - split);
+    memset(digest, 0, sizeof(digest));
+    HASH_TEST_CHECK(hash_engine_final(ctx, digest) >= 0 &&
+                    memcmp(digest, expected, desc->digestLength) == 0,
+                    "%s: wrong digest after serializing at %zu",
+                    desc->name, split);
+
+    // a flipped bit in the state, or a truncated state, is rejected
+
+    hash_engine_reset(copy);
+    state[size / 2] ^= 0x10;
+    HASH_TEST_CHECK(hash_engine_deserialize(copy, state, size) != 0,
+                    "%s: accepted a corrupted state", desc->name);
+    state[size / 2] ^= 0x10;
+
+    hash_engine_reset(copy);
+    HASH_TEST_CHECK(hash_engine_deserialize(copy, state, size - 1) != 0,
+                    "%s: accepted a truncated state", desc->name);
+
+done:
+    free(state);
+    hash_engine_free(copy);
+    hash_engine_free(ctx);
+}
+
+/* testOtherType - a state can't be restored into another hash */
+
+static void testOtherType(const hashEngineDescriptor *desc,
+                          const hashEngineDescriptor *other,
+                          const unsigned char *message)
+{
+    hashEngineContext *ctx = hash_engine_new(desc->type);
+    hashEngineContext *copy = hash_engine_new(other->type);
+    unsigned char *state = NULL;
+    size_t size = 0;
+
+    if (ctx != NULL && copy != NULL) {
+        hash_engine_update(ctx, message, 1000);
+        size = hash_engine_serialized_size(ctx);
+        state = malloc(size);
+        if (state != NULL &&
+            hash_engine_serialize(ctx, state, size) == size) {
+            HASH_TEST_CHECK(hash_engine_deserialize(copy, state, size) != 0,
+                            "%s: state accepted by %s",
+                            desc->name, other->name);
+        }
+    }
+
+    free(state);
+    hash_engine_free(copy);
+    hash_engine_free(ctx);
+}
+
+int main(void)
+{
+    const hashEngineDescriptor *desc = NULL;
+    const hashEngineDescriptor *prev = NULL;
+    hashEngineSimdLevel levels[2];
+    unsigned char *message = NULL;
+    unsigned char expected[HashTestMaxDigest];
+    size_t tested = 0;
+    size_t i = 0;
+    size_t j = 0;
+    size_t n = 0;
+
+    message = malloc(HashTestMessageLength);
+    if (message == NULL) {
+        return 1;
+    }
+    hash_test_message(message, HashTestMessageLength);
+
+    levels[0] = HASH_ENGINE_SIMD_PORTABLE;
+    levels[1] = hash_engine_simd_detected();
+
+    for (i = 0; i < 2; i++) {
+        hash_engine_set_simd_level(levels[i]);
+        prev = NULL;
+        tested = 0;
+
+        for (n = 0; (desc = hash_engine_descriptor_at(n)) != NULL; n++) {
+            HASH_TEST_CHECK(hash_test_expected(desc, expected) == 0,
+                            "%s: no known digest", desc->name);
+            if (hash_test_expected(desc, expected) != 0) {
+                continue;
+            }
+
+            for (j = 0; j < sizeof(gSplits)/sizeof(gSplits[0]); j++) {
+                testRoundTrip(desc, message, expected, gSplits[j]);
+            }
+            if (prev != NULL) {
+                testOtherType(desc, prev, message);
+            }
+
+            prev = desc;
+            tested++;
+        }
+
+        printf("%s: %zu hashes\n", hash_engine_simd_name(levels[i]), tested);
+    }
+
+    free(message);
+
+    return hash_test_result("test_serialize");
+}
@@ -0,0 +1,278 @@
+/*
+    Hash - test_skein_tree.c
+
+    Checks the Skein tree hashes against known answers computed by
+    Tests/skein_tree.py, an implementation of Skein written from the
+    specification rather than from Skein's reference code.  The
+    skein_tree API is checked with small leaves, nodes and heights so
+    that every level of the tree, and the collapse into a single node at
+    Y_m, is used; the engine's skein-*-tree hashes are checked with a
+    message long enough to fill a level 2 node, at the portable and
+    the detected SIMD levels.
+
+    History:
+
+    v. 1.0.0 (10/18/2026) - Initial version
+
+    Copyright (c) 2026 Sriranga R. Veeraraghavan <ranga@calalum.org>
+
+    Permission is hereby granted, free of charge, to any person obtaining
+    a copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+    OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "hash_test.h"
+#include "skein_tree.h"
+
+typedef struct skeinTreeVector {
+    size_t stateBits;
+    size_t hashBits;
+    unsigned int leafLevel;
+    unsigned int fanout;
+    unsigned int maxLevel;
+    size_t length;
+    const char *digest;
+} skeinTreeVector;
+
+static const skeinTreeVector gVectors[] = {
+    { 256, 256, 1, 1, 2, 0,
+      "4c2521b1d3ce21b8ea87e126044c1def8b01772e4e3838f7b191b666"
+      "64aa190c" },
+    { 256, 256, 1, 1, 2, 1,
+      "b9135450f124fbade0840f02dcdae6fa488536952b0591bfb6192245"
+      "53db6706" },
+    { 256, 256, 1, 1, 2, 64,
+      "0331d6c3fec47fb35370419be5920ad8eb02a4fde999acd971a5a2c1"
+      "88893368" },
+    { 256, 256, 1, 1, 2, 65,
+      "84d05f8af21ca23f6e03fa0f0b72578ed547f88c1cfd141554228e79"
+      "134bd272" },
+    { 256, 256, 1, 1, 2, 1000,
+      "cd34a1ea8724debbfea0f72b0998d56ae3279e29117a2beb8c466f61"
+      "90a8de81" },
+    { 512, 512, 1, 1, 3, 3000,
+      "1b81ccf08f4a4b324c389a5be4f725dd8219a41536ea879acf2da99d"
+      "ca2dc0aa0810b004575058a632452e7c95c791b1785770917be72a22"
+      "f64aed49d51459c2" },
+    { 512, 512, 1, 2, 255, 5000,
+      "f7234a83c11cc495757b9fca15ac71642ddd6b1081f3280bc419cd10"
+      "367e6617b1eeded668798d91d9307898d2094f121204a90f946c2ef6"
+      "709ad6623c7f6609" },
+    { 1024, 1024, 2, 1, 2, 5000,
+      "aad50b85772f76af37c1f804aa599104106613a9b8246c8ffb5fac02"
+      "5ed95fc902e3f7d263258d9ee871c48cb58d6eff3c858e0c7ab781b5"
+      "37d60f2ba0db98a83a062df45484e44e2293c9dffed20881f154c6f2"
+      "593445da91c023940a8ff16dd18ed31a53f2d447b1e6c5b10a185e10"
+      "20efe80ca57e51e40d1cd5039c1c27bf" },
+    { 1024, 1024, 1, 1, 255, 10000,
+      "0ef9c9c349d844344b018027e4f799fd81ea9ad20379ca5cdff5d7ca"
+      "b14aa827d99500d49d42f14a83a0e4965529d4376ae0c9635b7f90b5"
+      "3ab08ebd0818bd9f1cdaa5863d54ec3ca4370cc060fe074c3e9cb644"
+      "ab74f847a757924088d8f9b6ff0c2fd569b88c30f33a71692a1e9dc8"
+      "990aed4ad7dfcde489f39d7c0554c04b" },
+    { 256, 1024, 1, 1, 255, 1000,
+      "03c2db3b6e7d8bb31b646e04a03fa7d7cae168ef613869304b5c225e"
+      "7f175bc25bca307d87e96295f56041921e2ecc6b4a69b1314425fece"
+      "3d6b486a36dbabd7f5fa85466c32da495487fff9446f391842553b7d"
+      "5870805575153f8b06b9dbd6313b712be1f4924a93b9578c2018e40f"
+      "f12423012b5dbce85923be33a4174e00" },
+    { 512, 256, 2, 2, 4, 20000,
+      "6696f6530f5e5515676d4e4830e941c32efa04a08a13e623c14af04f"
+      "c5e99e70" },
+    { 512, 512, 1, 1, 255, 100000,
+      "ed6efb8ef84b811d47e0950f175f2a1a51cf9ed89f66c5a7134c15d0"
+      "df9f8d5ec7dcdee2ff37cce5c47b5081edd34e5aa2b936980c72a962"
+      "8e977afe154b4bfc" },
+};
+
+// the engine's hashes, 64KB leaves, 256 children per node, Y_m = 255
+
+enum {
+    EngineMessageLength = 16*1048576 + 12345,
+};
+
+static const struct {
+    const char *name;
+    const char *digest;
+} gEngineVectors[] = {
+    { "skein-256-tree",
+      "6d9cfb47d448e658d0970e79a0c93eba5dc14a040aa6a783946fe859"
+      "0002454c" },
+    { "skein-512-tree",
+      "12be596202ca9c4eccdb5704b710c59f0bc38a57cdeca6ac6e1ca8e9"
+      "d4be5b556d2b72abe438878e6470763a5ce1595c5622890b449f6846"
+      "da68923d96ef9be5" },
+    { "skein-1024-tree",
+      "d933cf5392b97e951513d984bee0129c49e153f990fd4d6ad4800c35"
+      "617443dd4219cb3008e3c31bfcea1c1b109a7f3015e73b7e9e585528"
+      "898f8ab35ab38c83fbda8d9fac2ae9412ccf98291d40d8b2ee2c7559"
+      "595ed4ad5a70fcdef7b5d7f8814650704c1bcb8c7f226f988bda0050"
+      "5e47b56518e7a16c1275ce2b7331bbce" },
+};
+
+/* testVector - hash the vector's message whole, and in pieces of
+                growing (odd) lengths */
+
+static void testVector(const skeinTreeVector *v,
+                       const unsigned char *message)
+{
+    skein_tree_state *S = NULL;
+    unsigned char expected[HashTestMaxDigest];
+    unsigned char digest[HashTestMaxDigest];
+    size_t hashBytes = (v->hashBits + 7) / 8;
+    size_t offset = 0;
+    size_t step = 0;
+    size_t n = 0;
+
+    S = malloc(sizeof(*S));
+    if (S == NULL ||
+        hash_test_hex(v->digest, expected, hashBytes) != 0) {
+        HASH_TEST_CHECK(0, "skein-%zu-%zu: bad vector",
+                        v->stateBits, v->hashBits);
+        free(S);
+        return;
+    }
+
+    HASH_TEST_CHECK(skein_tree_init(S,
+                                    v->stateBits,
+                                    v->hashBits,
+                                    v->leafLevel,
+                                    v->fanout,
+                                    v->maxLevel) == SKEIN_SUCCESS,
+                    "skein-%zu-%zu: init failed",
+                    v->stateBits, v->hashBits);
+    skein_tree_update(S, message, v->length);
+    memset(digest, 0, sizeof(digest));
+    skein_tree_final(S, digest);
+    HASH_TEST_CHECK(memcmp(digest, expected, hashBytes) == 0,
+                    "skein-%zu-%zu (%u, %u, %u): digest of %zu bytes is "
+                    "wrong",
+                    v->stateBits, v->hashBits,
+                    v->leafLevel, v->fanout, v->maxLevel, v->length);
+
+    (void)skein_tree_init(S,
+                          v->stateBits,
+                          v->hashBits,
+                          v->leafLevel,
+                          v->fanout,
+                          v->maxLevel);
+    for (offset = 0, step = 1; offset < v->length; offset += n) {
+        n = (step < v->length - offset ? step : v->length - offset);
+        skein_tree_update(S, message + offset, n);
+        step += 3*step/2;
+    }
+    memset(digest, 0, sizeof(digest));
+    skein_tree_final(S, digest);
+    HASH_TEST_CHECK(memcmp(digest, expected, hashBytes) == 0,
+                    "skein-%zu-%zu (%u, %u, %u): digest of %zu bytes in "
+                    "pieces is wrong",
+                    v->stateBits, v->hashBits,
+                    v->leafLevel, v->fanout, v->maxLevel, v->length);
+
+    free(S);
+}
+
+/* testEngine - the engine's tree hash of the long message, in one update
+                and in updates that split leaves */
+
+static void testEngine(const char *name,
+                       const char *hex,
+                       const unsigned char *message)
+{
+    const hashEngineDescriptor *desc = NULL;
+    hashEngineContext *ctx = NULL;
+    unsigned char expected[HashTestMaxDigest];
+    unsigned char digest[HashTestMaxDigest];
+    size_t offset = 0;
+    size_t n = 0;
+
+    desc = hash_engine_descriptor_by_name(name);
+    HASH_TEST_CHECK(desc != NULL, "%s: not supported", name);
+    if (desc == NULL ||
+        hash_test_hex(hex, expected, desc->digestLength) != 0) {
+        return;
+    }
+
+    ctx = hash_engine_new(desc->type);
+    if (ctx == NULL) {
+        return;
+    }
+    hash_engine_update(ctx, message, EngineMessageLength);
+    memset(digest, 0, sizeof(digest));
+    hash_engine_final(ctx, digest);
+    HASH_TEST_CHECK(memcmp(digest, expected, desc->digestLength) == 0,
+                    "%s: digest of %d bytes is wrong",
+                    name, EngineMessageLength);
+    hash_engine_free(ctx);
+
+    ctx = hash_engine_new(desc->type);
+    if (ctx == NULL) {
+        return;
+    }
+    for (offset = 0; offset < EngineMessageLength; offset += n) {
+        n = 1048576 + 4097;
+        if (n > EngineMessageLength - offset) {
+            n = EngineMessageLength - offset;
+        }
+        hash_engine_update(ctx, message + offset, n);
+    }
+    memset(digest, 0, sizeof(digest));
+    hash_engine_final(ctx, digest);
+    HASH_TEST_CHECK(memcmp(digest, expected, desc->digestLength) == 0,
+                    "%s: digest of %d bytes in pieces is wrong",
+                    name, EngineMessageLength);
+    hash_engine_free(ctx);
+}
+
+int main(void)
+{
+    hashEngineSimdLevel levels[2];
+    unsigned char *message = NULL;
+    size_t i = 0;
+    size_t j = 0;
+
+    message = malloc(EngineMessageLength);
+    if (message == NULL) {
+        return 1;
+    }
+    hash_test_message(message, EngineMessageLength);
+
+    for (i = 0; i < sizeof(gVectors)/sizeof(gVectors[0]); i++) {
+        testVector(&gVectors[i], message);
+    }
+
+    levels[0] = HASH_ENGINE_SIMD_PORTABLE;
+    levels[1] = hash_engine_simd_detected();
+
+    for (i = 0; i < 2; i++) {
+        hash_engine_set_simd_level(levels[i]);
+        for (j = 0;
+             j < sizeof(gEngineVectors)/sizeof(gEngineVectors[0]);
+             j++) {
+            testEngine(gEngineVectors[j].name,
+                       gEngineVectors[j].digest,
+                       message);
+        }
+        printf("%s: %zu tree hashes\n",
+               hash_engine_simd_name(levels[i]),
+               sizeof(gEngineVectors)/sizeof(gEngineVectors[0]));
+    }
+
+    free(message);
+
+    return hash_test_result("test_skein_tree");
+}
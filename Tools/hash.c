@@ -0,0 +1,2370 @@
+/*
+    Hash - hash.c
+
+    Headless command line interface to the hash engine.  Prints
+    coreutils (sha256sum, b2sum, etc.) compatible lines for each file
+    and each requested hash.
+
+    usage: hash [-a hash[,hash...]] [-b size] [-q depth] [-f list] [-0]
+                [-i] [-n] [-r] [-j threads] [-C cache [--paranoid]
+                [--clear-cache]] [-k checkpoint [-K interval] [--append]]
+                [-s] [-t] [-u] [-l] [file ...]
+           hash -c [--quiet] [--fail-fast] [-a hash] [-b size]
+                [-j threads] [-n] [manifest ...]
+           hash --outboard [-t] [-u] file ...
+           hash --verify-slice start:length --root digest file
+           hash --xof length [-a hash] [-b size] [-n] [file]
+
+    History:
+
+    v. 1.0.0 (10/18/2026) - Initial version
+    v. 1.0.1 (10/18/2026) - read each file once into a ring of buffers
+                            that is hashed by one worker thread per
+                            requested hash (-s to hash sequentially)
+    v. 1.0.2 (10/18/2026) - memory map large regular files instead of
+                            reading them (-n to always read)
+    v. 1.0.3 (10/18/2026) - pipeline reading and hashing, even for a
+                            single hash, with a configurable block size
+                            (-b) and queue depth (-q)
+    v. 1.0.4 (10/18/2026) - SHA256 is now available on all platforms,
+                            so it is always the default
+    v. 1.0.5 (10/18/2026) - hash several files at once in the SIMD lanes
+                            when a single MD5, SHA1 or SHA256 hash is
+                            requested (-i to hash one file at a time)
+    v. 1.0.6 (10/18/2026) - hash directories recursively (-r) on a pool
+                            of worker threads (-j)
+    v. 1.0.7 (10/18/2026) - skip files whose digests are in a digest
+                            cache (-C), optionally checking them
+                            (--paranoid)
+    v. 1.0.8 (10/18/2026) - periodically save the hash state of large
+                            files to a checkpoint (-k, -K) and resume
+                            from it after an interruption
+    v. 1.0.9 (10/18/2026) - with --append, keep the checkpoint at the
+                            end of the file, and only hash what has
+                            been appended since the next time
+    v. 1.1.0 (10/18/2026) - verify the files listed in manifests (-c)
+                            in parallel, reporting failures as soon as
+                            they are found (--fail-fast to stop at the
+                            first one)
+    v. 1.1.1 (10/18/2026) - write BLAKE3 (Bao) outboard trees
+                            (--outboard) and use them to verify byte
+                            ranges of a file (--verify-slice)
+    v. 1.1.2 (10/18/2026) - write any amount of raw output from an XOF
+                            (SHAKE, BLAKE3, K12) with --xof
+    v. 1.1.3 (10/18/2026) - if a mapped file is truncated while it is
+                            being hashed, read it instead of crashing
+
+    Copyright (c) 2026 Sriranga R. Veeraraghavan <ranga@calalum.org>
+
+    Permission is hereby granted, free of charge, to any person obtaining
+    a copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+    OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <ctype.h>
+#include <sys/stat.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <getopt.h>
+#include <limits.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "hash_cache.h"
+#include "hash_checkpoint.h"
+#include "hash_engine.h"
+#include "hash_map.h"
+#include "hash_multi.h"
+#include "hash_tree.h"
+#include "blake3.h"
+
+// Default File Buffer Size (400K), same as the app, and the default
+// number of buffers that can be queued for hashing
+
+enum {
+    HashCLIDefaultFileBufferSize = 409600,
+    HashCLIDefaultQueueDepth = 4,
+};
+
+// Default number of bytes hashed between checkpoints (1G)
+
+enum {
+    HashCLIDefaultCheckpointInterval = 1073741824,
+};
+
+// Size of the buffer that XOF output is squeezed into (4M), large
+// enough for BLAKE3 to split each squeeze across its thread pool
+
+enum {
+    HashCLIXofBufferSize = 4194304,
+};
+
+// Maximum number of hashes that can be requested at once
+
+enum {
+    HashCLIMaxHashes = HASH_TYPE_COUNT,
+};
+
+// Maximum number of SIMD lanes used to hash files in interleaved mode
+
+enum {
+    HashCLIMaxLanes = 16,
+};
+
+// Long options (there are no short equivalents)
+
+enum {
+    HashCLIOptionParanoid = 256,
+    HashCLIOptionClearCache,
+    HashCLIOptionAppend,
+    HashCLIOptionQuiet,
+    HashCLIOptionFailFast,
+    HashCLIOptionOutboard,
+    HashCLIOptionVerifySlice,
+    HashCLIOptionRoot,
+    HashCLIOptionXof,
+};
+
+static const struct option gLongOptions[] = {
+    { "paranoid",    no_argument, NULL, HashCLIOptionParanoid },
+    { "clear-cache", no_argument, NULL, HashCLIOptionClearCache },
+    { "append",      no_argument, NULL, HashCLIOptionAppend },
+    { "quiet",       no_argument, NULL, HashCLIOptionQuiet },
+    { "fail-fast",   no_argument, NULL, HashCLIOptionFailFast },
+    { "outboard",    no_argument, NULL, HashCLIOptionOutboard },
+    { "verify-slice", required_argument, NULL, HashCLIOptionVerifySlice },
+    { "root",        required_argument, NULL, HashCLIOptionRoot },
+    { "xof",         required_argument, NULL, HashCLIOptionXof },
+    { NULL,          0,           NULL, 0 },
+};
+
+/*
+    hashCLILane - a file being hashed in interleaved mode, several files
+                  are read a block at a time and their blocks are hashed
+                  together with hash_engine_update_many
+ */
+
+typedef enum {
+    HashCLILaneFree = 0,
+    HashCLILaneActive,
+    HashCLILaneDone,
+} hashCLILaneStatus;
+
+typedef struct hashCLILane {
+    hashCLILaneStatus  status;
+    char              *path;
+    int                fd;
+    int                err;
+    int                rc;
+    size_t             seq;
+    hashEngineContext *ctx;
+    unsigned char     *buffer;
+    unsigned char      digest[256];
+    hashCacheKey       key;
+    int                cacheable;
+    int                cached;
+    int                mismatch;
+    unsigned char      cachedDigest[HASH_CACHE_MAX_DIGEST_LENGTH];
+} hashCLILane;
+
+/*
+    hashCLICheck - the files listed in a manifest being checked (-c).
+                   Consecutive lines for the same file (e.g. from -a
+                   md5,sha256) are one entry, with an expected digest
+                   per line.
+ */
+
+typedef struct hashCLIExpected {
+    size_t  hash;       // index into the check's descs
+    char   *digest;     // as written in the manifest
+} hashCLIExpected;
+
+typedef struct hashCLICheckEntry {
+    char   *path;
+    size_t  first;      // index of the entry's first expected digest
+    size_t  count;
+} hashCLICheckEntry;
+
+typedef struct hashCLICheck {
+    const hashEngineDescriptor *descs[HashCLIMaxHashes];
+    size_t             hashCount;
+    hashCLICheckEntry *entries;
+    size_t             entryCount;
+    size_t             entryCapacity;
+    hashCLIExpected   *expected;
+    size_t             expectedCount;
+    size_t             expectedCapacity;
+    size_t             nextEntry;
+    size_t             checked;
+    size_t             badLines;
+    size_t             unreadable;
+    size_t             mismatched;
+    char              *digestStr;
+} hashCLICheck;
+
+/* hashes to compute and their contexts */
+
+typedef struct hashCLIState {
+    hashEngineContext *ctx[HashCLIMaxHashes];
+    size_t             count;
+    hashMultiContext  *multi;
+    unsigned char      digest[256];
+    char              *digestStr;
+    int                lowercase;
+    int                tagOutput;
+    int                noMap;
+    hashCLILane       *lanes;
+    size_t             laneCount;
+    size_t             laneBufferSize;
+    size_t             nextSeq;
+    size_t             printSeq;
+    int                laneFailed;
+    int                recursive;
+    size_t             threads;
+    size_t             blockSize;
+    hashCache         *cache;
+    int                paranoid;
+    int                treeFailed;
+    unsigned char      cached[HashCLIMaxHashes][HASH_CACHE_MAX_DIGEST_LENGTH];
+    const char        *checkpoint;
+    size_t             checkpointInterval;
+    int                append;
+    int                quiet;
+    int                failFast;
+    int                checkStopped;
+    unsigned long long xofLength;
+} hashCLIState;
+
+static const char *gProgName = "hash";
+
+/*
+    usage - print the usage message
+ */
+
+static void usage(void)
+{
+    fprintf(stderr,
+            "usage: %s [-a hash[,hash...]] [-b size] [-q depth] [-f list] [-0]"
+            " [-i] [-n] [-r] [-j threads]\n"
+            "       [-C cache [--paranoid] [--clear-cache]]"
+            " [-k checkpoint [-K interval] [--append]]\n"
+            "       [-s] [-t] [-u] [-l] [file ...]\n"
+            "       %s -c [--quiet] [--fail-fast] [-a hash] [-b size]"
+            " [-j threads] [-n]\n"
+            "       [manifest ...]\n"
+            "       %s --outboard [-t] [-u] file ...\n"
+            "       %s --verify-slice start:length --root digest file\n"
+            "       %s --xof length [-a hash] [-b size] [-n] [file]\n"
+            "    -a  hashes to compute (default: sha256)\n"
+            "    -b  read block size, in bytes (default: %d)\n"
+            "    -q  number of blocks to read ahead (default: %d)\n"
+            "    -f  read the files to hash from list ('-' for stdin)\n"
+            "    -0  names in the list are NUL terminated\n"
+            "    -i  hash one file at a time, instead of several at once\n"
+            "        in the SIMD lanes (md5, sha1, sha224, sha256)\n"
+            "    -n  read files instead of memory mapping them\n"
+            "    -r  hash the files in directories, recursively\n"
+            "    -j  number of threads for -r (default: one per cpu)\n"
+            "    -C  skip files whose digests are in the cache file\n"
+            "        (created if needed) and haven't changed since\n"
+            "    --paranoid     with -C, hash every file and report the\n"
+            "                   ones that don't match the cache\n"
+            "    --clear-cache  with -C, empty the cache first\n"
+            "    -k  save the state of the file being hashed to the\n"
+            "        checkpoint file, and resume from it if the file\n"
+            "        hasn't changed (implies -i)\n"
+            "    -K  bytes hashed between checkpoints (default: 1g)\n"
+            "    --append       with -k, for a file that is only appended\n"
+            "                   to: keep the checkpoint at its end, and\n"
+            "                   only hash the bytes added since\n"
+            "    -s  read and hash on one thread\n"
+            "    -t  output BSD style 'HASH (file) = digest' lines\n"
+            "    -u  output digests in upper case\n"
+            "    -l  list the supported hashes\n"
+            "    -c  check the files listed in the manifests (the output\n"
+            "        of this program or of sha256sum, etc.); -a sets the\n"
+            "        hash for lines that don't name one\n"
+            "    --quiet        with -c, don't print OK for each file\n"
+            "    --fail-fast    with -c, stop at the first failure\n"
+            "    --outboard     write each file's BLAKE3 tree to file.obao\n"
+            "                   (a Bao outboard) and print its digest\n"
+            "    --verify-slice verify the bytes from start to start +\n"
+            "                   length, using file.obao and the file's\n"
+            "                   trusted BLAKE3 digest (--root)\n"
+            "    --xof          write length bytes of raw output from an\n"
+            "                   XOF (default: shake256) to stdout\n",
+            gProgName,
+            gProgName,
+            gProgName,
+            gProgName,
+            gProgName,
+            HashCLIDefaultFileBufferSize,
+            HashCLIDefaultQueueDepth);
+}
+
+/*
+    listHashes - print the names of the supported hashes
+ */
+
+static void listHashes(void)
+{
+    const hashEngineDescriptor *desc = NULL;
+    size_t i = 0;
+
+    while ((desc = hash_engine_descriptor_at(i++)) != NULL) {
+        printf("%s\n", desc->name);
+    }
+}
+
+/*
+    parseNumber - parse a number, with an optional k, m or g suffix,
+                  that ends at stop (or at the end of the string)
+ */
+
+static int parseNumber(const char *str,
+                       int stop,
+                       unsigned long long *value,
+                       const char **next)
+{
+    unsigned long long multiplier = 1;
+    char *end = NULL;
+
+    if (!isdigit((unsigned char)*str)) {
+        return -1;
+    }
+
+    errno = 0;
+    *value = strtoull(str, &end, 10);
+    if (errno != 0 || end == str) {
+        return -1;
+    }
+
+    switch (*end) {
+        case 'k':
+        case 'K':
+            multiplier = 1024;
+            end++;
+            break;
+        case 'm':
+        case 'M':
+            multiplier = 1048576;
+            end++;
+            break;
+        case 'g':
+        case 'G':
+            multiplier = 1073741824;
+            end++;
+            break;
+        default:
+            break;
+    }
+
+    if ((*end != '\0' && *end != stop) || *value > ULLONG_MAX / multiplier) {
+        return -1;
+    }
+
+    *value *= multiplier;
+    if (next != NULL) {
+        *next = end;
+    }
+    return 0;
+}
+
+/*
+    parseSize - parse a positive number, with an optional k, m or g
+                suffix
+ */
+
+static int parseSize(const char *str, size_t *size)
+{
+    unsigned long long value = 0;
+    const char *end = NULL;
+
+    if (parseNumber(str, '\0', &value, &end) != 0 || value == 0 ||
+        value > (unsigned long long)(SIZE_MAX / 2)) {
+        return -1;
+    }
+
+    *size = (size_t)value;
+    return 0;
+}
+
+/*
+    addHashes - parse a comma separated list of hash names
+ */
+
+static int addHashes(hashCLIState *state, char *names)
+{
+    const hashEngineDescriptor *desc = NULL;
+    char *name = NULL;
+    char *last = NULL;
+
+    for (name = strtok_r(names, ",", &last);
+         name != NULL;
+         name = strtok_r(NULL, ",", &last)) {
+
+        desc = hash_engine_descriptor_by_name(name);
+        if (desc == NULL) {
+            fprintf(stderr, "%s: unknown or unsupported hash: %s\n",
+                    gProgName, name);
+            return -1;
+        }
+
+        if (state->count >= HashCLIMaxHashes) {
+            fprintf(stderr, "%s: too many hashes\n", gProgName);
+            return -1;
+        }
+
+        state->ctx[state->count] = hash_engine_new(desc->type);
+        if (state->ctx[state->count] == NULL) {
+            fprintf(stderr, "%s: %s\n", gProgName, strerror(ENOMEM));
+            return -1;
+        }
+        state->count++;
+    }
+
+    return 0;
+}
+
+/*
+    printName - print a file name, escaping it the way coreutils does
+                if it contains a backslash or a newline
+ */
+
+static void printName(const char *path)
+{
+    const char *p = NULL;
+
+    for (p = path; *p != '\0'; p++) {
+        switch (*p) {
+            case '\\':
+                fputs("\\\\", stdout);
+                break;
+            case '\n':
+                fputs("\\n", stdout);
+                break;
+            default:
+                putchar(*p);
+                break;
+        }
+    }
+}
+
+static int needsEscape(const char *path)
+{
+    return (strpbrk(path, "\\\n") != NULL);
+}
+
+/*
+    printResult - print the digest for a file in either the coreutils
+                  format ("digest  file") or the BSD/--tag format
+                  ("HASH (file) = digest")
+ */
+
+static void printResult(const hashCLIState *state,
+                        const hashEngineDescriptor *desc,
+                        const char *path)
+{
+    const char *p = NULL;
+
+    if (needsEscape(path)) {
+        putchar('\\');
+    }
+
+    if (state->tagOutput) {
+        for (p = desc->name; *p != '\0'; p++) {
+            putchar(toupper((unsigned char)*p));
+        }
+        fputs(" (", stdout);
+        printName(path);
+        printf(") = %s\n", state->digestStr);
+    } else {
+        printf("%s  ", state->digestStr);
+        printName(path);
+        putchar('\n');
+    }
+}
+
+/*
+    cacheKey - with a cache, set key to the identity and version of the
+               regular file open on fd.  returns 1 if the file's
+               digests can be cached.
+ */
+
+static int cacheKey(const hashCLIState *state, int fd, hashCacheKey *key)
+{
+    struct stat sb;
+
+    if (state->cache == NULL || fd == STDIN_FILENO ||
+        fstat(fd, &sb) != 0 || !S_ISREG(sb.st_mode)) {
+        return 0;
+    }
+
+    hash_cache_key(&sb, key);
+    return 1;
+}
+
+/* cacheUnchanged - whether the file open on fd still matches key */
+
+static int cacheUnchanged(int fd, const hashCacheKey *key)
+{
+    hashCacheKey now;
+    struct stat sb;
+
+    if (fstat(fd, &sb) != 0) {
+        return 0;
+    }
+
+    hash_cache_key(&sb, &now);
+    return (memcmp(&now, key, sizeof(hashCacheKey)) == 0);
+}
+
+/*
+    cacheUpdate - store a newly computed digest, returns 1 if there was a
+                  cached digest (cached is not NULL) and it is different
+ */
+
+static int cacheUpdate(hashCLIState *state,
+                       const hashCacheKey *key,
+                       const hashEngineDescriptor *desc,
+                       const unsigned char *digest,
+                       const unsigned char *cached)
+{
+    (void)hash_cache_store(state->cache,
+                           key,
+                           desc->type,
+                           digest,
+                           desc->digestLength);
+
+    return (cached != NULL && memcmp(digest, cached, desc->digestLength) != 0);
+}
+
+static void cacheMismatch(const char *path)
+{
+    fprintf(stderr,
+            "%s: %s: digest does not match the cache, but the file's"
+            " size and times do\n",
+            gProgName,
+            path);
+}
+
+/*
+    checkpointResume - with a checkpoint, set key to the identity and
+                       version of the regular file open on fd, and
+                       restore the contexts if the checkpoint is for
+                       this file (or, with --append, for a prefix
+                       of it).  returns 1 if the file can be
+                       checkpointed, and sets offset to the number of
+                       bytes that have already been hashed.
+ */
+
+static int checkpointResume(hashCLIState *state,
+                            int fd,
+                            hashCacheKey *key,
+                            unsigned long long *offset)
+{
+    struct stat sb;
+
+    *offset = 0;
+
+    if (state->checkpoint == NULL || fd == STDIN_FILENO ||
+        fstat(fd, &sb) != 0 || !S_ISREG(sb.st_mode)) {
+        return 0;
+    }
+
+    hash_cache_key(&sb, key);
+
+    // if the checkpoint is missing, stale, or for another file, the
+    // contexts are left reset and the file is hashed from the start
+
+    if (state->append) {
+        (void)hash_checkpoint_load_append(state->checkpoint,
+                                          fd,
+                                          key,
+                                          state->ctx,
+                                          state->count,
+                                          offset);
+    } else {
+        (void)hash_checkpoint_load(state->checkpoint,
+                                   key,
+                                   state->ctx,
+                                   state->count,
+                                   offset);
+    }
+    return 1;
+}
+
+/* checkpointSave - save the contexts once they have caught up */
+
+static void checkpointSave(hashCLIState *state,
+                           const char *path,
+                           int fd,
+                           const hashCacheKey *key,
+                           unsigned long long offset)
+{
+    int rc = 0;
+
+    hash_multi_wait(state->multi);
+
+    if (state->append) {
+        rc = hash_checkpoint_save_append(state->checkpoint,
+                                         fd,
+                                         key,
+                                         offset,
+                                         state->ctx,
+                                         state->count);
+    } else {
+        rc = hash_checkpoint_save(state->checkpoint,
+                                  key,
+                                  offset,
+                                  state->ctx,
+                                  state->count);
+    }
+
+    if (rc != 0) {
+        fprintf(stderr, "%s: %s: cannot save checkpoint for %s: %s\n",
+                gProgName, state->checkpoint, path, strerror(errno));
+    }
+}
+
+/*
+    writeXof - stream state->xofLength bytes of output from an XOF's
+               context to stdout.  returns 0 on success.
+ */
+
+static int writeXof(hashCLIState *state,
+                    hashEngineContext *ctx,
+                    const char *path)
+{
+    unsigned long long remaining = state->xofLength;
+    unsigned char *buffer = NULL;
+    size_t length = 0;
+    int err = 0;
+
+    buffer = malloc(HashCLIXofBufferSize);
+    if (buffer == NULL) {
+        fprintf(stderr, "%s: %s\n", gProgName, strerror(ENOMEM));
+        return -1;
+    }
+
+    while (remaining > 0 && err == 0) {
+        length = (remaining > HashCLIXofBufferSize ?
+                  HashCLIXofBufferSize : (size_t)remaining);
+        if (hash_engine_squeeze(ctx, buffer, length) != 0) {
+            fprintf(stderr, "%s: %s: %s failed\n",
+                    gProgName, path, ctx->desc->name);
+            err = -1;
+            break;
+        }
+        if (fwrite(buffer, 1, length, stdout) != length) {
+            fprintf(stderr, "%s: %s\n", gProgName, strerror(errno));
+            err = -1;
+            break;
+        }
+        remaining -= length;
+    }
+
+    free(buffer);
+    return err;
+}
+
+/*
+    hashFile - read (or map) a file once, handing the data to the context
+               for every requested hash, and print the results. returns 0
+               on success.
+ */
+
+static int hashFile(hashCLIState *state, const char *path)
+{
+    hashMappedFile map = { NULL, 0 };
+    unsigned char *buffer = NULL;
+    size_t bufferLength = hash_multi_buffer_size(state->multi);
+    ssize_t bytesRead = 0;
+    hashCacheKey key;
+    hashCacheKey fileKey;
+    unsigned long long offset = 0;
+    unsigned long long saved = 0;
+    size_t length = 0;
+    size_t i = 0;
+    int resumable = 0;
+    int cacheable = 0;
+    int cached = 0;
+    int mismatch = 0;
+    int rc = 0;
+    int fd = -1;
+    int err = 0;
+
+    if (strcmp(path, "-") == 0) {
+        fd = STDIN_FILENO;
+    } else {
+        fd = open(path, O_RDONLY);
+        if (fd < 0) {
+            fprintf(stderr, "%s: %s: %s\n", gProgName, path, strerror(errno));
+            return -1;
+        }
+#if defined(POSIX_FADV_SEQUENTIAL)
+        (void)posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+    }
+
+    // files that haven't changed since they were cached aren't read
+    // (unless the cache is being checked)
+
+    cacheable = cacheKey(state, fd, &key);
+    for (i = 0, cached = cacheable; i < state->count && cached; i++) {
+        cached = (hash_cache_lookup(state->cache,
+                                    &key,
+                                    state->ctx[i]->desc->type,
+                                    state->cached[i],
+                                    state->ctx[i]->desc->digestLength) == 0);
+    }
+
+    if (cached && !state->paranoid) {
+        close(fd);
+        for (i = 0; i < state->count; i++) {
+            hash_engine_digest_to_string(state->ctx[i]->desc,
+                                         state->cached[i],
+                                         state->lowercase,
+                                         state->digestStr);
+            printResult(state, state->ctx[i]->desc, path);
+        }
+        return 0;
+    }
+
+    for (i = 0; i < state->count; i++) {
+        hash_engine_reset(state->ctx[i]);
+    }
+
+    resumable = checkpointResume(state, fd, &fileKey, &offset);
+    saved = offset;
+
+    // large regular files are hashed straight from a mapping, everything
+    // else (stdin, small files, or when mapping fails) is read.  with a
+    // checkpoint, the state is saved every checkpointInterval bytes.
+
+    if (fd != STDIN_FILENO && !state->noMap && hash_map_fd(fd, &map) == 0) {
+        while (offset < map.length) {
+            length = map.length - (size_t)offset;
+            if (resumable && length > state->checkpointInterval) {
+                length = state->checkpointInterval;
+            }
+            hash_multi_update_mapped(state->multi,
+                                     map.data + offset,
+                                     length);
+            offset += length;
+            if (resumable && offset < map.length) {
+                hash_multi_wait(state->multi);
+                if (hash_map_truncated(&map)) {
+                    break;
+                }
+                checkpointSave(state, path, fd, &fileKey, offset);
+                saved = offset;
+            }
+        }
+
+        // if the file was truncated, the hashes saw zeros instead of
+        // the missing pages, so start over reading the file
+
+        hash_multi_wait(state->multi);
+        if (hash_map_truncated(&map)) {
+            hash_unmap(&map);
+            for (i = 0; i < state->count; i++) {
+                hash_engine_reset(state->ctx[i]);
+            }
+            offset = 0;
+            saved = 0;
+            if (lseek(fd, 0, SEEK_SET) != 0) {
+                err = errno;
+            }
+        }
+    } else if (offset > 0 &&
+               lseek(fd, (off_t)offset, SEEK_SET) != (off_t)offset) {
+        err = errno;
+    }
+
+    while (map.data == NULL && err == 0) {
+        buffer = hash_multi_acquire(state->multi);
+        bytesRead = read(fd, buffer, bufferLength);
+        if (bytesRead < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            err = errno;
+            break;
+        }
+
+        if (bytesRead == 0) {
+            break;
+        }
+
+        hash_multi_submit(state->multi, (size_t)bytesRead);
+
+        offset += (unsigned long long)bytesRead;
+        if (resumable && offset - saved >= state->checkpointInterval) {
+            checkpointSave(state, path, fd, &fileKey, offset);
+            saved = offset;
+        }
+    }
+
+    // wait for the slowest hash to catch up before finalizing
+
+    hash_multi_wait(state->multi);
+    hash_unmap(&map);
+
+    // with --append, the state at the end of the file is saved before
+    // it is finalized, so that next time only the bytes appended after
+    // this point have to be hashed
+
+    if (resumable && state->append && err == 0 && offset > saved) {
+        checkpointSave(state, path, fd, &fileKey, offset);
+    }
+
+    if (cacheable) {
+        cacheable = cacheUnchanged(fd, &key);
+    }
+
+    if (fd != STDIN_FILENO) {
+        close(fd);
+    }
+
+    if (err != 0) {
+        fprintf(stderr, "%s: %s: %s\n", gProgName, path, strerror(err));
+        return -1;
+    }
+
+    for (i = 0; i < state->count; i++) {
+        if (state->xofLength > 0) {
+            if (writeXof(state, state->ctx[i], path) != 0) {
+                err = -1;
+            }
+            continue;
+        }
+        rc = hash_engine_final(state->ctx[i], state->digest);
+        if (rc < 0) {
+            fprintf(stderr, "%s: %s: %s failed\n",
+                    gProgName, path, state->ctx[i]->desc->name);
+            err = -1;
+            continue;
+        }
+        if (rc == 0 && cacheable &&
+            cacheUpdate(state,
+                        &key,
+                        state->ctx[i]->desc,
+                        state->digest,
+                        (cached ? state->cached[i] : NULL))) {
+            mismatch = 1;
+        }
+        hash_engine_digest_to_string(state->ctx[i]->desc,
+                                     state->digest,
+                                     state->lowercase,
+                                     state->digestStr);
+        printResult(state, state->ctx[i]->desc, path);
+    }
+
+    if (mismatch) {
+        cacheMismatch(path);
+        err = -1;
+    }
+
+    // the checkpoint is only removed if it was for this file, otherwise
+    // it may still be needed for a file that comes later
+
+    if (err == 0 && resumable && saved > 0 && !state->append) {
+        hash_checkpoint_remove(state->checkpoint);
+    }
+
+    return (err == 0 ? 0 : -1);
+}
+
+/*
+    lanesNew - set up interleaved mode for the (single) requested hash,
+               with twice as many files in flight as there are lanes,
+               so that the lanes stay full while a large file holds up
+               the output.  returns 0 on success.
+ */
+
+static int lanesNew(hashCLIState *state, size_t lanes, size_t bufferSize)
+{
+    size_t i = 0;
+
+    state->laneCount = lanes*2;
+    state->laneBufferSize = bufferSize;
+    state->lanes = calloc(state->laneCount, sizeof(hashCLILane));
+    if (state->lanes == NULL) {
+        return -1;
+    }
+
+    for (i = 0; i < state->laneCount; i++) {
+        state->lanes[i].fd = -1;
+        state->lanes[i].ctx = hash_engine_new(state->ctx[0]->desc->type);
+        state->lanes[i].buffer = malloc(bufferSize);
+        if (state->lanes[i].ctx == NULL || state->lanes[i].buffer == NULL) {
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+static void lanesFree(hashCLIState *state)
+{
+    size_t i = 0;
+
+    if (state->lanes == NULL) {
+        return;
+    }
+
+    for (i = 0; i < state->laneCount; i++) {
+        hash_engine_free(state->lanes[i].ctx);
+        free(state->lanes[i].buffer);
+        free(state->lanes[i].path);
+    }
+
+    free(state->lanes);
+    state->lanes = NULL;
+}
+
+/*
+    lanesPrint - print the results of the finished files, in the order
+                 in which they were given
+ */
+
+static void lanesPrint(hashCLIState *state)
+{
+    hashCLILane *lane = NULL;
+    size_t i = 0;
+
+    for (;;) {
+        lane = NULL;
+        for (i = 0; i < state->laneCount; i++) {
+            if (state->lanes[i].status == HashCLILaneDone &&
+                state->lanes[i].seq == state->printSeq) {
+                lane = &state->lanes[i];
+                break;
+            }
+        }
+
+        if (lane == NULL) {
+            return;
+        }
+
+        if (lane->err != 0) {
+            fprintf(stderr, "%s: %s: %s\n",
+                    gProgName, lane->path, strerror(lane->err));
+            state->laneFailed = 1;
+        } else if (lane->rc < 0) {
+            fprintf(stderr, "%s: %s: %s failed\n",
+                    gProgName, lane->path, lane->ctx->desc->name);
+            state->laneFailed = 1;
+        } else {
+            hash_engine_digest_to_string(lane->ctx->desc,
+                                         lane->digest,
+                                         state->lowercase,
+                                         state->digestStr);
+            printResult(state, lane->ctx->desc, lane->path);
+            if (lane->mismatch) {
+                cacheMismatch(lane->path);
+                state->laneFailed = 1;
+            }
+        }
+
+        free(lane->path);
+        lane->path = NULL;
+        lane->status = HashCLILaneFree;
+        state->printSeq++;
+    }
+}
+
+/*
+    lanesStep - read the next block of every active file, and hash the
+                blocks together.  Files that reach EOF (or fail) are
+                finalized and printed when their turn comes.
+ */
+
+static void lanesStep(hashCLIState *state)
+{
+    hashEngineContext *ctxs[HashCLIMaxLanes*2];
+    const unsigned char *data[HashCLIMaxLanes*2];
+    size_t lengths[HashCLIMaxLanes*2];
+    hashCLILane *lane = NULL;
+    size_t count = 0;
+    ssize_t bytesRead = 0;
+    size_t i = 0;
+
+    for (i = 0; i < state->laneCount; i++) {
+        lane = &state->lanes[i];
+        if (lane->status != HashCLILaneActive) {
+            continue;
+        }
+
+        do {
+            bytesRead = read(lane->fd, lane->buffer, state->laneBufferSize);
+        } while (bytesRead < 0 && errno == EINTR);
+
+        if (bytesRead > 0) {
+            ctxs[count] = lane->ctx;
+            data[count] = lane->buffer;
+            lengths[count] = (size_t)bytesRead;
+            count++;
+            continue;
+        }
+
+        if (bytesRead < 0) {
+            lane->err = errno;
+        } else {
+            if (lane->cacheable) {
+                lane->cacheable = cacheUnchanged(lane->fd, &lane->key);
+            }
+            lane->rc = hash_engine_final(lane->ctx, lane->digest);
+            if (lane->rc == 0 && lane->cacheable) {
+                lane->mismatch =
+                    cacheUpdate(state,
+                                &lane->key,
+                                lane->ctx->desc,
+                                lane->digest,
+                                (lane->cached ? lane->cachedDigest : NULL));
+            }
+        }
+
+        if (lane->fd != STDIN_FILENO) {
+            close(lane->fd);
+        }
+        lane->fd = -1;
+        lane->status = HashCLILaneDone;
+    }
+
+    if (count > 0) {
+        (void)hash_engine_update_many(ctxs, data, lengths, count);
+    }
+
+    lanesPrint(state);
+}
+
+/*
+    lanesAdd - start hashing a file in interleaved mode, waiting for a
+               free lane if necessary. returns 0 on success.
+ */
+
+static int lanesAdd(hashCLIState *state, const char *path)
+{
+    hashCLILane *lane = NULL;
+    size_t i = 0;
+    int fd = -1;
+
+    while (lane == NULL) {
+        for (i = 0; i < state->laneCount; i++) {
+            if (state->lanes[i].status == HashCLILaneFree) {
+                lane = &state->lanes[i];
+                break;
+            }
+        }
+        if (lane == NULL) {
+            lanesStep(state);
+        }
+    }
+
+    if (strcmp(path, "-") == 0) {
+        fd = STDIN_FILENO;
+    } else {
+        fd = open(path, O_RDONLY);
+        if (fd < 0) {
+            fprintf(stderr, "%s: %s: %s\n", gProgName, path, strerror(errno));
+            return -1;
+        }
+#if defined(POSIX_FADV_SEQUENTIAL)
+        (void)posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+    }
+
+    lane->path = strdup(path);
+    if (lane->path == NULL) {
+        fprintf(stderr, "%s: %s\n", gProgName, strerror(ENOMEM));
+        if (fd != STDIN_FILENO) {
+            close(fd);
+        }
+        return -1;
+    }
+
+    hash_engine_reset(lane->ctx);
+    lane->fd = fd;
+    lane->err = 0;
+    lane->rc = 0;
+    lane->mismatch = 0;
+    lane->seq = state->nextSeq++;
+    lane->status = HashCLILaneActive;
+
+    lane->cacheable = cacheKey(state, fd, &lane->key);
+    lane->cached = (lane->cacheable &&
+                    hash_cache_lookup(state->cache,
+                                      &lane->key,
+                                      lane->ctx->desc->type,
+                                      lane->cachedDigest,
+                                      lane->ctx->desc->digestLength) == 0);
+
+    // a cached file is done without reading it (unless the cache is
+    // being checked)
+
+    if (lane->cached && !state->paranoid) {
+        memcpy(lane->digest,
+               lane->cachedDigest,
+               lane->ctx->desc->digestLength);
+        close(lane->fd);
+        lane->fd = -1;
+        lane->status = HashCLILaneDone;
+        lanesPrint(state);
+    }
+
+    return 0;
+}
+
+/* lanesFinish - hash the files still in flight. returns 0 on success. */
+
+static int lanesFinish(hashCLIState *state)
+{
+    while (state->printSeq != state->nextSeq) {
+        lanesStep(state);
+    }
+    return (state->laneFailed ? -1 : 0);
+}
+
+/*
+    treeResult - print the results for a file found by hashTree
+ */
+
+static int treeResult(void *arg,
+                      size_t index,
+                      const char *path,
+                      int err,
+                      unsigned int flags,
+                      const unsigned char *const *digests)
+{
+    hashCLIState *state = arg;
+    size_t i = 0;
+
+    (void)index;
+
+    if (err != 0) {
+        fprintf(stderr, "%s: %s: %s\n", gProgName, path, strerror(err));
+        return 0;
+    }
+
+    for (i = 0; i < state->count; i++) {
+        hash_engine_digest_to_string(state->ctx[i]->desc,
+                                     digests[i],
+                                     state->lowercase,
+                                     state->digestStr);
+        printResult(state, state->ctx[i]->desc, path);
+    }
+
+    if (flags & HASH_TREE_FLAG_CACHE_MISMATCH) {
+        cacheMismatch(path);
+        state->treeFailed = 1;
+    }
+
+    return 0;
+}
+
+/*
+    hashTree - hash every file under a directory, several files at a
+               time, and print the results in (sorted) directory order.
+               returns 0 on success.
+ */
+
+static int hashTree(hashCLIState *state, const char *path)
+{
+    HashType types[HashCLIMaxHashes];
+    hashTreeOptions options;
+    size_t i = 0;
+
+    // the files before the directory have to be printed first
+
+    if (state->lanes != NULL) {
+        (void)lanesFinish(state);
+    }
+
+    for (i = 0; i < state->count; i++) {
+        types[i] = state->ctx[i]->desc->type;
+    }
+
+    memset(&options, 0, sizeof(options));
+    options.types = types;
+    options.count = state->count;
+    options.threads = state->threads;
+    options.bufferSize = state->blockSize;
+    options.noMap = state->noMap;
+    options.cache = state->cache;
+    options.paranoid = state->paranoid;
+
+    state->treeFailed = 0;
+    if (hash_tree(path, &options, treeResult, state) != 0) {
+        return -1;
+    }
+
+    return (state->treeFailed ? -1 : 0);
+}
+
+/*
+    hashPath - hash a file, either right away or in interleaved mode, or
+               a directory (with -r)
+ */
+
+static int hashPath(hashCLIState *state, const char *path)
+{
+    struct stat sb;
+
+    if (state->recursive && strcmp(path, "-") != 0 &&
+        stat(path, &sb) == 0 && S_ISDIR(sb.st_mode)) {
+        return hashTree(state, path);
+    }
+    if (state->lanes != NULL) {
+        return lanesAdd(state, path);
+    }
+    return hashFile(state, path);
+}
+
+/*
+    hashFileList - hash each file named in a list (one name per line, or
+                   NUL terminated names)
+ */
+
+static int hashFileList(hashCLIState *state, const char *list, int delim)
+{
+    FILE *fp = NULL;
+    char *line = NULL;
+    size_t lineSize = 0;
+    ssize_t lineLength = 0;
+    int rc = 0;
+
+    if (strcmp(list, "-") == 0) {
+        fp = stdin;
+    } else {
+        fp = fopen(list, "r");
+        if (fp == NULL) {
+            fprintf(stderr, "%s: %s: %s\n", gProgName, list, strerror(errno));
+            return -1;
+        }
+    }
+
+    while ((lineLength = getdelim(&line, &lineSize, delim, fp)) != -1) {
+        if (lineLength > 0 && line[lineLength - 1] == delim) {
+            line[--lineLength] = '\0';
+        }
+        if (lineLength == 0) {
+            continue;
+        }
+        if (hashPath(state, line) != 0) {
+            rc = -1;
+        }
+    }
+
+    free(line);
+
+    if (fp != stdin) {
+        fclose(fp);
+    }
+
+    return rc;
+}
+
+/*
+    unescapeName - undo printName's escaping of a file name, in place.
+                   returns 0 on success, -1 for an invalid escape.
+ */
+
+static int unescapeName(char *name)
+{
+    char *from = name;
+    char *to = name;
+
+    while (*from != '\0') {
+        if (*from != '\\') {
+            *to++ = *from++;
+            continue;
+        }
+        switch (from[1]) {
+            case '\\':
+                *to++ = '\\';
+                break;
+            case 'n':
+                *to++ = '\n';
+                break;
+            default:
+                return -1;
+        }
+        from += 2;
+    }
+
+    *to = '\0';
+    return 0;
+}
+
+/*
+    parseCheckLine - split a manifest line, either "digest  file" (or
+                     "digest *file") for the default hash, or
+                     "HASH (file) = digest", modifying it in place.
+                     returns 0 on success, -1 if the line is improperly
+                     formatted.
+ */
+
+static int parseCheckLine(hashCLIState *state,
+                          char *line,
+                          const hashEngineDescriptor **desc,
+                          char **digest,
+                          char **path)
+{
+    char *open = NULL;
+    char *close = NULL;
+    char *p = NULL;
+    int escaped = 0;
+    size_t length = 0;
+
+    if (line[0] == '\\') {
+        escaped = 1;
+        line++;
+    }
+
+    *desc = NULL;
+    open = strstr(line, " (");
+    close = (open != NULL ? strstr(open, ") = ") : NULL);
+
+    if (close != NULL) {
+
+        // BSD style, the file name may contain ") = " itself
+
+        while ((p = strstr(close + 1, ") = ")) != NULL) {
+            close = p;
+        }
+        *open = '\0';
+        *desc = hash_engine_descriptor_by_name(line);
+    }
+
+    if (*desc != NULL) {
+        *path = open + 2;
+        *close = '\0';
+        *digest = close + 4;
+    } else {
+        *desc = state->ctx[0]->desc;
+        if (open != NULL && close != NULL) {
+            *open = ' ';
+        }
+        p = strchr(line, ' ');
+        if (p == NULL || (p[1] != ' ' && p[1] != '*')) {
+            return -1;
+        }
+        *p = '\0';
+        *digest = line;
+        *path = p + 2;
+    }
+
+    length = strlen(*digest);
+    if (length == 0 || strspn(*digest, "0123456789abcdefABCDEF") != length ||
+        ((*desc)->flags & HASH_ENGINE_FLAG_CHECKSUM ?
+         length > hash_engine_string_length(*desc) :
+         length != hash_engine_string_length(*desc))) {
+        return -1;
+    }
+
+    if (**path == '\0' || (escaped && unescapeName(*path) != 0)) {
+        return -1;
+    }
+
+    return 0;
+}
+
+/*
+    checkAdd - add a manifest line's file and expected digest to the
+               check.  returns 0 on success, -1 if out of memory.
+ */
+
+static int checkAdd(hashCLICheck *check,
+                    const hashEngineDescriptor *desc,
+                    const char *digest,
+                    const char *path)
+{
+    hashCLICheckEntry *entry = NULL;
+    void *grown = NULL;
+    size_t hash = 0;
+    size_t i = 0;
+
+    for (hash = 0; hash < check->hashCount; hash++) {
+        if (check->descs[hash] == desc) {
+            break;
+        }
+    }
+    if (hash == check->hashCount) {
+        check->descs[check->hashCount++] = desc;
+    }
+
+    // a file keeps its entry until a line for another file (or for a
+    // hash it already has) comes along
+
+    entry = (check->entryCount > 0 ?
+             &check->entries[check->entryCount - 1] : NULL);
+    for (i = 0; entry != NULL && i < entry->count; i++) {
+        if (check->expected[entry->first + i].hash == hash) {
+            entry = NULL;
+        }
+    }
+    if (entry != NULL && strcmp(entry->path, path) != 0) {
+        entry = NULL;
+    }
+
+    if (entry == NULL) {
+        if (check->entryCount == check->entryCapacity) {
+            check->entryCapacity = (check->entryCapacity > 0 ?
+                                    check->entryCapacity*2 : 1024);
+            grown = realloc(check->entries,
+                            check->entryCapacity * sizeof(hashCLICheckEntry));
+            if (grown == NULL) {
+                return -1;
+            }
+            check->entries = grown;
+        }
+        entry = &check->entries[check->entryCount];
+        entry->path = strdup(path);
+        if (entry->path == NULL) {
+            return -1;
+        }
+        entry->first = check->expectedCount;
+        entry->count = 0;
+        check->entryCount++;
+    }
+
+    if (check->expectedCount == check->expectedCapacity) {
+        check->expectedCapacity = (check->expectedCapacity > 0 ?
+                                   check->expectedCapacity*2 : 1024);
+        grown = realloc(check->expected,
+                        check->expectedCapacity * sizeof(hashCLIExpected));
+        if (grown == NULL) {
+            return -1;
+        }
+        check->expected = grown;
+    }
+
+    check->expected[check->expectedCount].hash = hash;
+    check->expected[check->expectedCount].digest = strdup(digest);
+    if (check->expected[check->expectedCount].digest == NULL) {
+        return -1;
+    }
+    check->expectedCount++;
+    entry->count++;
+
+    return 0;
+}
+
+/* checkFree - release a check's entries */
+
+static void checkFree(hashCLICheck *check)
+{
+    size_t i = 0;
+
+    for (i = 0; i < check->entryCount; i++) {
+        free(check->entries[i].path);
+    }
+    for (i = 0; i < check->expectedCount; i++) {
+        free(check->expected[i].digest);
+    }
+    free(check->entries);
+    free(check->expected);
+    free(check->digestStr);
+}
+
+/* checkNext - hand the next listed file to hash_tree_list */
+
+static const char *checkNext(void *arg)
+{
+    hashCLICheck *check = arg;
+
+    if (check->nextEntry == check->entryCount) {
+        return NULL;
+    }
+    return check->entries[check->nextEntry++].path;
+}
+
+/* printCheck - print a "file: status" line, escaping the name */
+
+static void printCheck(const char *path, const char *status)
+{
+    if (needsEscape(path)) {
+        putchar('\\');
+    }
+    printName(path);
+    printf(": %s\n", status);
+}
+
+/*
+    checkResult - compare a listed file's digests with the manifest, as
+                  soon as the file has been hashed.  returns non-zero to
+                  stop the check (--fail-fast).
+ */
+
+typedef struct hashCLICheckRun {
+    hashCLIState *state;
+    hashCLICheck *check;
+} hashCLICheckRun;
+
+static int checkResult(void *arg,
+                       size_t index,
+                       const char *path,
+                       int err,
+                       unsigned int flags,
+                       const unsigned char *const *digests)
+{
+    hashCLICheckRun *run = arg;
+    hashCLICheck *check = run->check;
+    const hashCLICheckEntry *entry = &check->entries[index];
+    const hashCLIExpected *expected = NULL;
+    int failed = 0;
+    size_t i = 0;
+
+    (void)flags;
+
+    check->checked++;
+
+    if (err != 0) {
+        fprintf(stderr, "%s: %s: %s\n", gProgName, path, strerror(err));
+        printCheck(path, "FAILED open or read");
+        check->unreadable++;
+        failed = 1;
+    } else {
+        for (i = 0; i < entry->count && !failed; i++) {
+            expected = &check->expected[entry->first + i];
+            hash_engine_digest_to_string(check->descs[expected->hash],
+                                         digests[expected->hash],
+                                         1,
+                                         check->digestStr);
+            failed = (strcasecmp(check->digestStr, expected->digest) != 0);
+        }
+        if (failed) {
+            printCheck(path, "FAILED");
+            check->mismatched++;
+        } else if (!run->state->quiet) {
+            printCheck(path, "OK");
+        }
+    }
+
+    // failures are reported right away, not when the output fills up
+
+    if (failed) {
+        fflush(stdout);
+    }
+
+    return (failed && run->state->failFast);
+}
+
+/* plural - "s" unless count is 1 */
+
+static const char *plural(size_t count)
+{
+    return (count == 1 ? "" : "s");
+}
+
+/*
+    checkManifest - verify every file listed in a manifest, hashing the
+                    files in parallel.  returns 0 if they all match.
+ */
+
+static int checkManifest(hashCLIState *state, const char *manifest)
+{
+    HashType types[HashCLIMaxHashes];
+    hashTreeOptions options;
+    hashCLICheckRun run;
+    hashCLICheck check;
+    const hashEngineDescriptor *desc = NULL;
+    FILE *fp = NULL;
+    char *line = NULL;
+    char *digest = NULL;
+    char *path = NULL;
+    size_t lineSize = 0;
+    ssize_t lineLength = 0;
+    size_t maxStringLength = 0;
+    size_t i = 0;
+    int rc = 0;
+
+    memset(&check, 0, sizeof(check));
+
+    if (strcmp(manifest, "-") == 0) {
+        fp = stdin;
+    } else {
+        fp = fopen(manifest, "r");
+        if (fp == NULL) {
+            fprintf(stderr, "%s: %s: %s\n",
+                    gProgName, manifest, strerror(errno));
+            return -1;
+        }
+    }
+
+    while (rc == 0 &&
+           (lineLength = getline(&line, &lineSize, fp)) != -1) {
+        if (lineLength > 0 && line[lineLength - 1] == '\n') {
+            line[--lineLength] = '\0';
+        }
+        if (lineLength > 0 && line[lineLength - 1] == '\r') {
+            line[--lineLength] = '\0';
+        }
+        if (lineLength == 0) {
+            continue;
+        }
+        if (parseCheckLine(state, line, &desc, &digest, &path) != 0) {
+            check.badLines++;
+            continue;
+        }
+        rc = checkAdd(&check, desc, digest, path);
+    }
+
+    free(line);
+
+    if (fp != stdin) {
+        fclose(fp);
+    }
+
+    for (i = 0; i < check.hashCount; i++) {
+        types[i] = check.descs[i]->type;
+        if (hash_engine_string_length(check.descs[i]) > maxStringLength) {
+            maxStringLength = hash_engine_string_length(check.descs[i]);
+        }
+    }
+
+    check.digestStr = calloc(maxStringLength + 1, sizeof(char));
+    if (rc != 0 || check.digestStr == NULL) {
+        fprintf(stderr, "%s: %s\n", gProgName, strerror(ENOMEM));
+        checkFree(&check);
+        return -1;
+    }
+
+    if (check.entryCount == 0) {
+        fprintf(stderr, "%s: %s: no properly formatted checksum lines found\n",
+                gProgName, manifest);
+        checkFree(&check);
+        return -1;
+    }
+
+    // every listed file gets every hash used in the manifest, and the
+    // results come back in the order the files are finished
+
+    memset(&options, 0, sizeof(options));
+    options.types = types;
+    options.count = check.hashCount;
+    options.threads = state->threads;
+    options.bufferSize = state->blockSize;
+    options.noMap = state->noMap;
+    options.unordered = 1;
+
+    run.state = state;
+    run.check = &check;
+
+    rc = hash_tree_list(checkNext, &check, &options, checkResult, &run);
+    if (rc == 1) {
+        state->checkStopped = 1;
+    }
+
+    if (check.badLines > 0) {
+        fprintf(stderr, "%s: WARNING: %zu line%s improperly formatted\n",
+                gProgName, check.badLines,
+                (check.badLines == 1 ? " is" : "s are"));
+    }
+    if (check.unreadable > 0) {
+        fprintf(stderr, "%s: WARNING: %zu listed file%s could not be read\n",
+                gProgName, check.unreadable, plural(check.unreadable));
+    }
+    if (check.mismatched > 0) {
+        fprintf(stderr,
+                "%s: WARNING: %zu computed checksum%s did NOT match\n",
+                gProgName, check.mismatched, plural(check.mismatched));
+    }
+    if (state->checkStopped && check.checked < check.entryCount) {
+        fprintf(stderr, "%s: WARNING: stopped at the first failure, %zu"
+                " listed file%s not checked\n",
+                gProgName, check.entryCount - check.checked,
+                plural(check.entryCount - check.checked));
+    }
+
+    if (rc == -1 && check.unreadable == 0) {
+        fprintf(stderr, "%s: %s: %s\n", gProgName, manifest, strerror(ENOMEM));
+    }
+
+    rc = (rc != 0 || check.unreadable > 0 || check.mismatched > 0 ? -1 : 0);
+    checkFree(&check);
+
+    return rc;
+}
+
+/*
+    loadFile - map a file (if useMap is set), or read it into memory if
+               it is too small to be mapped (buffer is then set, and
+               must be freed).  returns 0 on success.
+ */
+
+static int loadFile(const char *path,
+                    int useMap,
+                    hashMappedFile *map,
+                    unsigned char **buffer)
+{
+    struct stat sb;
+    ssize_t bytesRead = 0;
+    size_t total = 0;
+    int fd = -1;
+    int err = 0;
+
+    *buffer = NULL;
+    map->data = NULL;
+    map->length = 0;
+
+    fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        fprintf(stderr, "%s: %s: %s\n", gProgName, path, strerror(errno));
+        return -1;
+    }
+
+    if (useMap && hash_map_fd(fd, map) == 0) {
+        close(fd);
+        return 0;
+    }
+
+    if (fstat(fd, &sb) != 0) {
+        err = errno;
+    } else if (!S_ISREG(sb.st_mode)) {
+        err = EINVAL;
+    } else {
+        *buffer = malloc((size_t)sb.st_size + 1);
+        if (*buffer == NULL) {
+            err = ENOMEM;
+        }
+    }
+
+    while (err == 0 && total < (size_t)sb.st_size) {
+        bytesRead = read(fd, *buffer + total, (size_t)sb.st_size - total);
+        if (bytesRead < 0 && errno == EINTR) {
+            continue;
+        }
+        if (bytesRead < 0) {
+            err = errno;
+        } else if (bytesRead == 0) {
+            break;
+        }
+        total += (bytesRead > 0 ? (size_t)bytesRead : 0);
+    }
+
+    close(fd);
+
+    if (err != 0) {
+        fprintf(stderr, "%s: %s: %s\n", gProgName, path, strerror(err));
+        free(*buffer);
+        *buffer = NULL;
+        return -1;
+    }
+
+    map->data = *buffer;
+    map->length = total;
+    return 0;
+}
+
+/* unloadFile - release a file loaded with loadFile */
+
+static void unloadFile(hashMappedFile *map, unsigned char *buffer)
+{
+    if (buffer != NULL) {
+        free(buffer);
+        map->data = NULL;
+        map->length = 0;
+    } else {
+        hash_unmap(map);
+    }
+}
+
+/* outboardPath - return path.obao in a new string */
+
+static char *outboardPath(const char *path)
+{
+    char *obao = malloc(strlen(path) + sizeof(".obao"));
+
+    if (obao != NULL) {
+        sprintf(obao, "%s.obao", path);
+    }
+    return obao;
+}
+
+/*
+    writeOutboard - write a file's Bao outboard tree next to it, and
+                    print its BLAKE3 digest (mapping the file if useMap
+                    is set).  returns 0 on success.
+ */
+
+static int writeOutboard(hashCLIState *state, const char *path, int useMap)
+{
+    hashMappedFile map = { NULL, 0 };
+    unsigned char hash[BLAKE3_OUT_LEN];
+    unsigned char *buffer = NULL;
+    unsigned char *outboard = NULL;
+    size_t outboardLength = 0;
+    char *obao = NULL;
+    FILE *fp = NULL;
+    int err = 0;
+
+    if (loadFile(path, useMap, &map, &buffer) != 0) {
+        return -1;
+    }
+
+    outboardLength = blake3_bao_outboard_size(map.length);
+    outboard = malloc(outboardLength);
+    obao = outboardPath(path);
+    if (outboard == NULL || obao == NULL) {
+        err = ENOMEM;
+    } else {
+        blake3_bao_encode_outboard(map.data, map.length, outboard, hash);
+
+        // if the file was truncated, the tree is for zeros instead of
+        // the missing pages, so start over reading the file
+
+        if (hash_map_truncated(&map)) {
+            unloadFile(&map, buffer);
+            free(outboard);
+            free(obao);
+            return writeOutboard(state, path, 0);
+        }
+
+        fp = fopen(obao, "wb");
+        if (fp == NULL) {
+            err = errno;
+        } else {
+            if (fwrite(outboard, 1, outboardLength, fp) != outboardLength) {
+                err = errno;
+            }
+            if (fclose(fp) != 0 && err == 0) {
+                err = errno;
+            }
+        }
+    }
+
+    unloadFile(&map, buffer);
+    free(outboard);
+
+    if (err != 0) {
+        fprintf(stderr, "%s: %s: %s\n",
+                gProgName, (obao != NULL ? obao : path), strerror(err));
+        free(obao);
+        return -1;
+    }
+
+    free(obao);
+
+    hash_engine_digest_to_string(state->ctx[0]->desc,
+                                 hash,
+                                 state->lowercase,
+                                 state->digestStr);
+    printResult(state, state->ctx[0]->desc, path);
+    return 0;
+}
+
+/* parseDigest - parse a hex digest of length bytes */
+
+static int parseDigest(const char *str, unsigned char *digest, size_t length)
+{
+    unsigned int byte = 0;
+    size_t i = 0;
+
+    if (strlen(str) != 2*length ||
+        strspn(str, "0123456789abcdefABCDEF") != 2*length) {
+        return -1;
+    }
+
+    for (i = 0; i < length; i++) {
+        if (sscanf(str + 2*i, "%2x", &byte) != 1) {
+            return -1;
+        }
+        digest[i] = (unsigned char)byte;
+    }
+
+    return 0;
+}
+
+/*
+    verifySlice - verify the bytes [start, start + length) of a file
+                  against its trusted BLAKE3 digest, with the tree in
+                  file.obao, only reading the chunks of the file that
+                  cover the range.  returns 0 if they match, or -1 if
+                  they don't, or start is not in the file.  a range
+                  that runs past the end of the file is verified up to
+                  the end of the file, and the bytes that were checked
+                  are printed.
+ */
+
+static int verifySlice(const char *path,
+                       const unsigned char *root,
+                       unsigned long long start,
+                       unsigned long long length,
+                       int useMap)
+{
+    hashMappedFile map = { NULL, 0 };
+    hashMappedFile tree = { NULL, 0 };
+    unsigned char *buffer = NULL;
+    unsigned char *treeBuffer = NULL;
+    unsigned long long end = 0;
+    uint64_t badStart = 0;
+    uint64_t badLength = 0;
+    char *obao = NULL;
+    int rc = 0;
+
+    obao = outboardPath(path);
+    if (obao == NULL) {
+        fprintf(stderr, "%s: %s\n", gProgName, strerror(ENOMEM));
+        return -1;
+    }
+
+    if (loadFile(path, useMap, &map, &buffer) != 0) {
+        free(obao);
+        return -1;
+    }
+
+    if (loadFile(obao, useMap, &tree, &treeBuffer) != 0) {
+        unloadFile(&map, buffer);
+        free(obao);
+        return -1;
+    }
+
+    if (start >= map.length) {
+        fprintf(stderr,
+                "%s: %s: the slice starts at byte %llu, past the end of "
+                "the file (%llu bytes)\n",
+                gProgName,
+                path,
+                start,
+                (unsigned long long)map.length);
+        unloadFile(&tree, treeBuffer);
+        unloadFile(&map, buffer);
+        free(obao);
+        return -1;
+    }
+
+    rc = blake3_bao_verify(root,
+                           tree.data,
+                           tree.length,
+                           map.data,
+                           map.length,
+                           start,
+                           length,
+                           &badStart,
+                           &badLength);
+
+    // if either file was truncated, zeros were checked instead of the
+    // missing pages, so start over reading the files
+
+    if (hash_map_truncated(&map) || hash_map_truncated(&tree)) {
+        unloadFile(&tree, treeBuffer);
+        unloadFile(&map, buffer);
+        free(obao);
+        return verifySlice(path, root, start, length, 0);
+    }
+
+    // the range that was checked, clamped to the file
+
+    end = start + (length < map.length - start ? length : map.length - start);
+
+    if (rc == 0) {
+        printName(path);
+        if (end - start < length) {
+            printf(": OK (bytes %llu-%llu, the rest of the slice is past "
+                   "the end of the file)\n",
+                   start,
+                   end - 1);
+        } else {
+            printf(": OK (bytes %llu-%llu)\n", start, end - 1);
+        }
+    } else {
+        printName(path);
+        printf(": FAILED, bytes %llu-%llu do not match\n",
+               (unsigned long long)badStart,
+               (unsigned long long)(badStart + badLength -
+                                    (badLength > 0 ? 1 : 0)));
+    }
+
+    unloadFile(&tree, treeBuffer);
+    unloadFile(&map, buffer);
+    free(obao);
+
+    return (rc == 0 ? 0 : -1);
+}
+
+int main(int argc, char **argv)
+{
+    hashCLIState state;
+    const char *fileList = NULL;
+    const char *cachePath = NULL;
+    int clearCache = 0;
+    char defaultHash[] = "sha256";
+    char blake3Hash[] = "blake3";
+    char xofHash[] = "shake256";
+    size_t maxStringLength = 0;
+    size_t i = 0;
+    int delim = '\n';
+    size_t blockSize = HashCLIDefaultFileBufferSize;
+    size_t queueDepth = HashCLIDefaultQueueDepth;
+    int threaded = 1;
+    int interleave = 1;
+    int check = 0;
+    int outboard = 0;
+    const char *slice = NULL;
+    const char *rootDigest = NULL;
+    unsigned char root[BLAKE3_OUT_LEN];
+    unsigned long long sliceStart = 0;
+    unsigned long long sliceLength = 0;
+    const char *next = NULL;
+    size_t lanes = 1;
+    int rc = 0;
+    int ch = 0;
+
+    memset(&state, 0, sizeof(state));
+    state.lowercase = 1;
+
+    if (argv[0] != NULL && strrchr(argv[0], '/') != NULL) {
+        gProgName = strrchr(argv[0], '/') + 1;
+    } else if (argv[0] != NULL) {
+        gProgName = argv[0];
+    }
+
+    while ((ch = getopt_long(argc,
+                             argv,
+                             "a:b:q:f:j:C:k:K:0cinrstulh",
+                             gLongOptions,
+                             NULL)) != -1) {
+        switch (ch) {
+            case 'a':
+                if (addHashes(&state, optarg) != 0) {
+                    return 2;
+                }
+                break;
+            case 'b':
+                if (parseSize(optarg, &blockSize) != 0) {
+                    usage();
+                    return 2;
+                }
+                break;
+            case 'q':
+                if (parseSize(optarg, &queueDepth) != 0) {
+                    usage();
+                    return 2;
+                }
+                break;
+            case 'f':
+                fileList = optarg;
+                break;
+            case 'C':
+                cachePath = optarg;
+                break;
+            case 'k':
+                state.checkpoint = optarg;
+                break;
+            case 'K':
+                if (parseSize(optarg, &state.checkpointInterval) != 0) {
+                    usage();
+                    return 2;
+                }
+                break;
+            case HashCLIOptionParanoid:
+                state.paranoid = 1;
+                break;
+            case HashCLIOptionClearCache:
+                clearCache = 1;
+                break;
+            case HashCLIOptionAppend:
+                state.append = 1;
+                break;
+            case 'c':
+                check = 1;
+                break;
+            case HashCLIOptionQuiet:
+                state.quiet = 1;
+                break;
+            case HashCLIOptionFailFast:
+                state.failFast = 1;
+                break;
+            case HashCLIOptionOutboard:
+                outboard = 1;
+                break;
+            case HashCLIOptionVerifySlice:
+                slice = optarg;
+                if (parseNumber(slice, ':', &sliceStart, &next) != 0 ||
+                    *next != ':' ||
+                    parseNumber(next + 1, '\0', &sliceLength, NULL) != 0) {
+                    usage();
+                    return 2;
+                }
+                if (sliceLength == 0) {
+                    fprintf(stderr,
+                            "%s: the slice to verify is empty\n",
+                            gProgName);
+                    return 2;
+                }
+                break;
+            case HashCLIOptionRoot:
+                rootDigest = optarg;
+                if (parseDigest(rootDigest, root, sizeof(root)) != 0) {
+                    usage();
+                    return 2;
+                }
+                break;
+            case HashCLIOptionXof:
+                if (parseNumber(optarg, '\0', &state.xofLength, NULL) != 0 ||
+                    state.xofLength == 0) {
+                    usage();
+                    return 2;
+                }
+                break;
+            case '0':
+                delim = '\0';
+                break;
+            case 'i':
+                interleave = 0;
+                break;
+            case 'j':
+                if (parseSize(optarg, &state.threads) != 0 ||
+                    state.threads == 0 ||
+                    state.threads > HASH_TREE_MAX_THREADS) {
+                    usage();
+                    return 2;
+                }
+                break;
+            case 'n':
+                state.noMap = 1;
+                break;
+            case 'r':
+                state.recursive = 1;
+                break;
+            case 's':
+                threaded = 0;
+                break;
+            case 't':
+                state.tagOutput = 1;
+                break;
+            case 'u':
+                state.lowercase = 0;
+                break;
+            case 'l':
+                listHashes();
+                return 0;
+            case 'h':
+            default:
+                usage();
+                return 2;
+        }
+    }
+
+    argc -= optind;
+    argv += optind;
+
+    if (cachePath == NULL && (state.paranoid || clearCache)) {
+        usage();
+        return 2;
+    }
+
+    if (state.checkpoint == NULL &&
+        (state.checkpointInterval != 0 || state.append)) {
+        usage();
+        return 2;
+    }
+
+    // manifests are checked on the tree's pool, which doesn't read
+    // lists, cache or checkpoint
+
+    if ((check && (fileList != NULL || cachePath != NULL ||
+                   state.checkpoint != NULL || state.recursive)) ||
+        (!check && (state.quiet || state.failFast))) {
+        usage();
+        return 2;
+    }
+
+    if (state.checkpointInterval == 0) {
+        state.checkpointInterval = HashCLIDefaultCheckpointInterval;
+    }
+
+    // catch the SIGBUS raised when a mapped file is truncated while it
+    // is being hashed, so that it can be read instead (if the guard
+    // can't be installed, files are always read)
+
+    if (!state.noMap) {
+        (void)hash_map_install_guard();
+    }
+
+    // outboard trees are BLAKE3 only, and verifying a slice needs the
+    // trusted digest
+
+    if ((slice != NULL) != (rootDigest != NULL) ||
+        (slice != NULL && (argc != 1 || outboard)) ||
+        ((outboard || slice != NULL) &&
+         (check || argc == 0 || state.count > 0 || fileList != NULL ||
+          cachePath != NULL || state.checkpoint != NULL ||
+          state.recursive))) {
+        usage();
+        return 2;
+    }
+
+    if (slice != NULL) {
+        return (verifySlice(argv[0],
+                            root,
+                            sliceStart,
+                            sliceLength,
+                            !state.noMap) == 0 ?
+                0 : 1);
+    }
+
+    if (outboard) {
+        if (addHashes(&state, blake3Hash) != 0) {
+            return 2;
+        }
+    }
+
+    // raw XOF output is written for one hash of one file (or stdin)
+
+    if (state.xofLength > 0) {
+        if (argc > 1 || check || outboard || fileList != NULL ||
+            cachePath != NULL || state.checkpoint != NULL ||
+            state.recursive || state.count > 1) {
+            usage();
+            return 2;
+        }
+        if (state.count == 0 && addHashes(&state, xofHash) != 0) {
+            return 2;
+        }
+        if (!(state.ctx[0]->desc->flags & HASH_ENGINE_FLAG_XOF)) {
+            fprintf(stderr, "%s: %s is not an XOF\n",
+                    gProgName, state.ctx[0]->desc->name);
+            return 2;
+        }
+    }
+
+    // default to SHA256
+
+    if (state.count == 0) {
+        if (addHashes(&state, defaultHash) != 0) {
+            return 2;
+        }
+    }
+
+    // BSD style output is needed to tell the hashes apart
+
+    if (state.count > 1) {
+        state.tagOutput = 1;
+    }
+
+    for (i = 0; i < state.count; i++) {
+        if (hash_engine_string_length(state.ctx[i]->desc) > maxStringLength) {
+            maxStringLength = hash_engine_string_length(state.ctx[i]->desc);
+        }
+    }
+
+    state.blockSize = blockSize;
+    state.digestStr = calloc(maxStringLength + 1, sizeof(char));
+    state.multi = hash_multi_new(state.ctx,
+                                 state.count,
+                                 threaded,
+                                 blockSize,
+                                 queueDepth);
+    if (state.digestStr == NULL || state.multi == NULL) {
+        fprintf(stderr, "%s: %s\n", gProgName, strerror(ENOMEM));
+        return 2;
+    }
+
+    if (cachePath != NULL) {
+        state.cache = hash_cache_open(cachePath);
+        if (state.cache == NULL ||
+            (clearCache && hash_cache_clear(state.cache) != 0)) {
+            fprintf(stderr, "%s: %s: %s\n",
+                    gProgName, cachePath, strerror(errno));
+            return 2;
+        }
+    }
+
+    // with a single hash that can update several contexts at once, and
+    // more than one file, hash the files side by side in the SIMD lanes
+
+    if (state.count == 1) {
+        lanes = hash_engine_lanes(state.ctx[0]->desc->type);
+    }
+
+    // checkpoints are only saved when hashing one file at a time
+
+    if (state.checkpoint != NULL || check || outboard) {
+        interleave = 0;
+    }
+
+    if (interleave && lanes > 1 && lanes <= HashCLIMaxLanes &&
+        (fileList != NULL || argc > 1)) {
+        if (lanesNew(&state, lanes, blockSize) != 0) {
+            fprintf(stderr, "%s: %s\n", gProgName, strerror(ENOMEM));
+            return 2;
+        }
+    }
+
+    if (outboard) {
+        for (i = 0; i < (size_t)argc; i++) {
+            if (writeOutboard(&state, argv[i], !state.noMap) != 0) {
+                rc = 1;
+            }
+        }
+    } else if (check) {
+        if (argc == 0 && checkManifest(&state, "-") != 0) {
+            rc = 1;
+        }
+        for (i = 0; i < (size_t)argc && !state.checkStopped; i++) {
+            if (checkManifest(&state, argv[i]) != 0) {
+                rc = 1;
+            }
+        }
+    } else if (fileList != NULL) {
+        if (hashFileList(&state, fileList, delim) != 0) {
+            rc = 1;
+        }
+    } else if (argc == 0) {
+        if (hashFile(&state, "-") != 0) {
+            rc = 1;
+        }
+    }
+
+    for (i = 0; i < (size_t)argc && !check && !outboard; i++) {
+        if (hashPath(&state, argv[i]) != 0) {
+            rc = 1;
+        }
+    }
+
+    if (state.lanes != NULL) {
+        if (lanesFinish(&state) != 0) {
+            rc = 1;
+        }
+        lanesFree(&state);
+    }
+
+    hash_multi_free(state.multi);
+    for (i = 0; i < state.count; i++) {
+        hash_engine_free(state.ctx[i]);
+    }
+    free(state.digestStr);
+
+    if (state.cache != NULL && hash_cache_close(state.cache) != 0) {
+        fprintf(stderr, "%s: %s: %s\n",
+                gProgName, cachePath, strerror(errno));
+        rc = 1;
+    }
+
+    if (fflush(stdout) != 0) {
+        rc = 1;
+    }
+
+    return rc;
+}
@@ -0,0 +1,849 @@
+/*
+    Hash - hashbench.c
+
+    Throughput and latency benchmark for the hash engine.  Each requested
+    hash is timed over each requested message size (a fresh context is
+    initialized, updated and finalized for every message), and for the
+    hashes with run time selected SIMD implementations, once per
+    requested SIMD level so that the portable and SIMD code can be
+    compared.
+
+    usage: hashbench [-a hash[,hash...]] [-s size[,size...]]
+                     [-B level[,level...]] [-t seconds] [-i count]
+                     [-m count] [-x] [-f ghz] [-j] [-l]
+
+    Messages larger than HashBenchMaxBuffer are hashed by updating the
+    context repeatedly from the same buffer.  Large updates may be
+    hashed on several threads (BLAKE3, CRC32, cksum, K12), so for
+    those sizes the cycles/byte figures are per message, not per
+    core.
+
+    With -m, messages are hashed in batches with hash_engine_hash_many,
+    and the latencies are those of a whole batch.
+
+    With -x, the sizes are amounts of output squeezed from the XOFs
+    with hash_engine_squeeze, after hashing a short message.
+
+    History:
+
+    v. 1.0.0 (10/18/2026) - Initial version
+    v. 1.0.1 (10/18/2026) - benchmark hash_engine_hash_many (-m)
+    v. 1.0.2 (10/18/2026) - benchmark XOF output (-x)
+
+    Copyright (c) 2026 Sriranga R. Veeraraghavan <ranga@calalum.org>
+
+    Permission is hereby granted, free of charge, to any person obtaining
+    a copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+    OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <errno.h>
+#include <getopt.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <time.h>
+#include <unistd.h>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <x86intrin.h>
+#define HASHBENCH_HAVE_TSC 1
+#endif
+
+#include "hash_engine.h"
+
+// Limits and defaults
+
+enum {
+    HashBenchMaxHashes  = HASH_TYPE_COUNT,
+    HashBenchMaxSizes   = 32,
+    HashBenchMaxLevels  = HASH_ENGINE_SIMD_LEVEL_COUNT,
+    HashBenchMaxSamples = 1000000,
+    HashBenchDefaultIterations = 5,
+};
+
+// Messages larger than this (64MB) are hashed from a repeated buffer
+
+#define HashBenchMaxBuffer ((size_t)64 << 20)
+
+// Length of the message hashed before squeezing output with -x
+
+enum {
+    HashBenchXofMessage = 64,
+};
+
+// Default time spent on each measurement, in seconds
+
+#define HashBenchDefaultTime 0.25
+
+// Default message sizes
+
+static const char *gDefaultSizes = "64,1k,16k,1m,64m";
+
+/* the result of timing one hash, SIMD level and message size */
+
+typedef struct hashBenchResult {
+    size_t iterations;
+    double gbPerSecond;
+    double cyclesPerByte;       /* < 0 if unknown */
+    double minNs;
+    double p50Ns;
+    double p90Ns;
+    double p99Ns;
+    double maxNs;
+} hashBenchResult;
+
+/* benchmark settings */
+
+typedef struct hashBenchState {
+    const hashEngineDescriptor *hashes[HashBenchMaxHashes];
+    size_t              hashCount;
+    unsigned long long  sizes[HashBenchMaxSizes];
+    size_t              sizeCount;
+    hashEngineSimdLevel levels[HashBenchMaxLevels];
+    size_t              levelCount;
+    double              minTime;
+    size_t              minIterations;
+    double              ghz;
+    int                 json;
+    size_t              batch;
+    int                 xof;
+    unsigned char      *buffer;
+    size_t              bufferSize;
+    const unsigned char **inputs;
+    size_t             *lengths;
+    unsigned char      *digests;
+    unsigned char      *output;
+    double             *ns;
+    double             *cycles;
+} hashBenchState;
+
+static const char *gProgName = "hashbench";
+
+/*
+    usage - print the usage message
+ */
+
+static void usage(void)
+{
+    fprintf(stderr,
+            "usage: %s [-a hash[,hash...]] [-s size[,size...]]"
+            " [-B level[,level...]] [-t seconds] [-i count] [-m count]"
+            " [-x] [-f ghz] [-j] [-l]\n"
+            "    -a  hashes to benchmark (default: all)\n"
+            "    -s  message sizes, with an optional k, m or g suffix\n"
+            "        (default: %s)\n"
+            "    -B  SIMD levels to compare, 'native' or 'all'\n"
+            "        (default: portable,native)\n"
+            "    -t  minimum time for each measurement (default: %.2fs)\n"
+            "    -i  minimum number of messages for each measurement"
+            " (default: %d)\n"
+            "    -m  hash batches of count messages with"
+            " hash_engine_hash_many\n"
+            "    -x  squeeze size bytes of output from the XOFs\n"
+            "    -f  cpu frequency, to report cycles/byte on cpus"
+            " without a cycle counter\n"
+            "    -j  output JSON\n"
+            "    -l  list the supported hashes and SIMD levels\n",
+            gProgName,
+            gDefaultSizes,
+            HashBenchDefaultTime,
+            HashBenchDefaultIterations);
+}
+
+/*
+    listHashes - print the supported hashes and SIMD levels
+ */
+
+static void listHashes(void)
+{
+    const hashEngineDescriptor *desc = NULL;
+    int level = 0;
+    size_t i = 0;
+
+    while ((desc = hash_engine_descriptor_at(i++)) != NULL) {
+        printf("%s%s\n",
+               desc->name,
+               (desc->flags & HASH_ENGINE_FLAG_SIMD ? " (simd)" : ""));
+    }
+
+    printf("\nSIMD levels:");
+    for (level = 0; level <= (int)hash_engine_simd_detected(); level++) {
+        printf(" %s", hash_engine_simd_name((hashEngineSimdLevel)level));
+    }
+    printf("\n");
+}
+
+/*
+    parseSize - parse a positive number, with an optional k, m or g suffix
+ */
+
+static int parseSize(const char *str, unsigned long long *size)
+{
+    unsigned long long value = 0;
+    unsigned long long scale = 1;
+    char *end = NULL;
+
+    errno = 0;
+    value = strtoull(str, &end, 10);
+    if (errno != 0 || end == str || value == 0) {
+        return -1;
+    }
+
+    switch (*end) {
+        case 'k':
+        case 'K':
+            scale = 1024ULL;
+            end++;
+            break;
+        case 'm':
+        case 'M':
+            scale = 1024ULL*1024;
+            end++;
+            break;
+        case 'g':
+        case 'G':
+            scale = 1024ULL*1024*1024;
+            end++;
+            break;
+        default:
+            break;
+    }
+
+    if (*end != '\0' || value > UINT64_MAX / scale) {
+        return -1;
+    }
+
+    *size = value * scale;
+    return 0;
+}
+
+/*
+    addHashes - parse a comma separated list of hash names
+ */
+
+static int addHashes(hashBenchState *state, char *names)
+{
+    const hashEngineDescriptor *desc = NULL;
+    char *name = NULL;
+    char *last = NULL;
+
+    for (name = strtok_r(names, ",", &last);
+         name != NULL;
+         name = strtok_r(NULL, ",", &last)) {
+
+        desc = hash_engine_descriptor_by_name(name);
+        if (desc == NULL) {
+            fprintf(stderr, "%s: unknown or unsupported hash: %s\n",
+                    gProgName, name);
+            return -1;
+        }
+
+        if (state->hashCount >= HashBenchMaxHashes) {
+            fprintf(stderr, "%s: too many hashes\n", gProgName);
+            return -1;
+        }
+
+        state->hashes[state->hashCount++] = desc;
+    }
+
+    return 0;
+}
+
+/*
+    addSizes - parse a comma separated list of message sizes
+ */
+
+static int addSizes(hashBenchState *state, char *sizes)
+{
+    char *size = NULL;
+    char *last = NULL;
+
+    for (size = strtok_r(sizes, ",", &last);
+         size != NULL;
+         size = strtok_r(NULL, ",", &last)) {
+
+        if (state->sizeCount >= HashBenchMaxSizes) {
+            fprintf(stderr, "%s: too many sizes\n", gProgName);
+            return -1;
+        }
+
+        if (parseSize(size, &state->sizes[state->sizeCount]) != 0) {
+            fprintf(stderr, "%s: invalid size: %s\n", gProgName, size);
+            return -1;
+        }
+
+        state->sizeCount++;
+    }
+
+    return 0;
+}
+
+/*
+    addLevel - add a SIMD level, ignoring duplicates
+ */
+
+static void addLevel(hashBenchState *state, hashEngineSimdLevel level)
+{
+    size_t i = 0;
+
+    for (i = 0; i < state->levelCount; i++) {
+        if (state->levels[i] == level) {
+            return;
+        }
+    }
+
+    if (state->levelCount < HashBenchMaxLevels) {
+        state->levels[state->levelCount++] = level;
+    }
+}
+
+/*
+    addLevels - parse a comma separated list of SIMD levels, levels that
+                this cpu doesn't support are skipped
+ */
+
+static int addLevels(hashBenchState *state, char *names)
+{
+    hashEngineSimdLevel detected = hash_engine_simd_detected();
+    char *name = NULL;
+    char *last = NULL;
+    int level = 0;
+
+    for (name = strtok_r(names, ",", &last);
+         name != NULL;
+         name = strtok_r(NULL, ",", &last)) {
+
+        if (strcasecmp(name, "native") == 0) {
+            addLevel(state, detected);
+            continue;
+        }
+
+        if (strcasecmp(name, "all") == 0) {
+            for (level = 0; level <= (int)detected; level++) {
+                addLevel(state, (hashEngineSimdLevel)level);
+            }
+            continue;
+        }
+
+        level = hash_engine_simd_by_name(name);
+        if (level < 0) {
+            fprintf(stderr, "%s: unknown SIMD level: %s\n", gProgName, name);
+            return -1;
+        }
+
+        if (level > (int)detected) {
+            fprintf(stderr, "%s: %s is not supported, skipping\n",
+                    gProgName, name);
+            continue;
+        }
+
+        addLevel(state, (hashEngineSimdLevel)level);
+    }
+
+    return 0;
+}
+
+/* timers */
+
+static double nowNs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static uint64_t nowCycles(void)
+{
+#if defined(HASHBENCH_HAVE_TSC)
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+static int compareDoubles(const void *a, const void *b)
+{
+    double x = *(const double *)a;
+    double y = *(const double *)b;
+
+    return (x > y) - (x < y);
+}
+
+/* percentile - nearest rank percentile of n sorted samples */
+
+static double percentile(const double *samples, size_t n, double p)
+{
+    size_t rank = (size_t)(p / 100.0 * (double)n + 0.999999);
+
+    if (rank < 1) {
+        rank = 1;
+    }
+    if (rank > n) {
+        rank = n;
+    }
+
+    return samples[rank - 1];
+}
+
+/*
+    hashMessage - hash one message (or one batch of messages) of the
+                  specified size
+ */
+
+static void hashMessage(const hashBenchState *state,
+                        hashEngineContext *ctx,
+                        unsigned long long size,
+                        unsigned char *digest)
+{
+    size_t chunk = 0;
+    size_t i = 0;
+
+    // the messages in a batch are consecutive in the buffer, wrapping
+    // back to the start if the buffer isn't large enough
+
+    if (state->xof) {
+        hash_engine_reset(ctx);
+        hash_engine_update(ctx, state->buffer, HashBenchXofMessage);
+        while (size > 0) {
+            chunk = (size > state->bufferSize ?
+                     state->bufferSize : (size_t)size);
+            (void)hash_engine_squeeze(ctx, state->output, chunk);
+            size -= chunk;
+        }
+        return;
+    }
+
+    if (state->batch > 0) {
+        for (i = 0; i < state->batch; i++) {
+            state->lengths[i] = (size_t)size;
+            state->inputs[i] = state->buffer +
+                               (i * size) % (state->bufferSize - size + 1);
+        }
+        (void)hash_engine_hash_many(ctx->desc->type,
+                                    state->inputs,
+                                    state->lengths,
+                                    state->batch,
+                                    state->digests);
+        return;
+    }
+
+    hash_engine_reset(ctx);
+
+    while (size > 0) {
+        chunk = (size > state->bufferSize ? state->bufferSize : (size_t)size);
+        hash_engine_update(ctx, state->buffer, chunk);
+        size -= chunk;
+    }
+
+    (void)hash_engine_final(ctx, digest);
+}
+
+/*
+    measure - time messages of the specified size until both the minimum
+              time and the minimum number of messages have been reached
+ */
+
+static void measure(hashBenchState *state,
+                    hashEngineContext *ctx,
+                    unsigned long long size,
+                    hashBenchResult *result)
+{
+    unsigned char digest[256];
+    double start = 0, end = 0, total = 0;
+    double bytes = (double)size * (double)(state->batch > 0 ? state->batch : 1);
+    uint64_t startCycles = 0;
+    size_t n = 0;
+
+    // warm up the caches (and the thread pools)
+
+    hashMessage(state, ctx, size, digest);
+
+    while (n < HashBenchMaxSamples &&
+           (n < state->minIterations || total < state->minTime * 1e9)) {
+        startCycles = nowCycles();
+        start = nowNs();
+        hashMessage(state, ctx, size, digest);
+        end = nowNs();
+        state->cycles[n] = (double)(nowCycles() - startCycles);
+        state->ns[n] = end - start;
+        total += state->ns[n];
+        n++;
+    }
+
+    qsort(state->ns, n, sizeof(double), compareDoubles);
+    qsort(state->cycles, n, sizeof(double), compareDoubles);
+
+    result->iterations = n;
+    result->gbPerSecond = (total > 0 ? bytes * (double)n / total : 0);
+    result->minNs = state->ns[0];
+    result->p50Ns = percentile(state->ns, n, 50);
+    result->p90Ns = percentile(state->ns, n, 90);
+    result->p99Ns = percentile(state->ns, n, 99);
+    result->maxNs = state->ns[n - 1];
+
+#if defined(HASHBENCH_HAVE_TSC)
+    result->cyclesPerByte = percentile(state->cycles, n, 50) / bytes;
+#else
+    result->cyclesPerByte = (state->ghz > 0 ?
+                             result->p50Ns * state->ghz / bytes :
+                             -1);
+#endif
+}
+
+/* output */
+
+static void printHeader(const hashBenchState *state)
+{
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+
+    if (state->json) {
+        printf("{\n");
+        printf("  \"tool\": \"hashbench\",\n");
+        printf("  \"version\": \"1.0.0\",\n");
+        printf("  \"timestamp\": %lld,\n", (long long)time(NULL));
+        printf("  \"cpus\": %ld,\n", cpus);
+        printf("  \"batch\": %zu,\n", state->batch);
+        printf("  \"xof\": %s,\n", (state->xof ? "true" : "false"));
+        printf("  \"simd\": \"%s\",\n",
+               hash_engine_simd_name(hash_engine_simd_detected()));
+#if defined(HASHBENCH_HAVE_TSC)
+        printf("  \"cycles\": \"tsc\",\n");
+#else
+        printf("  \"cycles\": \"%s\",\n", (state->ghz > 0 ? "ghz" : "none"));
+#endif
+        printf("  \"results\": [");
+        return;
+    }
+
+    printf("cpus: %ld, simd: %s",
+           cpus,
+           hash_engine_simd_name(hash_engine_simd_detected()));
+    if (state->batch > 0) {
+        printf(", batches of %zu messages", state->batch);
+    }
+    if (state->xof) {
+        printf(", XOF output");
+    }
+    printf("\n\n");
+    printf("%-15s %-9s %11s %9s %9s %9s %11s %11s %11s\n",
+           "hash", "simd", "size", "count", "GB/s", "cpb",
+           "p50 (ns)", "p90 (ns)", "p99 (ns)");
+}
+
+static void printResult(const hashBenchState *state,
+                        const hashEngineDescriptor *desc,
+                        const char *level,
+                        unsigned long long size,
+                        const hashBenchResult *result,
+                        int first)
+{
+    if (state->json) {
+        printf("%s\n    {\"hash\": \"%s\", \"simd\": \"%s\", "
+               "\"size\": %llu, \"iterations\": %zu, "
+               "\"gb_per_s\": %.4f, ",
+               (first ? "" : ","),
+               desc->name, level, size, result->iterations,
+               result->gbPerSecond);
+        if (result->cyclesPerByte < 0) {
+            printf("\"cycles_per_byte\": null, ");
+        } else {
+            printf("\"cycles_per_byte\": %.3f, ", result->cyclesPerByte);
+        }
+        printf("\"latency_ns\": {\"min\": %.0f, \"p50\": %.0f, "
+               "\"p90\": %.0f, \"p99\": %.0f, \"max\": %.0f}}",
+               result->minNs, result->p50Ns, result->p90Ns,
+               result->p99Ns, result->maxNs);
+        return;
+    }
+
+    printf("%-15s %-9s %11llu %9zu %9.3f ",
+           desc->name, level, size, result->iterations,
+           result->gbPerSecond);
+    if (result->cyclesPerByte < 0) {
+        printf("%9s ", "-");
+    } else {
+        printf("%9.2f ", result->cyclesPerByte);
+    }
+    printf("%11.0f %11.0f %11.0f\n",
+           result->p50Ns, result->p90Ns, result->p99Ns);
+}
+
+static void printFooter(const hashBenchState *state)
+{
+    if (state->json) {
+        printf("\n  ]\n}\n");
+    }
+}
+
+/*
+    allocate - allocate the message buffer (filled with pseudo random
+               data) and the sample arrays
+ */
+
+static int allocate(hashBenchState *state)
+{
+    unsigned long long maxSize = 0;
+    uint64_t x = 0x9E3779B97F4A7C15ULL;
+    void *buffer = NULL;
+    size_t i = 0;
+
+    for (i = 0; i < state->sizeCount; i++) {
+        if (state->sizes[i] > maxSize) {
+            maxSize = state->sizes[i];
+        }
+    }
+
+    if (state->xof) {
+        if (maxSize < HashBenchXofMessage) {
+            maxSize = HashBenchXofMessage;
+        }
+        state->output = malloc(maxSize > HashBenchMaxBuffer ?
+                               HashBenchMaxBuffer : (size_t)maxSize);
+        if (state->output == NULL) {
+            return -1;
+        }
+    }
+
+    if (state->batch > 0) {
+        if (maxSize > HashBenchMaxBuffer) {
+            return -1;
+        }
+        maxSize = (maxSize * state->batch > HashBenchMaxBuffer ?
+                   HashBenchMaxBuffer : maxSize * state->batch);
+        state->inputs = calloc(state->batch, sizeof(unsigned char *));
+        state->lengths = calloc(state->batch, sizeof(size_t));
+        state->digests = calloc(state->batch, 256);
+        if (state->inputs == NULL ||
+            state->lengths == NULL ||
+            state->digests == NULL) {
+            return -1;
+        }
+    }
+
+    state->bufferSize = (maxSize > HashBenchMaxBuffer ?
+                         HashBenchMaxBuffer : (size_t)maxSize);
+
+    if (posix_memalign(&buffer, 64, state->bufferSize) != 0) {
+        return -1;
+    }
+    state->buffer = buffer;
+
+    for (i = 0; i < state->bufferSize; i++) {
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+        state->buffer[i] = (unsigned char)x;
+    }
+
+    state->ns = calloc(HashBenchMaxSamples, sizeof(double));
+    state->cycles = calloc(HashBenchMaxSamples, sizeof(double));
+    if (state->ns == NULL || state->cycles == NULL) {
+        return -1;
+    }
+
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    hashBenchState state;
+    hashBenchResult result;
+    hashEngineContext *ctx = NULL;
+    const hashEngineDescriptor *desc = NULL;
+    hashEngineSimdLevel detected = hash_engine_simd_detected();
+    char defaultSizes[64];
+    char *end = NULL;
+    size_t h = 0, l = 0, s = 0, levelCount = 0;
+    int first = 1;
+    int ch = 0;
+
+    memset(&state, 0, sizeof(state));
+    state.minTime = HashBenchDefaultTime;
+    state.minIterations = HashBenchDefaultIterations;
+
+    if (argv[0] != NULL && strrchr(argv[0], '/') != NULL) {
+        gProgName = strrchr(argv[0], '/') + 1;
+    }
+
+    while ((ch = getopt(argc, argv, "a:s:B:t:i:m:f:xjlh")) != -1) {
+        switch (ch) {
+            case 'a':
+                if (addHashes(&state, optarg) != 0) {
+                    return 2;
+                }
+                break;
+            case 's':
+                if (addSizes(&state, optarg) != 0) {
+                    return 2;
+                }
+                break;
+            case 'B':
+                if (addLevels(&state, optarg) != 0) {
+                    return 2;
+                }
+                break;
+            case 't':
+                state.minTime = strtod(optarg, &end);
+                if (end == optarg || *end != '\0' || state.minTime < 0) {
+                    fprintf(stderr, "%s: invalid time: %s\n",
+                            gProgName, optarg);
+                    return 2;
+                }
+                break;
+            case 'i':
+                state.minIterations = (size_t)strtoul(optarg, &end, 10);
+                if (end == optarg || *end != '\0' ||
+                    state.minIterations == 0) {
+                    fprintf(stderr, "%s: invalid count: %s\n",
+                            gProgName, optarg);
+                    return 2;
+                }
+                break;
+            case 'm':
+                state.batch = (size_t)strtoul(optarg, &end, 10);
+                if (end == optarg || *end != '\0' || state.batch == 0) {
+                    fprintf(stderr, "%s: invalid count: %s\n",
+                            gProgName, optarg);
+                    return 2;
+                }
+                break;
+            case 'f':
+                state.ghz = strtod(optarg, &end);
+                if (end == optarg || *end != '\0' || state.ghz <= 0) {
+                    fprintf(stderr, "%s: invalid frequency: %s\n",
+                            gProgName, optarg);
+                    return 2;
+                }
+                break;
+            case 'x':
+                state.xof = 1;
+                break;
+            case 'j':
+                state.json = 1;
+                break;
+            case 'l':
+                listHashes();
+                return 0;
+            case 'h':
+            default:
+                usage();
+                return 2;
+        }
+    }
+
+    if (optind != argc || (state.xof && state.batch > 0)) {
+        usage();
+        return 2;
+    }
+
+    // defaults: every hash (every XOF with -x), the default sizes,
+    // portable and native code
+
+    if (state.hashCount == 0) {
+        while ((desc = hash_engine_descriptor_at(h++)) != NULL &&
+               state.hashCount < HashBenchMaxHashes) {
+            if (!state.xof || (desc->flags & HASH_ENGINE_FLAG_XOF)) {
+                state.hashes[state.hashCount++] = desc;
+            }
+        }
+    }
+
+    for (h = 0; h < state.hashCount && state.xof; h++) {
+        if (!(state.hashes[h]->flags & HASH_ENGINE_FLAG_XOF)) {
+            fprintf(stderr, "%s: %s is not an XOF\n",
+                    gProgName, state.hashes[h]->name);
+            return 2;
+        }
+    }
+
+    if (state.sizeCount == 0) {
+        strncpy(defaultSizes, gDefaultSizes, sizeof(defaultSizes) - 1);
+        defaultSizes[sizeof(defaultSizes) - 1] = '\0';
+        (void)addSizes(&state, defaultSizes);
+    }
+
+    if (state.levelCount == 0) {
+        addLevel(&state, HASH_ENGINE_SIMD_PORTABLE);
+        addLevel(&state, detected);
+    }
+
+    if (allocate(&state) != 0) {
+        fprintf(stderr, "%s: %s\n", gProgName,
+                (state.buffer == NULL && state.batch > 0 ?
+                 "batched messages must be 64m or smaller" :
+                 strerror(ENOMEM)));
+        return 2;
+    }
+
+    printHeader(&state);
+
+    for (h = 0; h < state.hashCount; h++) {
+
+        desc = state.hashes[h];
+        ctx = hash_engine_new(desc->type);
+        if (ctx == NULL) {
+            fprintf(stderr, "%s: %s\n", gProgName, strerror(ENOMEM));
+            return 2;
+        }
+
+        // only the hashes with SIMD code are run at each level
+
+        levelCount = (desc->flags & HASH_ENGINE_FLAG_SIMD ?
+                      state.levelCount : 1);
+
+        for (l = 0; l < levelCount; l++) {
+
+            if (desc->flags & HASH_ENGINE_FLAG_SIMD) {
+                hash_engine_set_simd_level(state.levels[l]);
+            } else {
+                hash_engine_set_simd_level(detected);
+            }
+
+            for (s = 0; s < state.sizeCount; s++) {
+                measure(&state, ctx, state.sizes[s], &result);
+                printResult(&state,
+                            desc,
+                            (desc->flags & HASH_ENGINE_FLAG_SIMD ?
+                             hash_engine_simd_name(state.levels[l]) :
+                             "-"),
+                            state.sizes[s],
+                            &result,
+                            first);
+                first = 0;
+                fflush(stdout);
+            }
+        }
+
+        hash_engine_free(ctx);
+    }
+
+    printFooter(&state);
+
+    free(state.buffer);
+    free(state.ns);
+    free(state.cycles);
+    free(state.inputs);
+    free(state.lengths);
+    free(state.digests);
+    free(state.output);
+
+    return (fflush(stdout) == 0 ? 0 : 1);
+}